@@ -44,6 +44,7 @@
 #include "atcacert\atcacert_client.h"
 #include "atcacert\atcacert_host_hw.h"
 #include "basic\atca_helpers.h"
+#include "basic\atca_basic.h"
 #include <stdio.h>
 
 /** \defgroup auth Node authentication stages for node-auth-basic example
@@ -80,19 +81,35 @@ int client_rebuild_certs(void)
 {
     int ret = 0;
     uint8_t signer_public_key[64];
-    
-    g_signer_cert_size = sizeof(g_signer_cert);
-	ret = atcacert_read_cert(&g_cert_def_1_signer, g_signer_ca_public_key, g_signer_cert, &g_signer_cert_size);
-    if (ret != ATCACERT_E_SUCCESS) return ret;
-    
-    ret = atcacert_get_subj_public_key(&g_cert_def_1_signer, g_signer_cert, g_signer_cert_size, signer_public_key);
-    if (ret != ATCACERT_E_SUCCESS) return ret;
-    
-    g_device_cert_size = sizeof(g_device_cert);
-    ret = atcacert_read_cert(&g_cert_def_2_device, signer_public_key, g_device_cert, &g_device_cert_size);
-    if (ret != ATCACERT_E_SUCCESS) return ret;
+    // Read plans only depend on the cert defs, work them out once
+    static atcacert_read_plan_t signer_plan, device_plan;
+    static int plans_built = 0;
+
+    if (!plans_built)
+    {
+        ret = atcacert_read_plan_build(&g_cert_def_1_signer, &signer_plan);
+        if (ret != ATCACERT_E_SUCCESS) return ret;
+        ret = atcacert_read_plan_build(&g_cert_def_2_device, &device_plan);
+        if (ret != ATCACERT_E_SUCCESS) return ret;
+        plans_built = 1;
+    }
+
+    // Both certs are read while the device stays awake
+    atcab_session_begin();
 
-    return 0;
+    g_signer_cert_size = sizeof(g_signer_cert);
+    ret = atcacert_read_cert_plan(&signer_plan, g_signer_ca_public_key, g_signer_cert, &g_signer_cert_size);
+    if (ret == ATCACERT_E_SUCCESS)
+        ret = atcacert_get_subj_public_key(&g_cert_def_1_signer, g_signer_cert, g_signer_cert_size, signer_public_key);
+    if (ret == ATCACERT_E_SUCCESS)
+    {
+        g_device_cert_size = sizeof(g_device_cert);
+        ret = atcacert_read_cert_plan(&device_plan, signer_public_key, g_device_cert, &g_device_cert_size);
+    }
+
+    atcab_session_end();
+
+    return ret;
 }
 
 /** \brief This host role method demonstrates how to do a chain verify.  In this example, there is a root certificate
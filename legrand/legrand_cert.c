@@ -15,8 +15,10 @@
 /* ATCA specific implementation */
 #include "cryptoauthlib.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
 #include "atcacert/atcacert_date.h"
 #include "atcacert/atcacert_def.h"
+#include "atcacert/atcacert_cache.h"
 #include "tls/atcatls.h"
 #include "atca_status.h"
 #include "atca_iface.h"
@@ -1033,7 +1035,8 @@ bool lg_get_publickey(
 }
 
 /**
- * Read the Microchip public key from the ECC508A
+ * Read the Microchip public key from the ECC508A and register it with the
+ * software ECDSA verification key cache
  *
  * @param pubKeyBuf - place to put the results of reading the key
  * @param bufLen - size of the buffer
@@ -1058,6 +1061,9 @@ bool lg_get_microchip_pubkey(
             // intermediate keys.
             memcpy(pubKeyBuf, publicKeys + (ECC_P384_PUBLIC_KEYLEN * 2),
                 ECC_P256_PUBLIC_KEYLEN);
+            // the mfg ca key signs every device cert, give it a verification table
+            // up front. The legrand keys are P-384 and have no software verifier.
+            atcac_sw_ecdsa_p256_cache_add(pubKeyBuf);
             return true;
         }
     }
@@ -1635,6 +1641,52 @@ bool lg_init_atcatls(ATCAIfaceCfg* pCfg)
     return false;
 }
 
+/* Certificate cache ids for the Legrand certificates, kept clear of the ids
+ * atcacert_read_cert_cached() derives from a cert definition */
+#define LG_CERT_CACHE_ID(slot)  (0x4C470000UL | (slot))
+
+/**
+ * Look a certificate up in the certificate cache by its compressed cert
+ *
+ * @param slot        slot the compressed cert was read from
+ * @param template    certificate template the cert is built on
+ * @param templateLen template size
+ * @param compCert    compressed cert read from the slot
+ * @param fingerprint receives the fingerprint to store a rebuilt cert under
+ * @param certBuf
+ * @param certBufLen
+ * @param certAdjLen
+ *
+ * @return true if certBuf holds the cached certificate
+ */
+static bool lg_cert_cache_lookup(
+    uint8_t slot,
+    const uint8_t * template,
+    size_t templateLen,
+    const COMPRESSED_CERT * compCert,
+    uint8_t * fingerprint,
+    uint8_t * certBuf,
+    const uint32_t certBufLen,
+    uint32_t * certAdjLen)
+{
+    size_t certLen = certBufLen;
+
+    if (!atcacert_cache_is_enabled()) {
+        return false;
+    }
+    if (atcacert_cache_fingerprint(template, templateLen, (const uint8_t *) compCert,
+            sizeof(*compCert), NULL, fingerprint) != ATCACERT_E_SUCCESS) {
+        return false;
+    }
+    if (atcacert_cache_lookup(LG_CERT_CACHE_ID(slot), fingerprint, certBuf, &certLen,
+            NULL, NULL) != ATCACERT_E_SUCCESS) {
+        return false;
+    }
+
+    *certAdjLen = (uint32_t) certLen;
+    return true;
+}
+
 /**
  *
  * read the Factory Certificate from ECC508A
@@ -1658,6 +1710,7 @@ bool lg_factory_ca_read_certificate(
     uint8_t validDate[CERT_MAX_DATE_LEN] = { 0 };
     uint8_t expireDate[CERT_MAX_DATE_LEN] = { 0 };
     uint8_t signerCommonName[MAX_COMMON_NAME] = { 0 };
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE] = { 0 };
     size_t validDateLen = 0, expireDateLen = 0;
 
     if (certBufLen < sizeof(signer_cert_template)) {
@@ -1678,6 +1731,13 @@ bool lg_factory_ca_read_certificate(
         return false;
     }
 
+    // An unchanged compressed cert rebuilds to the certificate already cached
+    if (lg_cert_cache_lookup(Slot_Factory_CA_Compressed_Cert, signer_cert_template,
+            sizeof(signer_cert_template), &factoryCompCert, fingerprint,
+            certBuf, certBufLen, certAdjLen)) {
+        return true;
+    }
+
     // Convert the date compressed format to the format used by
     // the certificate, which is UTC.
     validDateLen = expireDateLen = CERT_MAX_DATE_LEN;
@@ -1762,6 +1822,11 @@ bool lg_factory_ca_read_certificate(
         return false;
     }
 
+    if (atcacert_cache_is_enabled()) {
+        atcacert_cache_store(LG_CERT_CACHE_ID(Slot_Factory_CA_Compressed_Cert),
+            fingerprint, certBuf, *certAdjLen);
+    }
+
     return true;
 }
 
@@ -1789,6 +1854,7 @@ bool lg_device_read_certificate(
     uint8_t validDate[CERT_MAX_DATE_LEN] = { 0 };
     uint8_t expireDate[CERT_MAX_DATE_LEN] = { 0 };
     uint8_t authorityKeyId[CERT_KEY_ID_LEN] = { 0 };
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE] = { 0 };
     size_t validDateLen = 0, expireDateLen = 0;
     uint32_t certTemplateLen = 0;
 
@@ -1814,6 +1880,13 @@ bool lg_device_read_certificate(
     if (!lg_read_compressed_cert(&deviceCompCert, CERT_DEVICE) ) {
         return false;
     }
+
+    // An unchanged compressed cert rebuilds to the certificate already cached
+    if (lg_cert_cache_lookup(Slot_Device_Compressed_Cert, device_cert_template,
+            sizeof(device_cert_template), &deviceCompCert, fingerprint,
+            certBuf, certBufLen, certAdjLen)) {
+        return true;
+    }
     // get the R part of the signature
     device_cert_elements[CERT_ELM_SIGNATURE_R].value =
         deviceCompCert.signature;
@@ -1919,6 +1992,11 @@ bool lg_device_read_certificate(
         return false;
     }
 
+    if (atcacert_cache_is_enabled()) {
+        atcacert_cache_store(LG_CERT_CACHE_ID(Slot_Device_Compressed_Cert),
+            fingerprint, certBuf, *certAdjLen);
+    }
+
     return true;
 }
 
@@ -135,4 +135,20 @@ ATCAIfaceCfg cfg_atsha204a_kithid_default = {
     .atcahid.guid       = { 0x4d,        0x1e, 0x55, 0xb2, 0xf1, 0x6f, 0x11, 0xcf, 0x88, 0xcb, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30 },
 };
 
+/** \brief default configuration for a simulated ATECC508A, see hal_sim.c */
+ATCAIfaceCfg cfg_atecc508a_sim_default = {
+    .iface_type         = ATCA_SIM_IFACE,
+    .devtype            = ATECC508A,
+    .atcasim.device_id  = 0,
+    .rx_retries         = 1
+};
+
+/** \brief default configuration for a simulated ATSHA204A, see hal_sim.c */
+ATCAIfaceCfg cfg_atsha204a_sim_default = {
+    .iface_type         = ATCA_SIM_IFACE,
+    .devtype            = ATSHA204A,
+    .atcasim.device_id  = 0,
+    .rx_retries         = 1
+};
+
 /** @} */
@@ -71,6 +71,12 @@ extern ATCAIfaceCfg cfg_atecc508a_kithid_default;
 /** \brief default configuration for Kit protocol over a HID interface for SHA204 */
 extern ATCAIfaceCfg cfg_atsha204a_kithid_default;
 
+/** \brief default configuration for a simulated ATECC508A */
+extern ATCAIfaceCfg cfg_atecc508a_sim_default;
+
+/** \brief default configuration for a simulated ATSHA204A */
+extern ATCAIfaceCfg cfg_atsha204a_sim_default;
+
 /** \brief example of a default configuration for AES132 SPI */
 extern ATCAIfaceCfg cfg_ataes132a_spi_default;
 
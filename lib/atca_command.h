@@ -165,6 +165,7 @@ typedef enum
 
 ATCA_STATUS atInitExecTimes(ATCACommand cacmd, ATCADeviceType device_type);
 uint16_t atGetExecTime(ATCACommand cacmd, ATCA_CmdMap cmd);
+uint16_t atGetOpcodeExecTime(ATCACommand cacmd, uint8_t opcode);
 
 void deleteATCACommand(ATCACommand *);        // destructor
 /*---- end of ATCACommand ----*/
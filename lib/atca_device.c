@@ -37,7 +37,11 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "atca_device.h"
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
 
 /** \defgroup device ATCADevice (atca_)
  * \brief ATCADevice object - composite of command and interface objects
@@ -49,8 +53,13 @@
 
 struct atca_device
 {
-    ATCACommand mCommands;  // has-a command set to support a given CryptoAuth device
-    ATCAIface   mIface;     // has-a physical interface
+    ATCACommand      mCommands; // has-a command set to support a given CryptoAuth device
+    ATCAIface        mIface;    // has-a physical interface
+    ATCASession      mSession;  // wake state across commands
+    ATCAConfigShadow mConfig;   // config zone as last read from the device
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_t mLock;  // recursive, serializes commands and sessions from different threads
+#endif
 };
 
 /** \brief constructor for an Atmel CryptoAuth device
@@ -66,14 +75,31 @@ ATCADevice newATCADevice(ATCAIfaceCfg *cfg)
         return NULL;
 
     cadev = (ATCADevice)malloc(sizeof(struct atca_device));
+    if (cadev == NULL)
+        return NULL;
+
+    memset(&cadev->mSession, 0, sizeof(cadev->mSession));
+    memset(&cadev->mConfig, 0, sizeof(cadev->mConfig));
     cadev->mCommands = (ATCACommand)newATCACommand(cfg->devtype);
     cadev->mIface    = (ATCAIface)newATCAIface(cfg);
 
     if (cadev->mCommands == NULL || cadev->mIface == NULL)
     {
         free(cadev);
-        cadev = NULL;
+        return NULL;
+    }
+
+#ifdef ATCA_USE_PTHREADS
+    {
+        pthread_mutexattr_t attr;
+
+        // a session holds the lock across the commands it runs, which take it again
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&cadev->mLock, &attr);
+        pthread_mutexattr_destroy(&attr);
     }
+#endif
 
     return cadev;
 }
@@ -84,6 +110,9 @@ ATCADevice newATCADevice(ATCAIfaceCfg *cfg)
  */
 ATCACommand atGetCommands(ATCADevice dev)
 {
+    if (dev == NULL)
+        return NULL;
+
     return dev->mCommands;
 }
 
@@ -94,9 +123,74 @@ ATCACommand atGetCommands(ATCADevice dev)
 
 ATCAIface atGetIFace(ATCADevice dev)
 {
+    if (dev == NULL)
+        return NULL;
+
     return dev->mIface;
 }
 
+/** \brief returns a reference to the session (wake) state of the device
+ * \param[in] dev  reference to a device
+ * \return reference to the session state of the device
+ */
+
+ATCASession* atGetSession(ATCADevice dev)
+{
+    if (dev == NULL)
+        return NULL;
+
+    return &dev->mSession;
+}
+
+/** \brief returns a reference to the config zone shadow of the device
+ * \param[in] dev  reference to a device
+ * \return reference to the config zone shadow of the device
+ */
+
+ATCAConfigShadow* atGetConfigShadow(ATCADevice dev)
+{
+    if (dev == NULL)
+        return NULL;
+
+    return &dev->mConfig;
+}
+
+/** \brief take exclusive use of a device for the calling thread
+ *
+ * Commands and sessions on the device from other threads wait until the matching
+ * atca_device_unlock(). The lock is recursive, so a thread may take it again while it
+ * holds it. Without ATCA_USE_PTHREADS this does nothing.
+ * \param[in] dev  reference to a device
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_device_lock(ATCADevice dev)
+{
+    if (dev == NULL)
+        return ATCA_BAD_PARAM;
+
+#ifdef ATCA_USE_PTHREADS
+    if (pthread_mutex_lock(&dev->mLock) != 0)
+        return ATCA_GEN_FAIL;
+#endif
+    return ATCA_SUCCESS;
+}
+
+/** \brief give up a hold on a device taken with atca_device_lock()
+ * \param[in] dev  reference to a device
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_device_unlock(ATCADevice dev)
+{
+    if (dev == NULL)
+        return ATCA_BAD_PARAM;
+
+#ifdef ATCA_USE_PTHREADS
+    if (pthread_mutex_unlock(&dev->mLock) != 0)
+        return ATCA_GEN_FAIL;
+#endif
+    return ATCA_SUCCESS;
+}
+
 /** \brief destructor for a device NULLs reference after object is freed
  * \param[in] cadev  pointer to a reference to a device
  *
@@ -110,6 +204,9 @@ void deleteATCADevice(ATCADevice *cadev)   // destructor
     {
         deleteATCACommand( (ATCACommand*)&(dev->mCommands));
         deleteATCAIface((ATCAIface*)&(dev->mIface));
+#ifdef ATCA_USE_PTHREADS
+        pthread_mutex_destroy(&dev->mLock);
+#endif
         free((void*)*cadev);
     }
 
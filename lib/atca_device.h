@@ -52,9 +52,39 @@ extern "C" {
 typedef struct atca_device * ATCADevice;
 ATCADevice newATCADevice(ATCAIfaceCfg *cfg);   // constructor
 
+/** \brief wake state the execution engine keeps for a device across commands */
+typedef struct
+{
+    int      depth;     // nesting level of open sessions, 0 when every command is bracketed by wake/idle
+    bool     awake;     // device has been woken and not idled or put to sleep since
+    uint32_t awake_us;  // device time accounted since the last wake, used to stay inside the watchdog timeout without a clock
+    uint64_t wake_us;   // monotonic time of the last wake, where the platform has a clock
+} ATCASession;
+
+/** \brief config zone bus reads a device's config shadow has filled and saved */
+typedef struct
+{
+    uint32_t fills;         // bulk reads of the whole config zone into the shadow
+    uint32_t reads_saved;   // config zone reads answered from the shadow instead of the bus
+    uint32_t invalidations; // writes, locks and UpdateExtra commands that dropped the shadow
+} ATCAConfigShadowStats;
+
+/** \brief host copy of a device's config zone, filled on the first config read and dropped
+ *         by anything that can change it */
+typedef struct
+{
+    bool                  valid;                        // data holds the config zone as last read
+    uint8_t               data[ATCA_ECC_CONFIG_SIZE];   // ATCA_SHA_CONFIG_SIZE bytes used on SHA devices
+    ATCAConfigShadowStats stats;
+} ATCAConfigShadow;
+
 /* member functions here */
 ATCACommand atGetCommands(ATCADevice dev);
 ATCAIface atGetIFace(ATCADevice dev);
+ATCASession* atGetSession(ATCADevice dev);
+ATCAConfigShadow* atGetConfigShadow(ATCADevice dev);
+ATCA_STATUS atca_device_lock(ATCADevice dev);
+ATCA_STATUS atca_device_unlock(ATCADevice dev);
 
 void deleteATCADevice(ATCADevice *dev);        // destructor
 /*---- end of OATCADevice ----*/
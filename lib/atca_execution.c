@@ -0,0 +1,448 @@
+/**
+ * \file
+ * \brief Command execution engine shared by the basic API.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cryptoauthlib.h"
+#ifdef __linux__
+#include <time.h>
+#endif
+
+/** \defgroup execution Command execution (atca_)
+ * \brief Runs a built ATCAPacket against a device: wake, send, wait, receive,
+ *        response checks and idle all happen here rather than in each caller.
+   @{ */
+
+/** \brief collect the response to a command that has just been sent
+ *
+ * With a zero poll_interval in the interface configuration the full execution time
+ * is waited before a single receive. Otherwise the response is polled every
+ * poll_interval microseconds, so the receive succeeds as soon as the device has
+ * finished and ACKs its address. Polling gives up once the execution time from the
+ * command's exectimes table has elapsed and rx_retries further polls have failed.
+ * \param[in]    iface           interface the command was sent on
+ * \param[inout] packet          command packet, rxsize holds the expected response size
+ * \param[in]    execution_time  maximum execution time of the command in milliseconds
+ * \param[inout] elapsed_us      incremented by the time spent waiting for the device
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS atca_get_response(ATCAIface iface, ATCAPacket *packet, uint16_t execution_time, uint32_t *elapsed_us)
+{
+    ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+    ATCA_STATUS status;
+    uint16_t rxsize = packet->rxsize;
+    uint32_t deadline = (uint32_t)execution_time * 1000;
+    uint32_t waited = 0;
+    int retries = cfg->rx_retries;
+
+    // the simulator has finished the command by the time atsend() returns
+    if (cfg->iface_type == ATCA_SIM_IFACE)
+        return atreceive(iface, packet->data, &packet->rxsize);
+
+    if (cfg->poll_interval == 0)
+    {
+        // delay the appropriate amount of time for command to execute
+        atca_delay_ms(execution_time);
+        *elapsed_us += (uint32_t)execution_time * 1000;
+        return atreceive(iface, packet->data, &packet->rxsize);
+    }
+
+    do
+    {
+        atca_delay_us(cfg->poll_interval);
+        waited += cfg->poll_interval;
+
+        // the device NACKs its address until the command has completed
+        packet->rxsize = rxsize;
+        if ( (status = atreceive(iface, packet->data, &packet->rxsize)) == ATCA_SUCCESS)
+            break;
+    }
+    while (waited < deadline || retries-- > 0);
+
+    *elapsed_us += waited;
+    return status;
+}
+
+/** \brief check a received response frame: size, CRC and the device status
+ * \param[in] packet  packet holding the response in its data member
+ * \return ATCA_SUCCESS for a good response, otherwise the error from the frame
+ */
+static ATCA_STATUS atca_check_response(ATCAPacket *packet)
+{
+    uint8_t count = packet->data[ATCA_COUNT_IDX];
+
+    // Check response size
+    if (packet->rxsize < 4)
+        return packet->rxsize > 0 ? ATCA_RX_FAIL : ATCA_RX_NO_RESPONSE;
+
+    if (count < 4 || count > packet->rxsize)
+        return ATCA_RX_FAIL;
+
+    if (atCheckCrc(packet->data) != ATCA_SUCCESS)
+        return ATCA_BAD_CRC;
+
+    return isATCAError(packet->data);
+}
+
+#ifdef __linux__
+/** \brief monotonic time in microseconds, sessions measure how long the device has been awake with it */
+static uint64_t atca_session_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+#endif
+
+/** \brief whether a session's device can take another command without being woken
+ *
+ * Where the platform has a clock the time since the wake is measured, so host work
+ * between the commands of a session counts against the watchdog as well. Without one
+ * only the accounted device time (awake_us) is available.
+ * \param[in] session  session state of the device
+ * \return true if the device is awake and well inside its watchdog timeout
+ */
+static bool atca_session_fresh(ATCASession *session)
+{
+    if (session->depth == 0 || !session->awake)
+        return false;
+#ifdef __linux__
+    return atca_session_now_us() - session->wake_us < ATCA_SESSION_REWAKE_US;
+#else
+    return session->awake_us < ATCA_SESSION_REWAKE_US;
+#endif
+}
+
+/** \brief make sure the device is awake before a command is sent to it
+ *
+ * Outside a session the device is always woken. Inside a session it is woken once
+ * and left awake, except that it is idled and woken again once it has been awake for
+ * ATCA_SESSION_REWAKE_US (see atca_session_fresh()), which restarts the watchdog long
+ * before it would put the device to sleep. Idle keeps TempKey.
+ * \param[in] iface    interface of the device
+ * \param[in] session  session state of the device
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS atca_session_wake(ATCAIface iface, ATCASession *session)
+{
+    ATCA_STATUS status;
+
+    if (atca_session_fresh(session))
+        return ATCA_SUCCESS;
+
+    if (session->awake)
+        atidle(iface);
+    session->awake = false;
+
+#ifdef __linux__
+    // the watchdog starts with the wake pulse
+    session->wake_us = atca_session_now_us();
+#endif
+    if ( (status = atwake(iface)) != ATCA_SUCCESS)
+        return status;
+
+    session->awake = true;
+    session->awake_us = atgetifacecfg(iface)->wake_delay;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief execute a command that has been built by one of the ATCACommand methods
+ *
+ * Wakes the device, sends the packet, waits for or polls the response according to
+ * the interface configuration, and checks its size, CRC and status. A command the
+ * device reports having received with a bad CRC is sent again, up to
+ * ATCA_EXECUTE_RETRIES times. Outside a session the device is idled afterwards,
+ * unless communication failed outright; inside one it is left awake for the next
+ * command (see atca_session_begin()). The device is locked against other threads
+ * for the duration of the command.
+ * \param[in]    device  device to execute the command on
+ * \param[inout] packet  built command, receives the response in its data member
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_execute_command(ATCADevice device, ATCAPacket *packet)
+{
+    ATCA_STATUS status;
+    ATCAIface iface;
+    ATCASession *session;
+    uint16_t execution_time;
+    uint16_t rxsize;
+    bool was_awake;
+    int retries = ATCA_EXECUTE_RETRIES;
+
+    if (device == NULL)
+        return ATCA_GEN_FAIL;
+    if (packet == NULL)
+        return ATCA_BAD_PARAM;
+
+    if ( (status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+
+    iface = atGetIFace(device);
+    session = atGetSession(device);
+    execution_time = atGetOpcodeExecTime(atGetCommands(device), packet->opcode);
+    rxsize = packet->rxsize;
+
+    do
+    {
+        was_awake = atca_session_fresh(session);
+        if ( (status = atca_session_wake(iface, session)) != ATCA_SUCCESS)
+            BREAK(status, "Failed to wakeup");
+
+        do
+        {
+            packet->rxsize = rxsize;
+            session->awake_us += ATCA_SESSION_XFER_US;
+
+            // send the command
+            status = atsend(iface, (uint8_t*)packet, packet->txsize);
+            if (status != ATCA_SUCCESS && was_awake)
+            {
+                // the device went to sleep behind the session's back and never saw the command
+                was_awake = false;
+                session->awake = false;
+                if ( (status = atca_session_wake(iface, session)) != ATCA_SUCCESS)
+                    break;
+                status = atsend(iface, (uint8_t*)packet, packet->txsize);
+            }
+            if (status != ATCA_SUCCESS)
+                break;
+
+            // receive the response
+            if ( (status = atca_get_response(iface, packet, execution_time, &session->awake_us)) != ATCA_SUCCESS)
+                break;
+
+            status = atca_check_response(packet);
+        }
+        while (status == ATCA_STATUS_CRC && retries-- > 0);    // the device dropped a corrupted command
+    }
+    while (0);
+
+    if (status == ATCA_COMM_FAIL)     // don't keep shoving more stuff at the chip if there's something wrong with comm
+        session->awake = false;
+    else if (session->depth == 0)
+    {
+        atidle(iface);
+        session->awake = false;
+    }
+
+    atca_device_unlock(device);
+    return status;
+}
+
+/** \brief open a session on a device, keeping it awake across the commands that follow
+ *
+ * Commands executed until the matching atca_session_end() share a single wake instead
+ * of waking and idling the device one command at a time. Long batches are re-woken
+ * transparently before the watchdog timeout. Sessions nest, the device is idled when
+ * the outermost one ends. The calling thread keeps the device locked until then, so
+ * the commands of a session are never interleaved with another thread's.
+ *
+ * The re-wake happens before a command once the device has been awake for
+ * ATCA_SESSION_REWAKE_US, measured on the monotonic clock on Linux. Builds without a
+ * clock only account device time plus ATCA_SESSION_XFER_US per command, so host work
+ * between commands goes unseen there and has to stay well short of the ~1.3 s
+ * watchdog. Either way a pause longer than the watchdog between two commands lets the
+ * device sleep: the next command wakes it again, but TempKey and the SHA context are
+ * lost by then.
+ * \param[in] device  device to open the session on
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_session_begin(ATCADevice device)
+{
+    ATCA_STATUS status;
+
+    if (device == NULL)
+        return ATCA_GEN_FAIL;
+
+    // held until the matching atca_session_end()
+    if ( (status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+
+    atGetSession(device)->depth++;
+    return ATCA_SUCCESS;
+}
+
+/** \brief close a session opened with atca_session_begin(), idling the device when the
+ *         outermost session ends
+ * \param[in] device  device to close the session on
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_session_end(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCASession *session;
+
+    if (device == NULL)
+        return ATCA_GEN_FAIL;
+
+    // a thread without a session of its own waits here, then finds depth 0
+    if ( (status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+
+    session = atGetSession(device);
+    if (session->depth == 0)
+    {
+        atca_device_unlock(device);
+        return ATCA_BAD_PARAM;
+    }
+
+    if (--session->depth == 0 && session->awake)
+    {
+        session->awake = false;
+        status = atidle(atGetIFace(device));
+    }
+
+    atca_device_unlock(device);
+    atca_device_unlock(device);    // the hold taken by atca_session_begin()
+    return status;
+}
+
+/** \brief send a command without waiting for its response, so the host can work while
+ *         the device executes it
+ *
+ * Only valid inside a session (see atca_session_begin()), which keeps the device awake
+ * and locked to the calling thread until atca_execute_receive() collects the response.
+ * No other command may be executed on the device in between.
+ * \param[in]    device      device to send the command to
+ * \param[in]    packet      built command, rxsize holds the expected response size
+ * \param[inout] elapsed_us  if not NULL, incremented by the device time accounted for a
+ *                           wake and the transfer
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_execute_send(ATCADevice device, ATCAPacket *packet, uint32_t *elapsed_us)
+{
+    ATCA_STATUS status;
+    ATCAIface iface;
+    ATCASession *session;
+    uint32_t before;
+    bool was_awake;
+
+    if (device == NULL)
+        return ATCA_GEN_FAIL;
+    if (packet == NULL)
+        return ATCA_BAD_PARAM;
+
+    if ( (status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+
+    iface = atGetIFace(device);
+    session = atGetSession(device);
+    do
+    {
+        if (session->depth == 0)
+        {
+            status = ATCA_BAD_PARAM;
+            break;
+        }
+
+        was_awake = atca_session_fresh(session);
+        if ( (status = atca_session_wake(iface, session)) != ATCA_SUCCESS)
+            BREAK(status, "Failed to wakeup");
+        before = was_awake ? session->awake_us : 0;
+        session->awake_us += ATCA_SESSION_XFER_US;
+
+        status = atsend(iface, (uint8_t*)packet, packet->txsize);
+        if (status != ATCA_SUCCESS && was_awake)
+        {
+            // the device went to sleep behind the session's back and never saw the command
+            session->awake = false;
+            if ( (status = atca_session_wake(iface, session)) != ATCA_SUCCESS)
+                break;
+            before = 0;
+            session->awake_us += ATCA_SESSION_XFER_US;
+            status = atsend(iface, (uint8_t*)packet, packet->txsize);
+        }
+
+        if (elapsed_us != NULL)
+            *elapsed_us += session->awake_us - before;
+    }
+    while (0);
+
+    if (status == ATCA_COMM_FAIL)
+        session->awake = false;
+
+    atca_device_unlock(device);
+    return status;
+}
+
+/** \brief collect and check the response to a command sent with atca_execute_send()
+ *
+ * Waits for or polls the response according to the interface configuration, then
+ * checks its size, CRC and status. Unlike atca_execute_command() a command the device
+ * received with a bad CRC is not sent again, the response has already replaced its data.
+ * \param[in]    device      device the command was sent to
+ * \param[inout] packet      the packet that was sent, receives the response in its data member
+ * \param[inout] elapsed_us  if not NULL, incremented by the time spent waiting for the device
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_execute_receive(ATCADevice device, ATCAPacket *packet, uint32_t *elapsed_us)
+{
+    ATCA_STATUS status;
+    ATCASession *session;
+    uint32_t before;
+
+    if (device == NULL)
+        return ATCA_GEN_FAIL;
+    if (packet == NULL)
+        return ATCA_BAD_PARAM;
+
+    if ( (status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+
+    session = atGetSession(device);
+    if (session->depth == 0 || !session->awake)
+    {
+        atca_device_unlock(device);
+        return ATCA_BAD_PARAM;
+    }
+
+    before = session->awake_us;
+    status = atca_get_response(atGetIFace(device), packet, atGetOpcodeExecTime(atGetCommands(device), packet->opcode), &session->awake_us);
+    if (elapsed_us != NULL)
+        *elapsed_us += session->awake_us - before;
+    if (status == ATCA_SUCCESS)
+        status = atca_check_response(packet);
+
+    if (status == ATCA_COMM_FAIL)
+        session->awake = false;
+
+    atca_device_unlock(device);
+    return status;
+}
+
+/** @} */
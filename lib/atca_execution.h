@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief Command execution engine shared by the basic API.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATCA_EXECUTION_H
+#define ATCA_EXECUTION_H
+
+#include "atca_status.h"
+#include "atca_command.h"
+#include "atca_device.h"
+
+/** \defgroup execution Command execution (atca_)
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATCA_EXECUTE_RETRIES    2       // resends of a command the device reported as received with a bad CRC
+#define ATCA_SESSION_REWAKE_US  500000  // time awake after which a session idles and re-wakes, well inside the ~1.3s watchdog
+#define ATCA_SESSION_XFER_US    1000    // allowance per command for bus transfers and host time, where no clock measures them
+
+ATCA_STATUS atca_execute_command(ATCADevice device, ATCAPacket *packet);
+ATCA_STATUS atca_session_begin(ATCADevice device);
+ATCA_STATUS atca_session_end(ATCADevice device);
+ATCA_STATUS atca_execute_send(ATCADevice device, ATCAPacket *packet, uint32_t *elapsed_us);
+ATCA_STATUS atca_execute_receive(ATCADevice device, ATCAPacket *packet, uint32_t *elapsed_us);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */
+#endif
@@ -138,7 +138,8 @@ ATCA_STATUS atidle(ATCAIface caiface)
     ATCA_STATUS status;
 
     status = caiface->atidle(caiface);
-    atca_delay_ms(1);
+    if (caiface->mIfaceCFG->iface_type != ATCA_SIM_IFACE)
+        atca_delay_ms(1);
     return status;
 }
 
@@ -147,7 +148,8 @@ ATCA_STATUS atsleep(ATCAIface caiface)
     ATCA_STATUS status;
 
     status = caiface->atsleep(caiface);
-    atca_delay_ms(1);
+    if (caiface->mIfaceCFG->iface_type != ATCA_SIM_IFACE)
+        atca_delay_ms(1);
     return status;
 }
 
@@ -83,6 +83,7 @@ typedef struct
         {
             uint8_t  slave_address; // 8-bit slave address
             uint8_t  bus;           // logical i2c bus number, 0-based - HAL will map this to a pin pair for SDA SCL
+            uint8_t  combined_xfer; // non-zero to use combined (I2C_RDWR) transactions where the HAL and adapter support them
             uint32_t baud;          // typically 400000
         } atcai2c;
 
@@ -111,14 +112,15 @@ typedef struct
 
         struct ATCASIM
         {
-            int     device_id;  // Unsupported, must be 0. Change to reference different simulation instances.
-            uint8_t dev_rev[4]; // DevRev to request
+            int     device_id;  // Simulated device instance, 0 to MAX_SIM_DEVICES - 1. Interfaces with the same ID share a device.
+            uint8_t dev_rev[4]; // DevRev to request, all zero for the default of the device type
         } atcasim;
 
     };
 
     uint16_t wake_delay;    // microseconds of tWHI + tWLO which varies based on chip type
     int      rx_retries;    // the number of retries to attempt for receiving bytes
+    uint16_t poll_interval; // microseconds between response polls, 0 waits the full execution time before a single receive
     void *   cfg_data;      // opaque data used by HAL in device discovery
 } ATCAIfaceCfg;
 
@@ -71,6 +71,7 @@
 #define ATCACERT_E_BAD_CERT             10  //!< Certificate structure is bad in some way.
 #define ATCACERT_E_WRONG_CERT_DEF       11
 #define ATCACERT_E_VERIFY_FAILED        12  //!< Certificate or challenge/response verification failed.
+#define ATCACERT_E_NOT_CACHED           13  //!< No fresh certificate for the request in the certificate cache.
 
 /** @} */
 #endif
\ No newline at end of file
@@ -0,0 +1,563 @@
+/**
+ * \file
+ * \brief Cache of reconstructed certificates, see atcacert_cache.h.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atcacert_cache.h"
+#include "atcacert_client.h"
+#include "cryptoauthlib.h"
+#include "basic/atca_basic.h"
+#include "crypto/atca_crypto_sw_sha2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/* Cache file: magic, version, entry count and two reserved bytes, then per entry a
+ * big endian id, the fingerprint and a big endian DER size followed by the DER, then
+ * a SHA-256 of everything before it. */
+#define ATCACERT_CACHE_FILE_MAGIC    "ACRT"
+#define ATCACERT_CACHE_FILE_VERSION  1
+#define ATCACERT_CACHE_FILE_HEADER   8
+#define ATCACERT_CACHE_FILE_ENTRY    (4 + ATCACERT_CACHE_FINGERPRINT_SIZE + 2)
+#define ATCACERT_CACHE_FILE_MAX      (ATCACERT_CACHE_FILE_HEADER + ATCACERT_CACHE_ENTRIES * (ATCACERT_CACHE_FILE_ENTRY + ATCACERT_CACHE_MAX_CERT_SIZE) + ATCA_SHA2_256_DIGEST_SIZE)
+
+// Largest compressed certificate a certificate definition fingerprints
+#define ATCACERT_CACHE_MAX_COMP_CERT 72
+
+typedef struct
+{
+    uint32_t id;
+    uint8_t  fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint32_t last_used;     // LRU clock, 0 for an empty entry
+    uint8_t* der;
+    size_t   der_size;
+    char*    pem;           // null terminated
+    size_t   pem_size;
+} atcacert_cache_entry;
+
+static atcacert_cache_entry atcacert_cache[ATCACERT_CACHE_ENTRIES];
+static uint32_t atcacert_cache_clock;
+static atcacert_cache_stats_t atcacert_cache_counts;
+static bool atcacert_cache_on;
+#ifdef ATCA_USE_PTHREADS
+static pthread_mutex_t atcacert_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void atcacert_cache_enter(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_lock(&atcacert_cache_lock);
+#endif
+}
+
+static void atcacert_cache_leave(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_unlock(&atcacert_cache_lock);
+#endif
+}
+
+/** \brief release an entry's buffers and mark it empty. Caller holds the lock. */
+static void atcacert_cache_drop(atcacert_cache_entry* entry)
+{
+    free(entry->der);
+    free(entry->pem);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/** \brief empty every entry. Caller holds the lock. */
+static void atcacert_cache_drop_all(void)
+{
+    size_t i;
+
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+        atcacert_cache_drop(&atcacert_cache[i]);
+    atcacert_cache_clock = 0;
+}
+
+void atcacert_cache_enable(bool enable)
+{
+    atcacert_cache_enter();
+    atcacert_cache_on = enable;
+    if (!enable)
+    {
+        atcacert_cache_drop_all();
+        memset(&atcacert_cache_counts, 0, sizeof(atcacert_cache_counts));
+    }
+    atcacert_cache_leave();
+}
+
+bool atcacert_cache_is_enabled(void)
+{
+    return atcacert_cache_on;
+}
+
+int atcacert_cache_fingerprint(const uint8_t* cert_template,
+                               size_t         cert_template_size,
+                               const uint8_t* comp_cert,
+                               size_t         comp_cert_size,
+                               const uint8_t* ca_public_key,
+                               uint8_t        fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE])
+{
+    atcac_sha2_256_ctx ctx;
+    uint8_t sizes[4];
+
+    if ((cert_template == NULL && cert_template_size > 0) || comp_cert == NULL || fingerprint == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    // Sizes keep the template and compressed cert from shifting into each other, the
+    // last byte tells whether a CA key follows
+    sizes[0] = (uint8_t)(cert_template_size >> 8);
+    sizes[1] = (uint8_t)cert_template_size;
+    sizes[2] = (uint8_t)comp_cert_size;
+    sizes[3] = ca_public_key != NULL;
+
+    atcac_sw_sha2_256_init(&ctx);
+    atcac_sw_sha2_256_update(&ctx, sizes, sizeof(sizes));
+    if (cert_template_size > 0)
+        atcac_sw_sha2_256_update(&ctx, cert_template, cert_template_size);
+    atcac_sw_sha2_256_update(&ctx, comp_cert, comp_cert_size);
+    if (ca_public_key != NULL)
+        atcac_sw_sha2_256_update(&ctx, ca_public_key, 64);
+    atcac_sw_sha2_256_finish(&ctx, fingerprint);
+
+    return ATCACERT_E_SUCCESS;
+}
+
+int atcacert_cache_lookup(uint32_t      id,
+                          const uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE],
+                          uint8_t*      cert,
+                          size_t*       cert_size,
+                          char*         pem,
+                          size_t*       pem_size)
+{
+    int ret = ATCACERT_E_NOT_CACHED;
+    size_t i;
+
+    if (fingerprint == NULL || (cert != NULL && cert_size == NULL) || (pem != NULL && pem_size == NULL))
+        return ATCACERT_E_BAD_PARAMS;
+
+    atcacert_cache_enter();
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        atcacert_cache_entry* entry = &atcacert_cache[i];
+
+        if (entry->last_used == 0 || entry->id != id)
+            continue;
+        if (memcmp(entry->fingerprint, fingerprint, ATCACERT_CACHE_FINGERPRINT_SIZE) != 0)
+            break;  // stale, the next store replaces it
+
+        ret = ATCACERT_E_SUCCESS;
+        if ((cert != NULL && *cert_size < entry->der_size) || (pem != NULL && *pem_size <= entry->pem_size))
+            ret = ATCACERT_E_BUFFER_TOO_SMALL;
+        if (cert != NULL)
+        {
+            if (ret == ATCACERT_E_SUCCESS)
+                memcpy(cert, entry->der, entry->der_size);
+            *cert_size = entry->der_size;
+        }
+        if (pem != NULL)
+        {
+            if (ret == ATCACERT_E_SUCCESS)
+                memcpy(pem, entry->pem, entry->pem_size + 1);
+            *pem_size = entry->pem_size;
+        }
+        entry->last_used = ++atcacert_cache_clock;
+        break;
+    }
+    if (ret == ATCACERT_E_NOT_CACHED)
+        atcacert_cache_counts.misses++;
+    else
+        atcacert_cache_counts.hits++;
+    atcacert_cache_leave();
+
+    return ret;
+}
+
+int atcacert_cache_store(uint32_t       id,
+                         const uint8_t  fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE],
+                         const uint8_t* cert,
+                         size_t         cert_size)
+{
+    int ret = 0;
+    atcacert_cache_entry* victim = NULL;
+    uint8_t* der = NULL;
+    char* pem = NULL;
+    size_t pem_size = cert_size * 2 + 128;
+    size_t i;
+
+    if (fingerprint == NULL || cert == NULL || cert_size == 0)
+        return ATCACERT_E_BAD_PARAMS;
+    if (cert_size > ATCACERT_CACHE_MAX_CERT_SIZE)
+        return ATCACERT_E_BUFFER_TOO_SMALL;
+
+    // Encode outside the lock, lookups don't wait for base 64
+    der = (uint8_t*)malloc(cert_size);
+    pem = (char*)malloc(pem_size);
+    if (der == NULL || pem == NULL)
+    {
+        free(der);
+        free(pem);
+        return ATCACERT_E_ERROR;
+    }
+    memcpy(der, cert, cert_size);
+    ret = atcacert_encode_pem_cert(cert, cert_size, pem, &pem_size);
+    if (ret != ATCACERT_E_SUCCESS)
+    {
+        free(der);
+        free(pem);
+        return ret;
+    }
+
+    atcacert_cache_enter();
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        atcacert_cache_entry* entry = &atcacert_cache[i];
+
+        if (entry->last_used != 0 && entry->id == id)
+        {
+            victim = entry;
+            break;
+        }
+        if (victim == NULL || entry->last_used < victim->last_used)
+            victim = entry;
+    }
+    atcacert_cache_drop(victim);
+    victim->id = id;
+    memcpy(victim->fingerprint, fingerprint, ATCACERT_CACHE_FINGERPRINT_SIZE);
+    victim->der = der;
+    victim->der_size = cert_size;
+    victim->pem = pem;
+    victim->pem_size = pem_size;
+    victim->last_used = ++atcacert_cache_clock;
+    atcacert_cache_counts.stores++;
+    atcacert_cache_leave();
+
+    return ATCACERT_E_SUCCESS;
+}
+
+void atcacert_cache_clear(void)
+{
+    atcacert_cache_enter();
+    atcacert_cache_drop_all();
+    memset(&atcacert_cache_counts, 0, sizeof(atcacert_cache_counts));
+    atcacert_cache_leave();
+}
+
+void atcacert_cache_stats(atcacert_cache_stats_t* stats)
+{
+    if (stats == NULL)
+        return;
+
+    atcacert_cache_enter();
+    *stats = atcacert_cache_counts;
+    atcacert_cache_leave();
+}
+
+int atcacert_cache_save(const char* path)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    atcacert_cache_entry* order[ATCACERT_CACHE_ENTRIES];
+    size_t count = 0;
+    uint8_t* file = NULL;
+    size_t size = ATCACERT_CACHE_FILE_HEADER;
+    FILE* fp = NULL;
+    size_t i, j;
+
+    if (path == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    file = (uint8_t*)malloc(ATCACERT_CACHE_FILE_MAX);
+    if (file == NULL)
+        return ATCACERT_E_ERROR;
+
+    atcacert_cache_enter();
+    // Least recently used first, so loading in file order restores the LRU order
+    for (i = 0; i < ATCACERT_CACHE_ENTRIES; i++)
+    {
+        atcacert_cache_entry* entry = &atcacert_cache[i];
+        if (entry->last_used == 0)
+            continue;
+        for (j = count; j > 0 && order[j - 1]->last_used > entry->last_used; j--)
+            order[j] = order[j - 1];
+        order[j] = entry;
+        count++;
+    }
+    for (i = 0; i < count; i++)
+    {
+        const atcacert_cache_entry* entry = order[i];
+
+        file[size++] = (uint8_t)(entry->id >> 24);
+        file[size++] = (uint8_t)(entry->id >> 16);
+        file[size++] = (uint8_t)(entry->id >> 8);
+        file[size++] = (uint8_t)entry->id;
+        memcpy(&file[size], entry->fingerprint, ATCACERT_CACHE_FINGERPRINT_SIZE);
+        size += ATCACERT_CACHE_FINGERPRINT_SIZE;
+        file[size++] = (uint8_t)(entry->der_size >> 8);
+        file[size++] = (uint8_t)entry->der_size;
+        memcpy(&file[size], entry->der, entry->der_size);
+        size += entry->der_size;
+    }
+    atcacert_cache_leave();
+
+    memcpy(file, ATCACERT_CACHE_FILE_MAGIC, 4);
+    file[4] = ATCACERT_CACHE_FILE_VERSION;
+    file[5] = (uint8_t)count;
+    file[6] = 0;
+    file[7] = 0;
+    atcac_sw_sha2_256(file, size, &file[size]);
+    size += ATCA_SHA2_256_DIGEST_SIZE;
+
+    fp = fopen(path, "wb");
+    if (fp == NULL)
+        ret = ATCACERT_E_ERROR;
+    else
+    {
+        if (fwrite(file, 1, size, fp) != size)
+            ret = ATCACERT_E_ERROR;
+        if (fclose(fp) != 0)
+            ret = ATCACERT_E_ERROR;
+    }
+    free(file);
+
+    return ret;
+}
+
+int atcacert_cache_load(const char* path)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    uint8_t* file = NULL;
+    uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE];
+    size_t size = 0;
+    size_t pos = ATCACERT_CACHE_FILE_HEADER;
+    size_t count;
+    FILE* fp = NULL;
+    size_t i;
+
+    if (path == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+        return ATCACERT_E_ERROR;
+    // One spare byte shows a file that is too long
+    file = (uint8_t*)malloc(ATCACERT_CACHE_FILE_MAX + 1);
+    if (file == NULL)
+    {
+        fclose(fp);
+        return ATCACERT_E_ERROR;
+    }
+    size = fread(file, 1, ATCACERT_CACHE_FILE_MAX + 1, fp);
+    fclose(fp);
+
+    atcacert_cache_clear();
+
+    do
+    {
+        if (size < ATCACERT_CACHE_FILE_HEADER + ATCA_SHA2_256_DIGEST_SIZE || size > ATCACERT_CACHE_FILE_MAX)
+        {
+            ret = ATCACERT_E_DECODING_ERROR;
+            break;
+        }
+        size -= ATCA_SHA2_256_DIGEST_SIZE;
+        atcac_sw_sha2_256(file, size, digest);
+        if (memcmp(digest, &file[size], sizeof(digest)) != 0 || memcmp(file, ATCACERT_CACHE_FILE_MAGIC, 4) != 0
+            || file[4] != ATCACERT_CACHE_FILE_VERSION || file[5] > ATCACERT_CACHE_ENTRIES)
+        {
+            ret = ATCACERT_E_DECODING_ERROR;
+            break;
+        }
+
+        count = file[5];
+        for (i = 0; i < count && ret == ATCACERT_E_SUCCESS; i++)
+        {
+            uint32_t id;
+            const uint8_t* fingerprint;
+            size_t der_size;
+
+            if (size - pos < ATCACERT_CACHE_FILE_ENTRY)
+            {
+                ret = ATCACERT_E_DECODING_ERROR;
+                break;
+            }
+            id = ((uint32_t)file[pos] << 24) | ((uint32_t)file[pos + 1] << 16) | ((uint32_t)file[pos + 2] << 8) | file[pos + 3];
+            fingerprint = &file[pos + 4];
+            der_size = ((size_t)file[pos + 4 + ATCACERT_CACHE_FINGERPRINT_SIZE] << 8) | file[pos + 5 + ATCACERT_CACHE_FINGERPRINT_SIZE];
+            pos += ATCACERT_CACHE_FILE_ENTRY;
+            if (size - pos < der_size)
+            {
+                ret = ATCACERT_E_DECODING_ERROR;
+                break;
+            }
+            ret = atcacert_cache_store(id, fingerprint, &file[pos], der_size);
+            if (ret == ATCACERT_E_BAD_PARAMS || ret == ATCACERT_E_BUFFER_TOO_SMALL)
+                ret = ATCACERT_E_DECODING_ERROR;
+            pos += der_size;
+        }
+        if (ret == ATCACERT_E_SUCCESS && pos != size)
+            ret = ATCACERT_E_DECODING_ERROR;
+    }
+    while (0);
+
+    if (ret != ATCACERT_E_SUCCESS)
+        atcacert_cache_clear();
+    else
+    {
+        // Loading isn't activity, start the counters from zero
+        atcacert_cache_enter();
+        memset(&atcacert_cache_counts, 0, sizeof(atcacert_cache_counts));
+        atcacert_cache_leave();
+    }
+    free(file);
+
+    return ret;
+}
+
+/** \brief cache id of a certificate definition, taken from where its compressed
+ *         certificate lives so it is the same in every process */
+static uint32_t atcacert_cache_def_id(const atcacert_def_t* cert_def)
+{
+    const atcacert_device_loc_t* loc = &cert_def->comp_cert_dev_loc;
+
+    return ((uint32_t)loc->zone << 24) | ((uint32_t)loc->slot << 16) | loc->offset;
+}
+
+/** \brief shared body of atcacert_read_cert_cached() and atcacert_read_cert_pem_cached(),
+ *         exactly one of cert and pem is set */
+static int atcacert_cache_read(const atcacert_def_t* cert_def,
+                               const uint8_t         ca_public_key[64],
+                               uint8_t*              cert,
+                               size_t*               cert_size,
+                               char*                 pem,
+                               size_t*               pem_size)
+{
+    int ret = 0;
+    const atcacert_device_loc_t* loc = &cert_def->comp_cert_dev_loc;
+    uint8_t comp_cert[ATCACERT_CACHE_MAX_COMP_CERT];
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint32_t id = atcacert_cache_def_id(cert_def);
+    uint8_t* der = cert;
+    size_t der_size = cert_size != NULL ? *cert_size : ATCACERT_CACHE_MAX_CERT_SIZE;
+
+    // Both the freshness check and a rebuild run in one wake
+    atcab_session_begin();
+    do
+    {
+        ret = atcab_read_bytes_zone(loc->zone, loc->slot, loc->offset, comp_cert, loc->count);
+        if (ret != ATCA_SUCCESS)
+            break;
+        ret = atcacert_cache_fingerprint(cert_def->cert_template, cert_def->cert_template_size,
+                                         comp_cert, loc->count, ca_public_key, fingerprint);
+        if (ret != ATCACERT_E_SUCCESS)
+            break;
+
+        ret = atcacert_cache_lookup(id, fingerprint, cert, cert_size, pem, pem_size);
+        if (ret != ATCACERT_E_NOT_CACHED)
+            break;
+
+        if (der == NULL)
+        {
+            der = (uint8_t*)malloc(der_size);
+            if (der == NULL)
+            {
+                ret = ATCACERT_E_ERROR;
+                break;
+            }
+        }
+        ret = atcacert_read_cert(cert_def, ca_public_key, der, &der_size);
+        if (ret != ATCACERT_E_SUCCESS)
+            break;
+        if (cert != NULL)
+            *cert_size = der_size;
+
+        // A certificate that can't be cached, too big or out of memory, is still returned
+        (void)atcacert_cache_store(id, fingerprint, der, der_size);
+        if (pem != NULL)
+            ret = atcacert_encode_pem_cert(der, der_size, pem, pem_size);
+    }
+    while (0);
+    atcab_session_end();
+
+    if (der != cert)
+        free(der);
+
+    return ret;
+}
+
+int atcacert_read_cert_cached(const atcacert_def_t* cert_def,
+                              const uint8_t         ca_public_key[64],
+                              uint8_t*              cert,
+                              size_t*               cert_size)
+{
+    if (cert_def == NULL || cert == NULL || cert_size == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    if (!atcacert_cache_on || cert_def->comp_cert_dev_loc.zone == DEVZONE_NONE
+        || cert_def->comp_cert_dev_loc.count > ATCACERT_CACHE_MAX_COMP_CERT)
+        return atcacert_read_cert(cert_def, ca_public_key, cert, cert_size);
+
+    return atcacert_cache_read(cert_def, ca_public_key, cert, cert_size, NULL, NULL);
+}
+
+int atcacert_read_cert_pem_cached(const atcacert_def_t* cert_def,
+                                  const uint8_t         ca_public_key[64],
+                                  char*                 pem,
+                                  size_t*               pem_size)
+{
+    int ret = 0;
+    uint8_t* der = NULL;
+    size_t der_size = ATCACERT_CACHE_MAX_CERT_SIZE;
+
+    if (cert_def == NULL || pem == NULL || pem_size == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    if (atcacert_cache_on && cert_def->comp_cert_dev_loc.zone != DEVZONE_NONE
+        && cert_def->comp_cert_dev_loc.count <= ATCACERT_CACHE_MAX_COMP_CERT)
+        return atcacert_cache_read(cert_def, ca_public_key, NULL, NULL, pem, pem_size);
+
+    der = (uint8_t*)malloc(der_size);
+    if (der == NULL)
+        return ATCACERT_E_ERROR;
+    ret = atcacert_read_cert(cert_def, ca_public_key, der, &der_size);
+    if (ret == ATCACERT_E_SUCCESS)
+        ret = atcacert_encode_pem_cert(der, der_size, pem, pem_size);
+    free(der);
+
+    return ret;
+}
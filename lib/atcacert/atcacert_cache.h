@@ -0,0 +1,221 @@
+/**
+ * \file
+ * \brief Cache of reconstructed certificates. A certificate rebuilt from its compressed
+ *        form on the device is kept as DER and PEM, keyed by a fingerprint of the
+ *        compressed certificate, and can be saved to and loaded from a file.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATCACERT_CACHE_H
+#define ATCACERT_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "atcacert_def.h"
+
+// Inform function naming when compiling in C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup atcacert_ Certificate manipulation methods (atcacert_)
+ *
+   @{ */
+
+#ifndef ATCACERT_CACHE_ENTRIES
+#define ATCACERT_CACHE_ENTRIES        4     //!< Certificates the cache holds, least recently used goes first.
+#endif
+#ifndef ATCACERT_CACHE_MAX_CERT_SIZE
+#define ATCACERT_CACHE_MAX_CERT_SIZE  1024  //!< Largest DER certificate the cache accepts.
+#endif
+
+#define ATCACERT_CACHE_FINGERPRINT_SIZE 32  //!< SHA-256 fingerprint of a certificate's inputs.
+
+/** \brief cache activity since the last atcacert_cache_clear() */
+typedef struct
+{
+    uint32_t hits;      //!< Lookups answered from the cache.
+    uint32_t misses;    //!< Lookups that found no entry or a stale one.
+    uint32_t stores;    //!< Certificates added or replaced.
+} atcacert_cache_stats_t;
+
+/**
+ * \brief Turns the cached read paths on or off. atcacert_read_cert_cached(), atcatls_get_cert()
+ *        and the Legrand certificate readers only use the cache while it is enabled.
+ *        Disabling it also empties it.
+ *
+ * \param[in] enable  true to use the cache.
+ */
+void atcacert_cache_enable(bool enable);
+
+/** \brief true while the cached read paths use the cache, see atcacert_cache_enable() */
+bool atcacert_cache_is_enabled(void);
+
+/**
+ * \brief Fingerprints the inputs of a reconstructed certificate.
+ *
+ * Only data that varies between certificates needs to go in, which for the compressed
+ * certificate formats is the template, the compressed certificate and the CA public key.
+ * A cached entry is fresh while its fingerprint matches; inputs left out, like a public
+ * key regenerated without rewriting the certificate, are not noticed.
+ *
+ * \param[in]  cert_template       Certificate template, NULL if not part of the fingerprint.
+ * \param[in]  cert_template_size  Template size in bytes.
+ * \param[in]  comp_cert           Compressed certificate as read from the device.
+ * \param[in]  comp_cert_size      Compressed certificate size in bytes.
+ * \param[in]  ca_public_key       CA public key (64 bytes) the certificate is built with, or NULL.
+ * \param[out] fingerprint         Receives the fingerprint.
+ *
+ * \return 0 on success
+ */
+int atcacert_cache_fingerprint(const uint8_t* cert_template,
+                               size_t         cert_template_size,
+                               const uint8_t* comp_cert,
+                               size_t         comp_cert_size,
+                               const uint8_t* ca_public_key,
+                               uint8_t        fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE]);
+
+/**
+ * \brief Looks a certificate up in the cache.
+ *
+ * \param[in]    id           Caller chosen identity of the certificate, e.g. its slot.
+ * \param[in]    fingerprint  Current fingerprint from atcacert_cache_fingerprint().
+ * \param[out]   cert         Receives the DER certificate. NULL if not wanted.
+ * \param[inout] cert_size    As input, the size of cert. As output, the DER size.
+ * \param[out]   pem          Receives the PEM certificate, null terminated. NULL if not wanted.
+ * \param[inout] pem_size     As input, the size of pem. As output, the PEM length without the
+ *                            terminator.
+ *
+ * \return 0 on a hit, ATCACERT_E_NOT_CACHED if no fresh entry exists,
+ *         ATCACERT_E_BUFFER_TOO_SMALL with the sizes needed set if an output doesn't fit.
+ */
+int atcacert_cache_lookup(uint32_t      id,
+                          const uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE],
+                          uint8_t*      cert,
+                          size_t*       cert_size,
+                          char*         pem,
+                          size_t*       pem_size);
+
+/**
+ * \brief Adds a certificate to the cache, replacing any entry with the same id.
+ *
+ * \param[in] id           Caller chosen identity of the certificate.
+ * \param[in] fingerprint  Fingerprint of the inputs the certificate was built from.
+ * \param[in] cert         DER certificate.
+ * \param[in] cert_size    DER size in bytes, at most ATCACERT_CACHE_MAX_CERT_SIZE.
+ *
+ * \return 0 on success
+ */
+int atcacert_cache_store(uint32_t       id,
+                         const uint8_t  fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE],
+                         const uint8_t* cert,
+                         size_t         cert_size);
+
+/** \brief Empties the cache and resets its statistics. */
+void atcacert_cache_clear(void);
+
+/**
+ * \brief Reports cache activity since the last atcacert_cache_clear().
+ *
+ * \param[out] stats  Receives the counters.
+ */
+void atcacert_cache_stats(atcacert_cache_stats_t* stats);
+
+/**
+ * \brief Writes the cached certificates to a file for atcacert_cache_load().
+ *
+ * The file carries a digest that detects corruption, not tampering: store it where only
+ * the application can write, as a replaced entry is served until its compressed
+ * certificate changes.
+ *
+ * \param[in] path  File to write.
+ *
+ * \return 0 on success
+ */
+int atcacert_cache_save(const char* path);
+
+/**
+ * \brief Replaces the cache contents with the certificates saved in a file.
+ *
+ * \param[in] path  File written by atcacert_cache_save().
+ *
+ * \return 0 on success, ATCACERT_E_DECODING_ERROR if the file is damaged, in which case
+ *         the cache is left empty.
+ */
+int atcacert_cache_load(const char* path);
+
+/**
+ * \brief atcacert_read_cert() through the cache.
+ *
+ * Only the compressed certificate is read from the device. When its fingerprint matches
+ * the cached entry the cached certificate is returned, otherwise the certificate is
+ * rebuilt and cached. Without the cache enabled this is atcacert_read_cert().
+ *
+ * \param[in]    cert_def       Certificate definition, see atcacert_read_cert().
+ * \param[in]    ca_public_key  CA public key, see atcacert_read_cert().
+ * \param[out]   cert           Buffer to received the certificate.
+ * \param[inout] cert_size      As input, the size of the cert buffer in bytes.
+ *                              As output, the size of the certificate returned in cert in bytes.
+ *
+ * \return 0 on success
+ */
+int atcacert_read_cert_cached(const atcacert_def_t* cert_def,
+                              const uint8_t         ca_public_key[64],
+                              uint8_t*              cert,
+                              size_t*               cert_size);
+
+/**
+ * \brief atcacert_read_cert_cached() returning the certificate in PEM format.
+ *
+ * \param[in]    cert_def       Certificate definition, see atcacert_read_cert().
+ * \param[in]    ca_public_key  CA public key, see atcacert_read_cert().
+ * \param[out]   pem            Buffer to received the PEM certificate, null terminated.
+ * \param[inout] pem_size       As input, the size of the pem buffer in bytes.
+ *                              As output, the PEM length without the terminator.
+ *
+ * \return 0 on success
+ */
+int atcacert_read_cert_pem_cached(const atcacert_def_t* cert_def,
+                                  const uint8_t         ca_public_key[64],
+                                  char*                 pem,
+                                  size_t*               pem_size);
+
+/** @} */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
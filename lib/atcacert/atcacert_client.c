@@ -40,6 +40,7 @@
 
 
 #include <stdlib.h>
+#include <string.h>
 #include "atcacert_client.h"
 #include "cryptoauthlib.h"
 #include "basic/atca_basic.h"
@@ -55,65 +56,186 @@ int atcacert_get_response(uint8_t       device_private_key_slot,
     return atcab_sign(device_private_key_slot, challenge, response);
 }
 
-int atcacert_read_cert(const atcacert_def_t* cert_def,
-                       const uint8_t         ca_public_key[64],
-                       uint8_t*              cert,
-                       size_t*               cert_size)
+// Bus cost of a read: word address, count, opcode, param1, param2 and CRC out,
+// count, data and CRC back
+#define ATCACERT_READ_CMD_BYTES  8
+#define ATCACERT_READ_RSP_BYTES  3
+
+static int atcacert_read_plan_add(atcacert_read_plan_t* plan, size_t loc, size_t block, size_t word, size_t size)
+{
+    atcacert_read_op_t* op;
+
+    if (plan->ops_count >= ATCACERT_READ_PLAN_MAX_OPS)
+        return ATCACERT_E_BUFFER_TOO_SMALL;
+
+    op = &plan->ops[plan->ops_count++];
+    op->loc = (uint8_t)loc;
+    op->block = (uint8_t)block;
+    op->word = (uint8_t)word;
+    op->size = (uint8_t)size;
+
+    plan->commands++;
+    plan->bus_bytes += ATCACERT_READ_CMD_BYTES + ATCACERT_READ_RSP_BYTES + size;
+
+    return ATCACERT_E_SUCCESS;
+}
+
+int atcacert_read_plan_build(const atcacert_def_t* cert_def, atcacert_read_plan_t* plan)
 {
     int ret = 0;
-    atcacert_device_loc_t device_locs[16];
-    size_t device_locs_count = 0;
-    size_t i = 0;
-    atcacert_build_state_t build_state;
+    atcacert_device_loc_t words[ATCACERT_READ_PLAN_MAX_LOCS];
+    size_t words_count = 0;
+    size_t i, j;
 
-    if (cert_def == NULL || cert == NULL || cert_size == NULL)
+    if (cert_def == NULL || plan == NULL)
         return ATCACERT_E_BAD_PARAMS;
 
-    ret = atcacert_get_device_locs(
-        cert_def,
-        device_locs,
-        &device_locs_count,
-        sizeof(device_locs) / sizeof(device_locs[0]),
-        32);
-    if (ret != ATCACERT_E_SUCCESS)
-        return ret;
+    memset(plan, 0, sizeof(*plan));
+    plan->cert_def = cert_def;
 
-    ret = atcacert_cert_build_start(&build_state, cert_def, cert, cert_size, ca_public_key);
+    // Block aligned locations feed the cert builder, word aligned ones tell which
+    // words inside those blocks the certificate actually uses
+    ret = atcacert_get_device_locs(cert_def, plan->device_locs, &plan->device_locs_count, ATCACERT_READ_PLAN_MAX_LOCS, 32);
     if (ret != ATCACERT_E_SUCCESS)
         return ret;
+    ret = atcacert_get_device_locs(cert_def, words, &words_count, ATCACERT_READ_PLAN_MAX_LOCS, 4);
+    if (ret == ATCACERT_E_BUFFER_TOO_SMALL)
+    {
+        // Too scattered to track by word, read the blocks whole
+        memcpy(words, plan->device_locs, sizeof(words));
+        words_count = plan->device_locs_count;
+    }
+    else if (ret != ATCACERT_E_SUCCESS)
+        return ret;
 
-    for (i = 0; i < device_locs_count; i++)
+    for (i = 0; i < plan->device_locs_count; i++)
     {
-        uint8_t data[416];
-        if (device_locs[i].zone == DEVZONE_DATA && device_locs[i].is_genkey)
+        const atcacert_device_loc_t* loc = &plan->device_locs[i];
+        size_t block;
+
+        if (loc->count > ATCACERT_READ_PLAN_MAX_LOC_SIZE)
+            return ATCACERT_E_BUFFER_TOO_SMALL;
+
+        if (loc->zone == DEVZONE_DATA && loc->is_genkey)
         {
-            ret = atcab_get_pubkey(device_locs[i].slot, data);
-            if (ret != ATCA_SUCCESS)
+            ret = atcacert_read_plan_add(plan, i, 0, 0, ATCA_PUB_KEY_SIZE);
+            if (ret != ATCACERT_E_SUCCESS)
                 return ret;
+            continue;
         }
-        else
+
+        for (block = loc->offset / 32; block < (size_t)(loc->offset + loc->count) / 32; block++)
         {
-            size_t start_block = device_locs[i].offset / 32;
-            uint8_t block;
-            size_t end_block = (device_locs[i].offset + device_locs[i].count) / 32;
-            for (block = (uint8_t)start_block; block < end_block; block++)
+            uint8_t used = 0;   // bit per word of the block
+            size_t word = 0;
+            size_t used_count = 0;
+
+            for (j = 0; j < words_count; j++)
             {
-                ret = atcab_read_zone(device_locs[i].zone, device_locs[i].slot, block, 0, &data[block * 32 - device_locs[i].offset], 32);
-                if (ret != ATCA_SUCCESS)
-                    return ret;
+                const atcacert_device_loc_t* w = &words[j];
+                size_t k;
+
+                if (w->zone != loc->zone || (w->zone == DEVZONE_DATA && (w->slot != loc->slot || w->is_genkey)))
+                    continue;
+                for (k = 0; k < 8; k++)
+                {
+                    size_t offset = block * 32 + k * 4;
+                    if (offset >= w->offset && offset < (size_t)w->offset + w->count)
+                        used |= (uint8_t)(1 << k);
+                }
             }
+
+            for (j = 0; j < 8; j++)
+            {
+                if (used & (1 << j))
+                {
+                    word = j;
+                    used_count++;
+                }
+            }
+
+            if (used_count == 0)
+                continue;
+            if (used_count == 1)
+                ret = atcacert_read_plan_add(plan, i, block, word, 4);
+            else
+                ret = atcacert_read_plan_add(plan, i, block, 0, 32);
+            if (ret != ATCACERT_E_SUCCESS)
+                return ret;
         }
+    }
+
+    return ATCACERT_E_SUCCESS;
+}
+
+int atcacert_read_cert_plan(const atcacert_read_plan_t* plan,
+                            const uint8_t               ca_public_key[64],
+                            uint8_t*                    cert,
+                            size_t*                     cert_size)
+{
+    int ret = 0;
+    size_t i = 0;
+    size_t op = 0;
+    atcacert_build_state_t build_state;
 
-        ret = atcacert_cert_build_process(&build_state, &device_locs[i], data);
+    if (plan == NULL || plan->cert_def == NULL || cert == NULL || cert_size == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    ret = atcacert_cert_build_start(&build_state, plan->cert_def, cert, cert_size, ca_public_key);
+    if (ret != ATCACERT_E_SUCCESS)
+        return ret;
+
+    // one wake for all the reads rather than one per command
+    atcab_session_begin();
+    for (i = 0; i < plan->device_locs_count; i++)
+    {
+        const atcacert_device_loc_t* loc = &plan->device_locs[i];
+        uint8_t data[ATCACERT_READ_PLAN_MAX_LOC_SIZE];
+
+        // Words the plan skips are never used by the certificate
+        memset(data, 0, loc->count);
+        for (; op < plan->ops_count && plan->ops[op].loc == i; op++)
+        {
+            const atcacert_read_op_t* rop = &plan->ops[op];
+
+            if (loc->zone == DEVZONE_DATA && loc->is_genkey)
+                ret = atcab_get_pubkey(loc->slot, data);
+            else
+                ret = atcab_read_zone(loc->zone, loc->slot, rop->block, rop->word,
+                                      &data[rop->block * 32 + rop->word * 4 - loc->offset], rop->size);
+            if (ret != ATCA_SUCCESS)
+                break;
+        }
+        if (ret != ATCA_SUCCESS)
+            break;
+
+        ret = atcacert_cert_build_process(&build_state, loc, data);
         if (ret != ATCACERT_E_SUCCESS)
-            return ret;
+            break;
     }
+    atcab_session_end();
+    if (ret != ATCACERT_E_SUCCESS)
+        return ret;
+
+    return atcacert_cert_build_finish(&build_state);
+}
+
+int atcacert_read_cert(const atcacert_def_t* cert_def,
+                       const uint8_t         ca_public_key[64],
+                       uint8_t*              cert,
+                       size_t*               cert_size)
+{
+    int ret = 0;
+    atcacert_read_plan_t plan;
 
-    ret = atcacert_cert_build_finish(&build_state);
+    if (cert_def == NULL || cert == NULL || cert_size == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    ret = atcacert_read_plan_build(cert_def, &plan);
     if (ret != ATCACERT_E_SUCCESS)
         return ret;
 
-    return ATCACERT_E_SUCCESS;
+    return atcacert_read_cert_plan(&plan, ca_public_key, cert, cert_size);
 }
 
 int atcacert_write_cert(const atcacert_def_t* cert_def,
@@ -95,6 +95,75 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
                        uint8_t*              cert,
                        size_t*               cert_size);
 
+#ifndef ATCACERT_READ_PLAN_MAX_LOCS
+#define ATCACERT_READ_PLAN_MAX_LOCS  16    //!< Most merged device locations a read plan holds.
+#endif
+#ifndef ATCACERT_READ_PLAN_MAX_OPS
+#define ATCACERT_READ_PLAN_MAX_OPS   32    //!< Most device reads a read plan holds.
+#endif
+#define ATCACERT_READ_PLAN_MAX_LOC_SIZE 416 //!< Largest device location a plan can read, one full slot.
+
+/**
+ * One device read in a read plan. The data lands in the buffer of device location
+ * loc at byte (block * 32 + word * 4) minus the location offset.
+ */
+typedef struct atcacert_read_op_s
+{
+    uint8_t loc;    //!< Index of the plan device location the read belongs to.
+    uint8_t block;  //!< 32-byte block within the zone or slot.
+    uint8_t word;   //!< 4-byte word within the block, 0 for block and GenKey reads.
+    uint8_t size;   //!< Bytes read: 4 for a word, 32 for a block, 64 for a GenKey public key.
+} atcacert_read_op_t;
+
+/**
+ * Ordered device reads that reconstruct one certificate, built once from its
+ * certificate definition by atcacert_read_plan_build() and replayed by
+ * atcacert_read_cert_plan() as often as needed.
+ */
+typedef struct atcacert_read_plan_s
+{
+    const atcacert_def_t* cert_def;                                  //!< Certificate definition the plan was built for.
+    atcacert_device_loc_t device_locs[ATCACERT_READ_PLAN_MAX_LOCS];  //!< Block aligned locations passed to atcacert_cert_build_process().
+    size_t                device_locs_count;
+    atcacert_read_op_t    ops[ATCACERT_READ_PLAN_MAX_OPS];           //!< Reads in execution order, grouped by location.
+    size_t                ops_count;
+    size_t                commands;                                  //!< Commands the plan sends to the device.
+    size_t                bus_bytes;                                 //!< Bytes the plan moves over the bus, commands and responses.
+} atcacert_read_plan_t;
+
+/**
+ * \brief Works out the device reads atcacert_read_cert() needs for a certificate
+ *        definition.
+ *
+ * The fewest commands win, and among those the fewest bus bytes. A 32-byte block is
+ * read whole unless only one of its words is used by the certificate, which is then
+ * read on its own. Blocks no certificate element touches are skipped.
+ *
+ * \param[in]  cert_def  Certificate definition to plan the reads for. Must outlive the plan.
+ * \param[out] plan      Receives the read plan.
+ *
+ * \return 0 on success
+ */
+int atcacert_read_plan_build(const atcacert_def_t* cert_def, atcacert_read_plan_t* plan);
+
+/**
+ * \brief Reads the certificate described by a read plan from the device, running all
+ *        the reads in one device session.
+ *
+ * \param[in]    plan           Read plan from atcacert_read_plan_build().
+ * \param[in]    ca_public_key  The ECC P256 public key of the certificate authority that signed
+ *                              this certificate, see atcacert_read_cert().
+ * \param[out]   cert           Buffer to received the certificate.
+ * \param[inout] cert_size      As input, the size of the cert buffer in bytes.
+ *                              As output, the size of the certificate returned in cert in bytes.
+ *
+ * \return 0 on success
+ */
+int atcacert_read_cert_plan(const atcacert_read_plan_t* plan,
+                            const uint8_t               ca_public_key[64],
+                            uint8_t*                    cert,
+                            size_t*                     cert_size);
+
 /**
  * \brief Take a full certificate and write it to the ATECC508A device according to the
  *        certificate definition.
@@ -524,106 +524,87 @@ int atcacert_date_dec_rfc5280_gen(const uint8_t      formatted_date[DATEFMT_RFC5
     return ATCACERT_E_SUCCESS;
 }
 
-static int is_leap_year(int year)
+/**
+ * \brief Days since 1970-01-01 of a proleptic Gregorian date, closed form.
+ *
+ * Counts in eras of 400 years (146097 days) from March 1st, so the leap day falls at the
+ * end of a counting year and no table or loop is needed. Valid for years 0 to 9999,
+ * which covers every max date of atcacert_date_get_max_date(). Days past the end of a
+ * month carry into the next month, as the loop this replaced did.
+ *
+ * \param[in] year  Full year, e.g. 2017.
+ * \param[in] mon   Month, 1 to 12.
+ * \param[in] mday  Day of the month, 1 to 31.
+ *
+ * \return Days since the POSIX epoch, negative before it.
+ */
+static int32_t days_from_civil(int32_t year, int32_t mon, int32_t mday)
 {
-    return (year % 400 == 0) || ((year % 4 == 0) && (year % 100 != 0));
-}
+    int32_t  y   = year - (mon <= 2);
+    int32_t  era = (y >= 0 ? y : y - 399) / 400;                                // floor, y is -1 in Jan/Feb of year 0
+    uint32_t yoe = (uint32_t)(y - era * 400);                                   // [0, 399]
+    uint32_t doy = (153 * (uint32_t)(mon > 2 ? mon - 3 : mon + 9) + 2) / 5 + (uint32_t)mday - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                       // [0, 146096]
 
-static uint32_t get_year_secs(int year)
-{
-    if (is_leap_year(year))
-        return (31 + 29 + 31 + 30 + 31 + 30 + 31 + 31 + 30 + 31 + 30 + 31) * 86400;
-    else
-        return (31 + 28 + 31 + 30 + 31 + 30 + 31 + 31 + 30 + 31 + 30 + 31) * 86400;
+    return era * 146097 + (int32_t)doe - 719468;
 }
 
-static uint32_t get_month_secs(int year, int mon)
+/**
+ * \brief Proleptic Gregorian date of a day count since 1970-01-01, the inverse of
+ *        days_from_civil(). Straight-line integer arithmetic, divisions by constants only.
+ *
+ * \param[in]  days  Days since the POSIX epoch, 0 or more.
+ * \param[out] year  Full year.
+ * \param[out] mon   Month, 1 to 12.
+ * \param[out] mday  Day of the month, 1 to 31.
+ */
+static void civil_from_days(uint32_t days, int* year, int* mon, int* mday)
 {
-    static const uint32_t month_secs[] = { 2678400, 2419200, 2678400, 2592000, 2678400, 2592000, 2678400, 2678400, 2592000, 2678400, 2592000, 2678400 };
-
-    if (mon == 1 && is_leap_year(year))
-        return 2505600;
-    else if (mon < 12)
-        return month_secs[mon];
-    else
-        return 0;
+    uint32_t z   = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;                                            // [0, 146096]
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;       // [0, 399]
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                     // [0, 365]
+    uint32_t mp  = (5 * doy + 2) / 153;                                         // [0, 11], March based
+    uint32_t m   = mp < 10 ? mp + 3 : mp - 9;
+
+    *mday = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *mon  = (int)m;
+    *year = (int)(yoe + era * 400 + (m <= 2));
 }
 
 static atcacert_tm_utc_t *atcacert_gmtime32(const uint32_t *posix_time, atcacert_tm_utc_t *result)
 {
-    uint32_t secs_remaining = *posix_time;
-    uint32_t secs = 0;
-
-    result->tm_year = 1970;
-    result->tm_mon = 0;
-    result->tm_mday = 1;
-    result->tm_hour = 0;
-    result->tm_min = 0;
-    result->tm_sec = 0;
-
-    secs = get_year_secs(result->tm_year);
-    while (secs_remaining >= secs)
-    {
-        result->tm_year++;
-        secs_remaining -= secs;
-        secs = get_year_secs(result->tm_year);
-    }
-
-    secs = get_month_secs(result->tm_year, result->tm_mon);
-    while (secs_remaining >= secs)
-    {
-        result->tm_mon++;
-        secs_remaining -= secs;
-        secs = get_month_secs(result->tm_year, result->tm_mon);
-    }
+    uint32_t secs = *posix_time % 86400;
 
+    civil_from_days(*posix_time / 86400, &result->tm_year, &result->tm_mon, &result->tm_mday);
     result->tm_year -= 1900;
+    result->tm_mon -= 1;
 
-    result->tm_mday += secs_remaining / 86400;
-    secs_remaining %= 86400;
-
-    result->tm_hour += secs_remaining / 3600;
-    secs_remaining %= 3600;
-
-    result->tm_min += secs_remaining / 60;
-    secs_remaining %= 60;
-
-    result->tm_sec += secs_remaining;
+    result->tm_hour = (int)(secs / 3600);
+    result->tm_min  = (int)(secs / 60 % 60);
+    result->tm_sec  = (int)(secs % 60);
 
     return result;
 }
 
 static uint32_t atcacert_mkgmtime32(const atcacert_tm_utc_t *timeptr)
 {
-    uint32_t posix_time = 0;
-    int cur_value = 0;
-    int year = timeptr->tm_year + 1900;
-
-    cur_value = year - 1;
-    while (cur_value >= 1970)
-        posix_time += get_year_secs(cur_value--);
+    uint32_t days = (uint32_t)days_from_civil(timeptr->tm_year + 1900, timeptr->tm_mon + 1, timeptr->tm_mday);
 
-    cur_value = timeptr->tm_mon - 1;
-    while (cur_value >= 0)
-        posix_time += get_month_secs(year, cur_value--);
-
-    posix_time += (uint32_t)(timeptr->tm_mday - 1) * 86400;
-    posix_time += (uint32_t)timeptr->tm_hour * 3600;
-    posix_time += (uint32_t)timeptr->tm_min * 60;
-    posix_time += (uint32_t)timeptr->tm_sec;
-
-    return posix_time;
+    return days * 86400
+           + (uint32_t)timeptr->tm_hour * 3600
+           + (uint32_t)timeptr->tm_min * 60
+           + (uint32_t)timeptr->tm_sec;
 }
 
-static int atcacert_date_enc_posix_uint32(const atcacert_tm_utc_t* timestamp, uint32_t* posix_uint32)
+/**
+ * \brief Check a timestamp is within POSIX uint32 time, 1970-01-01 to 2106-02-07 06:28:14.
+ */
+static int atcacert_date_check_posix_uint32(const atcacert_tm_utc_t* timestamp)
 {
-    //atcacert_tm_utc_t timestamp_nc;
-    //time_t posix_time = 0;
     int year = 0;
 
-    if (timestamp == NULL || posix_uint32 == NULL)
-        return ATCACERT_E_BAD_PARAMS;
-
     year = timestamp->tm_year + 1900;
 
     if (year > 2106 || year < 1970)
@@ -663,6 +644,22 @@ static int atcacert_date_enc_posix_uint32(const atcacert_tm_utc_t* timestamp, ui
         }
     }
 
+    return ATCACERT_E_SUCCESS;
+}
+
+static int atcacert_date_enc_posix_uint32(const atcacert_tm_utc_t* timestamp, uint32_t* posix_uint32)
+{
+    //atcacert_tm_utc_t timestamp_nc;
+    //time_t posix_time = 0;
+    int ret = 0;
+
+    if (timestamp == NULL || posix_uint32 == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    ret = atcacert_date_check_posix_uint32(timestamp);
+    if (ret != ATCACERT_E_SUCCESS)
+        return ret;
+
 //#ifdef WIN32
 //	timestamp_nc = *timestamp;
 //	posix_time = _mkgmtime(&timestamp_nc);
@@ -902,4 +899,89 @@ int atcacert_date_dec_compcert(const uint8_t          enc_dates[3],
     }
 
     return ATCACERT_E_SUCCESS;
-}
\ No newline at end of file
+}
+
+int atcacert_date_enc_batch(atcacert_date_format_t   format,
+                            const atcacert_tm_utc_t* timestamps,
+                            size_t                   count,
+                            uint8_t*                 formatted_dates)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    size_t date_size = 0;
+    size_t i;
+    uint32_t posix_uint32;
+    uint8_t* out;
+
+    if ((timestamps == NULL || formatted_dates == NULL) && count > 0)
+        return ATCACERT_E_BAD_PARAMS;
+    if (format < 0 || format >= sizeof(ATCACERT_DATE_FORMAT_SIZES) / sizeof(ATCACERT_DATE_FORMAT_SIZES[0]))
+        return ATCACERT_E_BAD_PARAMS;
+
+    if (format != DATEFMT_POSIX_UINT32_BE && format != DATEFMT_POSIX_UINT32_LE)
+    {
+        for (i = 0; i < count && ret == ATCACERT_E_SUCCESS; i++)
+        {
+            date_size = ATCACERT_DATE_FORMAT_SIZES[format];
+            ret = atcacert_date_enc(format, &timestamps[i], &formatted_dates[i * date_size], &date_size);
+        }
+        return ret;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        ret = atcacert_date_check_posix_uint32(&timestamps[i]);
+        if (ret != ATCACERT_E_SUCCESS)
+            return ret;
+    }
+
+    // Every timestamp is in range, the conversion has no branches left
+    for (i = 0; i < count; i++)
+    {
+        posix_uint32 = atcacert_mkgmtime32(&timestamps[i]);
+        out = &formatted_dates[i * 4];
+        if (format == DATEFMT_POSIX_UINT32_BE)
+            posix_uint32 = ((posix_uint32 >> 24) & 0xFF) | ((posix_uint32 >> 8) & 0xFF00) | ((posix_uint32 << 8) & 0xFF0000) | (posix_uint32 << 24);
+        out[0] = (uint8_t)(posix_uint32 >> 0);
+        out[1] = (uint8_t)(posix_uint32 >> 8);
+        out[2] = (uint8_t)(posix_uint32 >> 16);
+        out[3] = (uint8_t)(posix_uint32 >> 24);
+    }
+
+    return ATCACERT_E_SUCCESS;
+}
+
+int atcacert_date_dec_batch(atcacert_date_format_t format,
+                            const uint8_t*         formatted_dates,
+                            size_t                 count,
+                            atcacert_tm_utc_t*     timestamps)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    size_t date_size = 0;
+    size_t i;
+    uint32_t posix_uint32;
+    const uint8_t* in;
+
+    if ((timestamps == NULL || formatted_dates == NULL) && count > 0)
+        return ATCACERT_E_BAD_PARAMS;
+    if (format < 0 || format >= sizeof(ATCACERT_DATE_FORMAT_SIZES) / sizeof(ATCACERT_DATE_FORMAT_SIZES[0]))
+        return ATCACERT_E_BAD_PARAMS;
+
+    date_size = ATCACERT_DATE_FORMAT_SIZES[format];
+    if (format != DATEFMT_POSIX_UINT32_BE && format != DATEFMT_POSIX_UINT32_LE)
+    {
+        for (i = 0; i < count && ret == ATCACERT_E_SUCCESS; i++)
+            ret = atcacert_date_dec(format, &formatted_dates[i * date_size], date_size, &timestamps[i]);
+        return ret;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        in = &formatted_dates[i * 4];
+        posix_uint32 = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+        if (format == DATEFMT_POSIX_UINT32_BE)
+            posix_uint32 = ((posix_uint32 >> 24) & 0xFF) | ((posix_uint32 >> 8) & 0xFF00) | ((posix_uint32 << 8) & 0xFF0000) | (posix_uint32 << 24);
+        atcacert_gmtime32(&posix_uint32, &timestamps[i]);
+    }
+
+    return ATCACERT_E_SUCCESS;
+}
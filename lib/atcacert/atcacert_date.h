@@ -168,6 +168,44 @@ int atcacert_date_dec_compcert(const uint8_t          enc_dates[3],
  */
 int atcacert_date_get_max_date(atcacert_date_format_t format, atcacert_tm_utc_t* timestamp);
 
+/**
+ * \brief Format many timestamps in the same format, e.g. for a provisioning run that
+ *        stamps thousands of certificates.
+ *
+ * The POSIX formats are checked in one pass and converted in a second, branch free
+ * pass the compiler can vectorize. Other formats are formatted one by one.
+ *
+ * \param[in]  format           Format to use.
+ * \param[in]  timestamps       Timestamps to format.
+ * \param[in]  count            Number of timestamps.
+ * \param[out] formatted_dates  Formatted dates are returned here back to back,
+ *                              count * ATCACERT_DATE_FORMAT_SIZES[format] bytes.
+ *
+ * \return 0 on success. ATCACERT_E_INVALID_DATE if any timestamp can't be formatted, in
+ *         which case the contents of formatted_dates are undefined.
+ */
+int atcacert_date_enc_batch(atcacert_date_format_t   format,
+                            const atcacert_tm_utc_t* timestamps,
+                            size_t                   count,
+                            uint8_t*                 formatted_dates);
+
+/**
+ * \brief Parse many formatted dates in the same format, the inverse of
+ *        atcacert_date_enc_batch().
+ *
+ * \param[in]  format           Format of the dates.
+ * \param[in]  formatted_dates  Formatted dates back to back,
+ *                              count * ATCACERT_DATE_FORMAT_SIZES[format] bytes.
+ * \param[in]  count            Number of dates.
+ * \param[out] timestamps       Parsed timestamps are returned here.
+ *
+ * \return 0 on success
+ */
+int atcacert_date_dec_batch(atcacert_date_format_t format,
+                            const uint8_t*         formatted_dates,
+                            size_t                 count,
+                            atcacert_tm_utc_t*     timestamps);
+
 int atcacert_date_enc_iso8601_sep(const atcacert_tm_utc_t * timestamp,
                                   uint8_t                   formatted_date[DATEFMT_ISO8601_SEP_SIZE]);
 
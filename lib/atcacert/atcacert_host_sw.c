@@ -42,6 +42,22 @@
 #include "crypto/atca_crypto_sw_sha2.h"
 #include "crypto/atca_crypto_sw_ecdsa.h"
 #include "crypto/atca_crypto_sw_rand.h"
+#include <stdlib.h>
+
+/** \brief map a software ECDSA verify status onto the atcacert error codes
+ * \param[in] status  status returned by atcac_sw_ecdsa_verify_p256()
+ * \return ATCACERT_E_SUCCESS, ATCACERT_E_VERIFY_FAILED or ATCACERT_E_BAD_PARAMS
+ */
+static int atcacert_sw_verify_status(int status)
+{
+    if (status == ATCA_SUCCESS)
+        return ATCACERT_E_SUCCESS;
+    if (status == ATCA_CHECKMAC_VERIFY_FAILED)
+        return ATCACERT_E_VERIFY_FAILED;
+    if (status == ATCA_BAD_PARAM)
+        return ATCACERT_E_BAD_PARAMS;
+    return status;
+}
 
 int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
                             const uint8_t*        cert,
@@ -63,11 +79,77 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
     if (ret != ATCACERT_E_SUCCESS)
         return ret;
 
-    ret = atcac_sw_ecdsa_verify_p256(tbs_digest, signature, ca_public_key);
-    if (ret != ATCACERT_E_SUCCESS)
-        return ret;
+    return atcacert_sw_verify_status(atcac_sw_ecdsa_verify_p256(tbs_digest, signature, ca_public_key));
+}
+
+/* Scratch for one block of atcacert_verify_certs_sw_batch() */
+typedef struct
+{
+    const uint8_t*             tbs[ATCACERT_VERIFY_BATCH_BLOCK];
+    size_t                     tbs_size[ATCACERT_VERIFY_BATCH_BLOCK];
+    uint8_t                    digests[ATCACERT_VERIFY_BATCH_BLOCK][32];
+    uint8_t                    signatures[ATCACERT_VERIFY_BATCH_BLOCK][64];
+    atcac_sw_ecdsa_p256_item_t verify[ATCACERT_VERIFY_BATCH_BLOCK];
+} atcacert_verify_batch_t;
+
+int atcacert_verify_certs_sw_batch(const atcacert_verify_item_t items[],
+                                   size_t                       count,
+                                   uint8_t                      results[])
+{
+    atcacert_verify_batch_t* batch;
+    const atcacert_verify_item_t* item;
+    size_t start, n, i;
+    int verified = 1;
+    int ret;
+
+    if (count == 0)
+        return ATCACERT_E_SUCCESS;
+    if (items == NULL || results == NULL)
+        return ATCACERT_E_BAD_PARAMS;
+
+    batch = (atcacert_verify_batch_t*)malloc(sizeof(*batch));
+    if (batch == NULL)
+        return ATCACERT_E_ERROR;
+
+    for (start = 0; start < count; start += n)
+    {
+        n = count - start < ATCACERT_VERIFY_BATCH_BLOCK ? count - start : ATCACERT_VERIFY_BATCH_BLOCK;
+
+        // Items that don't parse hash an empty TBS and verify against a NULL key, which fails
+        for (i = 0; i < n; i++)
+        {
+            item = &items[start + i];
+            batch->tbs[i] = batch->signatures[i];
+            batch->tbs_size[i] = 0;
+            batch->verify[i].msg = batch->digests[i];
+            batch->verify[i].signature = batch->signatures[i];
+            batch->verify[i].public_key = NULL;
+
+            if (item->cert_def == NULL || item->cert == NULL || item->ca_public_key == NULL)
+                continue;
+            if (atcacert_get_tbs(item->cert_def, item->cert, item->cert_size, &batch->tbs[i], &batch->tbs_size[i]) != ATCACERT_E_SUCCESS ||
+                atcacert_get_signature(item->cert_def, item->cert, item->cert_size, batch->signatures[i]) != ATCACERT_E_SUCCESS)
+            {
+                batch->tbs[i] = batch->signatures[i];
+                batch->tbs_size[i] = 0;
+                continue;
+            }
+            batch->verify[i].public_key = item->ca_public_key;
+        }
+
+        ret = atcac_sw_sha2_256_multi(batch->tbs, batch->tbs_size, n, batch->digests);
+        if (ret != ATCA_SUCCESS)
+        {
+            free(batch);
+            return ret;
+        }
+
+        if (atcac_sw_ecdsa_verify_p256_batch(batch->verify, n, &results[start / 8]) != ATCA_SUCCESS)
+            verified = 0;
+    }
 
-    return ATCACERT_E_SUCCESS;
+    free(batch);
+    return verified ? ATCACERT_E_SUCCESS : ATCACERT_E_VERIFY_FAILED;
 }
 
 int atcacert_gen_challenge_sw(uint8_t challenge[32])
@@ -85,5 +167,5 @@ int atcacert_verify_response_sw(const uint8_t device_public_key[64],
     if (device_public_key == NULL || challenge == NULL || response == NULL)
         return ATCACERT_E_BAD_PARAMS;
 
-    return atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
+    return atcacert_sw_verify_status(atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key));
 }
\ No newline at end of file
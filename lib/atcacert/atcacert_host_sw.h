@@ -57,6 +57,24 @@ extern "C" {
  *
    @{ */
 
+/* Certificates atcacert_verify_certs_sw_batch() hashes and verifies together, a multiple of 8 */
+#ifndef ATCACERT_VERIFY_BATCH_BLOCK
+#define ATCACERT_VERIFY_BATCH_BLOCK 256
+#endif
+#if ATCACERT_VERIFY_BATCH_BLOCK <= 0 || ATCACERT_VERIFY_BATCH_BLOCK % 8 != 0
+#error "ATCACERT_VERIFY_BATCH_BLOCK must be a positive multiple of 8, each block fills whole bytes of the results bitmap"
+#endif
+
+/** \brief one certificate for atcacert_verify_certs_sw_batch(), arguments as for
+ *         atcacert_verify_cert_sw() */
+typedef struct
+{
+    const atcacert_def_t* cert_def;
+    const uint8_t*        cert;
+    size_t                cert_size;
+    const uint8_t*        ca_public_key;
+} atcacert_verify_item_t;
+
 /**
  * \brief Verify a certificate against its certificate authority's public key using software crypto
  *        functions.
@@ -76,6 +94,26 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
                             size_t                cert_size,
                             const uint8_t         ca_public_key[64]);
 
+/**
+ * \brief Verify many certificates against their certificate authorities' public keys using
+ *        software crypto functions, for example the signer and device certificates of a whole
+ *        fleet. The TBS digests are computed with multi-buffer SHA-256 and the signatures with
+ *        atcac_sw_ecdsa_verify_p256_batch().
+ *
+ * A chain is verified by listing the signer certificate with the root public key and the
+ * device certificate with the signer public key taken from the signer certificate.
+ *
+ * \param[in]  items    Certificates to verify.
+ * \param[in]  count    Number of items.
+ * \param[out] results  Bitmap of (count + 7) / 8 bytes, bit i % 8 of byte i / 8 is set when
+ *                      item i verifies. Items that can't be parsed fail.
+ *
+ * \return 0 if every certificate verifies, ATCACERT_E_VERIFY_FAILED if any doesn't.
+ */
+int atcacert_verify_certs_sw_batch(const atcacert_verify_item_t items[],
+                                   size_t                       count,
+                                   uint8_t                      results[]);
+
 /**
  * \brief Generate a random challenge to be sent to the client using a software PRNG.
  *
@@ -63,14 +63,13 @@ ATCA_STATUS atcab_version(char *verstr)
 }
 
 /** \brief basic API methods are all prefixed with atcab_  (Atmel CryptoAuth Basic)
- *  the fundamental premise of the basic API is it is based on a single interface
- *  instance and that instance is global, so all basic API commands assume that
- *  one global device is the one to operate on.
+ *  every command comes in two forms: atcab_xxx_ctx() takes the ATCADevice to operate
+ *  on as its first argument, and atcab_xxx() runs atcab_xxx_ctx() on the default device
+ *  set up by atcab_init() or atcab_init_device().  Applications driving several devices
+ *  (or several threads) use the _ctx form with a device each.
  */
 
 ATCADevice _gDevice = NULL;
-ATCACommand _gCommandObj = NULL;
-ATCAIface _gIface = NULL;
 
 /** \brief atcab_init is called once for the life of the application and creates a global ATCADevice object used by Basic API.
  *  This method builds a global ATCADevice instance behinds the scenes that's used for all Basic API operations
@@ -87,10 +86,7 @@ ATCA_STATUS atcab_init(ATCAIfaceCfg *cfg)
     if (_gDevice == NULL)
         return ATCA_GEN_FAIL;  // Device creation failed
 
-    _gCommandObj = atGetCommands(_gDevice);
-    _gIface = atGetIFace(_gDevice);
-
-    if (_gCommandObj == NULL || _gIface == NULL)
+    if (atGetCommands(_gDevice) == NULL || atGetIFace(_gDevice) == NULL)
         return ATCA_GEN_FAIL;  // More of an assert to make everything was constructed properly
 
     return ATCA_SUCCESS;
@@ -111,10 +107,7 @@ ATCA_STATUS atcab_init_device(ATCADevice cadevice)
         atcab_release();
 
     _gDevice = cadevice;
-    _gCommandObj = atGetCommands(_gDevice);
-    _gIface = atGetIFace(_gDevice);
-
-    if (_gCommandObj == NULL || _gIface == NULL)
+    if (atGetCommands(_gDevice) == NULL || atGetIFace(_gDevice) == NULL)
         return ATCA_GEN_FAIL;
 
     return ATCA_SUCCESS;
@@ -141,36 +134,168 @@ ATCADevice atcab_get_device(void)
 
 
 /** \brief wakeup the CryptoAuth device
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_wakeup(void)
+ATCA_STATUS atcab_wakeup_ctx(ATCADevice device)
 {
-    if (_gDevice == NULL)
+    ATCA_STATUS status;
+
+    if (device == NULL)
         return ATCA_GEN_FAIL;
 
-    return atwake(_gIface);
+    atca_device_lock(device);
+    status = atwake(atGetIFace(device));
+    atca_device_unlock(device);
+
+    return status;
+}
+
+/** \brief atcab_wakeup_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_wakeup(void)
+{
+    return atcab_wakeup_ctx(_gDevice);
 }
 
 /** \brief idle the CryptoAuth device
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_idle(void)
+ATCA_STATUS atcab_idle_ctx(ATCADevice device)
 {
-    if (_gDevice == NULL)
+    ATCA_STATUS status;
+
+    if (device == NULL)
         return ATCA_GEN_FAIL;
 
-    return atidle(_gIface);
+    atca_device_lock(device);
+    atGetSession(device)->awake = false;  // an open session wakes it again on its next command
+    status = atidle(atGetIFace(device));
+    atca_device_unlock(device);
+
+    return status;
+}
+
+/** \brief atcab_idle_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_idle(void)
+{
+    return atcab_idle_ctx(_gDevice);
 }
 
 /** \brief invoke sleep on the CryptoAuth device
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_sleep(void)
+ATCA_STATUS atcab_sleep_ctx(ATCADevice device)
 {
-    if (_gDevice == NULL)
+    ATCA_STATUS status;
+
+    if (device == NULL)
         return ATCA_GEN_FAIL;
 
-    return atsleep(_gIface);
+    atca_device_lock(device);
+    atGetSession(device)->awake = false;
+    status = atsleep(atGetIFace(device));
+    atca_device_unlock(device);
+
+    return status;
+}
+
+/** \brief atcab_sleep_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_sleep(void)
+{
+    return atcab_sleep_ctx(_gDevice);
+}
+
+/** \brief keep the device awake across the basic API commands that follow
+ *
+ *  Until the matching atcab_session_end() the commands share one wake pulse instead of
+ *  paying a wake and an idle each. A batch that runs long is idled and re-woken
+ *  transparently before the device watchdog would put it to sleep. Sessions nest.
+ *  \param[in] device  device context to run the command on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_session_begin_ctx(ATCADevice device)
+{
+    return atca_session_begin(device);
+}
+
+/** \brief atcab_session_begin_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_session_begin(void)
+{
+    return atcab_session_begin_ctx(_gDevice);
+}
+
+/** \brief end a session started with atcab_session_begin(), idling the device when the
+ *         outermost session ends
+ *  \param[in] device  device context to run the command on
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_session_end_ctx(ATCADevice device)
+{
+    return atca_session_end(device);
+}
+
+/** \brief atcab_session_end_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_session_end(void)
+{
+    return atcab_session_end_ctx(_gDevice);
+}
+
+/** \brief report how the device's config zone shadow has been used
+ *
+ *  Config zone reads outside the volatile counter and LastKeyUse bytes (52..83) are
+ *  served from a host copy filled with one bulk read. Config writes, UpdateExtra and
+ *  every Lock drop the copy. reads_saved counts the bus reads that were not made.
+ *  \param[in]  device  device context
+ *  \param[out] stats   receives the counters
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_config_shadow_stats_ctx(ATCADevice device, ATCAConfigShadowStats* stats)
+{
+    ATCAConfigShadow* shadow = atGetConfigShadow(device);
+
+    if (shadow == NULL || stats == NULL)
+        return ATCA_BAD_PARAM;
+
+    atca_device_lock(device);
+    *stats = shadow->stats;
+    atca_device_unlock(device);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief atcab_config_shadow_stats_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_config_shadow_stats(ATCAConfigShadowStats* stats)
+{
+    return atcab_config_shadow_stats_ctx(_gDevice, stats);
+}
+
+/** \brief forget the device's config zone shadow, for when the config zone was changed
+ *         behind the basic API's back (another host, a raw packet)
+ *  \param[in] device  device context
+ *  \return ATCA_STATUS
+ */
+ATCA_STATUS atcab_config_shadow_invalidate_ctx(ATCADevice device)
+{
+    ATCAConfigShadow* shadow = atGetConfigShadow(device);
+
+    if (shadow == NULL)
+        return ATCA_BAD_PARAM;
+
+    atca_device_lock(device);
+    if (shadow->valid)
+        shadow->stats.invalidations++;
+    shadow->valid = false;
+    atca_device_unlock(device);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief atcab_config_shadow_invalidate_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_config_shadow_invalidate(void)
+{
+    return atcab_config_shadow_invalidate_ctx(_gDevice);
 }
 
 
@@ -270,27 +395,18 @@ ATCA_STATUS atcab_cfg_discover(ATCAIfaceCfg cfgArray[], int maxIfaces)
     return ATCA_SUCCESS;
 }
 
-/** \brief common cleanup code which idles the device after any operation
- *  \return ATCA_STATUS
- */
-static ATCA_STATUS _atcab_exit(void)
-{
-    return atcab_idle();
-}
-
-
 /** \brief get the device revision information
+ *  \param[in] device  device context to run the command on
  *  \param[out] revision - 4-byte storage for receiving the revision number from the device
  *  \return ATCA_STATUS
  */
 
-ATCA_STATUS atcab_info(uint8_t *revision)
+ATCA_STATUS atcab_info_ctx(ATCADevice device, uint8_t *revision)
 {
     ATCAPacket packet;
     ATCA_STATUS status = ATCA_GEN_FAIL;
-    uint32_t execution_time;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
 
     // build an info command
@@ -305,59 +421,36 @@ ATCA_STATUS atcab_info(uint8_t *revision)
             status = ATCA_BAD_PARAM;
             BREAK(status, "atcab_info: Null inputs");
         }
-        if ( (status = atInfo(_gCommandObj, &packet)) != ATCA_SUCCESS)
+        if ( (status = atInfo(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             BREAK(status, "Failed to construct Info command");
 
-        execution_time = atGetExecTime(_gCommandObj, CMD_INFO);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            BREAK(status, "Failed to wakeup");
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            BREAK(status, "Failed to send Info command");
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, &(packet.data[0]), &(packet.rxsize) )) != ATCA_SUCCESS)
-            BREAK(status, "Failed to receive Info command");
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            BREAK(status, "Info command returned error code or no resonse");
-        }
-
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
-            BREAK(status, "Failed to construct Info command");
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
+            BREAK(status, "Failed to execute Info command");
 
         memcpy(revision, &packet.data[1], 4);    // don't include the receive length, only payload
     }
     while (0);
 
-    if (status != ATCA_COMM_FAIL)     // don't keep shoving more stuff at the chip if there's something wrong with comm
-        _atcab_exit();
-
     return status;
 }
 
+/** \brief atcab_info_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_info(uint8_t *revision)
+{
+    return atcab_info_ctx(_gDevice, revision);
+}
+
 /** \brief Get a 32 byte random number from the CryptoAuth device
+ *	\param[in] device  device context to run the command on
  *	\param[out] rand_out ptr to 32 bytes of storage for random number
  *	\return status of the operation
  */
-ATCA_STATUS atcab_random(uint8_t *rand_out)
+ATCA_STATUS atcab_random_ctx(ATCADevice device, uint8_t *rand_out)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
 
     do
@@ -365,36 +458,10 @@ ATCA_STATUS atcab_random(uint8_t *rand_out)
         // build an random command
         packet.param1 = RANDOM_SEED_UPDATE;
         packet.param2 = 0x0000;
-        if ( (status = atRandom(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_RANDOM);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
+        if ( (status = atRandom(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if (packet.rxsize < packet.data[ATCA_COUNT_IDX] || packet.data[ATCA_COUNT_IDX] != RANDOM_RSP_SIZE)
@@ -408,13 +475,19 @@ ATCA_STATUS atcab_random(uint8_t *rand_out)
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_random_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_random(uint8_t *rand_out)
+{
+    return atcab_random_ctx(_gDevice, rand_out);
+}
+
 /** \brief This command can generate a private key, compute a public key,
  *         and/or compute a digest of of a public key.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  mode        Mode bit mask determines what operations the GenKey
  *                         command performs. Bit 4 overrides bits 2 and 3.
  *                         Bit 2 will create a new random private key in
@@ -437,13 +510,12 @@ ATCA_STATUS atcab_random(uint8_t *rand_out)
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key)
+ATCA_STATUS atcab_genkey_base_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key)
 {
     ATCAPacket packet;
-    uint16_t execution_time = 0;
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
 
     do
@@ -453,36 +525,10 @@ ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* othe
         packet.param2 = key_id;
         if (other_data)
             memcpy(packet.data, other_data, GENKEY_OTHER_DATA_SIZE);
-        if ((status = atGenKey(_gCommandObj, &packet)) != ATCA_SUCCESS)
+        if ((status = atGenKey(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        execution_time = atGetExecTime(_gCommandObj, CMD_GENKEY);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if (public_key && packet.data[ATCA_COUNT_IDX] > 4)
@@ -490,12 +536,18 @@ ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* othe
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_genkey_base_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key)
+{
+    return atcab_genkey_base_ctx(_gDevice, mode, key_id, other_data, public_key);
+}
+
 /** \brief Generate a new random private key and return the public key.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  key_id      Slot where an ECC private key is configured.
  * \param[out] public_key  Public key will be returned here. Format will be
  *                         the X and Y integers in big-endian format.
@@ -504,39 +556,59 @@ ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* othe
  *
  * \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_genkey_ctx(ATCADevice device, uint16_t key_id, uint8_t *public_key)
+{
+    return atcab_genkey_base_ctx(device, GENKEY_MODE_PRIVATE, key_id, NULL, public_key);
+}
+
+/** \brief atcab_genkey_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t *public_key)
 {
-    return atcab_genkey_base(GENKEY_MODE_PRIVATE, key_id, NULL, public_key);
+    return atcab_genkey_ctx(_gDevice, key_id, public_key);
 }
 
 /** \brief Execute a pass-through Nonce command to initialize TempKey to the specified value
+ *  \param[in] device  device context to run the command on
  *  \param[in] tempkey - pointer to 32 bytes of data which will be used to initialize TempKey
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_nonce_ctx(ATCADevice device, const uint8_t *tempkey)
+{
+    return atcab_challenge_ctx(device, tempkey);
+}
+
+/** \brief atcab_nonce_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_nonce(const uint8_t *tempkey)
 {
-    return atcab_challenge(tempkey);
+    return atcab_nonce_ctx(_gDevice, tempkey);
 }
 
 /** \brief Initialize TempKey with a random Nonce
+ *  \param[in] device  device context to run the command on
  *  \param[in] seed - pointer to 20 bytes of data which will be used to calculate TempKey
  *  \param[out] rand_out - pointer to 32 bytes of data that is the output of the Nonce command
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_nonce_rand_ctx(ATCADevice device, const uint8_t *seed, uint8_t* rand_out)
+{
+    return atcab_challenge_seed_update_ctx(device, seed, rand_out);
+}
+
+/** \brief atcab_nonce_rand_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_nonce_rand(const uint8_t *seed, uint8_t* rand_out)
 {
-    return atcab_challenge_seed_update(seed, rand_out);
+    return atcab_nonce_rand_ctx(_gDevice, seed, rand_out);
 }
 
 /** \brief send a challenge to the device (a pass-through nonce)
+ *  \param[in] device  device context to run the command on
  *  \param[in] challenge - pointer to 32 bytes of data which will be sent as the challenge
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_challenge(const uint8_t *challenge)
+ATCA_STATUS atcab_challenge_ctx(ATCADevice device, const uint8_t *challenge)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -552,55 +624,34 @@ ATCA_STATUS atcab_challenge(const uint8_t *challenge)
         packet.param2 = 0x0000;
         memcpy(packet.data, challenge, 32);
 
-        if ((status = atNonce(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_NONCE);
-
-        if ((status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
+        if ((status = atNonce(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_challenge_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_challenge(const uint8_t *challenge)
+{
+    return atcab_challenge_ctx(_gDevice, challenge);
+}
+
 /** \brief send a challenge to the device (a seed update nonce)
+ *  \param[in] device  device context to run the command on
  *  \param[in] seed - pointer to 32 bytes of data which will be sent as the challenge
  *  \param[out] rand_out - points to space to receive random number
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
+ATCA_STATUS atcab_challenge_seed_update_ctx(ATCADevice device, const uint8_t *seed, uint8_t* rand_out)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -616,36 +667,10 @@ ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
         packet.param2 = 0x0000;
         memcpy(packet.data, seed, 20);
 
-        if ((status = atNonce(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_NONCE);
-
-        if ((status = atcab_wakeup()) != ATCA_SUCCESS)
+        if ((status = atNonce(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         memcpy(&rand_out[0], &packet.data[ATCA_RSP_DATA_IDX], 32);
@@ -653,12 +678,18 @@ ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_challenge_seed_update_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
+{
+    return atcab_challenge_seed_update_ctx(_gDevice, seed, rand_out);
+}
+
 /** \brief The Nonce command generates a nonce for use by subsequent commands.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  mode      Controls the mechanism of the internal RNG and seed
  *                       update.
  * \param[in]  num_in    Input value to either be included in the nonce
@@ -671,11 +702,10 @@ ATCA_STATUS atcab_challenge_seed_update(const uint8_t *seed, uint8_t* rand_out)
  *                       Can be NULL if not needed.
  * \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_nonce_base(uint8_t mode, const uint8_t *num_in, uint8_t* rand_out)
+ATCA_STATUS atcab_nonce_base_ctx(ATCADevice device, uint8_t mode, const uint8_t *num_in, uint8_t* rand_out)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -689,36 +719,10 @@ ATCA_STATUS atcab_nonce_base(uint8_t mode, const uint8_t *num_in, uint8_t* rand_
             memcpy(packet.data, num_in, 20);
 
 
-        if ((status = atNonce(_gCommandObj, &packet)) != ATCA_SUCCESS)
+        if ((status = atNonce(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        execution_time = atGetExecTime(_gCommandObj, CMD_NONCE);
-
-        if ((status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if ((rand_out != NULL) && (packet.rxsize >= 35))
@@ -727,14 +731,20 @@ ATCA_STATUS atcab_nonce_base(uint8_t mode, const uint8_t *num_in, uint8_t* rand_
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
+
+/** \brief atcab_nonce_base_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_nonce_base(uint8_t mode, const uint8_t *num_in, uint8_t* rand_out)
+{
+    return atcab_nonce_base_ctx(_gDevice, mode, num_in, rand_out);
+}
 /** \brief read the serial number of the device
+ *  \param[in] device  device context to run the command on
  *  \param[out] serial_number  pointer to space to receive serial number. This space should be 9 bytes long
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+ATCA_STATUS atcab_read_serial_number_ctx(ATCADevice device, uint8_t* serial_number)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t read_buf[ATCA_BLOCK_SIZE];
@@ -744,7 +754,7 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
 
     do
     {
-        if ( (status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (status = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0, 0, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
         memcpy(&serial_number[0], &read_buf[0], 4);
         memcpy(&serial_number[4], &read_buf[8], 5);
@@ -754,6 +764,12 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
     return status;
 }
 
+/** \brief atcab_read_serial_number_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
+{
+    return atcab_read_serial_number_ctx(_gDevice, serial_number);
+}
+
 /** \brief The Verify command takes an ECDSA [R,S] signature and verifies that
  *         it is correctly generated from a given message and public key. In
  *         all cases, the signature is an input to the command.
@@ -761,6 +777,7 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
  * For the Stored, External, and ValidateExternal Modes, the contents of
  * TempKey should contain the SHA-256 digest of the message.
  *
+ * \param[in] device  device context to run the command on
  * \param[in] mode        Verify command mode: Stored(0), ValidateExternal(1),
  *                        External(2), Validate(3), or Invalidate(7)
  * \param[in] key_id      Stored Mode - The slot containing the public key to
@@ -782,13 +799,12 @@ ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number)
  *
  * \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data)
+ATCA_STATUS atcab_verify_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
 
     do
@@ -809,47 +825,27 @@ ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature
         else if (other_data)
             memcpy(&packet.data[ATCA_SIG_SIZE], other_data, VERIFY_OTHER_DATA_SIZE);
 
-        if ( (status = atVerify(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_VERIFY);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS)
+        if ( (status = atVerify(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        status = isATCAError(packet.data);
+        status = atca_execute_command(device, &packet);
     }
     while (false);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_verify_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data)
+{
+    return atcab_verify_ctx(_gDevice, mode, key_id, signature, public_key, other_data);
+}
+
 /** \brief Verify a signature (ECDSA verify operation) with all components
  *         (message, signature, and public key) supplied. Uses the
  *         CryptoAuthentication hardware instead of software.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  message      32 byte message to be verified. Typically the
  *                            SHA256 hash of the full message.
  * \param[in]  signature    Signature to be verified. R and S integers in
@@ -863,33 +859,41 @@ ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature
  * \return ATCA_SUCCESS on verification success or failure, because the
  *         command still completed successfully.
  */
-ATCA_STATUS atcab_verify_extern(const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified)
+ATCA_STATUS atcab_verify_extern_ctx(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
     if (signature == NULL || message == NULL || public_key == NULL || is_verified == NULL)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // nonce passthrough
-        if ( (status = atcab_challenge(message)) != ATCA_SUCCESS)
+        if ( (status = atcab_challenge_ctx(device, message)) != ATCA_SUCCESS)
             break;
 
-        status = atcab_verify(VERIFY_MODE_EXTERNAL, VERIFY_KEY_P256, signature, public_key, NULL);
+        status = atcab_verify_ctx(device, VERIFY_MODE_EXTERNAL, VERIFY_KEY_P256, signature, public_key, NULL);
         *is_verified = (status == ATCA_SUCCESS);
         if (status == ATCA_CHECKMAC_VERIFY_FAILED)
             status = ATCA_SUCCESS;  // Verify failed, but command succeeded
     }
     while (0);
 
-    _atcab_exit();
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_verify_extern_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_verify_extern(const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified)
+{
+    return atcab_verify_extern_ctx(_gDevice, message, signature, public_key, is_verified);
+}
+
 /** \brief Verify a signature and message (ECDSA verify operation) against a
  *         public key stored in a specified slot.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  message      32 byte message to be verified. Typically the
  *                            SHA256 hash of the full message.
  * \param[in]  signature    Signature to be verified. R and S integers in
@@ -902,7 +906,7 @@ ATCA_STATUS atcab_verify_extern(const uint8_t *message, const uint8_t *signature
  * \return ATCA_SUCCESS on verification success or failure, because the
  *         command still completed successfully.
  */
-ATCA_STATUS atcab_verify_stored(const uint8_t *message, const uint8_t *signature, uint16_t key_id, bool *is_verified)
+ATCA_STATUS atcab_verify_stored_ctx(ATCADevice device, const uint8_t *message, const uint8_t *signature, uint16_t key_id, bool *is_verified)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
@@ -911,28 +915,36 @@ ATCA_STATUS atcab_verify_stored(const uint8_t *message, const uint8_t *signature
     if (signature == NULL || message == NULL || is_verified == NULL)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // nonce passthrough
-        if ( (status = atcab_challenge(message)) != ATCA_SUCCESS)
+        if ( (status = atcab_challenge_ctx(device, message)) != ATCA_SUCCESS)
             break;
 
-        status = atcab_verify(VERIFY_MODE_STORED, key_id, signature, NULL, NULL);
+        status = atcab_verify_ctx(device, VERIFY_MODE_STORED, key_id, signature, NULL, NULL);
         *is_verified = (status == ATCA_SUCCESS);
         if (status == ATCA_CHECKMAC_VERIFY_FAILED)
             status = ATCA_SUCCESS;  // Verify failed, but command succeeded
     }
     while (0);
 
-    _atcab_exit();
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_verify_stored_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_verify_stored(const uint8_t *message, const uint8_t *signature, uint16_t key_id, bool *is_verified)
+{
+    return atcab_verify_stored_ctx(_gDevice, message, signature, key_id, is_verified);
+}
+
 /** \brief Validate a public key stored in a slot.
  *
  * This command can only be run after GenKey has been used to create a PubKey
  * digest of the public key to be validated in TempKey (mode=0x10).
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  key_id       Slot containing the public key to be validated.
  * \param[in]  signature    Signature to be verified. R and S integers in
  *                            big-endian format. 64 bytes for P256 curve.
@@ -944,7 +956,7 @@ ATCA_STATUS atcab_verify_stored(const uint8_t *message, const uint8_t *signature
  * \return ATCA_SUCCESS on verification success or failure, because the
  *         command still completed successfully.
  */
-ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
+ATCA_STATUS atcab_verify_validate_ctx(ATCADevice device, uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
 
@@ -953,7 +965,7 @@ ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t *signature, con
     if (signature == NULL || other_data == NULL || is_verified == NULL)
         return ATCA_BAD_PARAM;
 
-    status = atcab_verify(VERIFY_MODE_VALIDATE, key_id, signature, NULL, other_data);
+    status = atcab_verify_ctx(device, VERIFY_MODE_VALIDATE, key_id, signature, NULL, other_data);
     *is_verified = (status == ATCA_SUCCESS);
     if (status == ATCA_CHECKMAC_VERIFY_FAILED)
         status = ATCA_SUCCESS;  // Verify failed, but command succeeded
@@ -961,11 +973,18 @@ ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t *signature, con
     return status;
 }
 
+/** \brief atcab_verify_validate_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
+{
+    return atcab_verify_validate_ctx(_gDevice, key_id, signature, other_data, is_verified);
+}
+
 /** \brief Invalidate a public key stored in a slot.
  *
  * This command can only be run after GenKey has been used to create a PubKey
  * digest of the public key to be invalidated in TempKey (mode=0x10).
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  key_id       Slot containing the public key to be invalidated.
  * \param[in]  signature    Signature to be verified. R and S integers in
  *                            big-endian format. 64 bytes for P256 curve.
@@ -977,7 +996,7 @@ ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t *signature, con
  * \return ATCA_SUCCESS on verification success or failure, because the
  *         command still completed successfully.
  */
-ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
+ATCA_STATUS atcab_verify_invalidate_ctx(ATCADevice device, uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
 
@@ -986,7 +1005,7 @@ ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t *signature, c
     if (signature == NULL || other_data == NULL || is_verified == NULL)
         return ATCA_BAD_PARAM;
 
-    status = atcab_verify(VERIFY_MODE_INVALIDATE, key_id, signature, NULL, other_data);
+    status = atcab_verify_ctx(device, VERIFY_MODE_INVALIDATE, key_id, signature, NULL, other_data);
     *is_verified = (status == ATCA_SUCCESS);
     if (status == ATCA_CHECKMAC_VERIFY_FAILED)
         status = ATCA_SUCCESS;  // Verify failed, but command succeeded
@@ -994,8 +1013,15 @@ ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t *signature, c
     return status;
 }
 
+/** \brief atcab_verify_invalidate_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified)
+{
+    return atcab_verify_invalidate_ctx(_gDevice, key_id, signature, other_data, is_verified);
+}
+
 /** \brief ECDH command with premaster secret returned in the response.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] key_id     Slot of key for ECDH computation
  *  \param[in] pubkey     Public key input to ECDH calculation. X and Y
  *                        integers in big-endian format. 64 bytes for P256
@@ -1005,11 +1031,10 @@ ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t *signature, c
  *
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
+ATCA_STATUS atcab_ecdh_ctx(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
 {
     ATCA_STATUS status;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -1025,33 +1050,10 @@ ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
         packet.param2 = key_id;
         memcpy(packet.data, pubkey, ATCA_PUB_KEY_SIZE);
 
-        if ( (status = atECDH(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_ECDH);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        atca_delay_ms(execution_time);
-
-        if ((status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ( (status = atECDH(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         // The ECDH command may return a single byte. Then the CRC is copied into indices [1:2]
@@ -1060,12 +1062,18 @@ ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_ecdh_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
+{
+    return atcab_ecdh_ctx(_gDevice, key_id, pubkey, pms);
+}
+
 /** \brief ECDH command with premaster secret read (encrypted) from next slot.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] key_id     Slot of key for ECDH computation
  *  \param[in] pubkey     Public key input to ECDH calculation. X and Y
  *                        integers in big-endian format. 64 bytes for P256
@@ -1077,13 +1085,14 @@ ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
  *
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms, const uint8_t* enckey, uint16_t enckeyid)
+ATCA_STATUS atcab_ecdh_enc_ctx(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms, const uint8_t* enckey, uint16_t enckeyid)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     uint8_t cmpBuf[ATCA_WORD_SIZE];
     uint8_t cmpBuf_2[ATCA_WORD_SIZE];
     uint8_t block = 0;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Check the inputs
@@ -1093,11 +1102,11 @@ ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms,
             BREAK(status, "Bad input parameters");
         }
         // Send the ECDH command with the public key provided
-        if ((status = atcab_ecdh(key_id, pubkey, pms)) != ATCA_SUCCESS)
+        if ((status = atcab_ecdh_ctx(device, key_id, pubkey, pms)) != ATCA_SUCCESS)
             BREAK(status, "ECDH Failed");
 
         // ECDH may return a key or a single byte.
-        // The atcab_ecdh() function performs a memset to 00h on ecdhRsp.
+        // The atcab_ecdh_ctx(device) function performs a memset to 00h on ecdhRsp.
 
         memset(cmpBuf, 0, ATCA_WORD_SIZE);
         memset(cmpBuf_2, 0xFF, ATCA_WORD_SIZE);
@@ -1115,15 +1124,22 @@ ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms,
                 BREAK(status, "ECDH Command Execution Failure");
 
             // ECDH succeeded, perform an encrypted read from the n+1 slot.
-            if ((status = atcab_read_enc(key_id + 1, block, pms, enckey, enckeyid)) != ATCA_SUCCESS)
+            if ((status = atcab_read_enc_ctx(device, key_id + 1, block, pms, enckey, enckeyid)) != ATCA_SUCCESS)
                 BREAK(status, "Encrypte read failed");
         }
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_ecdh_enc_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* pubkey, uint8_t* pms, const uint8_t* enckey, uint16_t enckeyid)
+{
+    return atcab_ecdh_enc_ctx(_gDevice, key_id, pubkey, pms, enckey, enckeyid);
+}
+
 
 /** \brief Compute the address given the zone, slot, block, and offset
  *  \param[in] zone
@@ -1167,6 +1183,7 @@ ATCA_STATUS atcab_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t o
 
 /** \brief Gets the size of the specified zone in bytes.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  zone  Zone to get size information from. Config(0), OTP(1), or
  *                   Data(2) which requires a slot.
  * \param[in]  slot  If zone is Data(2), the slot to query for size.
@@ -1174,14 +1191,14 @@ ATCA_STATUS atcab_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t o
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
+ATCA_STATUS atcab_get_zone_size_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
 
     if (size == NULL)
         return ATCA_BAD_PARAM;
 
-    if (atgetifacecfg(_gIface)->devtype == ATSHA204A)
+    if (atgetifacecfg(atGetIFace(device))->devtype == ATSHA204A)
     {
         switch (zone)
         {
@@ -1214,12 +1231,19 @@ ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
     return status;
 }
 
+/** \brief atcab_get_zone_size_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size)
+{
+    return atcab_get_zone_size_ctx(_gDevice, zone, slot, size);
+}
+
 /** \brief Query to see if the specified slot is locked
+ *  \param[in] device  device context to run the command on
  *  \param[in]  slot      The slot to query for locked (slot 0-15)
  *  \param[out] is_locked  true if the specified slot is locked
  *  \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *is_locked)
+ATCA_STATUS atcab_is_slot_locked_ctx(ATCADevice device, uint8_t slot, bool *is_locked)
 {
     ATCA_STATUS ret = ATCA_GEN_FAIL;
     uint8_t data[ATCA_WORD_SIZE];
@@ -1233,7 +1257,7 @@ ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *is_locked)
             return ATCA_BAD_PARAM;
 
         // Read the word with the lock bytes ( SlotLock[2], RFU[2] ) (config block = 2, word offset = 6)
-        if ( (ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 2 /*block*/, 6 /*offset*/, data, ATCA_WORD_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 2 /*block*/, 6 /*offset*/, data, ATCA_WORD_SIZE)) != ATCA_SUCCESS)
             break;
 
         slot_locked = ((uint16_t)data[0]) | ((uint16_t)data[1] << 8);
@@ -1244,12 +1268,19 @@ ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *is_locked)
     return ret;
 }
 
+/** \brief atcab_is_slot_locked_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_is_slot_locked(uint8_t slot, bool *is_locked)
+{
+    return atcab_is_slot_locked_ctx(_gDevice, slot, is_locked);
+}
+
 /** \brief Query to see if the specified zone is locked
+ *  \param[in] device  device context to run the command on
  *  \param[in]  zone      The zone to query for locked (use LOCK_ZONE_CONFIG or LOCK_ZONE_DATA)
  *  \param[out] is_locked  true if the specified zone is locked
  *  \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_is_locked(uint8_t zone, bool *is_locked)
+ATCA_STATUS atcab_is_locked_ctx(ATCADevice device, uint8_t zone, bool *is_locked)
 {
     ATCA_STATUS ret = ATCA_GEN_FAIL;
     uint8_t data[ATCA_WORD_SIZE];
@@ -1260,7 +1291,7 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool *is_locked)
             return ATCA_BAD_PARAM;
 
         // Read the word with the lock bytes (UserExtra, Selector, LockValue, LockConfig) (config block = 2, word offset = 5)
-        if ( (ret = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 2 /*block*/, 5 /*offset*/, data, ATCA_WORD_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 2 /*block*/, 5 /*offset*/, data, ATCA_WORD_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Determine the index into the word_data based on the zone we are querying for
@@ -1276,12 +1307,129 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool *is_locked)
     return ret;
 }
 
+/** \brief atcab_is_locked_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_is_locked(uint8_t zone, bool *is_locked)
+{
+    return atcab_is_locked_ctx(_gDevice, zone, is_locked);
+}
+
+/** \brief read a 4 or 32 byte zone address over the bus, parameters already checked
+ *  \param[in]  device  device context to run the command on
+ *  \param[in]  zone    zone without the 32 byte flag
+ *  \param[in]  addr    address from atcab_get_addr()
+ *  \param[out] data    receives the bytes read
+ *  \param[in]  len     4 or 32
+ *  \return ATCA_STATUS
+ */
+static ATCA_STATUS atcab_read_zone_bus(ATCADevice device, uint8_t zone, uint16_t addr, uint8_t *data, uint8_t len)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCAPacket packet;
+
+    do
+    {
+        // If there are 32 bytes to write, then xor the bit into the mode
+        if (len == ATCA_BLOCK_SIZE)
+            zone = zone | ATCA_ZONE_READWRITE_32;
+
+        // build a read command
+        packet.param1 = zone;
+        packet.param2 = addr;
+
+        if ( (status = atRead(atGetCommands(device), &packet)) != ATCA_SUCCESS)
+            break;
+
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
+            break;
+
+        memcpy(data, &packet.data[1], len);
+    }
+    while (0);
+
+    return status;
+}
+
+#ifndef ATCA_NO_CONFIG_SHADOW
+/* Config bytes the device changes on its own, counters, UseFlag/UpdateCount and
+ * LastKeyUse. Reads touching them always go to the bus. */
+#define ATCA_CONFIG_VOLATILE_START  52
+#define ATCA_CONFIG_VOLATILE_END    84
+
+/** \brief answer a config zone read from the device's config shadow, filling the shadow
+ *         with a bulk read first if it is empty
+ *  \param[in]  device  device context
+ *  \param[in]  start   byte offset in the config zone
+ *  \param[out] data    receives the bytes
+ *  \param[in]  len     bytes to read
+ *  \return ATCA_SUCCESS if data was served from the shadow, otherwise the caller reads the bus
+ */
+static ATCA_STATUS atca_config_shadow_read(ATCADevice device, size_t start, uint8_t *data, size_t len)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCAConfigShadow* shadow = atGetConfigShadow(device);
+    ATCAIface iface = atGetIFace(device);
+    size_t size;
+    uint8_t buf[ATCA_ECC_CONFIG_SIZE];
+    size_t pos = 0;
+    uint16_t addr;
+
+    if (shadow == NULL || iface == NULL)
+        return ATCA_BAD_PARAM;
+    size = atgetifacecfg(iface)->devtype == ATSHA204A ? ATCA_SHA_CONFIG_SIZE : ATCA_ECC_CONFIG_SIZE;
+    if (start + len > size)
+        return ATCA_BAD_PARAM;
+    if (start < ATCA_CONFIG_VOLATILE_END && start + len > ATCA_CONFIG_VOLATILE_START)
+        return ATCA_BAD_PARAM;
+
+    if ((status = atca_device_lock(device)) != ATCA_SUCCESS)
+        return status;
+    if (!shadow->valid)
+    {
+        // Whole blocks, then words for the short last block of SHA devices, all in one wake
+        atcab_session_begin_ctx(device);
+        while (pos < size && status == ATCA_SUCCESS)
+        {
+            uint8_t step = size - pos >= ATCA_BLOCK_SIZE ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+
+            status = atcab_get_addr(ATCA_ZONE_CONFIG, 0, (uint8_t)(pos / ATCA_BLOCK_SIZE), (uint8_t)((pos % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE), &addr);
+            if (status == ATCA_SUCCESS)
+                status = atcab_read_zone_bus(device, ATCA_ZONE_CONFIG, addr, &buf[pos], step);
+            pos += step;
+        }
+        atcab_session_end_ctx(device);
+        if (status == ATCA_SUCCESS)
+        {
+            memcpy(shadow->data, buf, size);
+            shadow->valid = true;
+            shadow->stats.fills++;
+        }
+    }
+    if (status == ATCA_SUCCESS)
+    {
+        memcpy(data, &shadow->data[start], len);
+        shadow->stats.reads_saved++;
+    }
+    atca_device_unlock(device);
+
+    return status;
+}
+
+/** \brief drop a device's config shadow, the next config read fills it again
+ *  \param[in] device  device context
+ */
+static void atca_config_shadow_drop(ATCADevice device)
+{
+    atcab_config_shadow_invalidate_ctx(device);
+}
+#endif
+
 /**
  * \brief The Write command writes either one four byte word or an 8-word block of 32 bytes to one of the EEPROM
  * zones on the device. Depending upon the value of the WriteConfig byte for this slot, the data may be required
  * to be encrypted by the system prior to being sent to the device. This command cannot be used to write slots
  * configured as ECC private keys.
  *
+ * \param[in] device  device context to run the command on
  * \param[in] zone     Zone/Param1 for the write command.
  * \param[in] address  Addres/Param2 for the write command.
  * \param[in] value    Plain-text data to be written or cipher-text for encrypted writes. 32 or 4 bytes depending
@@ -1290,11 +1438,10 @@ ATCA_STATUS atcab_is_locked(uint8_t zone, bool *is_locked)
  *
  * \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t *value, const uint8_t *mac)
+ATCA_STATUS atcab_write_ctx(ATCADevice device, uint8_t zone, uint16_t address, const uint8_t *value, const uint8_t *mac)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     if (value == NULL)
         return ATCA_BAD_PARAM;
@@ -1316,48 +1463,33 @@ ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t *value, co
         {
             // 4-byte write
             memcpy(packet.data, value, 4);
-        } if ((status = atWrite(_gCommandObj, &packet, mac && (zone & ATCA_ZONE_READWRITE_32))) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_WRITEMEM);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        } if ((status = atWrite(atGetCommands(device), &packet, mac && (zone & ATCA_ZONE_READWRITE_32))) != ATCA_SUCCESS)
             break;
-        }
 
-        status = isATCAError(packet.data);
+        status = atca_execute_command(device, &packet);
 
     }
     while (0);
 
-    _atcab_exit();
+#ifndef ATCA_NO_CONFIG_SHADOW
+    if ((zone & 0x03) == ATCA_ZONE_CONFIG)
+        atca_config_shadow_drop(device);
+#endif
+
     return status;
 }
 
+/** \brief atcab_write_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t *value, const uint8_t *mac)
+{
+    return atcab_write_ctx(_gDevice, zone, address, value, mac);
+}
+
 /** \brief Write either 4 or 32 bytes of data into a device zone.
  *
  *  See ECC108A datasheet, datazone address values, table 9-8
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] zone    Device zone to write to (0=config, 1=OTP, 2=data).
  *  \param[in] slot    If writing to the data zone, whit is the slot to write to, otherwise it should be 0.
  *  \param[in] block   32-byte block to write to.
@@ -1367,7 +1499,7 @@ ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t *value, co
  *  \param[in] len     Number of bytes to be written. Must be either 4 or 32.
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_write_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint16_t addr;
@@ -1389,7 +1521,7 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
         if (len == ATCA_BLOCK_SIZE)
             zone = zone | ATCA_ZONE_READWRITE_32;
 
-        status = atcab_write(zone, addr, data, NULL);
+        status = atcab_write_ctx(device, zone, addr, data, NULL);
 
     }
     while (0);
@@ -1397,6 +1529,12 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
     return status;
 }
 
+/** \brief atcab_write_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len)
+{
+    return atcab_write_zone_ctx(_gDevice, zone, slot, block, offset, data, len);
+}
+
 /** \brief read either 4 or 32 bytes of data into given slot
  *
  *  for 32 byte read, offset is ignored
@@ -1404,6 +1542,7 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
  *
  *  data zone must be locked and the slot configuration must not be secret for a slot to be successfully read
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] zone
  *  \param[in] slot
  *  \param[in] block
@@ -1412,77 +1551,45 @@ ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
  *  \param[in] len  Must be either 4 or 32
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+ATCA_STATUS atcab_read_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
-    ATCAPacket packet;
     uint16_t addr;
-    uint16_t execution_time = 0;
 
-    do
-    {
-        // Check the input parameters
-        if (data == NULL)
-            return ATCA_BAD_PARAM;
-
-        if (len != 4 && len != 32)
-            return ATCA_BAD_PARAM;
-
-        // The get address function checks the remaining variables
-        if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS)
-            break;
-
-        // If there are 32 bytes to write, then xor the bit into the mode
-        if (len == ATCA_BLOCK_SIZE)
-            zone = zone | ATCA_ZONE_READWRITE_32;
-
-        // build a read command
-        packet.param1 = zone;
-        packet.param2 = addr;
-
-        if ( (status = atRead(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_READMEM);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
+    // Check the input parameters
+    if (data == NULL)
+        return ATCA_BAD_PARAM;
 
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize) )) != ATCA_SUCCESS)
-            break;
+    if (len != 4 && len != 32)
+        return ATCA_BAD_PARAM;
 
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
+    // The get address function checks the remaining variables
+    if ( (status = atcab_get_addr(zone, slot, block, offset, &addr)) != ATCA_SUCCESS)
+        return status;
 
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
-            break;
+#ifndef ATCA_NO_CONFIG_SHADOW
+    if (zone == ATCA_ZONE_CONFIG)
+    {
+        size_t start = (size_t)block * ATCA_BLOCK_SIZE + (len == ATCA_WORD_SIZE ? (size_t)offset * ATCA_WORD_SIZE : 0);
 
-        memcpy(data, &packet.data[1], len);
+        if (atca_config_shadow_read(device, start, data, len) == ATCA_SUCCESS)
+            return ATCA_SUCCESS;
     }
-    while (0);
+#endif
 
-    _atcab_exit();
-    return status;
+    return atcab_read_zone_bus(device, zone, addr, data, len);
+}
+
+/** \brief atcab_read_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    return atcab_read_zone_ctx(_gDevice, zone, slot, block, offset, data, len);
 }
 
 /** \brief Read 32 bytes of data from the given slot.
  *		The function returns clear text bytes. Encrypted bytes are read over the wire, then subsequently decrypted
  *		Data zone must be locked and the slot configuration must be set to encrypted read for the block to be successfully read
+ *  \param[in] device  device context to run the command on
  *  \param[in]  key_id    The slot id for the encrypted read
  *  \param[in]  block     The block id in the specified slot
  *  \param[out] data      The 32 bytes of clear text data that was read encrypted from the slot, then decrypted
@@ -1490,7 +1597,7 @@ ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t
  *  \param[in]  enckeyid  The keyid of the parent encryption key
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
+ATCA_STATUS atcab_read_enc_ctx(ATCADevice device, uint16_t key_id, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t zone = ATCA_ZONE_DATA | ATCA_ZONE_READWRITE_32;
@@ -1503,6 +1610,7 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
     uint8_t other_data[4] = { 0 };
     int i = 0;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Verify inputs parameters
@@ -1513,13 +1621,13 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
         }
 
         // Read the device SN
-        if ((status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
+        if ((status = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
             break;
         // Make the SN continuous by moving SN[4:8] right after SN[0:3]
         memmove(&sn[4], &sn[8], 5);
 
         // Send the random Nonce command
-        if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS)
+        if ((status = atcab_nonce_rand_ctx(device, numin, randout)) != ATCA_SUCCESS)
             BREAK(status, "Nonce failed");
 
         // Calculate Tempkey
@@ -1539,7 +1647,7 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
         other_data[3] = (uint8_t)(enckeyid >> 8);
 
         // Send the GenDig command
-        if ((status = atcab_gendig(GENDIG_ZONE_DATA, enckeyid, other_data, sizeof(other_data))) != ATCA_SUCCESS)
+        if ((status = atcab_gendig_ctx(device, GENDIG_ZONE_DATA, enckeyid, other_data, sizeof(other_data))) != ATCA_SUCCESS)
             BREAK(status, "GenDig failed");
 
         // Calculate Tempkey
@@ -1557,7 +1665,7 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
             BREAK(status, "");
 
         // Read Encrypted
-        if ((status = atcab_read_zone(zone, key_id, block, 0, data, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ((status = atcab_read_zone_ctx(device, zone, key_id, block, 0, data, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             BREAK(status, "Read encrypted failed");
 
         // Decrypt
@@ -1569,13 +1677,20 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
     }
     while (0);
 
-    _atcab_exit();
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_read_enc_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
+{
+    return atcab_read_enc_ctx(_gDevice, key_id, block, data, enckey, enckeyid);
+}
+
 /** \brief Write 32 bytes of data into given slot.
  *		The function takes clear text bytes, but encrypts them for writing over the wire
  *		Data zone must be locked and the slot configuration must be set to encrypted write for the block to be successfully written
+ *  \param[in] device  device context to run the command on
  *  \param[in] key_id
  *  \param[in] block
  *  \param[in] data      The 32 bytes of clear text data to be written to the slot
@@ -1583,7 +1698,7 @@ ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t *data, const
  *  \param[in] enckeyid  The keyid of the parent encryption key
  *  returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
+ATCA_STATUS atcab_write_enc_ctx(ATCADevice device, uint16_t key_id, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t zone = ATCA_ZONE_DATA | ATCA_ZONE_READWRITE_32;
@@ -1599,6 +1714,7 @@ ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data,
     uint8_t other_data[4] = { 0 };
     uint16_t addr;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Verify inputs parameters
@@ -1609,7 +1725,7 @@ ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data,
         }
 
         // Read the device SN
-        if ((status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
+        if ((status = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
             break;
         // Make the SN continuous by moving SN[4:8] right after SN[0:3]
         memmove(&sn[4], &sn[8], 5);
@@ -1624,7 +1740,7 @@ ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data,
         nonceParam.temp_key = &tempkey;
 
         // Send the random Nonce command
-        if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS)
+        if ((status = atcab_nonce_rand_ctx(device, numin, randout)) != ATCA_SUCCESS)
             BREAK(status, "Nonce failed");
 
         // Calculate Tempkey
@@ -1638,7 +1754,7 @@ ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data,
         other_data[3] = (uint8_t)(enckeyid >> 8);
 
         // Send the GenDig command
-        if ((status = atcab_gendig(GENDIG_ZONE_DATA, enckeyid, other_data, sizeof(other_data))) != ATCA_SUCCESS)
+        if ((status = atcab_gendig_ctx(device, GENDIG_ZONE_DATA, enckeyid, other_data, sizeof(other_data))) != ATCA_SUCCESS)
             BREAK(status, "GenDig failed");
 
         // Calculate Tempkey
@@ -1670,22 +1786,31 @@ ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data,
         if ((status = atcah_write_auth_mac(&writeMacParam)) != ATCA_SUCCESS)
             BREAK(status, "Calculate Auth MAC failed");
 
-        status = atcab_write(writeMacParam.zone, writeMacParam.key_id, writeMacParam.encrypted_data, writeMacParam.auth_mac);
+        status = atcab_write_ctx(device, writeMacParam.zone, writeMacParam.key_id, writeMacParam.encrypted_data, writeMacParam.auth_mac);
 
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_write_enc_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid)
+{
+    return atcab_write_enc_ctx(_gDevice, key_id, block, data, enckey, enckeyid);
+}
+
 /** \brief given an SHA configuration zone buffer and dev type, read its parts from the device's config zone
+ *  \param[in] device  device context to run the command on
  *  \param[out] config_data pointer to buffer containing a contiguous set of bytes to write to the config zone
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
+ATCA_STATUS atcab_read_config_zone_ctx(ATCADevice device, uint8_t* config_data)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
+    atcab_session_begin_ctx(device);
     do
     {
 
@@ -1696,10 +1821,10 @@ ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
             break;
         }
 
-        if (atgetifacecfg(_gIface)->devtype == ATSHA204A)
-            status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 0x00, config_data, ATCA_SHA_CONFIG_SIZE);
+        if (atgetifacecfg(atGetIFace(device))->devtype == ATSHA204A)
+            status = atcab_read_bytes_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0x00, config_data, ATCA_SHA_CONFIG_SIZE);
         else
-            status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 0x00, config_data, ATCA_ECC_CONFIG_SIZE);
+            status = atcab_read_bytes_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0x00, config_data, ATCA_ECC_CONFIG_SIZE);
 
         if (status != ATCA_SUCCESS)
             break;
@@ -1707,9 +1832,16 @@ ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_read_config_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
+{
+    return atcab_read_config_zone_ctx(_gDevice, config_data);
+}
+
 /** \brief Writes the configuration zone skipping the lock values.
  *
  *  First 16 bytes are skipped as they are not writable. LockValue and
@@ -1719,12 +1851,13 @@ ATCA_STATUS atcab_read_config_zone(uint8_t* config_data)
  *  This command may fail if UserExtra and/or Selector bytes have
  *  already been set to non-zero values.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] config_data  Data to the config zone data. This should be 88
  *                          bytes for SHA devices and 128 bytes for ECC
  *                          devices.
  *  \returns ATCA_STATUS
  */
-ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
+ATCA_STATUS atcab_write_config_zone_ctx(ATCADevice device, const uint8_t* config_data)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     size_t config_size = 0;
@@ -1732,38 +1865,47 @@ ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
     if (config_data == NULL)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Get config zone size for the device
-        status = atcab_get_zone_size(ATCA_ZONE_CONFIG, 0, &config_size);
+        status = atcab_get_zone_size_ctx(device, ATCA_ZONE_CONFIG, 0, &config_size);
         if (status != ATCA_SUCCESS)
             break;
 
         // Write config zone excluding UserExtra and Selector
-        status = atcab_write_bytes_zone(ATCA_ZONE_CONFIG, 0, 16, &config_data[16], config_size - 16);
+        status = atcab_write_bytes_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 16, &config_data[16], config_size - 16);
         if (status != ATCA_SUCCESS)
             break;
 
         // Write the UserExtra and Selector. This may fail if either value is already non-zero.
-        status = atcab_updateextra(UPDATE_MODE_USER_EXTRA, config_data[84]);
+        status = atcab_updateextra_ctx(device, UPDATE_MODE_USER_EXTRA, config_data[84]);
         if (status != ATCA_SUCCESS)
             break;
-        status = atcab_updateextra(UPDATE_MODE_SELECTOR, config_data[85]);
+        status = atcab_updateextra_ctx(device, UPDATE_MODE_SELECTOR, config_data[85]);
         if (status != ATCA_SUCCESS)
             break;
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_write_config_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data)
+{
+    return atcab_write_config_zone_ctx(_gDevice, config_data);
+}
+
 /** \brief This function compares all writable bytes in the configuration zone that is passed in to the bytes on the device
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in]  config_data  pointer to all bytes in configuration zone. Not used if NULL.
  *  \param[out] same_config  pointer to boolean status whether config data passed in matches the actual config zone
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
+ATCA_STATUS atcab_cmp_config_zone_ctx(ATCADevice device, uint8_t* config_data, bool* same_config)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t device_config_data[ATCA_ECC_CONFIG_SIZE];   /** Max for all configs */
@@ -1781,11 +1923,11 @@ ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
         *same_config = false;
 
         // Read all of the configuration bytes from the device
-        if ((status = atcab_read_config_zone(device_config_data)) != ATCA_SUCCESS)
+        if ((status = atcab_read_config_zone_ctx(device, device_config_data)) != ATCA_SUCCESS)
             BREAK(status, "Read config zone failed");
 
         /* Get the config size of the device being tested */
-        if (ATCA_SUCCESS != (status = atcab_get_zone_size(ATCA_ZONE_CONFIG, 0, &config_size)))
+        if (ATCA_SUCCESS != (status = atcab_get_zone_size_ctx(device, ATCA_ZONE_CONFIG, 0, &config_size)))
             BREAK(status, "Failed to get config zone size");
 
         /* Compare the lower writable bytes (16-51) */
@@ -1811,22 +1953,28 @@ ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
     return status;
 }
 
+/** \brief atcab_cmp_config_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config)
+{
+    return atcab_cmp_config_zone_ctx(_gDevice, config_data, same_config);
+}
+
 /** \brief The Lock command prevents future modifications of the Configuration
  *         and/or Data and OTP zones. If the device is so configured, then
  *         this command can be used to lock individual data slots. This
  *         command fails if the designated area is already locked.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  mode           Zone, and/or slot, and summary check (bit 7).
  * \param[in]  summary_crc    CRC of the config or data zones. Ignored for
  *                            slot locks or when mode bit 7 is set.
  *
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc)
+ATCA_STATUS atcab_lock_ctx(ATCADevice device, uint8_t mode, uint16_t summary_crc)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     // build command for lock zone and send
     memset(&packet, 0, sizeof(packet));
@@ -1835,52 +1983,42 @@ ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc)
 
     do
     {
-        if ( (status = atLock(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_LOCK);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
+        if ( (status = atLock(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        //check the response for error
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
     }
     while (0);
 
-    _atcab_exit();
+#ifndef ATCA_NO_CONFIG_SHADOW
+    // Any lock changes LockValue, LockConfig or SlotLocked
+    atca_config_shadow_drop(device);
+#endif
+
     return status;
 }
 
+/** \brief atcab_lock_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc)
+{
+    return atcab_lock_ctx(_gDevice, mode, summary_crc);
+}
+
 /** \brief Unconditionally (no CRC required) lock the config zone.
  *
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_lock_config_zone_ctx(ATCADevice device)
+{
+    return atcab_lock_ctx(device, LOCK_ZONE_NO_CRC | LOCK_ZONE_CONFIG, 0);
+}
+
+/** \brief atcab_lock_config_zone_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_lock_config_zone(void)
 {
-    return atcab_lock(LOCK_ZONE_NO_CRC | LOCK_ZONE_CONFIG, 0);
+    return atcab_lock_config_zone_ctx(_gDevice);
 }
 
 /** \brief Lock the config zone with summary CRC.
@@ -1889,24 +2027,38 @@ ATCA_STATUS atcab_lock_config_zone(void)
  *  ATSHA devices, 128 bytes for ATECC devices. Lock will fail if the provided
  *  CRC doesn't match the internally calculated one.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] crc  Expected CRC over the config zone.
  *
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_lock_config_zone_crc_ctx(ATCADevice device, uint16_t crc)
+{
+    return atcab_lock_ctx(device, LOCK_ZONE_CONFIG, crc);
+}
+
+/** \brief atcab_lock_config_zone_crc_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_lock_config_zone_crc(uint16_t crc)
 {
-    return atcab_lock(LOCK_ZONE_CONFIG, crc);
+    return atcab_lock_config_zone_crc_ctx(_gDevice, crc);
 }
 
 /** \brief Unconditionally (no CRC required) lock the data zone (slots and OTP).
  *
  *	ConfigZone must be locked and DataZone must be unlocked for the zone to be successfully locked.
  *
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_lock_data_zone_ctx(ATCADevice device)
+{
+    return atcab_lock_ctx(device, LOCK_ZONE_NO_CRC | LOCK_ZONE_DATA, 0);
+}
+
+/** \brief atcab_lock_data_zone_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_lock_data_zone(void)
 {
-    return atcab_lock(LOCK_ZONE_NO_CRC | LOCK_ZONE_DATA, 0);
+    return atcab_lock_data_zone_ctx(_gDevice);
 }
 
 /** \brief Lock the data zone (slots and OTP) with summary CRC.
@@ -1915,32 +2067,47 @@ ATCA_STATUS atcab_lock_data_zone(void)
  *  OTP at the end. Private keys (KeyConfig.Private=1) are skipped. Lock will
  *  fail if the provided CRC doesn't match the internally calculated one.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] crc  Expected CRC over the data zone.
  *
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_lock_data_zone_crc_ctx(ATCADevice device, uint16_t crc)
+{
+    return atcab_lock_ctx(device, LOCK_ZONE_DATA, crc);
+}
+
+/** \brief atcab_lock_data_zone_crc_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_lock_data_zone_crc(uint16_t crc)
 {
-    return atcab_lock(LOCK_ZONE_DATA, crc);
+    return atcab_lock_data_zone_crc_ctx(_gDevice, crc);
 }
 
 /** \brief Lock an individual slot in the data zone on an ATECC device. Not
  *         available for ATSHA devices. Slot must be configured to be slot
  *         lockable (KeyConfig.Lockable=1).
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] slot  Slot to be locked in data zone.
  *
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_lock_data_slot_ctx(ATCADevice device, uint8_t slot)
+{
+    return atcab_lock_ctx(device, (slot << 2) | LOCK_ZONE_DATA_SLOT, 0);
+}
+
+/** \brief atcab_lock_data_slot_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_lock_data_slot(uint8_t slot)
 {
-    return atcab_lock((slot << 2) | LOCK_ZONE_DATA_SLOT, 0);
+    return atcab_lock_data_slot_ctx(_gDevice, slot);
 }
 
 /** \brief The Sign command generates a signature using the ECDSA algorithm.
  *
  * For external messages, it must be loaded into TempKey.
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  mode       Bit mask indicating signing mode.
  *                          Bit 0: 1 for Verify(Invalidate),
  *                            0 for Verify(Validate) and all others
@@ -1956,54 +2123,26 @@ ATCA_STATUS atcab_lock_data_slot(uint8_t slot)
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t *signature)
+ATCA_STATUS atcab_sign_base_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *signature)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     if (signature == NULL)
         return ATCA_BAD_PARAM;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
 
     do
     {
         // Build sign command
         packet.param1 = mode;
-        packet.param2 = key_id;
-        if ((status = atSign(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_SIGN);
-
-        if ((status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        packet.param2 = key_id;
+        if ((status = atSign(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        // check for response
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if (packet.data[ATCA_COUNT_IDX] > 4)
@@ -2011,12 +2150,18 @@ ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t *signature)
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_sign_base_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t *signature)
+{
+    return atcab_sign_base_ctx(_gDevice, mode, key_id, signature);
+}
+
 /** \brief Sign a 32-byte message using the private key in the specified slot
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in]  key_id     Slot of the private key to be used to sign the
  *                           message.
  *  \param[in]  msg        32-byte message to be signed. Typically the
@@ -2027,29 +2172,38 @@ ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t *signature)
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t *msg, uint8_t *signature)
+ATCA_STATUS atcab_sign_ctx(ATCADevice device, uint16_t key_id, const uint8_t *msg, uint8_t *signature)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Make sure RNG has updated its seed
-        if ( (status = atcab_random(NULL)) != ATCA_SUCCESS)
+        if ( (status = atcab_random_ctx(device, NULL)) != ATCA_SUCCESS)
             break;
         // Load message into TempKey
-        if ( (status = atcab_challenge(msg)) != ATCA_SUCCESS)
+        if ( (status = atcab_challenge_ctx(device, msg)) != ATCA_SUCCESS)
             break;
         // Sign the message
-        if ( (status = atcab_sign_base(SIGN_MODE_EXTERNAL, key_id, signature)) != ATCA_SUCCESS)
+        if ( (status = atcab_sign_base_ctx(device, SIGN_MODE_EXTERNAL, key_id, signature)) != ATCA_SUCCESS)
             break;
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_sign_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t *msg, uint8_t *signature)
+{
+    return atcab_sign_ctx(_gDevice, key_id, msg, signature);
+}
+
 /** \brief Sign an internally generated message.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in]  key_id         Slot of the private key to be used to sign the
  *                               message.
  *  \param[in]  is_invalidate  Set to true if the signature will be used with
@@ -2063,7 +2217,7 @@ ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t *msg, uint8_t *signature)
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t *signature)
+ATCA_STATUS atcab_sign_internal_ctx(ATCADevice device, uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t *signature)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t mode = SIGN_MODE_INTERNAL;
@@ -2075,7 +2229,7 @@ ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_ful
             mode |= SIGN_MODE_INVALIDATE;
         if (is_full_sn)
             mode |= SIGN_MODE_INCLUDE_SN;
-        if ((status = atcab_sign_base(mode, key_id, signature)) != ATCA_SUCCESS)
+        if ((status = atcab_sign_base_ctx(device, mode, key_id, signature)) != ATCA_SUCCESS)
             break;
     }
     while (0);
@@ -2083,9 +2237,16 @@ ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_ful
     return status;
 }
 
+/** \brief atcab_sign_internal_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t *signature)
+{
+    return atcab_sign_internal_ctx(_gDevice, key_id, is_invalidate, is_full_sn, signature);
+}
+
 /** \brief Issues a GenDig command, which performs a SHA256 hash on the source data indicated by zone with the
  *  contents of TempKey.  See the CryptoAuth datasheet for your chip to see what the values of zone
  *  correspond to.
+ *  \param[in] device  device context to run the command on
  *  \param[in] zone             Designates the source of the data to hash with TempKey.
  *  \param[in] key_id           Indicates the key, OTP block, or message order for shared nonce mode.
  *  \param[in] other_data       Four bytes of data for SHA calculation when using a NoMac key, 32 bytes for
@@ -2093,14 +2254,13 @@ ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_ful
  *  \param[in] other_data_size  Size of other_data in bytes.
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id, const uint8_t *other_data, uint8_t other_data_size)
+ATCA_STATUS atcab_gendig_ctx(ATCADevice device, uint8_t zone, uint16_t key_id, const uint8_t *other_data, uint8_t other_data_size)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
     bool hasMACKey = 0;
 
-    if (!_gDevice)
+    if (!device)
         return ATCA_GEN_FAIL;
     if (other_data_size > 0 && other_data == NULL)
         return ATCA_BAD_PARAM;
@@ -2122,52 +2282,31 @@ ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id, const uint8_t *other_dat
             hasMACKey = true;
         }
 
-        if ( (status = atGenDig(_gCommandObj, &packet, hasMACKey)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_GENDIG);
-
-        if ( (status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ( (status = atGenDig(atGetCommands(device), &packet, hasMACKey)) != ATCA_SUCCESS)
             break;
-        }
 
-        // check for response
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_gendig_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id, const uint8_t *other_data, uint8_t other_data_size)
+{
+    return atcab_gendig_ctx(_gDevice, zone, key_id, other_data, other_data_size);
+}
+
 /** \brief reads a signature found in one of slots 8 through F.
+ *  \param[in] device  device context to run the command on
  *  \param[in] slot8toF - which slot to read
  *  \param[out] sig - pointer to the space to receive the signature found in the slot
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
+ATCA_STATUS atcab_read_sig_ctx(ATCADevice device, uint8_t slot8toF, uint8_t *sig)
 {
     ATCA_STATUS ret = ATCA_GEN_FAIL;
     uint8_t read_buf[ATCA_BLOCK_SIZE];
@@ -2175,6 +2314,7 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
     uint8_t offset = 0;
     uint8_t cpyIndex = 0;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Check the pointers
@@ -2187,7 +2327,7 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
 
         // Read the first block
         block = 0;
-        if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Copy.  first 32 bytes
@@ -2196,7 +2336,7 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
 
         // Read the second block
         block = 1;
-        if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Copy.  next 32 bytes
@@ -2206,28 +2346,43 @@ ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return ret;
 }
 
+/** \brief atcab_read_sig_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_sig(uint8_t slot8toF, uint8_t *sig)
+{
+    return atcab_read_sig_ctx(_gDevice, slot8toF, sig);
+}
+
 /** \brief returns a public key found in a designated slot.  The slot must be configured as a slot with a private key.
  *  This method will use GenKey to generate the corresponding public key from the private key in the given slot.
+ *  \param[in] device  device context to run the command on
  *  \param[in] key_id ID of the private key slot
  *  \param[out] public_key - pointer to space receiving the contents of the public key that was generated
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_get_pubkey_ctx(ATCADevice device, uint16_t key_id, uint8_t *public_key)
+{
+    return atcab_genkey_base_ctx(device, GENKEY_MODE_PUBLIC, key_id, NULL, public_key);
+}
+
+/** \brief atcab_get_pubkey_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_get_pubkey(uint16_t key_id, uint8_t *public_key)
 {
-    return atcab_genkey_base(GENKEY_MODE_PUBLIC, key_id, NULL, public_key);
+    return atcab_get_pubkey_ctx(_gDevice, key_id, public_key);
 }
 
 /** \brief write a P256 private key in given slot using mac computation
+ *  \param[in] device  device context to run the command on
  *  \param[in] key_id
  *  \param[in] priv_key first 4 bytes of 36 bytes should be zero for P256 curve
  *  \param[in] write_key_slot slot to make a session key
  *  \param[in] write_key key to make a session key
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
+ATCA_STATUS atcab_priv_write_ctx(ATCADevice device, uint16_t key_id, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
@@ -2241,11 +2396,11 @@ ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_
     uint8_t cipher_text[36] = { 0 };
     uint8_t host_mac[MAC_SIZE] = { 0 };
     uint8_t other_data[4] = { 0 };
-    uint16_t execution_time = 0;
 
     if (key_id > 15 || priv_key == NULL)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
 
@@ -2261,13 +2416,13 @@ ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_
         else
         {
             // Read the device SN
-            if ((status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
+            if ((status = atcab_read_zone_ctx(device, ATCA_ZONE_CONFIG, 0, 0, 0, sn, 32)) != ATCA_SUCCESS)
                 break;
             // Make the SN continuous by moving SN[4:8] right after SN[0:3]
             memmove(&sn[4], &sn[8], 5);
 
             // Send the random Nonce command
-            if ((status = atcab_nonce_rand(numin, randout)) != ATCA_SUCCESS)
+            if ((status = atcab_nonce_rand_ctx(device, numin, randout)) != ATCA_SUCCESS)
                 break;
 
             // Calculate Tempkey
@@ -2287,7 +2442,7 @@ ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_
             other_data[3] = (uint8_t)(write_key_slot >> 8);
 
             // Send the GenDig command
-            if ((status = atcab_gendig(GENDIG_ZONE_DATA, write_key_slot, other_data, sizeof(other_data))) != ATCA_SUCCESS)
+            if ((status = atcab_gendig_ctx(device, GENDIG_ZONE_DATA, write_key_slot, other_data, sizeof(other_data))) != ATCA_SUCCESS)
                 break;
 
             // Calculate Tempkey
@@ -2322,51 +2477,32 @@ ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_
             memcpy(&packet.data[sizeof(cipher_text)], host_mac, sizeof(host_mac));
         }
 
-        if ((status = atPrivWrite(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_PRIVWRITE);
-
-        if ( (status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &packet.rxsize)) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ((status = atPrivWrite(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
     }
     while (0);
 
-    _atcab_exit();
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_priv_write_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32])
+{
+    return atcab_priv_write_ctx(_gDevice, key_id, priv_key, write_key_slot, write_key);
+}
+
 /** \brief Writes a pub key from to a data slot
+ *  \param[in] device  device context to run the command on
  *  \param[in] slot8toF Slot number to write, expected value is 0x8 through 0xF
  *  \param[out] pubkey The public key to write into the slot specified
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
+ATCA_STATUS atcab_write_pubkey_ctx(ATCADevice device, uint16_t slot8toF, const uint8_t *pubkey)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     uint8_t write_block[ATCA_BLOCK_SIZE];
@@ -2376,6 +2512,7 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
     uint8_t cpySize = 0;
     uint8_t writeIndex = 0;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // Check the pointers
@@ -2402,7 +2539,7 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
         memcpy(&write_block[writeIndex], &pubkey[cpyIndex], cpySize);
         cpyIndex += cpySize;
         // Write the first block
-        status = atcab_write_zone(ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
+        status = atcab_write_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
         if (status != ATCA_SUCCESS)
             break;
 
@@ -2420,7 +2557,7 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
         memcpy(&write_block[writeIndex], &pubkey[cpyIndex], cpySize);
         cpyIndex += cpySize;
         // Write the second block
-        status = atcab_write_zone(ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
+        status = atcab_write_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
         if (status != ATCA_SUCCESS)
             break;
 
@@ -2432,22 +2569,30 @@ ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
         cpySize = ATCA_PUB_KEY_PAD + ATCA_PUB_KEY_PAD;
         memcpy(&write_block[writeIndex], &pubkey[cpyIndex], cpySize);
         // Write the third block
-        status = atcab_write_zone(ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
+        status = atcab_write_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, write_block, ATCA_BLOCK_SIZE);
         if (status != ATCA_SUCCESS)
             break;
 
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_write_pubkey_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write_pubkey(uint16_t slot8toF, const uint8_t *pubkey)
+{
+    return atcab_write_pubkey_ctx(_gDevice, slot8toF, pubkey);
+}
+
 /** \brief reads a pub key from a readable data slot versus atcab_get_pubkey which generates a pubkey from a private key slot
+ *  \param[in] device  device context to run the command on
  *  \param[in] slot8toF - slot number to read, expected value is 0x8 through 0xF
  *  \param[out] pubkey - space to receive read pubkey
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
+ATCA_STATUS atcab_read_pubkey_ctx(ATCADevice device, uint16_t slot8toF, uint8_t *pubkey)
 {
     ATCA_STATUS ret = ATCA_GEN_FAIL;
     uint8_t read_buf[ATCA_BLOCK_SIZE];
@@ -2464,6 +2609,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
     if (slot8toF < 8 || slot8toF > 0xF)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
         // The 64 byte P256 public key gets written to a 72 byte slot in the following pattern
@@ -2472,7 +2618,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
 
         // Read the block
         block = 0;
-        if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Copy.  Account for 4 byte pad
@@ -2483,7 +2629,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
 
         // Read the next block
         block = 1;
-        if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Copy.  First four bytes
@@ -2499,7 +2645,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
 
         // Read the next block
         block = 2;
-        if ( (ret = atcab_read_zone(ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
+        if ( (ret = atcab_read_zone_ctx(device, ATCA_ZONE_DATA, slot8toF, block, offset, read_buf, ATCA_BLOCK_SIZE)) != ATCA_SUCCESS)
             break;
 
         // Copy.  The remaining 8 bytes
@@ -2510,9 +2656,16 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
     }
     while (0);
 
+    atcab_session_end_ctx(device);
     return ret;
 }
 
+/** \brief atcab_read_pubkey_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
+{
+    return atcab_read_pubkey_ctx(_gDevice, slot8toF, pubkey);
+}
+
 /** \brief Write data into config, otp, or data zone with a given byte offset
  *         and length. Offset and length must be multiples of a word (4 bytes).
  *
@@ -2520,6 +2673,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
  * unlocked, only 32-byte writes are allowed to slots and OTP and the offset
  * and length must be multiples of 32 or the write will fail.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] zone          Zone to write data to: ATCA_ZONE_CONFIG(0),
  *                           ATCA_ZONE_OTP(1), or ATCA_ZONE_DATA(2).
  *  \param[in] slot          If zone is ATCA_ZONE_DATA(2), the slot number to
@@ -2532,7 +2686,7 @@ ATCA_STATUS atcab_read_pubkey(uint16_t slot8toF, uint8_t *pubkey)
  *
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t *data, size_t length)
+ATCA_STATUS atcab_write_bytes_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t *data, size_t length)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     size_t zone_size = 0;
@@ -2551,13 +2705,17 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
     if (offset_bytes % ATCA_WORD_SIZE != 0 || length % ATCA_WORD_SIZE != 0)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
-        status = atcab_get_zone_size(zone, slot, &zone_size);
+        status = atcab_get_zone_size_ctx(device, zone, slot, &zone_size);
         if (status != ATCA_SUCCESS)
             break;
         if (offset_bytes + length > zone_size)
-            return ATCA_BAD_PARAM;
+        {
+            status = ATCA_BAD_PARAM;
+            break;
+        }
 
         cur_block = offset_bytes / ATCA_BLOCK_SIZE;
         cur_word = (offset_bytes % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE;
@@ -2567,7 +2725,7 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
             // The last item makes sure we handle the selector, user extra, and lock bytes in the config properly
             if (cur_word == 0 && length - data_idx >= ATCA_BLOCK_SIZE && !(zone == ATCA_ZONE_CONFIG && cur_block == 2))
             {
-                status = atcab_write_zone(zone, slot, (uint8_t)cur_block, 0, &data[data_idx], ATCA_BLOCK_SIZE);
+                status = atcab_write_zone_ctx(device, zone, slot, (uint8_t)cur_block, 0, &data[data_idx], ATCA_BLOCK_SIZE);
                 if (status != ATCA_SUCCESS)
                     break;
                 data_idx += ATCA_BLOCK_SIZE;
@@ -2578,7 +2736,7 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
                 // Skip trying to change UserExtra, Selector, LockValue, and LockConfig which require special values
                 if (!(zone == ATCA_ZONE_CONFIG && cur_block == 2 && cur_word == 5))
                 {
-                    status = atcab_write_zone(zone, slot, (uint8_t)cur_block, (uint8_t)cur_word, &data[data_idx], ATCA_WORD_SIZE);
+                    status = atcab_write_zone_ctx(device, zone, slot, (uint8_t)cur_block, (uint8_t)cur_word, &data[data_idx], ATCA_WORD_SIZE);
                     if (status != ATCA_SUCCESS)
                         break;
                 }
@@ -2594,12 +2752,20 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
     }
     while (false);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_write_bytes_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t *data, size_t length)
+{
+    return atcab_write_bytes_zone_ctx(_gDevice, zone, slot, offset_bytes, data, length);
+}
+
 /** \brief Read data from config, otp, or data zone with a given byte offset
  *         and length.
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in]  zone          Zone to read data from: Config(0), OTP(1), or
  *                            Data(2).
  *  \param[in]  slot          If zone is Data(2), the slot number to read from.
@@ -2610,7 +2776,7 @@ ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_by
  *
  *  \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, uint8_t *data, size_t length)
+ATCA_STATUS atcab_read_bytes_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, uint8_t *data, size_t length)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     size_t zone_size = 0;
@@ -2632,13 +2798,17 @@ ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_byt
     if (data == NULL)
         return ATCA_BAD_PARAM;
 
+    atcab_session_begin_ctx(device);
     do
     {
-        status = atcab_get_zone_size(zone, slot, &zone_size);
+        status = atcab_get_zone_size_ctx(device, zone, slot, &zone_size);
         if (status != ATCA_SUCCESS)
             break;
         if (offset_bytes + length > zone_size)
-            return ATCA_BAD_PARAM;
+        {
+            status = ATCA_BAD_PARAM;
+            break;
+        }
 
         cur_block = offset_bytes / ATCA_BLOCK_SIZE;
 
@@ -2651,7 +2821,7 @@ ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_byt
                 cur_offset = ((data_idx + offset_bytes) / ATCA_WORD_SIZE) % (ATCA_BLOCK_SIZE / ATCA_WORD_SIZE);
             }
 
-            status = atcab_read_zone(
+            status = atcab_read_zone_ctx(device, 
                 zone,
                 slot,
                 (uint8_t)cur_block,
@@ -2682,22 +2852,29 @@ ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_byt
     }
     while (false);
 
+    atcab_session_end_ctx(device);
     return status;
 }
 
+/** \brief atcab_read_bytes_zone_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, uint8_t *data, size_t length)
+{
+    return atcab_read_bytes_zone_ctx(_gDevice, zone, slot, offset_bytes, data, length);
+}
+
 
 /** \brief Get a 32 byte MAC from the CryptoAuth device given a key ID and a challenge
+ *	\param[in] device  device context to run the command on
  *	\param[in]  mode       Controls which fields within the device are used in the message
  *	\param[in]  key_id     The key in the CryptoAuth device to use for the MAC
  *	\param[in]  challenge  The 32 byte challenge number
  *	\param[out] digest     The response of the MAC command using the given challenge
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest)
+ATCA_STATUS atcab_mac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -2719,37 +2896,10 @@ ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, u
             memcpy(&packet.data[0], challenge, 32);  // a 32-byte challenge
         }
 
-        if ( (status = atMAC(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_MAC);
-
-        if ( (status != atcab_wakeup()) != ATCA_SUCCESS)
+        if ( (status = atMAC(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        // check for response
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         memcpy(digest, &packet.data[ATCA_RSP_DATA_IDX], MAC_SIZE);
@@ -2757,11 +2907,17 @@ ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, u
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_mac_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest)
+{
+    return atcab_mac_ctx(_gDevice, mode, key_id, challenge, digest);
+}
+
 /** \brief Compares a MAC response with input values
+ *	\param[in] device  device context to run the command on
  *	\param[in] mode Controls which fields within the device are used in the message
  *	\param[in] key_id The key in the CryptoAuth device to use for the MAC
  *	\param[in] challenge The 32 byte challenge number
@@ -2769,11 +2925,10 @@ ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, u
  *	\param[in] other_data The 13 byte other data number
  *  \return ATCA_STATUS
  */
-ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
+ATCA_STATUS atcab_checkmac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     // Verify the inputs
     if (response == NULL || other_data == NULL)
@@ -2793,51 +2948,30 @@ ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t *challen
         memcpy(&packet.data[32], response, CHECKMAC_CLIENT_RESPONSE_SIZE);
         memcpy(&packet.data[64], other_data, CHECKMAC_OTHER_DATA_SIZE);
 
-        if ( (status = atCheckMAC(_gCommandObj, &packet)) != ATCA_SUCCESS)
+        if ( (status = atCheckMAC(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
 
-        execution_time = atGetExecTime(_gCommandObj, CMD_CHECKMAC);
-
-        if ( (status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
-            break;
-        }
-
-        // check for response
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_checkmac_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data)
+{
+    return atcab_checkmac_ctx(_gDevice, mode, key_id, challenge, response, other_data);
+}
+
 /** \brief The HMAC command computes an HMAC/SHA-256 digest of a key stored in the device, a challenge, and other
  *         information on the device.
  * The output of this command is the output of the HMAC algorithm computed over this
  * key and message. If the message includes the serial number of the device, the response is said to be
  * "diversified".
  *
+ * \param[in] device  device context to run the command on
  * \param[in]  mode    Controls which fields within the device are used in the message.
  * \param[in]  key_id  Which key is to be used to generate the response.
  *                     Bits 0:3 only are used to select a slot but all 16 bits are used in the HMAC message.
@@ -2845,11 +2979,10 @@ ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t *challen
  *
  * \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t *digest)
+ATCA_STATUS atcab_hmac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *digest)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -2862,37 +2995,10 @@ ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t *digest)
         packet.param1 = mode;
         packet.param2 = key_id;
 
-        if ( (status = atHMAC(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_DERIVEKEY);
-
-        if ( (status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ( (status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ( (status = atHMAC(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        // check for response
-        if ( (status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if (packet.rxsize != HMAC_DIGEST_SIZE + 3)
@@ -2906,23 +3012,28 @@ ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t *digest)
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_hmac_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t *digest)
+{
+    return atcab_hmac_ctx(_gDevice, mode, key_id, digest);
+}
+
 /** \brief Send a DeriveKey Command to the device
  *
+ *  \param[in] device  device context to run the command on
  *  \param[in] mode        Bit 2 must match the value in TempKey.SourceFlag
  *  \param[in] target_key  Key slot to be written
  *  \param[in] mac         Optional 32 byte MAC used to validate operation. NULL if not required.
  *
  *  \return ATCA_SUCCESS
  */
-ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t target_key, uint8_t* mac)
+ATCA_STATUS atcab_derivekey_ctx(ATCADevice device, uint8_t mode, uint16_t target_key, uint8_t* mac)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -2933,45 +3044,24 @@ ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t target_key, uint8_t* mac)
         if (mac != NULL)
             memcpy(packet.data, mac, 32);
 
-        if ((status = atDeriveKey(_gCommandObj, &packet, mac != NULL)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_DERIVEKEY);
-
-        if ((status = atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ((status = atDeriveKey(atGetCommands(device), &packet, mac != NULL)) != ATCA_SUCCESS)
             break;
-        }
 
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_derivekey_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t target_key, uint8_t* mac)
+{
+    return atcab_derivekey_ctx(_gDevice, mode, target_key, mac);
+}
+
 /** \brief The SHA command computes a SHA-256 digest for general purpose use
  *         by the system. Any message length can be accommodated. The system
  *         is responsible for sending the pad and length bytes with the last
@@ -2979,6 +3069,7 @@ ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t target_key, uint8_t* mac)
  *
  * Only the Start(0) and Compute(1) modes are available for ATSHA devices.
  *
+ * \param[in] device  device context to run the command on
  * \param[in] mode     SHA command mode: Start(0), Update/Compute(1), End(2),
  *                       Public(3), HMACstart(4), MHACend(5)
  * \param[in] length   Number of bytes in the Message parameter. Must be 0 for
@@ -2992,11 +3083,10 @@ ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t target_key, uint8_t* mac)
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* message, uint8_t* digest)
+ATCA_STATUS atcab_sha_base_ctx(ATCADevice device, uint8_t mode, uint16_t length, const uint8_t* message, uint8_t* digest)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     if (length > 0 && message == NULL)
         return ATCA_BAD_PARAM;
@@ -3010,37 +3100,10 @@ ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* message
         packet.param2 = length;
         memcpy(packet.data, message, length);
 
-        if ( (status = atSHA(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_SHA);
-
-        if ((status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ( (status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ( (status = atSHA(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        // check for response
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
 
         if (packet.rxsize != 4)
@@ -3058,47 +3121,80 @@ ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* message
     }
     while (0);
 
-    _atcab_exit();
     return status;
 }
 
+/** \brief atcab_sha_base_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* message, uint8_t* digest)
+{
+    return atcab_sha_base_ctx(_gDevice, mode, length, message, digest);
+}
+
 /** \brief Initialize SHA-256 calculation engine
+ *  \param[in] device  device context to run the command on
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_sha_start_ctx(ATCADevice device)
+{
+    return atcab_sha_base_ctx(device, SHA_MODE_SHA256_START, 0, NULL, NULL);
+}
+
+/** \brief atcab_sha_start_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_sha_start(void)
 {
-    return atcab_sha_base(SHA_MODE_SHA256_START, 0, NULL, NULL);
+    return atcab_sha_start_ctx(_gDevice);
 }
 
 /** \brief Adds the message to be digested
+ *	\param[in] device  device context to run the command on
  *	\param[in] message  Add 64 bytes in the message parameter to the SHA context
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_sha_update_ctx(ATCADevice device, const uint8_t *message)
+{
+    return atcab_sha_base_ctx(device, SHA_MODE_SHA256_UPDATE, 64, message, NULL);
+}
+
+/** \brief atcab_sha_update_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_sha_update(const uint8_t *message)
 {
-    return atcab_sha_base(SHA_MODE_SHA256_UPDATE, 64, message, NULL);
+    return atcab_sha_update_ctx(_gDevice, message);
 }
 
 /** \brief The SHA-256 calculation is complete
+ *	\param[in] device  device context to run the command on
  *	\param[out] digest   The SHA256 digest that is calculated
  *  \param[in]  length   Length of any remaining data to include in hash. Max 64 bytes.
  *  \param[in]  message  Remaining data to include in hash. NULL if length is 0.
  *  \return ATCA_SUCCESS on success
  */
+ATCA_STATUS atcab_sha_end_ctx(ATCADevice device, uint8_t *digest, uint16_t length, const uint8_t *message)
+{
+    return atcab_sha_base_ctx(device, SHA_MODE_SHA256_END, length, message, digest);
+}
+
+/** \brief atcab_sha_end_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_sha_end(uint8_t *digest, uint16_t length, const uint8_t *message)
 {
-    return atcab_sha_base(SHA_MODE_SHA256_END, length, message, digest);
+    return atcab_sha_end_ctx(_gDevice, digest, length, message);
 }
 
 /** \brief Computes a SHA-256 digest
+ *	\param[in] device  device context to run the command on
  *	\param[in] length The number of bytes in the message parameter
  *	\param[in] message - pointer to variable length message
  *	\param[out] digest The SHA256 digest
  *  \return ATCA_STATUS
  */
+ATCA_STATUS atcab_sha_ctx(ATCADevice device, uint16_t length, const uint8_t *message, uint8_t *digest)
+{
+    return atcab_hw_sha2_256_ctx(device, message, length, digest);
+}
+
+/** \brief atcab_sha_ctx() on the default device, see atcab_init() */
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t *message, uint8_t *digest)
 {
-    return atcab_hw_sha2_256(message, length, digest);
+    return atcab_sha_ctx(_gDevice, length, message, digest);
 }
 
 typedef struct
@@ -3108,13 +3204,19 @@ typedef struct
     uint8_t  block[ ATCA_SHA256_BLOCK_SIZE * 2]; //!< Unprocessed message storage
 } hw_sha256_ctx;
 
-ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx)
+ATCA_STATUS atcab_hw_sha2_256_init_ctx(ATCADevice device, atca_sha256_ctx_t* ctx)
 {
     memset(ctx, 0, sizeof(*ctx));
-    return atcab_sha_start();
+    return atcab_sha_start_ctx(device);
 }
 
-ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+/** \brief atcab_hw_sha2_256_init_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx)
+{
+    return atcab_hw_sha2_256_init_ctx(_gDevice, ctx);
+}
+
+ATCA_STATUS atcab_hw_sha2_256_update_ctx(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     uint32_t block_count;
@@ -3133,7 +3235,7 @@ ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data
     }
 
     // Process the current block
-    status = atcab_sha_update(ctx->block);
+    status = atcab_sha_update_ctx(device, ctx->block);
     if (status != ATCA_SUCCESS)
         return status;
 
@@ -3142,7 +3244,7 @@ ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data
     block_count = data_size / ATCA_SHA256_BLOCK_SIZE;
     for (i = 0; i < block_count; i++)
     {
-        status = atcab_sha_update(&data[copy_size + i * ATCA_SHA256_BLOCK_SIZE]);
+        status = atcab_sha_update_ctx(device, &data[copy_size + i * ATCA_SHA256_BLOCK_SIZE]);
         if (status != ATCA_SUCCESS)
             return status;
     }
@@ -3155,13 +3257,19 @@ ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data
     return ATCA_SUCCESS;
 }
 
-ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t * ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
+/** \brief atcab_hw_sha2_256_update_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size)
+{
+    return atcab_hw_sha2_256_update_ctx(_gDevice, ctx, data, data_size);
+}
+
+ATCA_STATUS atcab_hw_sha2_256_finish_ctx(ATCADevice device, atca_sha256_ctx_t * ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     uint32_t msg_size_bits;
     uint32_t pad_zero_count;
 
-    if (atgetifacecfg(_gIface)->devtype == ATSHA204A)
+    if (atgetifacecfg(atGetIFace(device))->devtype == ATSHA204A)
     {
         // Calculate the total message size in bits
         ctx->total_msg_size += ctx->block_size;
@@ -3184,19 +3292,19 @@ ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t * ctx, uint8_t digest[ATC
         ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 8);
         ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 0);
 
-        status = atcab_sha_base(SHA_MODE_SHA256_UPDATE, ATCA_SHA256_BLOCK_SIZE, ctx->block, digest);
+        status = atcab_sha_base_ctx(device, SHA_MODE_SHA256_UPDATE, ATCA_SHA256_BLOCK_SIZE, ctx->block, digest);
         if (status != ATCA_SUCCESS)
             return status;
         if (ctx->block_size > ATCA_SHA256_BLOCK_SIZE)
         {
-            status = atcab_sha_base(SHA_MODE_SHA256_UPDATE, ATCA_SHA256_BLOCK_SIZE, &ctx->block[ATCA_SHA256_BLOCK_SIZE], digest);
+            status = atcab_sha_base_ctx(device, SHA_MODE_SHA256_UPDATE, ATCA_SHA256_BLOCK_SIZE, &ctx->block[ATCA_SHA256_BLOCK_SIZE], digest);
             if (status != ATCA_SUCCESS)
                 return status;
         }
     }
     else
     {
-        status = atcab_sha_end(digest, ctx->block_size, ctx->block);
+        status = atcab_sha_end_ctx(device, digest, ctx->block_size, ctx->block);
         if (status != ATCA_SUCCESS)
             return status;
     }
@@ -3204,24 +3312,41 @@ ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t * ctx, uint8_t digest[ATC
     return ATCA_SUCCESS;
 }
 
-ATCA_STATUS atcab_hw_sha2_256(const uint8_t * data, size_t data_size, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
+/** \brief atcab_hw_sha2_256_finish_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t * ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
+{
+    return atcab_hw_sha2_256_finish_ctx(_gDevice, ctx, digest);
+}
+
+ATCA_STATUS atcab_hw_sha2_256_ctx(ATCADevice device, const uint8_t * data, size_t data_size, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     atca_sha256_ctx_t ctx;
 
-    status = atcab_hw_sha2_256_init(&ctx);
-    if (status != ATCA_SUCCESS)
-        return status;
+    // the device holds the digest state between commands, keep other threads off it
+    atcab_session_begin_ctx(device);
+    do
+    {
+        status = atcab_hw_sha2_256_init_ctx(device, &ctx);
+        if (status != ATCA_SUCCESS)
+            break;
 
-    status = atcab_hw_sha2_256_update(&ctx, data, data_size);
-    if (status != ATCA_SUCCESS)
-        return status;
+        status = atcab_hw_sha2_256_update_ctx(device, &ctx, data, data_size);
+        if (status != ATCA_SUCCESS)
+            break;
 
-    status = atcab_hw_sha2_256_finish(&ctx, digest);
-    if (status != ATCA_SUCCESS)
-        return status;
+        status = atcab_hw_sha2_256_finish_ctx(device, &ctx, digest);
+    }
+    while (0);
+    atcab_session_end_ctx(device);
 
-    return ATCA_SUCCESS;
+    return status;
+}
+
+/** \brief atcab_hw_sha2_256_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_hw_sha2_256(const uint8_t * data, size_t data_size, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
+{
+    return atcab_hw_sha2_256_ctx(_gDevice, data, data_size, digest);
 }
 
 /** \brief The UpdateExtra command is used to update the values of the two
@@ -3230,6 +3355,7 @@ ATCA_STATUS atcab_hw_sha2_256(const uint8_t * data, size_t data_size, uint8_t di
  * Can also be used to decrement the limited use counter associated with the
  * key in slot NewValue.
  *
+ * \param[in] device  device context to run the command on
  * \param[in] mode       Bit 0: 0 = update user extra (config[84]),
  *                              1 = update selector (config[85])
  *                       Bit 1: Ignores bit 0 and decrements the limited use
@@ -3239,11 +3365,10 @@ ATCA_STATUS atcab_hw_sha2_256(const uint8_t * data, size_t data_size, uint8_t di
  *
  * \return ATCA_SUCCESS on success
  */
-ATCA_STATUS atcab_updateextra(uint8_t mode, uint16_t new_value)
+ATCA_STATUS atcab_updateextra_ctx(ATCADevice device, uint8_t mode, uint16_t new_value)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     ATCAPacket packet;
-    uint16_t execution_time = 0;
 
     do
     {
@@ -3252,41 +3377,23 @@ ATCA_STATUS atcab_updateextra(uint8_t mode, uint16_t new_value)
         packet.param1 = mode;
         packet.param2 = new_value;
 
-        if ((status = atUpdateExtra(_gCommandObj, &packet)) != ATCA_SUCCESS)
-            break;
-
-        execution_time = atGetExecTime(_gCommandObj, CMD_UPDATEEXTRA);
-
-        if ((status != atcab_wakeup()) != ATCA_SUCCESS)
-            break;
-
-        // send the command
-        if ((status = atsend(_gIface, (uint8_t*)&packet, packet.txsize)) != ATCA_SUCCESS)
-            break;
-
-        // delay the appropriate amount of time for command to execute
-        atca_delay_ms(execution_time);
-
-        // receive the response
-        if ((status = atreceive(_gIface, packet.data, &(packet.rxsize))) != ATCA_SUCCESS)
-            break;
-
-        // Check response size
-        if (packet.rxsize < 4)
-        {
-            if (packet.rxsize > 0)
-                status = ATCA_RX_FAIL;
-            else
-                status = ATCA_RX_NO_RESPONSE;
+        if ((status = atUpdateExtra(atGetCommands(device), &packet)) != ATCA_SUCCESS)
             break;
-        }
 
-        // check for response
-        if ((status = isATCAError(packet.data)) != ATCA_SUCCESS)
+        if ( (status = atca_execute_command(device, &packet)) != ATCA_SUCCESS)
             break;
     }
     while (0);
 
-    _atcab_exit();
+#ifndef ATCA_NO_CONFIG_SHADOW
+    atca_config_shadow_drop(device);
+#endif
+
     return status;
+}
+
+/** \brief atcab_updateextra_ctx() on the default device, see atcab_init() */
+ATCA_STATUS atcab_updateextra(uint8_t mode, uint16_t new_value)
+{
+    return atcab_updateextra_ctx(_gDevice, mode, new_value);
 }
\ No newline at end of file
@@ -67,6 +67,10 @@ ATCADevice atcab_get_device(void);
 ATCA_STATUS atcab_wakeup(void);
 ATCA_STATUS atcab_idle(void);
 ATCA_STATUS atcab_sleep(void);
+ATCA_STATUS atcab_session_begin(void);
+ATCA_STATUS atcab_session_end(void);
+ATCA_STATUS atcab_config_shadow_stats(ATCAConfigShadowStats* stats);
+ATCA_STATUS atcab_config_shadow_invalidate(void);
 
 // discovery
 ATCA_STATUS atcab_cfg_discover(ATCAIfaceCfg cfgArray[], int max);
@@ -151,6 +155,74 @@ ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data
 ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t * ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE]);
 ATCA_STATUS atcab_hw_sha2_256(const uint8_t * data, size_t data_size, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE]);
 
+// the same API on an explicit ATCADevice (atcab_xxx_ctx), for more than one device
+ATCA_STATUS atcab_wakeup_ctx(ATCADevice device);
+ATCA_STATUS atcab_idle_ctx(ATCADevice device);
+ATCA_STATUS atcab_sleep_ctx(ATCADevice device);
+ATCA_STATUS atcab_session_begin_ctx(ATCADevice device);
+ATCA_STATUS atcab_session_end_ctx(ATCADevice device);
+ATCA_STATUS atcab_config_shadow_stats_ctx(ATCADevice device, ATCAConfigShadowStats* stats);
+ATCA_STATUS atcab_config_shadow_invalidate_ctx(ATCADevice device);
+ATCA_STATUS atcab_info_ctx(ATCADevice device, uint8_t *revision);
+ATCA_STATUS atcab_random_ctx(ATCADevice device, uint8_t *rand_out);
+ATCA_STATUS atcab_genkey_base_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key);
+ATCA_STATUS atcab_genkey_ctx(ATCADevice device, uint16_t key_id, uint8_t *public_key);
+ATCA_STATUS atcab_nonce_ctx(ATCADevice device, const uint8_t *tempkey);
+ATCA_STATUS atcab_nonce_rand_ctx(ATCADevice device, const uint8_t *seed, uint8_t* rand_out);
+ATCA_STATUS atcab_challenge_ctx(ATCADevice device, const uint8_t *challenge);
+ATCA_STATUS atcab_challenge_seed_update_ctx(ATCADevice device, const uint8_t *seed, uint8_t* rand_out);
+ATCA_STATUS atcab_nonce_base_ctx(ATCADevice device, uint8_t mode, const uint8_t *num_in, uint8_t* rand_out);
+ATCA_STATUS atcab_read_serial_number_ctx(ATCADevice device, uint8_t* serial_number);
+ATCA_STATUS atcab_verify_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data);
+ATCA_STATUS atcab_verify_extern_ctx(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified);
+ATCA_STATUS atcab_verify_stored_ctx(ATCADevice device, const uint8_t *message, const uint8_t *signature, uint16_t key_id, bool *is_verified);
+ATCA_STATUS atcab_verify_validate_ctx(ATCADevice device, uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified);
+ATCA_STATUS atcab_verify_invalidate_ctx(ATCADevice device, uint16_t key_id, const uint8_t *signature, const uint8_t *other_data, bool *is_verified);
+ATCA_STATUS atcab_ecdh_ctx(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms);
+ATCA_STATUS atcab_ecdh_enc_ctx(ATCADevice device, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms, const uint8_t* enckey, uint16_t enckeyid);
+ATCA_STATUS atcab_get_zone_size_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size);
+ATCA_STATUS atcab_is_slot_locked_ctx(ATCADevice device, uint8_t slot, bool *is_locked);
+ATCA_STATUS atcab_is_locked_ctx(ATCADevice device, uint8_t zone, bool *is_locked);
+ATCA_STATUS atcab_write_ctx(ATCADevice device, uint8_t zone, uint16_t address, const uint8_t *value, const uint8_t *mac);
+ATCA_STATUS atcab_write_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_read_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len);
+ATCA_STATUS atcab_read_enc_ctx(ATCADevice device, uint16_t key_id, uint8_t block, uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid);
+ATCA_STATUS atcab_write_enc_ctx(ATCADevice device, uint16_t key_id, uint8_t block, const uint8_t *data, const uint8_t* enckey, const uint16_t enckeyid);
+ATCA_STATUS atcab_read_config_zone_ctx(ATCADevice device, uint8_t* config_data);
+ATCA_STATUS atcab_write_config_zone_ctx(ATCADevice device, const uint8_t* config_data);
+ATCA_STATUS atcab_cmp_config_zone_ctx(ATCADevice device, uint8_t* config_data, bool* same_config);
+ATCA_STATUS atcab_lock_ctx(ATCADevice device, uint8_t mode, uint16_t summary_crc);
+ATCA_STATUS atcab_lock_config_zone_ctx(ATCADevice device);
+ATCA_STATUS atcab_lock_config_zone_crc_ctx(ATCADevice device, uint16_t crc);
+ATCA_STATUS atcab_lock_data_zone_ctx(ATCADevice device);
+ATCA_STATUS atcab_lock_data_zone_crc_ctx(ATCADevice device, uint16_t crc);
+ATCA_STATUS atcab_lock_data_slot_ctx(ATCADevice device, uint8_t slot);
+ATCA_STATUS atcab_sign_base_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *signature);
+ATCA_STATUS atcab_sign_ctx(ATCADevice device, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS atcab_sign_internal_ctx(ATCADevice device, uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t *signature);
+ATCA_STATUS atcab_gendig_ctx(ATCADevice device, uint8_t zone, uint16_t key_id, const uint8_t *other_data, uint8_t other_data_size);
+ATCA_STATUS atcab_read_sig_ctx(ATCADevice device, uint8_t slot8toF, uint8_t *sig);
+ATCA_STATUS atcab_get_pubkey_ctx(ATCADevice device, uint16_t key_id, uint8_t *public_key);
+ATCA_STATUS atcab_priv_write_ctx(ATCADevice device, uint16_t key_id, const uint8_t priv_key[36], uint8_t write_key_slot, const uint8_t write_key[32]);
+ATCA_STATUS atcab_write_pubkey_ctx(ATCADevice device, uint16_t slot8toF, const uint8_t *pubkey);
+ATCA_STATUS atcab_read_pubkey_ctx(ATCADevice device, uint16_t slot8toF, uint8_t *pubkey);
+ATCA_STATUS atcab_write_bytes_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t *data, size_t length);
+ATCA_STATUS atcab_read_bytes_zone_ctx(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, uint8_t *data, size_t length);
+ATCA_STATUS atcab_mac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest);
+ATCA_STATUS atcab_checkmac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t *challenge, const uint8_t *response, const uint8_t *other_data);
+ATCA_STATUS atcab_hmac_ctx(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t *digest);
+ATCA_STATUS atcab_derivekey_ctx(ATCADevice device, uint8_t mode, uint16_t target_key, uint8_t* mac);
+ATCA_STATUS atcab_sha_base_ctx(ATCADevice device, uint8_t mode, uint16_t length, const uint8_t* message, uint8_t* digest);
+ATCA_STATUS atcab_sha_start_ctx(ATCADevice device);
+ATCA_STATUS atcab_sha_update_ctx(ATCADevice device, const uint8_t *message);
+ATCA_STATUS atcab_sha_end_ctx(ATCADevice device, uint8_t *digest, uint16_t length, const uint8_t *message);
+ATCA_STATUS atcab_sha_ctx(ATCADevice device, uint16_t length, const uint8_t *message, uint8_t *digest);
+ATCA_STATUS atcab_hw_sha2_256_init_ctx(ATCADevice device, atca_sha256_ctx_t* ctx);
+ATCA_STATUS atcab_hw_sha2_256_update_ctx(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atcab_hw_sha2_256_finish_ctx(ATCADevice device, atca_sha256_ctx_t * ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE]);
+ATCA_STATUS atcab_hw_sha2_256_ctx(ATCADevice device, const uint8_t * data, size_t data_size, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE]);
+ATCA_STATUS atcab_updateextra_ctx(ATCADevice device, uint8_t mode, uint16_t new_value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,7 +41,30 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-#ifdef ATCAPRINTF
+/** \brief Upper case hex digits, indexed by nibble */
+static const char atca_hex_digit[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/** \brief Value of each character as a hex digit, 0xFF for anything that isn't one */
+static const uint8_t atca_hex_value[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
 
 /** \brief convert a binary buffer to a hex string suitable for human reading
  *  \param[in] binary input buffer to convert
@@ -58,8 +81,9 @@ ATCA_STATUS atcab_bin2hex(const uint8_t* binary, int binLen, char* asciihex, int
 /** \brief convert a binary buffer to a hex string suitable for human reading
  *  \param[in] inbuff input buffer to convert
  *  \param[in] inbuffLen length of buffer to convert
- *  \param[out] asciihex buffer that receives hex string
- *  \param[inout] asciihexlen the length of the asciihex buffer
+ *  \param[out] asciihex buffer that receives hex string, null terminated when there is room
+ *  \param[inout] asciihexlen As input, the size of the asciihex buffer.
+ *                            As output, the length of the hex string. Conversion stops at the last byte that fits.
  *  \param[inout] addspace indicates whether spaces and returns should be added for pretty printing
  * \return ATCA_STATUS
  */
@@ -67,103 +91,77 @@ ATCA_STATUS atcab_bin2hex_(const uint8_t* binary, int binLen, char* asciihex, in
 {
     int i;
     int hexlen = 0;
+    int bytelen = addspace ? 3 : 2;
 
     // Verify the inputs
     if ((binary == NULL) || (asciihex == NULL) || (asciihexlen == NULL))
         return ATCA_BAD_PARAM;
 
-    // Initialize the return bytes to all 0s
-    memset(asciihex, 0, *asciihexlen);
-
     // Convert one byte at a time
     for (i = 0; i < binLen; i++)
     {
-        if (hexlen > *asciihexlen)
-            break;
         if ((i % 16 == 0 && i != 0) && addspace)
         {
-            sprintf(&asciihex[hexlen], "\r\n");
-            hexlen += 2;
+            if (hexlen + 2 + bytelen > *asciihexlen)
+                break;
+            asciihex[hexlen++] = '\r';
+            asciihex[hexlen++] = '\n';
         }
+        if (hexlen + bytelen > *asciihexlen)
+            break;
+        asciihex[hexlen++] = atca_hex_digit[binary[i] >> 4];
+        asciihex[hexlen++] = atca_hex_digit[binary[i] & 0x0F];
         if (addspace)
-        {
-            sprintf(&asciihex[hexlen], "%02X ", *binary++);
-            hexlen += 3;
-        }
-        else
-        {
-            sprintf(&asciihex[hexlen], "%02X", *binary++);
-            hexlen += 2;
-        }
+            asciihex[hexlen++] = ' ';
     }
-    *asciihexlen = (int)strlen(asciihex);
+    if (hexlen < *asciihexlen)
+        asciihex[hexlen] = '\0';
+    *asciihexlen = hexlen;
 
     return ATCA_SUCCESS;
 }
 
-/** \brief convert a binary buffer to a hex string suitable for human reading
- *  \param[in] inbuff input buffer to convert
- *  \param[in] inbuffLen length of buffer to convert
- *  \param[out] outbuff buffer that receives hex string
- *  \return string length of the output buffer
+/** \brief convert a hex string to binary, skipping white space and any other non-hex characters
+ *
+ * binary may point into asciiHex to decode in place.
+ *
+ *  \param[in] asciiHex input hex string to convert
+ *  \param[in] asciiHexLen length of the hex string
+ *  \param[out] binary buffer that receives the bytes
+ *  \param[inout] binLen As input, the size of the binary buffer. As output, the number of bytes converted.
+ * \return ATCA_STATUS
  */
 ATCA_STATUS atcab_hex2bin(const char* asciiHex, int asciiHexLen, uint8_t* binary, int* binLen)
 {
     int i = 0;
     int j = 0;
-    uint32_t byt;
-    char* packedHex = NULL;
-    int packedLen = asciiHexLen;
-    char hexByte[3];
+    uint8_t value;
+    uint8_t high = 0;
+    bool have_high = false;
 
     // Verify the inputs
     if ((binary == NULL) || (asciiHex == NULL) || (binLen == NULL))
         return ATCA_BAD_PARAM;
 
-    // Pack the bytes (remove white space & make even number of characters)
-    packedHex = (char*)malloc(packedLen);
-    memset(packedHex, 0, packedLen);
-    packHex(asciiHex, asciiHexLen, packedHex, &packedLen);
-
-    // Initialize the binary buffer to all 0s
-    memset(binary, 0, *binLen);
-    memset(hexByte, 0, 3);
-
-    // Convert the ascii bytes to binary
-    for (i = 0, j = 0; i < packedLen; i += 2, j++)
+    // Convert the ascii bytes to binary, two digits per byte
+    for (i = 0; i < asciiHexLen && j < *binLen; i++)
     {
-        if (i > packedLen || j > *binLen)
-            break;
-        // Copy two characters to be scanned
-        memcpy(hexByte, &packedHex[i], 2);
-        sscanf(hexByte, "%x", (unsigned int*)&byt);
-        // take the msb of the uint32_t
-        binary[j] = byt;
+        value = atca_hex_value[(uint8_t)asciiHex[i]];
+        if (value > 0x0F)
+            continue;
+        if (have_high)
+            binary[j++] = (uint8_t)((high << 4) | value);
+        else
+            high = value;
+        have_high = !have_high;
     }
+    // An odd digit at the end is converted on its own
+    if (have_high && j < *binLen)
+        binary[j++] = high;
     *binLen = j;
-    free(packedHex);
-    return ATCA_SUCCESS;
-}
 
-#else
-/* dummy function for non-printing test setup */
-ATCA_STATUS atcab_bin2hex(const uint8_t* binary, int binLen, char* asciihex, int* asciihexlen)
-{
-    (void)binary;
-    (void)binLen;
-    (void)asciihex;
-    (void)asciihexlen;
-    return ATCA_SUCCESS;
-}
-/* dummy function for non-printing test setup */
-ATCA_STATUS atcab_printbin_label(const char* label, uint8_t* binary, int binLen)
-{
-    (void)label;
-    (void)binary;
-    (void)binLen;
     return ATCA_SUCCESS;
 }
-#endif
 
 /**
  * \brief Checks to see if a character is an ASCII representation of a digit ((c ge '0') and (c le '9'))
@@ -223,7 +221,7 @@ bool isHex(char c)
  */
 bool isHexDigit(char c)
 {
-    return isDigit(c) || isHexAlpha(c);
+    return atca_hex_value[(uint8_t)c] <= 0x0F;
 }
 
 /**
@@ -326,6 +324,15 @@ ATCA_STATUS atcab_printbin(uint8_t* binary, int binLen, bool addspace)
 
     return ATCA_SUCCESS;
 }
+#else
+/* dummy function for non-printing test setup */
+ATCA_STATUS atcab_printbin_label(const char* label, uint8_t* binary, int binLen)
+{
+    (void)label;
+    (void)binary;
+    (void)binLen;
+    return ATCA_SUCCESS;
+}
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -335,6 +342,29 @@ ATCA_STATUS atcab_printbin(uint8_t* binary, int binLen, bool addspace)
 #define IS_EQUAL    (char)64
 #define IS_INVALID  (char)0xFF
 
+/** \brief Base 64 characters, indexed by 6-bit value */
+static const char atca_base64_char[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** \brief Base 64 index of each character, IS_EQUAL for '=' and IS_INVALID for anything else */
+static const uint8_t atca_base64_value[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
 /**
  * \brief Returns true if this character is a valid base 64 character or if this is whitespace (A character can be
  *        included in a valid base 64 string).
@@ -353,7 +383,7 @@ bool isBase64(char c)
  */
 bool isBase64Digit(char c)
 {
-    return isDigit(c) || isAlpha(c) || c == '+' || c == '/' || c == '=';
+    return atca_base64_value[(uint8_t)c] != (uint8_t)IS_INVALID;
 }
 
 /**
@@ -403,20 +433,7 @@ ATCA_STATUS packBase64(const char* asciiBase64, int asciiBase64Len, char* packed
  */
 char base64Index(char c)
 {
-    if ((c >= 'A') && (c <= 'Z'))
-        return (char)(c - 'A');
-    if ((c >= 'a') && (c <= 'z'))
-        return (char)(26 + c - 'a');
-    if ((c >= '0') && (c <= '9'))
-        return (char)(52 + c - '0');
-    if (c == '+')
-        return (char)62;
-    if (c == '/')
-        return (char)63;
-
-    if (c == '=')
-        return IS_EQUAL;
-    return IS_INVALID;
+    return (char)atca_base64_value[(uint8_t)c];
 }
 
 /**
@@ -426,16 +443,8 @@ char base64Index(char c)
  */
 char base64Char(char id)
 {
-    if (id >= 0 && (id < 26))
-        return (char)('A' + id);
-    if ((id >= 26) && (id < 52))
-        return (char)('a' + id - 26);
-    if ((id >= 52) && (id < 62))
-        return (char)('0' + id - 52);
-    if (id == 62)
-        return (char)'+';
-    if (id == 63)
-        return (char)'/';
+    if (id >= 0 && (id < 64))
+        return atca_base64_char[(int)id];
 
     if (id == IS_EQUAL)
         return (char)'=';
@@ -444,6 +453,10 @@ char base64Char(char id)
 
 /**
  * \brief Decode base 64 encoded characters into a byte array
+ *
+ * White space and other characters outside the base 64 alphabet are skipped.
+ * byteArray may point to encoded to decode in place.
+ *
  * \param[in]    encoded		The input base 64 encoded characters that will be decoded.
  * \param[in]    encodedLen	The length of the encoded characters
  * \param[out]   byteArray	The output buffer that contains the decoded byte array
@@ -454,19 +467,14 @@ char base64Char(char id)
 ATCA_STATUS atcab_base64decode(const char* encoded, size_t encodedLen, uint8_t* byteArray, size_t* arrayLen)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
-    int id[4];
-    int i = 0;
-    int j = 0;
-    char* packedBase64 = NULL;
-    int packedLen = encodedLen;
+    uint8_t id[4];
+    int count = 0;
+    size_t i = 0;
+    size_t j = 0;
 
     // Set the output length.
     size_t outLen = (encodedLen * 3) / 4;
 
-    // Allocate the memory for the packed base 64 buffer
-    packedBase64 = (char*)malloc(packedLen);
-    memset(packedBase64, 0, packedLen);
-
     do
     {
         // Check the input parameters
@@ -475,29 +483,21 @@ ATCA_STATUS atcab_base64decode(const char* encoded, size_t encodedLen, uint8_t*
             status = ATCA_BAD_PARAM;
             BREAK(status, "Null input parameter");
         }
-        // Pack the encoded characters (remove the white space from the encoded characters)
-        packBase64(encoded, encodedLen, packedBase64, &packedLen);
-        // Packed length must be divisible by 4
-        if (packedLen % 4 != 0)
-        {
-            status = ATCA_BAD_PARAM;
-            BREAK(status, "Invalid base64 input");
-        }
         if (*arrayLen < outLen)
         {
             status = ATCA_BAD_PARAM;
             BREAK(status, "Length of decoded buffer too small");
         }
-        // Initialize the return length to 0
-        *arrayLen = 0;
 
-        // Take the encoded bytes in groups of 4 and decode them into 3 bytes
-        for (i = 0; i < packedLen; i += 4)
+        // Take the encoded characters in groups of 4 and decode them into 3 bytes
+        for (i = 0; i < encodedLen; i++)
         {
-            id[0] = base64Index(packedBase64[i]);
-            id[1] = base64Index(packedBase64[i + 1]);
-            id[2] = base64Index(packedBase64[i + 2]);
-            id[3] = base64Index(packedBase64[i + 3]);
+            id[count] = atca_base64_value[(uint8_t)encoded[i]];
+            if (id[count] == (uint8_t)IS_INVALID)
+                continue;
+            if (++count < 4)
+                continue;
+            count = 0;
             byteArray[j++] = (uint8_t)((id[0] << 2) | (id[1] >> 4));
             if (id[2] < 64)
             {
@@ -506,12 +506,16 @@ ATCA_STATUS atcab_base64decode(const char* encoded, size_t encodedLen, uint8_t*
                     byteArray[j++] = (uint8_t)((id[2] << 6) | id[3]);
             }
         }
+        // The number of base 64 characters must be divisible by 4
+        if (count != 0)
+        {
+            status = ATCA_BAD_PARAM;
+            BREAK(status, "Invalid base64 input");
+        }
         *arrayLen = j;
     }
     while (false);
 
-    // Deallocate the packed buffer
-    free(packedBase64);
     return status;
 }
 
@@ -544,8 +548,7 @@ ATCA_STATUS atcab_base64encode_(const uint8_t* byteArray, size_t arrayLen, char*
     ATCA_STATUS status = ATCA_SUCCESS;
     size_t i = 0;
     size_t j = 0;
-    size_t offset = 0;
-    int id = 0;
+    size_t line = 0;
 
     // Set the output length.  Add the \n every 64 characters
     size_t r3 = (arrayLen % 3);
@@ -565,45 +568,35 @@ ATCA_STATUS atcab_base64encode_(const uint8_t* byteArray, size_t arrayLen, char*
             status = ATCA_BAD_PARAM;
             BREAK(status, "Length of encoded buffer too small");
         }
-        // Initialize the return length to 0
-        *encodedLen = 0;
 
         // Loop through the byte array by 3 then map to 4 base 64 encoded characters
         for (i = 0; i < arrayLen; i += 3)
         {
-            id = (byteArray[i] & 0xFC) >> 2;
-            encoded[j++] = base64Char(id);
-            id = (byteArray[i] & 0x03) << 4;
-            if (i + 1 < arrayLen)
+            encoded[j++] = atca_base64_char[byteArray[i] >> 2];
+            if (i + 2 < arrayLen)
+            {
+                encoded[j++] = atca_base64_char[((byteArray[i] & 0x03) << 4) | (byteArray[i + 1] >> 4)];
+                encoded[j++] = atca_base64_char[((byteArray[i + 1] & 0x0F) << 2) | (byteArray[i + 2] >> 6)];
+                encoded[j++] = atca_base64_char[byteArray[i + 2] & 0x3F];
+            }
+            else if (i + 1 < arrayLen)
             {
-                id |= (byteArray[i + 1] & 0xF0) >> 4;
-                encoded[j++] = base64Char(id);
-                id = (byteArray[i + 1] & 0x0F) << 2;
-                if (i + 2 < arrayLen)
-                {
-                    id |= (byteArray[i + 2] & 0xC0) >> 6;
-                    encoded[j++] = base64Char(id);
-                    id = byteArray[i + 2] & 0x3F;
-                    encoded[j++] = base64Char(id);
-                }
-                else
-                {
-                    encoded[j++] = base64Char(id);
-                    encoded[j++] = base64Char(IS_EQUAL);
-                }
+                encoded[j++] = atca_base64_char[((byteArray[i] & 0x03) << 4) | (byteArray[i + 1] >> 4)];
+                encoded[j++] = atca_base64_char[(byteArray[i + 1] & 0x0F) << 2];
+                encoded[j++] = '=';
             }
             else
             {
-                encoded[j++] = base64Char(id);
-                encoded[j++] = base64Char(IS_EQUAL);
-                encoded[j++] = base64Char(IS_EQUAL);
+                encoded[j++] = atca_base64_char[(byteArray[i] & 0x03) << 4];
+                encoded[j++] = '=';
+                encoded[j++] = '=';
             }
-            // Add \n every 64 bytes if specified
-            if (addNewLine && ((j - offset) % 64 == 0))
+            // Add \n every 64 characters if specified
+            line += 4;
+            if (addNewLine && line == 64)
             {
-                // as soon as we do this, we introduce an offset
                 encoded[j++] = '\n';
-                offset++;
+                line = 0;
             }
         }
         // Set the final encoded length
@@ -612,6 +605,3 @@ ATCA_STATUS atcab_base64encode_(const uint8_t* byteArray, size_t arrayLen, char*
     while (false);
     return status;
 }
-
-
-
@@ -54,12 +54,12 @@ extern "C" {
 
 #ifdef ATCAPRINTF
 ATCA_STATUS atcab_printbin(uint8_t* binary, int binLen, bool addspace);
-ATCA_STATUS atcab_bin2hex_(const uint8_t* binary, int binLen, char* asciiHex, int* asciiHexLen, bool addSpace);
-ATCA_STATUS atcab_hex2bin(const char* asciiHex, int asciiHexLen, uint8_t* binary, int* binLen);
 ATCA_STATUS atcab_printbin_sp(uint8_t* binary, int binLen);
 #endif
 ATCA_STATUS atcab_printbin_label(const char* label, uint8_t* binary, int binLen);
 ATCA_STATUS atcab_bin2hex(const uint8_t* binary, int binLen, char* asciiHex, int* asciiHexLen);
+ATCA_STATUS atcab_bin2hex_(const uint8_t* binary, int binLen, char* asciiHex, int* asciiHexLen, bool addSpace);
+ATCA_STATUS atcab_hex2bin(const char* asciiHex, int asciiHexLen, uint8_t* binary, int* binLen);
 
 ATCA_STATUS packHex(const char* asciiHex, int asciiHexLen, char* packedHex, int* packedLen);
 bool isDigit(char c);
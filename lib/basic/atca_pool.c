@@ -0,0 +1,460 @@
+/**
+ * \file
+ * \brief  Pool of CryptoAuth devices sharing sign, verify, ECDH and random requests
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atca_pool.h"
+
+#ifdef ATCA_USE_PTHREADS
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+/** \defgroup pool Device pool (atca_pool_)
+   @{ */
+
+enum atca_pool_op
+{
+    POOL_OP_SIGN,
+    POOL_OP_VERIFY_EXTERN,
+    POOL_OP_ECDH,
+    POOL_OP_RANDOM
+};
+
+/** \brief one request, lives on the stack of the thread waiting for it */
+typedef struct atca_pool_req
+{
+    enum atca_pool_op     op;
+    uint16_t              key_id;
+    const uint8_t*        in[3];        // operands, in the order of the matching atcab_ call
+    uint8_t*              out;          // signature, pre-master secret or random number
+    bool*                 is_verified;
+    uint64_t              queued_ns;
+    ATCA_STATUS           status;
+    bool                  done;
+    struct atca_pool_req* next;
+} atca_pool_req_t;
+
+typedef struct
+{
+    ATCADevice       device;
+    pthread_t        thread;
+    pthread_cond_t   work;      // signalled when a request is queued or the pool stops
+    atca_pool_req_t* head;      // queued requests, oldest first
+    atca_pool_req_t* tail;
+    ATCAPoolStats    stats;
+} atca_pool_dev_t;
+
+/** \brief atca_pool is the C object backing ATCAPool */
+struct atca_pool
+{
+    pthread_mutex_t  lock;      // guards the queues, the stats and request completion
+    pthread_cond_t   done;      // broadcast when a request completes
+    bool             stopping;
+    int              count;
+    int              next;      // device to start the least-busy search at, spreads ties
+    atca_pool_dev_t  devs[ATCA_POOL_MAX_DEVICES];
+};
+
+typedef struct
+{
+    struct atca_pool* pool;
+    atca_pool_dev_t*  dev;
+} atca_pool_worker_arg_t;
+
+static uint64_t atca_pool_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** \brief run a request on a device with the matching atcab_ _ctx call */
+static ATCA_STATUS atca_pool_execute(ATCADevice device, atca_pool_req_t *req)
+{
+    switch (req->op)
+    {
+    case POOL_OP_SIGN:
+        return atcab_sign_ctx(device, req->key_id, req->in[0], req->out);
+    case POOL_OP_VERIFY_EXTERN:
+        return atcab_verify_extern_ctx(device, req->in[0], req->in[1], req->in[2], req->is_verified);
+    case POOL_OP_ECDH:
+        return atcab_ecdh_ctx(device, req->key_id, req->in[0], req->out);
+    case POOL_OP_RANDOM:
+        return atcab_random_ctx(device, req->out);
+    }
+    return ATCA_BAD_PARAM;
+}
+
+/** \brief worker thread, drains the queue of one device until the pool stops */
+static void* atca_pool_worker(void *arg)
+{
+    struct atca_pool *pool = ((atca_pool_worker_arg_t*)arg)->pool;
+    atca_pool_dev_t *dev = ((atca_pool_worker_arg_t*)arg)->dev;
+    atca_pool_req_t *req;
+    uint64_t start_ns, end_ns;
+    uint32_t latency_us;
+
+    free(arg);
+
+    pthread_mutex_lock(&pool->lock);
+    for (;; )
+    {
+        while (dev->head == NULL && !pool->stopping)
+            pthread_cond_wait(&dev->work, &pool->lock);
+        if (dev->head == NULL)
+            break;  // stopping with nothing left to do
+
+        req = dev->head;
+        dev->head = req->next;
+        if (dev->head == NULL)
+            dev->tail = NULL;
+        pthread_mutex_unlock(&pool->lock);
+
+        start_ns = atca_pool_now_ns();
+        req->status = atca_pool_execute(dev->device, req);
+        end_ns = atca_pool_now_ns();
+
+        pthread_mutex_lock(&pool->lock);
+        latency_us = (uint32_t)((end_ns - req->queued_ns) / 1000);
+        dev->stats.queue_depth--;
+        dev->stats.completed++;
+        if (req->status != ATCA_SUCCESS)
+            dev->stats.failed++;
+        dev->stats.total_us += latency_us;
+        dev->stats.last_us = latency_us;
+        if (latency_us > dev->stats.max_us)
+            dev->stats.max_us = latency_us;
+        dev->stats.busy_us += (end_ns - start_ns) / 1000;
+        req->done = true;
+        pthread_cond_broadcast(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/** \brief queue a request on the least busy device and wait for its result */
+static ATCA_STATUS atca_pool_submit(ATCAPool pool, atca_pool_req_t *req)
+{
+    atca_pool_dev_t *dev = NULL;
+    int i, d;
+
+    if (pool == NULL)
+        return ATCA_BAD_PARAM;
+
+    req->done = false;
+    req->next = NULL;
+    req->status = ATCA_GEN_FAIL;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->stopping)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        return ATCA_GEN_FAIL;
+    }
+
+    // shortest queue wins, ties go round robin
+    for (i = 0; i < pool->count; i++)
+    {
+        d = (pool->next + i) % pool->count;
+        if (dev == NULL || pool->devs[d].stats.queue_depth < dev->stats.queue_depth)
+            dev = &pool->devs[d];
+    }
+    pool->next = (pool->next + 1) % pool->count;
+
+    req->queued_ns = atca_pool_now_ns();
+    if (dev->tail)
+        dev->tail->next = req;
+    else
+        dev->head = req;
+    dev->tail = req;
+    dev->stats.queue_depth++;
+    pthread_cond_signal(&dev->work);
+
+    while (!req->done)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    return req->status;
+}
+
+/** \brief stop the workers and free the devices of a pool
+ * \param[in] pool  pool, its first count devices and workers are running
+ */
+static void atca_pool_shutdown(struct atca_pool *pool)
+{
+    int i;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    for (i = 0; i < pool->count; i++)
+        pthread_cond_signal(&pool->devs[i].work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < pool->count; i++)
+    {
+        pthread_join(pool->devs[i].thread, NULL);
+        pthread_cond_destroy(&pool->devs[i].work);
+        deleteATCADevice(&pool->devs[i].device);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+/** \brief constructor for a pool of devices provisioned with equivalent keys
+ *
+ * Creates a device for every configuration and starts a worker thread for it.
+ * \param[in] cfgs   interface configurations, one per device
+ * \param[in] count  number of configurations, 1 to ATCA_POOL_MAX_DEVICES
+ * \return reference to a new ATCAPool, NULL if a device or thread couldn't be created
+ */
+ATCAPool newATCAPool(ATCAIfaceCfg *cfgs[], int count)
+{
+    struct atca_pool *pool;
+    atca_pool_worker_arg_t *arg;
+    int i;
+
+    if (cfgs == NULL || count < 1 || count > ATCA_POOL_MAX_DEVICES)
+        return NULL;
+
+    pool = (struct atca_pool*)calloc(1, sizeof(struct atca_pool));
+    if (pool == NULL)
+        return NULL;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (i = 0; i < count; i++)
+    {
+        atca_pool_dev_t *dev = &pool->devs[i];
+
+        if ( (dev->device = newATCADevice(cfgs[i])) == NULL)
+            break;
+
+        pthread_cond_init(&dev->work, NULL);
+        arg = (atca_pool_worker_arg_t*)malloc(sizeof(*arg));
+        if (arg != NULL)
+        {
+            arg->pool = pool;
+            arg->dev = dev;
+            if (pthread_create(&dev->thread, NULL, atca_pool_worker, arg) == 0)
+            {
+                pool->count++;
+                continue;
+            }
+            free(arg);
+        }
+        pthread_cond_destroy(&dev->work);
+        deleteATCADevice(&dev->device);
+        break;
+    }
+
+    if (pool->count != count)
+    {
+        atca_pool_shutdown(pool);
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+/** \brief destructor for a pool, NULLs the reference after the pool is freed
+ *
+ * Requests already queued are completed before the workers stop.
+ * \param[in] pool  pointer to a reference to a pool
+ */
+void deleteATCAPool(ATCAPool *pool)
+{
+    if (pool == NULL || *pool == NULL)
+        return;
+
+    atca_pool_shutdown(*pool);
+    free(*pool);
+    *pool = NULL;
+}
+
+/** \brief number of devices in a pool
+ * \param[in] pool  pool
+ * \return device count, 0 for a NULL pool
+ */
+int atca_pool_size(ATCAPool pool)
+{
+    return pool ? pool->count : 0;
+}
+
+/** \brief one of the devices of a pool, for setup that isn't load balanced
+ *
+ * The device is shared with its worker; the per-device lock keeps direct calls and
+ * pool requests apart.
+ * \param[in] pool   pool
+ * \param[in] index  device index, 0 to atca_pool_size() - 1
+ * \return device, NULL if the index is out of range
+ */
+ATCADevice atca_pool_get_device(ATCAPool pool, int index)
+{
+    if (pool == NULL || index < 0 || index >= pool->count)
+        return NULL;
+
+    return pool->devs[index].device;
+}
+
+/** \brief queue depth and latency counters of one device of a pool
+ * \param[in]  pool   pool
+ * \param[in]  index  device index, 0 to atca_pool_size() - 1
+ * \param[out] stats  receives a snapshot of the counters
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_get_stats(ATCAPool pool, int index, ATCAPoolStats *stats)
+{
+    if (pool == NULL || stats == NULL || index < 0 || index >= pool->count)
+        return ATCA_BAD_PARAM;
+
+    pthread_mutex_lock(&pool->lock);
+    *stats = pool->devs[index].stats;
+    pthread_mutex_unlock(&pool->lock);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief zero the counters of every device of a pool, queue depths are kept
+ * \param[in] pool  pool
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_reset_stats(ATCAPool pool)
+{
+    uint32_t queue_depth;
+    int i;
+
+    if (pool == NULL)
+        return ATCA_BAD_PARAM;
+
+    pthread_mutex_lock(&pool->lock);
+    for (i = 0; i < pool->count; i++)
+    {
+        queue_depth = pool->devs[i].stats.queue_depth;
+        memset(&pool->devs[i].stats, 0, sizeof(pool->devs[i].stats));
+        pool->devs[i].stats.queue_depth = queue_depth;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief atcab_sign() on the least busy device of a pool
+ * \param[in]  pool       pool
+ * \param[in]  key_id     slot of the private key, the same on every device
+ * \param[in]  msg        32-byte message digest to sign
+ * \param[out] signature  64-byte signature, R then S
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_sign(ATCAPool pool, uint16_t key_id, const uint8_t *msg, uint8_t *signature)
+{
+    atca_pool_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = POOL_OP_SIGN;
+    req.key_id = key_id;
+    req.in[0] = msg;
+    req.out = signature;
+
+    return atca_pool_submit(pool, &req);
+}
+
+/** \brief atcab_verify_extern() on the least busy device of a pool
+ * \param[in]  pool         pool
+ * \param[in]  message      32-byte message digest that was signed
+ * \param[in]  signature    64-byte signature, R then S
+ * \param[in]  public_key   64-byte public key, X then Y
+ * \param[out] is_verified  true when the signature matches
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_verify_extern(ATCAPool pool, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified)
+{
+    atca_pool_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = POOL_OP_VERIFY_EXTERN;
+    req.in[0] = message;
+    req.in[1] = signature;
+    req.in[2] = public_key;
+    req.is_verified = is_verified;
+
+    return atca_pool_submit(pool, &req);
+}
+
+/** \brief atcab_ecdh() on the least busy device of a pool
+ * \param[in]  pool    pool
+ * \param[in]  key_id  slot of the private key, the same on every device
+ * \param[in]  pubkey  64-byte public key of the peer, X then Y
+ * \param[out] pms     32-byte pre-master secret
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_ecdh(ATCAPool pool, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms)
+{
+    atca_pool_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = POOL_OP_ECDH;
+    req.key_id = key_id;
+    req.in[0] = pubkey;
+    req.out = pms;
+
+    return atca_pool_submit(pool, &req);
+}
+
+/** \brief atcab_random() on the least busy device of a pool
+ * \param[in]  pool      pool
+ * \param[out] rand_out  32-byte random number
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_pool_random(ATCAPool pool, uint8_t *rand_out)
+{
+    atca_pool_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.op = POOL_OP_RANDOM;
+    req.out = rand_out;
+
+    return atca_pool_submit(pool, &req);
+}
+
+/** @} */
+
+#endif /* ATCA_USE_PTHREADS */
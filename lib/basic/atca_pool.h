@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief  Pool of CryptoAuth devices sharing sign, verify, ECDH and random requests
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATCA_POOL_H_
+#define ATCA_POOL_H_
+
+#include "cryptoauthlib.h"
+
+/** \defgroup pool Device pool (atca_pool_)
+ *
+ * \brief
+ * A pool owns several devices provisioned with equivalent keys and a worker thread
+ * per device. Requests go to the device with the shortest queue, so throughput grows
+ * with the number of parts. Needs ATCA_USE_PTHREADS.
+ *
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ATCA_POOL_MAX_DEVICES   16
+
+typedef struct atca_pool * ATCAPool;
+
+/** \brief per-device counters of a pool, latencies include the time spent queued */
+typedef struct
+{
+    uint32_t queue_depth;   // requests queued on or running on the device right now
+    uint32_t completed;     // requests finished, successfully or not
+    uint32_t failed;        // requests finished with a status other than ATCA_SUCCESS
+    uint64_t total_us;      // sum of request latencies, average is total_us / completed
+    uint32_t last_us;       // latency of the most recent request
+    uint32_t max_us;        // worst request latency
+    uint64_t busy_us;       // time the device spent executing requests
+} ATCAPoolStats;
+
+ATCAPool newATCAPool(ATCAIfaceCfg *cfgs[], int count);   // constructor
+void deleteATCAPool(ATCAPool *pool);                      // destructor
+
+int atca_pool_size(ATCAPool pool);
+ATCADevice atca_pool_get_device(ATCAPool pool, int index);
+ATCA_STATUS atca_pool_get_stats(ATCAPool pool, int index, ATCAPoolStats *stats);
+ATCA_STATUS atca_pool_reset_stats(ATCAPool pool);
+
+ATCA_STATUS atca_pool_sign(ATCAPool pool, uint16_t key_id, const uint8_t *msg, uint8_t *signature);
+ATCA_STATUS atca_pool_verify_extern(ATCAPool pool, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified);
+ATCA_STATUS atca_pool_ecdh(ATCAPool pool, uint16_t key_id, const uint8_t* pubkey, uint8_t* pms);
+ATCA_STATUS atca_pool_random(ATCAPool pool, uint8_t *rand_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ATCA_POOL_H_ */
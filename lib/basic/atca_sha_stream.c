@@ -0,0 +1,313 @@
+/**
+ * \file
+ * \brief  Streaming SHA-256 on the device, pipelined, with a software fallback
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atca_sha_stream.h"
+
+/** \defgroup sha_stream Streaming SHA-256 (atca_sha_stream_)
+   @{ */
+
+/** \brief device time of the commands atcab_hw_sha2_256_finish_ctx() ran, from the session's
+ *         accounting, which restarts from the wake delay when the session re-wakes
+ */
+static uint32_t atca_sha_stream_session_us(uint32_t before, uint32_t after)
+{
+    return after >= before ? after - before : after;
+}
+
+/** \brief collect the response of the SHA update in flight */
+static ATCA_STATUS atca_sha_stream_collect(ATCAShaStream* ctx)
+{
+    ATCA_STATUS status;
+    uint32_t elapsed_us = 0;
+
+    status = atca_execute_receive(ctx->device, &ctx->packet[ctx->current], &elapsed_us);
+    ctx->stats.device_us += elapsed_us;
+    ctx->pending = false;
+
+    return status;
+}
+
+/** \brief queue one full 64 byte block: build its command while the previous one executes,
+ *         collect the previous one, then send
+ */
+static ATCA_STATUS atca_sha_stream_submit(ATCAShaStream* ctx, const uint8_t* block)
+{
+    ATCA_STATUS status;
+    int next = ctx->pending ? ctx->current ^ 1 : ctx->current;
+    ATCAPacket* packet = &ctx->packet[next];
+    uint32_t elapsed_us = 0;
+
+    packet->param1 = SHA_MODE_SHA256_UPDATE;
+    packet->param2 = ATCA_SHA256_BLOCK_SIZE;
+    memcpy(packet->data, block, ATCA_SHA256_BLOCK_SIZE);
+    if ( (status = atSHA(atGetCommands(ctx->device), packet)) != ATCA_SUCCESS)
+        return status;
+
+    if (ctx->pending && (status = atca_sha_stream_collect(ctx)) != ATCA_SUCCESS)
+        return status;
+
+    status = atca_execute_send(ctx->device, packet, &elapsed_us);
+    ctx->stats.device_us += elapsed_us;
+    if (status != ATCA_SUCCESS)
+        return status;
+
+    ctx->current = next;
+    ctx->pending = true;
+    ctx->stats.commands++;
+    ctx->hw.total_msg_size += ATCA_SHA256_BLOCK_SIZE;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief start a SHA-256 stream
+ *
+ * With digest_on_chip the message is hashed by the device, which holds a session, and so
+ * stays locked to the calling thread, until atca_sha_stream_finish() or
+ * atca_sha_stream_abort(). Otherwise it is hashed in software and device is not used.
+ * \param[out] ctx             stream state
+ * \param[in]  device          device to hash on, may be NULL without digest_on_chip
+ * \param[in]  digest_on_chip  true if the digest has to be computed by the device, e.g.
+ *                             because it is to remain in TempKey
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream_init(ATCAShaStream* ctx, ATCADevice device, bool digest_on_chip)
+{
+    ATCA_STATUS status;
+    ATCAPacket packet;
+
+    if (ctx == NULL || (digest_on_chip && device == NULL))
+        return ATCA_BAD_PARAM;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->device = device;
+    ctx->software = !digest_on_chip;
+    ctx->stats.software = ctx->software;
+
+    if (ctx->software)
+        return atcac_sw_sha2_256_init(&ctx->sw) == ATCA_SUCCESS ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+
+    if ( (status = atcab_session_begin_ctx(device)) != ATCA_SUCCESS)
+        return status;
+    ctx->started = true;
+
+    memset(&packet, 0, sizeof(packet));
+    packet.param1 = SHA_MODE_SHA256_START;
+    packet.param2 = 0;
+    if ( (status = atSHA(atGetCommands(device), &packet)) == ATCA_SUCCESS)
+        status = atca_execute_command(device, &packet);
+    if (status != ATCA_SUCCESS)
+    {
+        atca_sha_stream_abort(ctx);
+        return status;
+    }
+    ctx->stats.commands++;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief add message bytes to a stream, any length
+ *
+ * On the device each full block is sent as soon as it is complete and the call returns
+ * while the last one may still be executing. A failure aborts the stream.
+ * \param[inout] ctx        stream state
+ * \param[in]    data       message bytes
+ * \param[in]    data_size  number of bytes in data
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream_update(ATCAShaStream* ctx, const uint8_t* data, size_t data_size)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t copy_size;
+
+    if (ctx == NULL || (data == NULL && data_size > 0))
+        return ATCA_BAD_PARAM;
+
+    if (ctx->software)
+    {
+        ctx->stats.bytes += (uint32_t)data_size;
+        return atcac_sw_sha2_256_update(&ctx->sw, data, data_size) == ATCA_SUCCESS ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+    }
+    if (!ctx->started)
+        return ATCA_BAD_PARAM;
+
+    while (data_size > 0)
+    {
+        // blocks straight from the caller's buffer need no copy into the context
+        if (ctx->hw.block_size == 0 && data_size >= ATCA_SHA256_BLOCK_SIZE)
+        {
+            if ( (status = atca_sha_stream_submit(ctx, data)) != ATCA_SUCCESS)
+                break;
+            copy_size = ATCA_SHA256_BLOCK_SIZE;
+        }
+        else
+        {
+            copy_size = ATCA_SHA256_BLOCK_SIZE - ctx->hw.block_size;
+            if (copy_size > data_size)
+                copy_size = data_size;
+            memcpy(&ctx->hw.block[ctx->hw.block_size], data, copy_size);
+            ctx->hw.block_size += (uint32_t)copy_size;
+            if (ctx->hw.block_size == ATCA_SHA256_BLOCK_SIZE)
+            {
+                if ( (status = atca_sha_stream_submit(ctx, ctx->hw.block)) != ATCA_SUCCESS)
+                    break;
+                ctx->hw.block_size = 0;
+            }
+        }
+        ctx->stats.bytes += (uint32_t)copy_size;
+        data += copy_size;
+        data_size -= copy_size;
+    }
+
+    if (status != ATCA_SUCCESS)
+        atca_sha_stream_abort(ctx);
+
+    return status;
+}
+
+/** \brief complete a stream and return its digest, the device's session is closed
+ * \param[inout] ctx     stream state
+ * \param[out]   digest  SHA-256 digest of the message
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream_finish(ATCAShaStream* ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE])
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCASession* session;
+    uint32_t before;
+
+    if (ctx == NULL || digest == NULL)
+        return ATCA_BAD_PARAM;
+
+    if (ctx->software)
+        return atcac_sw_sha2_256_finish(&ctx->sw, digest) == ATCA_SUCCESS ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+    if (!ctx->started)
+        return ATCA_BAD_PARAM;
+
+    if (ctx->pending)
+        status = atca_sha_stream_collect(ctx);
+    if (status == ATCA_SUCCESS)
+    {
+        // the ATSHA204A has no End mode, the host pads and may need a second block
+        if (atgetifacecfg(atGetIFace(ctx->device))->devtype == ATSHA204A && ctx->hw.block_size + 9 > ATCA_SHA256_BLOCK_SIZE)
+            ctx->stats.commands += 2;
+        else
+            ctx->stats.commands += 1;
+
+        session = atGetSession(ctx->device);
+        before = session->awake_us;
+        status = atcab_hw_sha2_256_finish_ctx(ctx->device, &ctx->hw, digest);
+        ctx->stats.device_us += atca_sha_stream_session_us(before, session->awake_us);
+    }
+
+    ctx->started = false;
+    atcab_session_end_ctx(ctx->device);
+
+    return status;
+}
+
+/** \brief give up on a stream, waiting for a command still in flight and closing the
+ *         device's session
+ * \param[inout] ctx  stream state
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream_abort(ATCAShaStream* ctx)
+{
+    if (ctx == NULL)
+        return ATCA_BAD_PARAM;
+
+    if (ctx->started)
+    {
+        if (ctx->pending)
+            atca_sha_stream_collect(ctx);
+        ctx->started = false;
+        atcab_session_end_ctx(ctx->device);
+    }
+    memset(&ctx->hw, 0, sizeof(ctx->hw));
+    memset(&ctx->sw, 0, sizeof(ctx->sw));
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief report the work done by a stream so far, bytes_per_sec is computed here
+ * \param[in]  ctx    stream state
+ * \param[out] stats  receives the counters
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream_get_stats(const ATCAShaStream* ctx, ATCAShaStreamStats* stats)
+{
+    if (ctx == NULL || stats == NULL)
+        return ATCA_BAD_PARAM;
+
+    *stats = ctx->stats;
+    stats->bytes_per_sec = 0;
+    if (stats->device_us > 0)
+        stats->bytes_per_sec = (uint32_t)((uint64_t)stats->bytes * 1000000 / stats->device_us);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief hash a whole message with a stream, see atca_sha_stream_init()
+ * \param[in]  device          device to hash on, may be NULL without digest_on_chip
+ * \param[in]  digest_on_chip  true if the digest has to be computed by the device
+ * \param[in]  data            message
+ * \param[in]  data_size       number of bytes in data
+ * \param[out] digest          SHA-256 digest of the message
+ * \param[out] stats           receives the work done, may be NULL
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS atca_sha_stream(ATCADevice device, bool digest_on_chip, const uint8_t* data, size_t data_size,
+                            uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE], ATCAShaStreamStats* stats)
+{
+    ATCA_STATUS status;
+    ATCAShaStream ctx;
+
+    if ( (status = atca_sha_stream_init(&ctx, device, digest_on_chip)) != ATCA_SUCCESS)
+        return status;
+
+    if ( (status = atca_sha_stream_update(&ctx, data, data_size)) == ATCA_SUCCESS)
+        status = atca_sha_stream_finish(&ctx, digest);
+    else
+        atca_sha_stream_abort(&ctx);
+
+    if (stats != NULL)
+        atca_sha_stream_get_stats(&ctx, stats);
+
+    return status;
+}
+
+/** @} */
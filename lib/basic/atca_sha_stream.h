@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \brief  Streaming SHA-256 on the device, pipelined, with a software fallback
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATCA_SHA_STREAM_H_
+#define ATCA_SHA_STREAM_H_
+
+#include "cryptoauthlib.h"
+#include "crypto/atca_crypto_sw_sha2.h"
+
+/** \defgroup sha_stream Streaming SHA-256 (atca_sha_stream_)
+ *
+ * \brief
+ * Hashes a long message, a firmware image say, on the device's SHA engine. The whole
+ * message runs in one session, so the device is woken once instead of once per 64 byte
+ * block, and the command for the next block is built while the device executes the
+ * current one. Only a digest that has to end up inside the device (TempKey for a
+ * following Sign or GenDig) needs the device, every other stream is hashed by
+ * atcac_sw_sha2_256 behind the same calls, orders of magnitude faster.
+ *
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief work done by a stream, device time is what the execution layer accounts for
+ *         wakes, transfers and command execution */
+typedef struct
+{
+    uint32_t bytes;         // message bytes hashed
+    uint32_t commands;      // SHA commands sent to the device, 0 when hashed in software
+    uint64_t device_us;     // device time spent on the stream
+    uint32_t bytes_per_sec; // bytes / device_us, 0 in software or when no time was accounted
+    bool     software;      // true if atcac_sw_sha2_256 computed the digest
+} ATCAShaStreamStats;
+
+/** \brief state of one stream, owned by the caller */
+typedef struct
+{
+    ATCADevice         device;
+    bool               software;
+    bool               pending;     // a SHA update is executing on the device
+    bool               started;     // the stream holds a session on the device
+    ATCAPacket         packet[2];   // the command in flight and the one being built
+    int                current;     // index of the command in flight
+    atca_sha256_ctx_t  hw;          // message bytes not yet sent as a full block
+    atcac_sha2_256_ctx sw;
+    ATCAShaStreamStats stats;
+} ATCAShaStream;
+
+ATCA_STATUS atca_sha_stream_init(ATCAShaStream* ctx, ATCADevice device, bool digest_on_chip);
+ATCA_STATUS atca_sha_stream_update(ATCAShaStream* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atca_sha_stream_finish(ATCAShaStream* ctx, uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE]);
+ATCA_STATUS atca_sha_stream_abort(ATCAShaStream* ctx);
+ATCA_STATUS atca_sha_stream_get_stats(const ATCAShaStream* ctx, ATCAShaStreamStats* stats);
+ATCA_STATUS atca_sha_stream(ATCADevice device, bool digest_on_chip, const uint8_t* data, size_t data_size,
+                            uint8_t digest[ATCA_SHA2_256_DIGEST_SIZE], ATCAShaStreamStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
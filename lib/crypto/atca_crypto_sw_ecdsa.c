@@ -39,17 +39,445 @@
 
 
 #include "atca_crypto_sw_ecdsa.h"
+#include "atca_crypto_sw_p256.h"
+#include <string.h>
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifndef ATCA_NO_P256_TABLES
+
+/* Cache of precomputed tables for the public keys verified against most often, CA and
+ * signer keys on a gateway. A key starts as a candidate and gets a table once it has
+ * been seen ATCAC_SW_ECDSA_P256_CACHE_PROMOTE times. Candidates and tables have their
+ * own LRU slots, so a stream of one-off device keys churns the candidates without
+ * evicting any table. */
+
+typedef struct
+{
+    uint8_t            public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    atcac_sw_p256_key* key;         // precomputed table, NULL for a candidate
+    uint32_t           uses;        // verifications against the key
+    uint32_t           last_used;   // LRU clock, 0 for an empty slot
+    uint32_t           refs;        // verifications in flight using the table
+} atcac_sw_ecdsa_p256_cache_entry;
+
+static atcac_sw_ecdsa_p256_cache_entry atcac_sw_ecdsa_p256_cache[ATCAC_SW_ECDSA_P256_CACHE_SIZE * 2];
+static uint32_t atcac_sw_ecdsa_p256_cache_clock;
+static atcac_sw_ecdsa_p256_cache_stats_t atcac_sw_ecdsa_p256_cache_counts;
+#ifdef ATCA_USE_PTHREADS
+static pthread_mutex_t atcac_sw_ecdsa_p256_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void atcac_sw_ecdsa_p256_cache_enter(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_lock(&atcac_sw_ecdsa_p256_cache_lock);
+#endif
+}
+
+static void atcac_sw_ecdsa_p256_cache_leave(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_unlock(&atcac_sw_ecdsa_p256_cache_lock);
+#endif
+}
+
+/** \brief cache entry for a public key, NULL if it isn't cached. Caller holds the lock. */
+static atcac_sw_ecdsa_p256_cache_entry* atcac_sw_ecdsa_p256_cache_find(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(atcac_sw_ecdsa_p256_cache) / sizeof(atcac_sw_ecdsa_p256_cache[0]); i++)
+    {
+        atcac_sw_ecdsa_p256_cache_entry* entry = &atcac_sw_ecdsa_p256_cache[i];
+        if (entry->last_used != 0 && memcmp(entry->public_key, public_key, ATCA_ECC_P256_PUBLIC_KEY_SIZE) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+/** \brief least recently used entry that is free to reuse, among the entries with tables
+ *         or among the candidates and empty slots. Caller holds the lock.
+ * \param[in] with_table  non-zero to pick an entry with a table
+ * \param[in] count       receives the number of entries of that kind
+ * \return the entry, NULL if all of them are in use
+ */
+static atcac_sw_ecdsa_p256_cache_entry* atcac_sw_ecdsa_p256_cache_victim(int with_table, size_t* count)
+{
+    atcac_sw_ecdsa_p256_cache_entry* victim = NULL;
+    size_t i;
+
+    *count = 0;
+    for (i = 0; i < sizeof(atcac_sw_ecdsa_p256_cache) / sizeof(atcac_sw_ecdsa_p256_cache[0]); i++)
+    {
+        atcac_sw_ecdsa_p256_cache_entry* entry = &atcac_sw_ecdsa_p256_cache[i];
+        if ((entry->key != NULL) != (with_table != 0))
+            continue;
+        if (entry->last_used != 0)
+            (*count)++;
+        if (entry->refs == 0 && (victim == NULL || entry->last_used < victim->last_used))
+            victim = entry;
+    }
+    return victim;
+}
+
+/** \brief give a cache entry a freshly built table, evicting the least recently used
+ *         table if all the slots are taken. Caller holds the lock.
+ * \param[in] public_key  key the table was built for
+ * \param[in] key         the table, owned by the cache on success
+ * \return the entry now holding a table for public_key with a reference taken for the
+ *         caller, NULL when every table is in use and the key can't be cached
+ */
+static atcac_sw_ecdsa_p256_cache_entry* atcac_sw_ecdsa_p256_cache_insert(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE],
+                                                                         atcac_sw_p256_key* key)
+{
+    atcac_sw_ecdsa_p256_cache_entry* entry = atcac_sw_ecdsa_p256_cache_find(public_key);
+    atcac_sw_ecdsa_p256_cache_entry* victim;
+    size_t count;
+
+    if (entry != NULL && entry->key != NULL)
+    {
+        // Another thread got there first
+        atcac_sw_p256_key_free(key);
+        entry->refs++;
+        return entry;
+    }
+
+    victim = atcac_sw_ecdsa_p256_cache_victim(1, &count);
+    if (count >= ATCAC_SW_ECDSA_P256_CACHE_SIZE)
+    {
+        if (victim == NULL)
+            return NULL;
+        atcac_sw_p256_key_free(victim->key);
+        memset(victim, 0, sizeof(*victim));
+        atcac_sw_ecdsa_p256_cache_counts.evictions++;
+    }
+
+    if (entry == NULL)
+    {
+        entry = atcac_sw_ecdsa_p256_cache_victim(0, &count);
+        if (entry == NULL)
+            return NULL;
+        memcpy(entry->public_key, public_key, ATCA_ECC_P256_PUBLIC_KEY_SIZE);
+        entry->uses = 1;
+    }
+    entry->key = key;
+    entry->refs = 1;
+    entry->last_used = ++atcac_sw_ecdsa_p256_cache_clock;
+    atcac_sw_ecdsa_p256_cache_counts.builds++;
+    return entry;
+}
+
+/** \brief build a table for a public key and put it in the cache
+ * \param[in]  public_key  X then Y
+ * \param[out] key         the table, owned by the returned entry or, when that is NULL,
+ *                         by the caller. NULL if the key is off the curve or memory ran out.
+ * \return the cache entry with a reference taken for the caller, or NULL
+ */
+static atcac_sw_ecdsa_p256_cache_entry* atcac_sw_ecdsa_p256_cache_build(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE],
+                                                                        atcac_sw_p256_key** key)
+{
+    atcac_sw_ecdsa_p256_cache_entry* entry;
+
+    // Built outside the lock, it takes milliseconds
+    *key = atcac_sw_p256_key_new(public_key);
+    if (*key == NULL)
+        return NULL;
+
+    atcac_sw_ecdsa_p256_cache_enter();
+    entry = atcac_sw_ecdsa_p256_cache_insert(public_key, *key);
+    if (entry != NULL)
+        *key = entry->key;
+    atcac_sw_ecdsa_p256_cache_leave();
+
+    return entry;
+}
+
+static void atcac_sw_ecdsa_p256_cache_release(atcac_sw_ecdsa_p256_cache_entry* entry)
+{
+    atcac_sw_ecdsa_p256_cache_enter();
+    entry->refs--;
+    atcac_sw_ecdsa_p256_cache_leave();
+}
+
+#endif /* ATCA_NO_P256_TABLES */
 
 /** \brief return software generated ECDSA verification result
  * \param[in] msg         ptr to message or challenge
  * \param[in] signature   ptr to the signature to verify
  * \param[in] public_key  ptr to public key of device which signed the challenge
- * return ATCA_STATUS
+ *
+ * Keys verified against repeatedly get a precomputed table from the key cache, see
+ * atcac_sw_ecdsa_p256_cache_add().
+ *
+ * \return ATCA_SUCCESS if the signature is valid, ATCA_CHECKMAC_VERIFY_FAILED if it isn't,
+ *         ATCA_BAD_PARAM for a NULL pointer or a public key that isn't on the curve
  */
 
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
 {
-    return ATCA_UNIMPLEMENTED;
+#ifndef ATCA_NO_P256_TABLES
+    atcac_sw_ecdsa_p256_cache_entry* entry;
+    atcac_sw_p256_key* key = NULL;
+    size_t count;
+    int build = 0;
+    int ret;
+#endif
+
+    if (msg == NULL || signature == NULL || public_key == NULL)
+        return ATCA_BAD_PARAM;
+
+#ifndef ATCA_NO_P256_TABLES
+    atcac_sw_ecdsa_p256_cache_enter();
+    entry = atcac_sw_ecdsa_p256_cache_find(public_key);
+    if (entry != NULL)
+    {
+        entry->uses++;
+        entry->last_used = ++atcac_sw_ecdsa_p256_cache_clock;
+        if (entry->key != NULL)
+        {
+            entry->refs++;
+            key = entry->key;
+            atcac_sw_ecdsa_p256_cache_counts.hits++;
+        }
+        else
+        {
+            build = entry->uses >= ATCAC_SW_ECDSA_P256_CACHE_PROMOTE;
+        }
+    }
+    else if ((entry = atcac_sw_ecdsa_p256_cache_victim(0, &count)) != NULL)
+    {
+        memcpy(entry->public_key, public_key, ATCA_ECC_P256_PUBLIC_KEY_SIZE);
+        entry->uses = 1;
+        entry->last_used = ++atcac_sw_ecdsa_p256_cache_clock;
+        build = ATCAC_SW_ECDSA_P256_CACHE_PROMOTE <= 1;
+    }
+    if (key == NULL)
+        atcac_sw_ecdsa_p256_cache_counts.misses++;
+    atcac_sw_ecdsa_p256_cache_leave();
+
+    if (key != NULL)
+    {
+        ret = atcac_sw_p256_verify_key(msg, signature, key);
+        atcac_sw_ecdsa_p256_cache_release(entry);
+        return ret;
+    }
+    if (build)
+    {
+        entry = atcac_sw_ecdsa_p256_cache_build(public_key, &key);
+        if (key != NULL)
+        {
+            ret = atcac_sw_p256_verify_key(msg, signature, key);
+            if (entry != NULL)
+                atcac_sw_ecdsa_p256_cache_release(entry);
+            else
+                atcac_sw_p256_key_free(key);
+            return ret;
+        }
+    }
+#endif
+
+    return atcac_sw_p256_verify(msg, signature, public_key);
+}
+
+/* Items are handed out to the batch threads eight at a time, so each byte of the result
+ * bitmap has a single writer */
+typedef struct
+{
+    const atcac_sw_ecdsa_p256_item_t* items;
+    size_t                            count;
+    uint8_t*                          results;
+    size_t                            next;     // next group of eight to verify
+    size_t                            failures;
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_t                   lock;
+#endif
+} atcac_sw_ecdsa_p256_batch_t;
+
+static void* atcac_sw_ecdsa_p256_batch_worker(void* arg)
+{
+    atcac_sw_ecdsa_p256_batch_t* batch = (atcac_sw_ecdsa_p256_batch_t*)arg;
+    size_t failures = 0;
+    size_t group, i, end;
+    uint8_t bits;
+
+    for (;; )
+    {
+#ifdef ATCA_USE_PTHREADS
+        pthread_mutex_lock(&batch->lock);
+#endif
+        group = batch->next++;
+#ifdef ATCA_USE_PTHREADS
+        pthread_mutex_unlock(&batch->lock);
+#endif
+        if (group * 8 >= batch->count)
+            break;
+
+        bits = 0;
+        end = group * 8 + 8 < batch->count ? group * 8 + 8 : batch->count;
+        for (i = group * 8; i < end; i++)
+        {
+            const atcac_sw_ecdsa_p256_item_t* item = &batch->items[i];
+            if (atcac_sw_ecdsa_verify_p256(item->msg, item->signature, item->public_key) == ATCA_SUCCESS)
+                bits |= (uint8_t)(1 << (i % 8));
+            else
+                failures++;
+        }
+        batch->results[group] = bits;
+    }
+
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_lock(&batch->lock);
+#endif
+    batch->failures += failures;
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_unlock(&batch->lock);
+#endif
+    return NULL;
+}
+
+/** \brief verify many independent ECDSA signatures, spread over
+ *         ATCAC_SW_ECDSA_BATCH_THREADS threads when built with ATCA_USE_PTHREADS. Keys
+ *         shared across the batch, such as the signer key of a fleet of device
+ *         certificates, get a cached table after a few uses.
+ *
+ * Signatures are checked one by one rather than with a randomized batch equation:
+ * that needs the full point R, which an ECDSA signature only carries as x mod n.
+ *
+ * \param[in]  items    signatures to check. Items with a NULL member fail.
+ * \param[in]  count    number of items
+ * \param[out] results  bitmap of (count + 7) / 8 bytes, bit i % 8 of byte i / 8 set when
+ *                      item i verifies
+ * \return ATCA_SUCCESS when every item verifies, ATCA_CHECKMAC_VERIFY_FAILED when any
+ *         doesn't, ATCA_BAD_PARAM for NULL arrays
+ */
+int atcac_sw_ecdsa_verify_p256_batch(const atcac_sw_ecdsa_p256_item_t items[], size_t count, uint8_t results[])
+{
+    atcac_sw_ecdsa_p256_batch_t batch;
+
+#ifdef ATCA_USE_PTHREADS
+    pthread_t threads[64];
+    long threads_max = ATCAC_SW_ECDSA_BATCH_THREADS;
+    size_t threads_started = 0;
+    size_t i;
+#endif
+
+    if (count == 0)
+        return ATCA_SUCCESS;
+    if (items == NULL || results == NULL)
+        return ATCA_BAD_PARAM;
+
+    batch.items = items;
+    batch.count = count;
+    batch.results = results;
+    batch.next = 0;
+    batch.failures = 0;
+
+#ifdef ATCA_USE_PTHREADS
+    if (threads_max <= 0)
+        threads_max = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads_max > (long)(sizeof(threads) / sizeof(threads[0])) + 1)
+        threads_max = (long)(sizeof(threads) / sizeof(threads[0])) + 1;
+    if (threads_max > (long)((count + 7) / 8))
+        threads_max = (long)((count + 7) / 8);
+
+    pthread_mutex_init(&batch.lock, NULL);
+    while ((long)threads_started + 1 < threads_max &&
+           pthread_create(&threads[threads_started], NULL, atcac_sw_ecdsa_p256_batch_worker, &batch) == 0)
+        threads_started++;
+#endif
+
+    // The calling thread works through the batch too
+    atcac_sw_ecdsa_p256_batch_worker(&batch);
+
+#ifdef ATCA_USE_PTHREADS
+    for (i = 0; i < threads_started; i++)
+        pthread_join(threads[i], NULL);
+    pthread_mutex_destroy(&batch.lock);
+#endif
+
+    return batch.failures == 0 ? ATCA_SUCCESS : ATCA_CHECKMAC_VERIFY_FAILED;
+}
+
+/** \brief give a public key a precomputed table in the verification key cache right away,
+ *         for long-lived keys such as CA keys that are known to be verified against often.
+ *         The least recently used table is evicted when the cache is full.
+ * \param[in] public_key  X then Y
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM for a public key that isn't on the curve,
+ *         ATCA_FUNC_FAIL when out of memory or every cached table is in use
+ */
+int atcac_sw_ecdsa_p256_cache_add(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    if (public_key == NULL || atcac_sw_p256_check_pubkey(public_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+
+#ifndef ATCA_NO_P256_TABLES
+    {
+        atcac_sw_ecdsa_p256_cache_entry* entry;
+        atcac_sw_p256_key* key;
+
+        atcac_sw_ecdsa_p256_cache_enter();
+        entry = atcac_sw_ecdsa_p256_cache_find(public_key);
+        if (entry != NULL && entry->key != NULL)
+        {
+            entry->last_used = ++atcac_sw_ecdsa_p256_cache_clock;
+            atcac_sw_ecdsa_p256_cache_leave();
+            return ATCA_SUCCESS;
+        }
+        atcac_sw_ecdsa_p256_cache_leave();
+
+        entry = atcac_sw_ecdsa_p256_cache_build(public_key, &key);
+        if (entry == NULL)
+        {
+            atcac_sw_p256_key_free(key);
+            return ATCA_FUNC_FAIL;
+        }
+        atcac_sw_ecdsa_p256_cache_release(entry);
+    }
+#endif
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief drop every cached table and candidate. Tables in use by a verification in
+ *         another thread are left in place. */
+void atcac_sw_ecdsa_p256_cache_clear(void)
+{
+#ifndef ATCA_NO_P256_TABLES
+    size_t i;
+
+    atcac_sw_ecdsa_p256_cache_enter();
+    for (i = 0; i < sizeof(atcac_sw_ecdsa_p256_cache) / sizeof(atcac_sw_ecdsa_p256_cache[0]); i++)
+    {
+        atcac_sw_ecdsa_p256_cache_entry* entry = &atcac_sw_ecdsa_p256_cache[i];
+        if (entry->refs == 0)
+        {
+            atcac_sw_p256_key_free(entry->key);
+            memset(entry, 0, sizeof(*entry));
+        }
+    }
+    memset(&atcac_sw_ecdsa_p256_cache_counts, 0, sizeof(atcac_sw_ecdsa_p256_cache_counts));
+    atcac_sw_ecdsa_p256_cache_leave();
+#endif
+}
+
+/** \brief counters for the verification key cache since the last clear
+ * \param[out] stats  receives the counters, all zero when tables are compiled out
+ */
+void atcac_sw_ecdsa_p256_cache_stats(atcac_sw_ecdsa_p256_cache_stats_t* stats)
+{
+    if (stats == NULL)
+        return;
+
+#ifndef ATCA_NO_P256_TABLES
+    atcac_sw_ecdsa_p256_cache_enter();
+    *stats = atcac_sw_ecdsa_p256_cache_counts;
+    atcac_sw_ecdsa_p256_cache_leave();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
 }
\ No newline at end of file
@@ -57,6 +57,39 @@
 #define ATCA_ECC_P256_PUBLIC_KEY_SIZE  (ATCA_ECC_P256_FIELD_SIZE * 2)
 #define ATCA_ECC_P256_SIGNATURE_SIZE   (ATCA_ECC_P256_FIELD_SIZE * 2)
 
+/* Public keys atcac_sw_ecdsa_verify_p256() keeps precomputed tables for, about 53 KB each */
+#ifndef ATCAC_SW_ECDSA_P256_CACHE_SIZE
+#define ATCAC_SW_ECDSA_P256_CACHE_SIZE    4
+#endif
+
+/* Verifications against a key before it gets a table. Building one costs about as much
+   as seven verifications and makes each later one three times faster. */
+#ifndef ATCAC_SW_ECDSA_P256_CACHE_PROMOTE
+#define ATCAC_SW_ECDSA_P256_CACHE_PROMOTE 3
+#endif
+
+/* Threads atcac_sw_ecdsa_verify_p256_batch() spreads a batch over, counting the caller.
+   0 for one per online CPU. */
+#ifndef ATCAC_SW_ECDSA_BATCH_THREADS
+#define ATCAC_SW_ECDSA_BATCH_THREADS      0
+#endif
+
+/** \brief one signature for atcac_sw_ecdsa_verify_p256_batch() */
+typedef struct
+{
+    const uint8_t* msg;         //!< 32-byte digest that was signed
+    const uint8_t* signature;   //!< 64-byte signature, R then S
+    const uint8_t* public_key;  //!< 64-byte public key, X then Y
+} atcac_sw_ecdsa_p256_item_t;
+
+typedef struct
+{
+    uint32_t hits;          //!< verifications that used a cached table
+    uint32_t misses;        //!< verifications without one
+    uint32_t builds;        //!< tables built
+    uint32_t evictions;     //!< tables dropped to make room for another key
+} atcac_sw_ecdsa_p256_cache_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -64,6 +97,10 @@ extern "C" {
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_ecdsa_verify_p256_batch(const atcac_sw_ecdsa_p256_item_t items[], size_t count, uint8_t results[]);
+int atcac_sw_ecdsa_p256_cache_add(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+void atcac_sw_ecdsa_p256_cache_clear(void);
+void atcac_sw_ecdsa_p256_cache_stats(atcac_sw_ecdsa_p256_cache_stats_t* stats);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,1340 @@
+/**
+ * \file
+ * \brief  Software implementation of the NIST P-256 curve: key generation, ECDSA and ECDH
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atca_crypto_sw_p256.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/** \defgroup atcac_ Software crypto methods (atcac_)
+   @{ */
+
+/* Integers modulo p (field elements) and modulo n (scalars) are held as four 64-bit
+ * limbs, least significant first, in Montgomery form with R = 2^256. Points are in
+ * Jacobian coordinates (X, Y, Z) standing for (X/Z^2, Y/Z^3), Z = 0 is the point at
+ * infinity. */
+
+typedef uint64_t p256_int[4];
+
+typedef struct
+{
+    p256_int m;        // modulus
+    uint64_t m0inv;    // -m^-1 mod 2^64
+    p256_int rr;       // R^2 mod m
+} p256_mod_t;
+
+typedef struct
+{
+    p256_int x;
+    p256_int y;
+    p256_int z;
+} p256_point_t;
+
+static const p256_mod_t p256_p = {
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000001ULL },
+    0x0000000000000001ULL,
+    { 0x0000000000000003ULL, 0xFFFFFFFBFFFFFFFFULL, 0xFFFFFFFFFFFFFFFEULL, 0x00000004FFFFFFFDULL }
+};
+
+static const p256_mod_t p256_n = {
+    { 0xF3B9CAC2FC632551ULL, 0xBCE6FAADA7179E84ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF00000000ULL },
+    0xCCD1C8AAEE00BC4FULL,
+    { 0x83244C95BE79EEA2ULL, 0x4699799C49BD6FA6ULL, 0x2845B2392B6BEC59ULL, 0x66E12D94F3D95620ULL }
+};
+
+static const p256_int p256_b = {
+    0x3BCE3C3E27D2604BULL, 0x651D06B0CC53B0F6ULL, 0xB3EBBD55769886BCULL, 0x5AC635D8AA3A93E7ULL
+};
+
+static const p256_int p256_gx = {
+    0xF4A13945D898C296ULL, 0x77037D812DEB33A0ULL, 0xF8BCE6E563A440F2ULL, 0x6B17D1F2E12C4247ULL
+};
+
+static const p256_int p256_gy = {
+    0xCBB6406837BF51F5ULL, 0x2BCE33576B315ECEULL, 0x8EE7EB4A7C0F9E16ULL, 0x4FE342E2FE1A7F9BULL
+};
+
+static const p256_int p256_one = { 1, 0, 0, 0 };
+
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 p256_u128;
+
+/* One row of a 4x4 limb product: (x0..x4) += (a0..a3) * b, x4 receiving the carry out */
+#define P256_MUL_ROW(x0, x1, x2, x3, x4, b)                 \
+    do {                                                    \
+        t = (p256_u128)a[0] * (b) + x0;                     \
+        x0 = (uint64_t)t;                                   \
+        t = (p256_u128)a[1] * (b) + x1 + (uint64_t)(t >> 64); \
+        x1 = (uint64_t)t;                                   \
+        t = (p256_u128)a[2] * (b) + x2 + (uint64_t)(t >> 64); \
+        x2 = (uint64_t)t;                                   \
+        t = (p256_u128)a[3] * (b) + x3 + (uint64_t)(t >> 64); \
+        x3 = (uint64_t)t;                                   \
+        x4 = (uint64_t)(t >> 64);                           \
+    } while (0)
+
+/* One generic Montgomery reduction step, clearing x0 */
+#define P256_MONT_STEP(x0, x1, x2, x3, x4)                          \
+    do {                                                            \
+        u = x0 * m->m0inv;                                          \
+        t = (p256_u128)u * m->m[0] + x0;                            \
+        t = (p256_u128)u * m->m[1] + x1 + (uint64_t)(t >> 64);      \
+        x1 = (uint64_t)t;                                           \
+        t = (p256_u128)u * m->m[2] + x2 + (uint64_t)(t >> 64);      \
+        x2 = (uint64_t)t;                                           \
+        t = (p256_u128)u * m->m[3] + x3 + (uint64_t)(t >> 64);      \
+        x3 = (uint64_t)t;                                           \
+        t = (p256_u128)x4 + top + (uint64_t)(t >> 64);              \
+        x4 = (uint64_t)t;                                           \
+        top = (uint64_t)(t >> 64);                                  \
+    } while (0)
+
+#else
+/** \brief a * b + c + carry as a 128-bit result, low half returned, high half left in carry */
+static uint64_t p256_mac(uint64_t a, uint64_t b, uint64_t c, uint64_t *carry)
+{
+    uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    uint64_t lo = (ll & 0xFFFFFFFF) | (mid << 32);
+    uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+    lo += c;
+    hi += (lo < c);
+    lo += *carry;
+    hi += (lo < *carry);
+    *carry = hi;
+    return lo;
+}
+#endif
+
+/** \brief r = a + b, returns the carry out */
+static uint64_t p256_add_raw(p256_int r, const p256_int a, const p256_int b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 t;
+
+    t = (unsigned __int128)a[0] + b[0];
+    r[0] = (uint64_t)t;
+    t = (unsigned __int128)a[1] + b[1] + (uint64_t)(t >> 64);
+    r[1] = (uint64_t)t;
+    t = (unsigned __int128)a[2] + b[2] + (uint64_t)(t >> 64);
+    r[2] = (uint64_t)t;
+    t = (unsigned __int128)a[3] + b[3] + (uint64_t)(t >> 64);
+    r[3] = (uint64_t)t;
+    return (uint64_t)(t >> 64);
+#else
+    uint64_t carry = 0;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        uint64_t t = a[i] + carry;
+        carry = (t < carry);
+        r[i] = t + b[i];
+        carry += (r[i] < t);
+    }
+    return carry;
+#endif
+}
+
+/** \brief r = a - b, returns the borrow out */
+static uint64_t p256_sub_raw(p256_int r, const p256_int a, const p256_int b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 t;
+
+    t = (unsigned __int128)a[0] - b[0];
+    r[0] = (uint64_t)t;
+    t = (unsigned __int128)a[1] - b[1] - ((uint64_t)(t >> 64) & 1);
+    r[1] = (uint64_t)t;
+    t = (unsigned __int128)a[2] - b[2] - ((uint64_t)(t >> 64) & 1);
+    r[2] = (uint64_t)t;
+    t = (unsigned __int128)a[3] - b[3] - ((uint64_t)(t >> 64) & 1);
+    r[3] = (uint64_t)t;
+    return (uint64_t)(t >> 64) & 1;
+#else
+    uint64_t borrow = 0;
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        uint64_t t = a[i] - borrow;
+        borrow = (a[i] < borrow);
+        borrow += (t < b[i]);
+        r[i] = t - b[i];
+    }
+    return borrow;
+#endif
+}
+
+/** \brief r = a when mask is all ones, left alone when it is zero */
+static void p256_select(p256_int r, const p256_int a, uint64_t mask)
+{
+    r[0] = (r[0] & ~mask) | (a[0] & mask);
+    r[1] = (r[1] & ~mask) | (a[1] & mask);
+    r[2] = (r[2] & ~mask) | (a[2] & mask);
+    r[3] = (r[3] & ~mask) | (a[3] & mask);
+}
+
+static int p256_is_zero(const p256_int a)
+{
+    return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+static int p256_equal(const p256_int a, const p256_int b)
+{
+    return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) == 0;
+}
+
+/** \brief non-zero when a < m */
+static int p256_less_than(const p256_int a, const p256_int m)
+{
+    p256_int t;
+
+    return (int)p256_sub_raw(t, a, m);
+}
+
+/** \brief r = a + b mod m, inputs below m */
+static void p256_mod_add(p256_int r, const p256_int a, const p256_int b, const p256_mod_t *m)
+{
+    p256_int t;
+    uint64_t carry = p256_add_raw(r, a, b);
+    uint64_t borrow = p256_sub_raw(t, r, m->m);
+
+    // subtract m when the sum overflowed or is at least m
+    p256_select(r, t, (uint64_t)0 - (carry | (borrow ^ 1)));
+}
+
+/** \brief r = a - b mod m, inputs below m */
+static void p256_mod_sub(p256_int r, const p256_int a, const p256_int b, const p256_mod_t *m)
+{
+    p256_int t;
+    uint64_t borrow = p256_sub_raw(r, a, b);
+
+    p256_add_raw(t, r, m->m);
+    p256_select(r, t, (uint64_t)0 - borrow);
+}
+
+/** \brief Montgomery product r = a * b / R mod m, inputs below m */
+static void p256_mont_mul(p256_int r, const p256_int a, const p256_int b, const p256_mod_t *m)
+{
+#ifdef __SIZEOF_INT128__
+    uint64_t x0 = 0, x1 = 0, x2 = 0, x3 = 0, x4, x5, x6, x7;
+    uint64_t u, top = 0, borrow;
+    p256_u128 t;
+    p256_int d;
+
+    P256_MUL_ROW(x0, x1, x2, x3, x4, b[0]);
+    x5 = 0;
+    P256_MUL_ROW(x1, x2, x3, x4, x5, b[1]);
+    x6 = 0;
+    P256_MUL_ROW(x2, x3, x4, x5, x6, b[2]);
+    x7 = 0;
+    P256_MUL_ROW(x3, x4, x5, x6, x7, b[3]);
+
+    P256_MONT_STEP(x0, x1, x2, x3, x4);
+    P256_MONT_STEP(x1, x2, x3, x4, x5);
+    P256_MONT_STEP(x2, x3, x4, x5, x6);
+    P256_MONT_STEP(x3, x4, x5, x6, x7);
+
+    r[0] = x4;
+    r[1] = x5;
+    r[2] = x6;
+    r[3] = x7;
+    borrow = p256_sub_raw(d, r, m->m);
+    p256_select(r, d, (uint64_t)0 - (top | (borrow ^ 1)));
+#else
+    uint64_t t[6] = { 0, 0, 0, 0, 0, 0 };
+    uint64_t carry, u, s;
+    p256_int d;
+    int i, j;
+
+    for (i = 0; i < 4; i++)
+    {
+        carry = 0;
+        for (j = 0; j < 4; j++)
+            t[j] = p256_mac(a[j], b[i], t[j], &carry);
+        t[4] += carry;
+        t[5] = (t[4] < carry);
+
+        u = t[0] * m->m0inv;
+        carry = 0;
+        p256_mac(u, m->m[0], t[0], &carry);
+        for (j = 1; j < 4; j++)
+            t[j - 1] = p256_mac(u, m->m[j], t[j], &carry);
+        s = t[4] + carry;
+        t[3] = s;
+        t[4] = t[5] + (s < carry);
+    }
+
+    // t < 2m, one conditional subtraction brings it below m
+    s = p256_sub_raw(d, t, m->m);
+    memcpy(r, t, sizeof(p256_int));
+    p256_select(r, d, (uint64_t)0 - (t[4] | (s ^ 1)));
+#endif
+}
+
+static void p256_mont_sqr(p256_int r, const p256_int a, const p256_mod_t *m)
+{
+    p256_mont_mul(r, a, a, m);
+}
+
+static void p256_to_mont(p256_int r, const p256_int a, const p256_mod_t *m)
+{
+    p256_mont_mul(r, a, m->rr, m);
+}
+
+static void p256_from_mont(p256_int r, const p256_int a, const p256_mod_t *m)
+{
+    p256_mont_mul(r, a, p256_one, m);
+}
+
+/** \brief r = a^-1 mod m in Montgomery form, by Fermat's little theorem (a^(m-2)) */
+static void p256_mont_inv(p256_int r, const p256_int a, const p256_mod_t *m)
+{
+    static const p256_int two = { 2, 0, 0, 0 };
+    p256_int e, acc;
+    int i;
+
+    p256_sub_raw(e, m->m, two);
+    p256_to_mont(acc, p256_one, m);
+    for (i = 255; i >= 0; i--)
+    {
+        p256_mont_sqr(acc, acc, m);
+        if ((e[i / 64] >> (i % 64)) & 1)
+            p256_mont_mul(acc, acc, a, m);
+    }
+    memcpy(r, acc, sizeof(p256_int));
+}
+
+#ifdef __SIZEOF_INT128__
+/* One Montgomery reduction step mod p, clearing x0. p[0] = 2^64 - 1 makes the quotient
+   x0 itself with u * p[0] + x0 = u * 2^64, and p[2] = 0 drops a multiply. */
+#define P256_REDUCE_STEP(x0, x1, x2, x3, x4)                            \
+    do {                                                                \
+        t = (p256_u128)x0 * 0x00000000FFFFFFFFULL + x1 + x0;            \
+        x1 = (uint64_t)t;                                               \
+        t = (p256_u128)x2 + (uint64_t)(t >> 64);                        \
+        x2 = (uint64_t)t;                                               \
+        t = (p256_u128)x0 * 0xFFFFFFFF00000001ULL + x3 + (uint64_t)(t >> 64); \
+        x3 = (uint64_t)t;                                               \
+        t = (p256_u128)x4 + top + (uint64_t)(t >> 64);                  \
+        x4 = (uint64_t)t;                                               \
+        top = (uint64_t)(t >> 64);                                      \
+    } while (0)
+
+/** \brief Montgomery reduction of a 512-bit product mod p into r */
+static void p256_fe_reduce(p256_int r, uint64_t x0, uint64_t x1, uint64_t x2, uint64_t x3,
+                           uint64_t x4, uint64_t x5, uint64_t x6, uint64_t x7)
+{
+    p256_u128 t;
+    uint64_t top = 0, borrow;
+    p256_int d;
+
+    P256_REDUCE_STEP(x0, x1, x2, x3, x4);
+    P256_REDUCE_STEP(x1, x2, x3, x4, x5);
+    P256_REDUCE_STEP(x2, x3, x4, x5, x6);
+    P256_REDUCE_STEP(x3, x4, x5, x6, x7);
+
+    // x4..x7 + top * 2^256 < 2p, one conditional subtraction brings it below p
+    r[0] = x4;
+    r[1] = x5;
+    r[2] = x6;
+    r[3] = x7;
+    borrow = p256_sub_raw(d, r, p256_p.m);
+    p256_select(r, d, (uint64_t)0 - (top | (borrow ^ 1)));
+}
+
+/** \brief r = a * b / R mod p, the hot path of every point operation */
+static void p256_fe_mul(p256_int r, const p256_int a, const p256_int b)
+{
+    uint64_t x0 = 0, x1 = 0, x2 = 0, x3 = 0, x4, x5, x6, x7;
+    p256_u128 t;
+
+    P256_MUL_ROW(x0, x1, x2, x3, x4, b[0]);
+    x5 = 0;
+    P256_MUL_ROW(x1, x2, x3, x4, x5, b[1]);
+    x6 = 0;
+    P256_MUL_ROW(x2, x3, x4, x5, x6, b[2]);
+    x7 = 0;
+    P256_MUL_ROW(x3, x4, x5, x6, x7, b[3]);
+    p256_fe_reduce(r, x0, x1, x2, x3, x4, x5, x6, x7);
+}
+
+/** \brief r = a^2 / R mod p, cross products computed once and doubled */
+static void p256_fe_sqr(p256_int r, const p256_int a)
+{
+    uint64_t x0, x1, x2, x3, x4, x5, x6, x7;
+    p256_u128 t;
+
+    t = (p256_u128)a[0] * a[1];
+    x1 = (uint64_t)t;
+    t = (p256_u128)a[0] * a[2] + (uint64_t)(t >> 64);
+    x2 = (uint64_t)t;
+    t = (p256_u128)a[0] * a[3] + (uint64_t)(t >> 64);
+    x3 = (uint64_t)t;
+    x4 = (uint64_t)(t >> 64);
+    t = (p256_u128)a[1] * a[2] + x3;
+    x3 = (uint64_t)t;
+    t = (p256_u128)a[1] * a[3] + x4 + (uint64_t)(t >> 64);
+    x4 = (uint64_t)t;
+    x5 = (uint64_t)(t >> 64);
+    t = (p256_u128)a[2] * a[3] + x5;
+    x5 = (uint64_t)t;
+    x6 = (uint64_t)(t >> 64);
+
+    x7 = x6 >> 63;
+    x6 = (x6 << 1) | (x5 >> 63);
+    x5 = (x5 << 1) | (x4 >> 63);
+    x4 = (x4 << 1) | (x3 >> 63);
+    x3 = (x3 << 1) | (x2 >> 63);
+    x2 = (x2 << 1) | (x1 >> 63);
+    x1 <<= 1;
+
+    t = (p256_u128)a[0] * a[0];
+    x0 = (uint64_t)t;
+    t = (p256_u128)x1 + (uint64_t)(t >> 64);
+    x1 = (uint64_t)t;
+    t = (p256_u128)a[1] * a[1] + x2 + (uint64_t)(t >> 64);
+    x2 = (uint64_t)t;
+    t = (p256_u128)x3 + (uint64_t)(t >> 64);
+    x3 = (uint64_t)t;
+    t = (p256_u128)a[2] * a[2] + x4 + (uint64_t)(t >> 64);
+    x4 = (uint64_t)t;
+    t = (p256_u128)x5 + (uint64_t)(t >> 64);
+    x5 = (uint64_t)t;
+    t = (p256_u128)a[3] * a[3] + x6 + (uint64_t)(t >> 64);
+    x6 = (uint64_t)t;
+    x7 += (uint64_t)(t >> 64);
+    p256_fe_reduce(r, x0, x1, x2, x3, x4, x5, x6, x7);
+}
+#else
+static void p256_fe_mul(p256_int r, const p256_int a, const p256_int b)
+{
+    p256_mont_mul(r, a, b, &p256_p);
+}
+
+static void p256_fe_sqr(p256_int r, const p256_int a)
+{
+    p256_mont_mul(r, a, a, &p256_p);
+}
+#endif
+
+/** \brief r = a^-1 mod p in Montgomery form, a^(p-2) with p-2 a public exponent */
+static void p256_fe_inv(p256_int r, const p256_int a)
+{
+    static const p256_int two = { 2, 0, 0, 0 };
+    p256_int e, acc;
+    int i;
+
+    p256_sub_raw(e, p256_p.m, two);
+    memcpy(acc, a, sizeof(p256_int));
+    for (i = 254; i >= 0; i--)       // bit 255 of p-2 is set and already in acc
+    {
+        p256_fe_sqr(acc, acc);
+        if ((e[i / 64] >> (i % 64)) & 1)
+            p256_fe_mul(acc, acc, a);
+    }
+    memcpy(r, acc, sizeof(p256_int));
+}
+
+/** \brief all ones when a is zero, zero otherwise, without branching */
+static uint64_t p256_zero_mask(const p256_int a)
+{
+    uint64_t z = a[0] | a[1] | a[2] | a[3];
+
+    return ((z | ((uint64_t)0 - z)) >> 63) - 1;
+}
+
+static void p256_from_bytes(p256_int r, const uint8_t bytes[32])
+{
+    int i, j;
+
+    for (i = 0; i < 4; i++)
+    {
+        r[i] = 0;
+        for (j = 0; j < 8; j++)
+            r[i] = (r[i] << 8) | bytes[(3 - i) * 8 + j];
+    }
+}
+
+static void p256_to_bytes(uint8_t bytes[32], const p256_int a)
+{
+    int i, j;
+
+    for (i = 0; i < 4; i++)
+        for (j = 0; j < 8; j++)
+            bytes[(3 - i) * 8 + j] = (uint8_t)(a[i] >> (56 - 8 * j));
+}
+
+/** \brief r = a mod n for any 256-bit a, a single subtraction since 2^256 < 2n */
+static void p256_reduce_n(p256_int r, const p256_int a)
+{
+    p256_int t;
+    uint64_t borrow = p256_sub_raw(t, a, p256_n.m);
+
+    memcpy(r, a, sizeof(p256_int));
+    p256_select(r, t, (uint64_t)0 - (borrow ^ 1));
+}
+
+static void p256_point_set_infinity(p256_point_t *r)
+{
+    memset(r, 0, sizeof(*r));
+}
+
+static int p256_point_is_infinity(const p256_point_t *a)
+{
+    return p256_is_zero(a->z);
+}
+
+/** \brief r = a when mask is all ones, left alone when it is zero */
+static void p256_point_select(p256_point_t *r, const p256_point_t *a, uint64_t mask)
+{
+    p256_select(r->x, a->x, mask);
+    p256_select(r->y, a->y, mask);
+    p256_select(r->z, a->z, mask);
+}
+
+/** \brief r = 2a, dbl-2001-b for a = -3. Without branches: Z = 0 (infinity) gives
+ *         Z3 = 0 and P-256 has no point with Y = 0. */
+static void p256_point_double(p256_point_t *r, const p256_point_t *a)
+{
+    const p256_mod_t *m = &p256_p;
+    p256_int delta, gamma, beta, alpha, t1, t2;
+
+    p256_fe_sqr(delta, a->z);
+    p256_fe_sqr(gamma, a->y);
+    p256_fe_mul(beta, a->x, gamma);
+
+    // alpha = 3 * (X - delta) * (X + delta)
+    p256_mod_sub(t1, a->x, delta, m);
+    p256_mod_add(t2, a->x, delta, m);
+    p256_fe_mul(alpha, t1, t2);
+    p256_mod_add(t1, alpha, alpha, m);
+    p256_mod_add(alpha, t1, alpha, m);
+
+    // Z3 = (Y + Z)^2 - gamma - delta
+    p256_mod_add(t1, a->y, a->z, m);
+    p256_fe_sqr(t1, t1);
+    p256_mod_sub(t1, t1, gamma, m);
+    p256_mod_sub(r->z, t1, delta, m);
+
+    // X3 = alpha^2 - 8 * beta
+    p256_mod_add(beta, beta, beta, m);
+    p256_mod_add(beta, beta, beta, m);          // 4 * beta
+    p256_fe_sqr(t1, alpha);
+    p256_mod_add(t2, beta, beta, m);
+    p256_mod_sub(r->x, t1, t2, m);
+
+    // Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+    p256_mod_sub(t1, beta, r->x, m);
+    p256_fe_mul(t1, alpha, t1);
+    p256_fe_sqr(t2, gamma);
+    p256_mod_add(t2, t2, t2, m);
+    p256_mod_add(t2, t2, t2, m);
+    p256_mod_add(t2, t2, t2, m);
+    p256_mod_sub(r->y, t1, t2, m);
+}
+
+/** \brief r = a + b with add-2007-bl, no special cases. a == b gives infinity, which
+ *         callers rule out; a or b at infinity gives garbage, which callers select away.
+ *         Returns H and R2 = 2 * (S2 - S1), both zero when a == b. */
+static void p256_point_add_formula(p256_point_t *r, const p256_point_t *a, const p256_point_t *b,
+                                   p256_int h, p256_int rr)
+{
+    const p256_mod_t *m = &p256_p;
+    p256_int z1z1, z2z2, u1, u2, s1, s2, i, j, v, t;
+
+    p256_fe_sqr(z1z1, a->z);
+    p256_fe_sqr(z2z2, b->z);
+    p256_fe_mul(u1, a->x, z2z2);
+    p256_fe_mul(u2, b->x, z1z1);
+    p256_fe_mul(s1, a->y, b->z);
+    p256_fe_mul(s1, s1, z2z2);
+    p256_fe_mul(s2, b->y, a->z);
+    p256_fe_mul(s2, s2, z1z1);
+
+    p256_mod_sub(h, u2, u1, m);
+    p256_mod_sub(rr, s2, s1, m);
+
+    p256_mod_add(i, h, h, m);
+    p256_fe_sqr(i, i);                          // I = (2H)^2
+    p256_fe_mul(j, h, i);                       // J = H * I
+    p256_mod_add(rr, rr, rr, m);                // r = 2 * (S2 - S1)
+    p256_fe_mul(v, u1, i);                      // V = U1 * I
+
+    // Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H, before X3 and Y3 overwrite an aliased input
+    p256_mod_add(t, a->z, b->z, m);
+    p256_fe_sqr(t, t);
+    p256_mod_sub(t, t, z1z1, m);
+    p256_mod_sub(t, t, z2z2, m);
+    p256_fe_mul(r->z, t, h);
+
+    // X3 = r^2 - J - 2V
+    p256_fe_sqr(t, rr);
+    p256_mod_sub(t, t, j, m);
+    p256_mod_sub(t, t, v, m);
+    p256_mod_sub(r->x, t, v, m);
+
+    // Y3 = r * (V - X3) - 2 * S1 * J
+    p256_mod_sub(t, v, r->x, m);
+    p256_fe_mul(t, rr, t);
+    p256_fe_mul(s1, s1, j);
+    p256_mod_add(s1, s1, s1, m);
+    p256_mod_sub(r->y, t, s1, m);
+}
+
+/** \brief r = a + b for public points, falls back to doubling when a == b */
+static void p256_point_add(p256_point_t *r, const p256_point_t *a, const p256_point_t *b)
+{
+    p256_point_t sum;
+    p256_int h, rr;
+
+    if (p256_point_is_infinity(a))
+    {
+        *r = *b;
+        return;
+    }
+    if (p256_point_is_infinity(b))
+    {
+        *r = *a;
+        return;
+    }
+
+    p256_point_add_formula(&sum, a, b, h, rr);
+    if (p256_is_zero(h) && p256_is_zero(rr))
+        p256_point_double(r, a);
+    else
+        *r = sum;                               // a == -b leaves Z3 = 0, the point at infinity
+}
+
+/** \brief r = a + b without branches on the points, for secret scalar multiplication.
+ *         Either input may be infinity; a == b must not occur. */
+static void p256_point_add_ct(p256_point_t *r, const p256_point_t *a, const p256_point_t *b)
+{
+    p256_point_t sum;
+    p256_int h, rr;
+    uint64_t a_inf = p256_zero_mask(a->z);
+    uint64_t b_inf = p256_zero_mask(b->z);
+
+    p256_point_add_formula(&sum, a, b, h, rr);
+    p256_point_select(&sum, a, b_inf);
+    p256_point_select(&sum, b, a_inf);
+    *r = sum;
+}
+
+/** \brief r = -a */
+static void p256_point_negate(p256_point_t *r, const p256_point_t *a)
+{
+    static const p256_int zero = { 0, 0, 0, 0 };
+
+    memcpy(r->x, a->x, sizeof(p256_int));
+    p256_mod_sub(r->y, zero, a->y, &p256_p);
+    memcpy(r->z, a->z, sizeof(p256_int));
+}
+
+/** \brief r = k * a for a secret k in constant time: fixed 4-bit windows, every table
+ *         entry read for each window and no branches on k. Requires k < n. */
+static void p256_point_mul_ct(p256_point_t *r, const p256_int k, const p256_point_t *a)
+{
+    p256_point_t table[16], acc, t;
+    uint64_t digit;
+    int i, j;
+
+    p256_point_set_infinity(&table[0]);
+    table[1] = *a;
+    for (i = 2; i < 16; i++)
+    {
+        if (i & 1)
+            p256_point_add_ct(&table[i], &table[i - 1], a);
+        else
+            p256_point_double(&table[i], &table[i / 2]);
+    }
+
+    p256_point_set_infinity(&acc);
+    for (i = 63; i >= 0; i--)
+    {
+        p256_point_double(&acc, &acc);
+        p256_point_double(&acc, &acc);
+        p256_point_double(&acc, &acc);
+        p256_point_double(&acc, &acc);
+
+        digit = (k[i / 16] >> ((i % 16) * 4)) & 0xF;
+        p256_point_set_infinity(&t);
+        for (j = 1; j < 16; j++)
+        {
+            uint64_t diff = digit ^ (uint64_t)j;
+            p256_point_select(&t, &table[j], ((diff | ((uint64_t)0 - diff)) >> 63) - 1);
+        }
+        p256_point_add_ct(&acc, &acc, &t);
+    }
+    *r = acc;
+}
+
+#define P256_WNAF_WIDTH   5
+#define P256_WNAF_POINTS  (1 << (P256_WNAF_WIDTH - 2))
+
+/** \brief width-5 NAF of k, least significant digit first: every non-zero digit is odd
+ *         and below 16 in magnitude, and any 5 consecutive digits hold at most one of
+ *         them. Returns the number of digits. Variable time, for public scalars. */
+static int p256_wnaf(int8_t naf[257], const p256_int k)
+{
+    uint64_t d[5] = { k[0], k[1], k[2], k[3], 0 };
+    int len = 0;
+    int digit, i;
+
+    while ((d[0] | d[1] | d[2] | d[3] | d[4]) != 0)
+    {
+        digit = 0;
+        if (d[0] & 1)
+        {
+            digit = (int)(d[0] & ((1 << P256_WNAF_WIDTH) - 1));
+            if (digit >= (1 << (P256_WNAF_WIDTH - 1)))
+                digit -= 1 << P256_WNAF_WIDTH;
+
+            // d -= digit, which clears the low bits
+            if (digit > 0)
+            {
+                uint64_t borrow = d[0] < (uint64_t)digit;
+                d[0] -= (uint64_t)digit;
+                for (i = 1; i < 5 && borrow; i++)
+                    borrow = d[i]-- == 0;
+            }
+            else
+            {
+                uint64_t carry;
+                d[0] += (uint64_t)(-digit);
+                carry = d[0] < (uint64_t)(-digit);
+                for (i = 1; i < 5 && carry; i++)
+                    carry = ++d[i] == 0;
+            }
+        }
+        naf[len++] = (int8_t)digit;
+
+        for (i = 0; i < 4; i++)
+            d[i] = (d[i] >> 1) | (d[i + 1] << 63);
+        d[4] >>= 1;
+    }
+    return len;
+}
+
+/** \brief odd multiples a, 3a, 5a, ... (2 * P256_WNAF_POINTS - 1)a */
+static void p256_point_odd_multiples(p256_point_t table[P256_WNAF_POINTS], const p256_point_t *a)
+{
+    p256_point_t dbl;
+    int i;
+
+    table[0] = *a;
+    p256_point_double(&dbl, a);
+    for (i = 1; i < P256_WNAF_POINTS; i++)
+        p256_point_add(&table[i], &table[i - 1], &dbl);
+}
+
+/** \brief add the table point for a wNAF digit, negated for negative digits */
+static void p256_point_add_digit(p256_point_t *acc, const p256_point_t table[P256_WNAF_POINTS], int digit)
+{
+    p256_point_t neg;
+
+    if (digit > 0)
+    {
+        p256_point_add(acc, acc, &table[digit >> 1]);
+    }
+    else if (digit < 0)
+    {
+        p256_point_negate(&neg, &table[(-digit) >> 1]);
+        p256_point_add(acc, acc, &neg);
+    }
+}
+
+/** \brief r = u1 * a + u2 * b by interleaved wNAF (Shamir's trick): both scalars share
+ *         one chain of doublings. Variable time, only for public scalars and points as
+ *         in signature verification. */
+static void p256_point_mul_double(p256_point_t *r, const p256_int u1, const p256_point_t *a,
+                                  const p256_int u2, const p256_point_t *b)
+{
+    p256_point_t table_a[P256_WNAF_POINTS], table_b[P256_WNAF_POINTS], acc;
+    int8_t naf_a[257], naf_b[257];
+    int len_a, len_b, i;
+
+    len_a = p256_wnaf(naf_a, u1);
+    len_b = p256_wnaf(naf_b, u2);
+    p256_point_odd_multiples(table_a, a);
+    p256_point_odd_multiples(table_b, b);
+
+    p256_point_set_infinity(&acc);
+    for (i = (len_a > len_b ? len_a : len_b) - 1; i >= 0; i--)
+    {
+        if (!p256_point_is_infinity(&acc))
+            p256_point_double(&acc, &acc);
+        if (i < len_a)
+            p256_point_add_digit(&acc, table_a, naf_a[i]);
+        if (i < len_b)
+            p256_point_add_digit(&acc, table_b, naf_b[i]);
+    }
+    *r = acc;
+}
+
+#ifndef ATCA_NO_P256_TABLES
+
+/* Fixed-base tables: for each 5-bit window i of a scalar the table holds j * 2^(5i) * P
+ * for j = 1..16 as affine points, so k * P is one mixed addition per signed digit of k
+ * and no doublings at all. 52 windows cover the 257 bits a signed recoding can need. */
+#define P256_COMB_WIDTH     5
+#define P256_COMB_POINTS    (1 << (P256_COMB_WIDTH - 1))
+#define P256_COMB_WINDOWS   ((257 + P256_COMB_WIDTH - 1) / P256_COMB_WIDTH)
+
+typedef struct
+{
+    p256_int xy[P256_COMB_WINDOWS][P256_COMB_POINTS][2];    // Montgomery form
+} p256_comb_t;
+
+/* R mod p, the Montgomery form of 1 */
+static const p256_int p256_mont_one = { 0x0000000000000001ULL, 0xFFFFFFFF00000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFEULL };
+
+/** \brief acc += (x, y) for an affine point, madd-2007-bl. Variable time, for public
+ *         points only. */
+static void p256_point_add_affine(p256_point_t *acc, const p256_int x, const p256_int y)
+{
+    const p256_mod_t *m = &p256_p;
+    p256_int z1z1, u2, s2, h, hh, i, j, rr, v, t;
+
+    if (p256_point_is_infinity(acc))
+    {
+        memcpy(acc->x, x, sizeof(p256_int));
+        memcpy(acc->y, y, sizeof(p256_int));
+        memcpy(acc->z, p256_mont_one, sizeof(p256_int));
+        return;
+    }
+
+    p256_fe_sqr(z1z1, acc->z);
+    p256_fe_mul(u2, x, z1z1);
+    p256_fe_mul(s2, y, acc->z);
+    p256_fe_mul(s2, s2, z1z1);
+    p256_mod_sub(h, u2, acc->x, m);
+    p256_mod_sub(rr, s2, acc->y, m);
+    if (p256_is_zero(h))
+    {
+        if (p256_is_zero(rr))
+            p256_point_double(acc, acc);
+        else
+            p256_point_set_infinity(acc);
+        return;
+    }
+
+    p256_fe_sqr(hh, h);
+    p256_mod_add(i, hh, hh, m);
+    p256_mod_add(i, i, i, m);                   // I = 4 * HH
+    p256_fe_mul(j, h, i);                       // J = H * I
+    p256_mod_add(rr, rr, rr, m);                // r = 2 * (S2 - Y1)
+    p256_fe_mul(v, acc->x, i);                  // V = X1 * I
+
+    // Z3 = (Z1 + H)^2 - Z1Z1 - HH
+    p256_mod_add(t, acc->z, h, m);
+    p256_fe_sqr(t, t);
+    p256_mod_sub(t, t, z1z1, m);
+    p256_mod_sub(acc->z, t, hh, m);
+
+    // X3 = r^2 - J - 2V
+    p256_fe_sqr(t, rr);
+    p256_mod_sub(t, t, j, m);
+    p256_mod_sub(t, t, v, m);
+    p256_mod_sub(acc->x, t, v, m);
+
+    // Y3 = r * (V - X3) - 2 * Y1 * J
+    p256_mod_sub(t, v, acc->x, m);
+    p256_fe_mul(t, rr, t);
+    p256_fe_mul(j, acc->y, j);
+    p256_mod_add(j, j, j, m);
+    p256_mod_sub(acc->y, t, j, m);
+}
+
+/** \brief fill a table for point a: window by window, compute 1..16 times the window
+ *         base in Jacobian form, convert them to affine with one shared inversion and
+ *         move on to the next base, 32 times the current one */
+static void p256_comb_build(p256_comb_t *table, const p256_point_t *a)
+{
+    p256_point_t multiples[P256_COMB_POINTS], base;
+    p256_int prefix[P256_COMB_POINTS], inv, zinv, zinv2;
+    int i, j;
+
+    base = *a;
+    for (i = 0; i < P256_COMB_WINDOWS; i++)
+    {
+        multiples[0] = base;
+        p256_point_double(&multiples[1], &base);
+        for (j = 2; j < P256_COMB_POINTS; j++)
+            p256_point_add(&multiples[j], &multiples[j - 1], &base);
+        p256_point_double(&base, &multiples[P256_COMB_POINTS - 1]);
+
+        // Montgomery's trick: invert the product of all the Z, then peel off each one
+        memcpy(prefix[0], multiples[0].z, sizeof(p256_int));
+        for (j = 1; j < P256_COMB_POINTS; j++)
+            p256_fe_mul(prefix[j], prefix[j - 1], multiples[j].z);
+        p256_fe_inv(inv, prefix[P256_COMB_POINTS - 1]);
+        for (j = P256_COMB_POINTS - 1; j >= 0; j--)
+        {
+            if (j > 0)
+            {
+                p256_fe_mul(zinv, inv, prefix[j - 1]);
+                p256_fe_mul(inv, inv, multiples[j].z);
+            }
+            else
+            {
+                memcpy(zinv, inv, sizeof(p256_int));
+            }
+            p256_fe_sqr(zinv2, zinv);
+            p256_fe_mul(table->xy[i][j][0], multiples[j].x, zinv2);
+            p256_fe_mul(zinv2, zinv2, zinv);
+            p256_fe_mul(table->xy[i][j][1], multiples[j].y, zinv2);
+        }
+    }
+}
+
+/** \brief acc += k * P using the table for P. Signed base-32 digits in [-16, 16] keep
+ *         the table at 16 points per window. Variable time, for public scalars. */
+static void p256_comb_mul_add(p256_point_t *acc, const p256_int k, const p256_comb_t *table)
+{
+    static const p256_int zero = { 0, 0, 0, 0 };
+    p256_int y;
+    uint64_t bits;
+    int carry = 0;
+    int digit, bit, i;
+
+    for (i = 0; i < P256_COMB_WINDOWS; i++)
+    {
+        bit = i * P256_COMB_WIDTH;
+        bits = k[bit / 64] >> (bit % 64);
+        if (bit % 64 > 64 - P256_COMB_WIDTH && bit / 64 < 3)
+            bits |= k[bit / 64 + 1] << (64 - bit % 64);
+
+        digit = (int)(bits & ((1 << P256_COMB_WIDTH) - 1)) + carry;
+        carry = digit > P256_COMB_POINTS;
+        if (carry)
+            digit -= 1 << P256_COMB_WIDTH;
+
+        if (digit > 0)
+        {
+            p256_point_add_affine(acc, table->xy[i][digit - 1][0], table->xy[i][digit - 1][1]);
+        }
+        else if (digit < 0)
+        {
+            p256_mod_sub(y, zero, table->xy[i][-digit - 1][1], &p256_p);
+            p256_point_add_affine(acc, table->xy[i][-digit - 1][0], y);
+        }
+    }
+}
+
+#endif /* ATCA_NO_P256_TABLES */
+
+/** \brief affine coordinates of a point, out of Montgomery form */
+static void p256_point_to_affine(p256_int x, p256_int y, const p256_point_t *a)
+{
+    const p256_mod_t *m = &p256_p;
+    p256_int zinv, zinv2;
+
+    p256_fe_inv(zinv, a->z);
+    p256_fe_sqr(zinv2, zinv);
+    p256_fe_mul(x, a->x, zinv2);
+    p256_fe_mul(zinv2, zinv2, zinv);
+    p256_fe_mul(y, a->y, zinv2);
+    p256_from_mont(x, x, m);
+    p256_from_mont(y, y, m);
+}
+
+static void p256_point_generator(p256_point_t *r)
+{
+    p256_to_mont(r->x, p256_gx, &p256_p);
+    p256_to_mont(r->y, p256_gy, &p256_p);
+    p256_to_mont(r->z, p256_one, &p256_p);
+}
+
+#ifndef ATCA_NO_P256_TABLES
+/* Table for the generator, shared by every verification and built on first use */
+static p256_comb_t p256_g_comb;
+#ifdef ATCA_USE_PTHREADS
+static pthread_once_t p256_g_comb_once = PTHREAD_ONCE_INIT;
+#else
+static int p256_g_comb_ready;
+#endif
+
+static void p256_g_comb_build(void)
+{
+    p256_point_t g;
+
+    p256_point_generator(&g);
+    p256_comb_build(&p256_g_comb, &g);
+}
+
+static const p256_comb_t *p256_g_comb_get(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_once(&p256_g_comb_once, p256_g_comb_build);
+#else
+    if (!p256_g_comb_ready)
+    {
+        p256_g_comb_build();
+        p256_g_comb_ready = 1;
+    }
+#endif
+    return &p256_g_comb;
+}
+#endif
+
+struct atcac_sw_p256_key
+{
+    p256_point_t q;
+#ifndef ATCA_NO_P256_TABLES
+    p256_comb_t  comb;
+#endif
+};
+
+/** \brief load a public key as a point, checking it lies on the curve */
+static int p256_point_from_pubkey(p256_point_t *r, const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    const p256_mod_t *m = &p256_p;
+    p256_int x, y, lhs, rhs, t;
+
+    p256_from_bytes(x, &public_key[0]);
+    p256_from_bytes(y, &public_key[32]);
+    if (!p256_less_than(x, m->m) || !p256_less_than(y, m->m))
+        return ATCA_BAD_PARAM;
+
+    p256_to_mont(r->x, x, m);
+    p256_to_mont(r->y, y, m);
+    p256_to_mont(r->z, p256_one, m);
+
+    // y^2 == x^3 - 3x + b
+    p256_fe_sqr(lhs, r->y);
+    p256_fe_sqr(rhs, r->x);
+    p256_fe_mul(rhs, rhs, r->x);
+    p256_mod_add(t, r->x, r->x, m);
+    p256_mod_add(t, t, r->x, m);
+    p256_mod_sub(rhs, rhs, t, m);
+    p256_to_mont(t, p256_b, m);
+    p256_mod_add(rhs, rhs, t, m);
+
+    return p256_equal(lhs, rhs) ? ATCA_SUCCESS : ATCA_BAD_PARAM;
+}
+
+/** \brief load a scalar, checking 0 < k < n */
+static int p256_scalar_from_bytes(p256_int r, const uint8_t bytes[32])
+{
+    p256_from_bytes(r, bytes);
+    if (p256_is_zero(r) || !p256_less_than(r, p256_n.m))
+        return ATCA_BAD_PARAM;
+    return ATCA_SUCCESS;
+}
+
+/** \brief compute the public key of a private key
+ * \param[in]  private_key  private key, 0 < d < n
+ * \param[out] public_key   d * G, X then Y
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM for a private key out of range
+ */
+int atcac_sw_p256_get_pubkey(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                             uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    p256_point_t g, q;
+    p256_int d, x, y;
+
+    if (private_key == NULL || public_key == NULL)
+        return ATCA_BAD_PARAM;
+    if (p256_scalar_from_bytes(d, private_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+
+    p256_point_generator(&g);
+    p256_point_mul_ct(&q, d, &g);
+    p256_point_to_affine(x, y, &q);
+    p256_to_bytes(&public_key[0], x);
+    p256_to_bytes(&public_key[32], y);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief check that a public key is a point on the curve
+ * \param[in] public_key  X then Y
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM when it isn't a valid point
+ */
+int atcac_sw_p256_check_pubkey(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    p256_point_t q;
+
+    if (public_key == NULL)
+        return ATCA_BAD_PARAM;
+
+    return p256_point_from_pubkey(&q, public_key);
+}
+
+/** \brief ECDSA signature of a digest
+ * \param[in]  private_key  private key, 0 < d < n
+ * \param[in]  digest       32-byte message digest
+ * \param[in]  k            per-signature secret nonce, 0 < k < n, never to be reused
+ * \param[out] signature    R then S
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM for a key or nonce out of range or a nonce that
+ *         yields R or S of zero, in which case sign again with a new nonce
+ */
+int atcac_sw_p256_sign(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                       const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                       const uint8_t k[ATCA_ECC_P256_FIELD_SIZE],
+                       uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE])
+{
+    const p256_mod_t *n = &p256_n;
+    p256_point_t g, kg;
+    p256_int d, kk, e, r, s, x, y, t;
+
+    if (private_key == NULL || digest == NULL || k == NULL || signature == NULL)
+        return ATCA_BAD_PARAM;
+    if (p256_scalar_from_bytes(d, private_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+    if (p256_scalar_from_bytes(kk, k) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+
+    // R = (k * G).x mod n
+    p256_point_generator(&g);
+    p256_point_mul_ct(&kg, kk, &g);
+    p256_point_to_affine(x, y, &kg);
+    p256_reduce_n(r, x);
+    if (p256_is_zero(r))
+        return ATCA_BAD_PARAM;
+
+    // S = k^-1 * (e + R * d) mod n
+    p256_from_bytes(e, digest);
+    p256_reduce_n(e, e);
+    p256_to_mont(e, e, n);
+    p256_to_mont(t, r, n);
+    p256_to_mont(d, d, n);
+    p256_mont_mul(t, t, d, n);
+    p256_mod_add(t, t, e, n);
+    p256_to_mont(kk, kk, n);
+    p256_mont_inv(kk, kk, n);
+    p256_mont_mul(s, kk, t, n);
+    p256_from_mont(s, s, n);
+    if (p256_is_zero(s))
+        return ATCA_BAD_PARAM;
+
+    p256_to_bytes(&signature[0], r);
+    p256_to_bytes(&signature[32], s);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief u1 = e / S and u2 = R / S mod n for a signature, with R and S range checked */
+static int p256_verify_scalars(p256_int u1, p256_int u2, p256_int r,
+                               const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                               const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE])
+{
+    const p256_mod_t *n = &p256_n;
+    p256_int e, s, w;
+
+    if (p256_scalar_from_bytes(r, &signature[0]) != ATCA_SUCCESS ||
+        p256_scalar_from_bytes(s, &signature[32]) != ATCA_SUCCESS)
+        return ATCA_CHECKMAC_VERIFY_FAILED;
+
+    p256_from_bytes(e, digest);
+    p256_reduce_n(e, e);
+    p256_to_mont(e, e, n);
+    p256_to_mont(w, s, n);
+    p256_mont_inv(w, w, n);
+    p256_mont_mul(u1, e, w, n);
+    p256_from_mont(u1, u1, n);
+    p256_to_mont(u2, r, n);
+    p256_mont_mul(u2, u2, w, n);
+    p256_from_mont(u2, u2, n);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief check x(p1) mod n == R. Compares in projective form instead of inverting Z:
+ *         x = X / Z^2 and x mod n == R when X == R * Z^2, or X == (R + n) * Z^2 if R + n
+ *         is still below p. */
+static int p256_verify_point(const p256_point_t *p1, const p256_int r)
+{
+    p256_int x, zz, rn;
+
+    if (p256_point_is_infinity(p1))
+        return ATCA_CHECKMAC_VERIFY_FAILED;
+
+    p256_fe_sqr(zz, p1->z);
+    p256_to_mont(x, r, &p256_p);
+    p256_fe_mul(x, x, zz);
+    if (p256_equal(x, p1->x))
+        return ATCA_SUCCESS;
+    if (p256_add_raw(rn, r, p256_n.m) == 0 && p256_less_than(rn, p256_p.m))
+    {
+        p256_to_mont(x, rn, &p256_p);
+        p256_fe_mul(x, x, zz);
+        if (p256_equal(x, p1->x))
+            return ATCA_SUCCESS;
+    }
+
+    return ATCA_CHECKMAC_VERIFY_FAILED;
+}
+
+/** \brief verify an ECDSA signature of a digest
+ * \param[in] digest      32-byte message digest
+ * \param[in] signature   R then S
+ * \param[in] public_key  X then Y
+ * \return ATCA_SUCCESS when the signature is valid, ATCA_CHECKMAC_VERIFY_FAILED when it
+ *         isn't, ATCA_BAD_PARAM for a public key off the curve
+ */
+int atcac_sw_p256_verify(const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                         const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
+                         const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    p256_point_t g, q, p1;
+    p256_int r, u1, u2;
+    int ret;
+
+    if (digest == NULL || signature == NULL || public_key == NULL)
+        return ATCA_BAD_PARAM;
+    if (p256_point_from_pubkey(&q, public_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+    if ((ret = p256_verify_scalars(u1, u2, r, digest, signature)) != ATCA_SUCCESS)
+        return ret;
+
+    // u1 * G + u2 * Q. The generator table doesn't pay here: Q needs its doublings
+    // anyway and G rides along on them.
+    p256_point_generator(&g);
+    p256_point_mul_double(&p1, u1, &g, u2, &q);
+
+    return p256_verify_point(&p1, r);
+}
+
+/** \brief prepare a public key for repeated verification: checks it is on the curve and
+ *         precomputes its fixed-base table, about 53 KB on the heap
+ * \param[in] public_key  X then Y
+ * \return the key object, NULL for a public key off the curve or out of memory.
+ *         Release it with atcac_sw_p256_key_free().
+ */
+atcac_sw_p256_key* atcac_sw_p256_key_new(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    atcac_sw_p256_key* key;
+    p256_point_t q;
+
+    if (public_key == NULL || p256_point_from_pubkey(&q, public_key) != ATCA_SUCCESS)
+        return NULL;
+
+    key = (atcac_sw_p256_key*)malloc(sizeof(*key));
+    if (key == NULL)
+        return NULL;
+
+    key->q = q;
+#ifndef ATCA_NO_P256_TABLES
+    p256_comb_build(&key->comb, &q);
+#endif
+    return key;
+}
+
+/** \brief release a key object from atcac_sw_p256_key_new(), NULL is ignored */
+void atcac_sw_p256_key_free(atcac_sw_p256_key* key)
+{
+    free(key);
+}
+
+/** \brief verify an ECDSA signature against a prepared key. With both fixed-base tables
+ *         the whole verification is about 104 mixed additions and no doublings.
+ * \param[in] digest     32-byte message digest
+ * \param[in] signature  R then S
+ * \param[in] key        key object from atcac_sw_p256_key_new()
+ * \return ATCA_SUCCESS when the signature is valid, ATCA_CHECKMAC_VERIFY_FAILED when it
+ *         isn't, ATCA_BAD_PARAM for a NULL argument
+ */
+int atcac_sw_p256_verify_key(const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                             const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
+                             const atcac_sw_p256_key* key)
+{
+    p256_point_t p1;
+    p256_int r, u1, u2;
+    int ret;
+
+    if (digest == NULL || signature == NULL || key == NULL)
+        return ATCA_BAD_PARAM;
+    if ((ret = p256_verify_scalars(u1, u2, r, digest, signature)) != ATCA_SUCCESS)
+        return ret;
+
+#ifndef ATCA_NO_P256_TABLES
+    p256_point_set_infinity(&p1);
+    p256_comb_mul_add(&p1, u2, &key->comb);
+    p256_comb_mul_add(&p1, u1, p256_g_comb_get());
+#else
+    {
+        p256_point_t g;
+
+        p256_point_generator(&g);
+        p256_point_mul_double(&p1, u1, &g, u2, &key->q);
+    }
+#endif
+
+    return p256_verify_point(&p1, r);
+}
+
+/** \brief ECDH shared secret, the X coordinate of d * Q
+ * \param[in]  private_key    private key, 0 < d < n
+ * \param[in]  public_key     peer public key, X then Y
+ * \param[out] shared_secret  32-byte X coordinate of the shared point
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM for a private key out of range or a public key
+ *         off the curve
+ */
+int atcac_sw_p256_ecdh(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                       const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE],
+                       uint8_t shared_secret[ATCA_ECC_P256_FIELD_SIZE])
+{
+    p256_point_t q, s;
+    p256_int d, x, y;
+
+    if (private_key == NULL || public_key == NULL || shared_secret == NULL)
+        return ATCA_BAD_PARAM;
+    if (p256_scalar_from_bytes(d, private_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+    if (p256_point_from_pubkey(&q, public_key) != ATCA_SUCCESS)
+        return ATCA_BAD_PARAM;
+
+    p256_point_mul_ct(&s, d, &q);
+    if (p256_point_is_infinity(&s))
+        return ATCA_BAD_PARAM;
+
+    p256_point_to_affine(x, y, &s);
+    p256_to_bytes(shared_secret, x);
+
+    return ATCA_SUCCESS;
+}
+
+/** @} */
@@ -0,0 +1,88 @@
+/**
+ * \file
+ * \brief  Software implementation of the NIST P-256 curve: key generation, ECDSA and ECDH
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATCA_CRYPTO_SW_P256_H
+#define ATCA_CRYPTO_SW_P256_H
+
+#include "atca_crypto_sw.h"
+#include "atca_crypto_sw_ecdsa.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** \defgroup atcac_ Software crypto methods (atcac_)
+ *
+ * \brief
+ * These methods provide a software implementation of various crypto
+ * algorithms
+ *
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Keys, digests and signature halves are 32-byte big-endian integers, public keys are X then Y */
+
+/** \brief public key prepared for repeated verification, see atcac_sw_p256_key_new() */
+typedef struct atcac_sw_p256_key atcac_sw_p256_key;
+
+int atcac_sw_p256_get_pubkey(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                             uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_p256_check_pubkey(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_p256_sign(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                       const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                       const uint8_t k[ATCA_ECC_P256_FIELD_SIZE],
+                       uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE]);
+int atcac_sw_p256_verify(const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                         const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
+                         const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+atcac_sw_p256_key* atcac_sw_p256_key_new(const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+void atcac_sw_p256_key_free(atcac_sw_p256_key* key);
+int atcac_sw_p256_verify_key(const uint8_t digest[ATCA_ECC_P256_FIELD_SIZE],
+                             const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
+                             const atcac_sw_p256_key* key);
+int atcac_sw_p256_ecdh(const uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE],
+                       const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE],
+                       uint8_t shared_secret[ATCA_ECC_P256_FIELD_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif
@@ -37,14 +37,416 @@
  */
 
 #include "atca_crypto_sw_rand.h"
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
+#ifdef ATCAC_SW_RANDOM_DEVICE_RESEED
+#include "basic/atca_basic.h"
+#endif
+
+/** \brief absorb the HMAC pads for a new key K */
+static void atcac_sw_hmac_drbg_set_key(atcac_sw_hmac_drbg_ctx* ctx, const uint8_t key[SHA256_DIGEST_SIZE])
+{
+    uint8_t pad[SHA256_BLOCK_SIZE];
+    size_t i;
+
+    for (i = 0; i < sizeof(pad); i++)
+        pad[i] = (uint8_t)((i < SHA256_DIGEST_SIZE ? key[i] : 0) ^ 0x36);
+    sw_sha256_init(&ctx->inner);
+    sw_sha256_update(&ctx->inner, pad, sizeof(pad));
+
+    for (i = 0; i < sizeof(pad); i++)
+        pad[i] ^= 0x36 ^ 0x5C;
+    sw_sha256_init(&ctx->outer);
+    sw_sha256_update(&ctx->outer, pad, sizeof(pad));
+}
+
+/** \brief mac = HMAC(K, V || [sep] || data[0] || data[1] || data[2]), sep < 0 for none */
+static void atcac_sw_hmac_drbg_mac(const atcac_sw_hmac_drbg_ctx* ctx, int sep,
+                                   const uint8_t* const data[3], const size_t data_size[3],
+                                   uint8_t mac[SHA256_DIGEST_SIZE])
+{
+    sw_sha256_ctx hash = ctx->inner;
+    uint8_t sep_byte = (uint8_t)sep;
+    size_t i;
+
+    sw_sha256_update(&hash, ctx->v, sizeof(ctx->v));
+    if (sep >= 0)
+    {
+        sw_sha256_update(&hash, &sep_byte, 1);
+        for (i = 0; i < 3; i++)
+        {
+            if (data[i] != NULL && data_size[i] > 0)
+                sw_sha256_update(&hash, data[i], (uint32_t)data_size[i]);
+        }
+    }
+    sw_sha256_final(&hash, mac);
+
+    hash = ctx->outer;
+    sw_sha256_update(&hash, mac, SHA256_DIGEST_SIZE);
+    sw_sha256_final(&hash, mac);
+}
+
+/** \brief HMAC_DRBG_Update with the provided data given in up to three pieces */
+static void atcac_sw_hmac_drbg_update(atcac_sw_hmac_drbg_ctx* ctx, const uint8_t* const data[3], const size_t data_size[3])
+{
+    uint8_t key[SHA256_DIGEST_SIZE];
+    int sep;
+
+    for (sep = 0; sep < 2; sep++)
+    {
+        atcac_sw_hmac_drbg_mac(ctx, sep, data, data_size, key);
+        atcac_sw_hmac_drbg_set_key(ctx, key);
+        atcac_sw_hmac_drbg_mac(ctx, -1, NULL, NULL, ctx->v);
+        if (data_size[0] + data_size[1] + data_size[2] == 0)
+            break;
+    }
+    memset(key, 0, sizeof(key));
+}
+
+/** \brief instantiate an HMAC_DRBG
+ * \param[out] ctx                   generator state
+ * \param[in]  entropy               entropy input, at least 32 bytes for 256-bit security
+ * \param[in]  entropy_size          size of entropy
+ * \param[in]  nonce                 nonce, may be NULL
+ * \param[in]  nonce_size            size of nonce
+ * \param[in]  personalization       personalization string, may be NULL
+ * \param[in]  personalization_size  size of personalization
+ * \return ATCA_SUCCESS or ATCA_BAD_PARAM
+ */
+int atcac_sw_hmac_drbg_init(atcac_sw_hmac_drbg_ctx* ctx,
+                            const uint8_t* entropy, size_t entropy_size,
+                            const uint8_t* nonce, size_t nonce_size,
+                            const uint8_t* personalization, size_t personalization_size)
+{
+    static const uint8_t zero_key[SHA256_DIGEST_SIZE] = { 0 };
+    const uint8_t* data[3] = { entropy, nonce, personalization };
+    size_t data_size[3] = { entropy_size, nonce_size, personalization_size };
+
+    if (ctx == NULL || entropy == NULL || entropy_size == 0)
+        return ATCA_BAD_PARAM;
+    if (nonce == NULL)
+        data_size[1] = 0;
+    if (personalization == NULL)
+        data_size[2] = 0;
+
+    atcac_sw_hmac_drbg_set_key(ctx, zero_key);
+    memset(ctx->v, 0x01, sizeof(ctx->v));
+    atcac_sw_hmac_drbg_update(ctx, data, data_size);
+    ctx->reseed_counter = 1;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief reseed an HMAC_DRBG with fresh entropy
+ * \param[in,out] ctx              generator state
+ * \param[in]     entropy          entropy input
+ * \param[in]     entropy_size     size of entropy
+ * \param[in]     additional       additional input, may be NULL
+ * \param[in]     additional_size  size of additional
+ * \return ATCA_SUCCESS or ATCA_BAD_PARAM
+ */
+int atcac_sw_hmac_drbg_reseed(atcac_sw_hmac_drbg_ctx* ctx,
+                              const uint8_t* entropy, size_t entropy_size,
+                              const uint8_t* additional, size_t additional_size)
+{
+    const uint8_t* data[3] = { entropy, additional, NULL };
+    size_t data_size[3] = { entropy_size, additional_size, 0 };
+
+    if (ctx == NULL || entropy == NULL || entropy_size == 0)
+        return ATCA_BAD_PARAM;
+    if (additional == NULL)
+        data_size[1] = 0;
+
+    atcac_sw_hmac_drbg_update(ctx, data, data_size);
+    ctx->reseed_counter = 1;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief generate bytes from an HMAC_DRBG
+ * \param[in,out] ctx              generator state
+ * \param[out]    data             receives the random bytes
+ * \param[in]     data_size        number of bytes, at most ATCAC_SW_HMAC_DRBG_MAX_REQUEST
+ * \param[in]     additional       additional input, may be NULL
+ * \param[in]     additional_size  size of additional
+ * \return ATCA_SUCCESS or ATCA_BAD_PARAM
+ */
+int atcac_sw_hmac_drbg_generate(atcac_sw_hmac_drbg_ctx* ctx, uint8_t* data, size_t data_size,
+                                const uint8_t* additional, size_t additional_size)
+{
+    const uint8_t* extra[3] = { additional, NULL, NULL };
+    size_t extra_size[3] = { additional_size, 0, 0 };
+    size_t n;
+
+    if (ctx == NULL || (data == NULL && data_size > 0) || data_size > ATCAC_SW_HMAC_DRBG_MAX_REQUEST)
+        return ATCA_BAD_PARAM;
+    if (additional == NULL)
+        extra_size[0] = 0;
+
+    if (extra_size[0] > 0)
+        atcac_sw_hmac_drbg_update(ctx, extra, extra_size);
+
+    while (data_size > 0)
+    {
+        atcac_sw_hmac_drbg_mac(ctx, -1, NULL, NULL, ctx->v);
+        n = data_size < sizeof(ctx->v) ? data_size : sizeof(ctx->v);
+        memcpy(data, ctx->v, n);
+        data += n;
+        data_size -= n;
+    }
+
+    atcac_sw_hmac_drbg_update(ctx, extra, extra_size);
+    ctx->reseed_counter++;
+
+    return ATCA_SUCCESS;
+}
+
+/* atcac_sw_random() keeps one generator per thread so it never takes a lock */
+#if defined(_MSC_VER)
+#define ATCAC_SW_RANDOM_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define ATCAC_SW_RANDOM_THREAD_LOCAL __thread
+#else
+#define ATCAC_SW_RANDOM_THREAD_LOCAL
+#endif
+
+typedef struct
+{
+    atcac_sw_hmac_drbg_ctx drbg;
+    uint32_t               forks;   // fork count the generator was seeded under
+    int                    seeded;
+#if ATCAC_SW_RANDOM_BUFFER_SIZE > 0
+    size_t                 buffered;    // unused bytes at the end of buffer
+    uint8_t                buffer[ATCAC_SW_RANDOM_BUFFER_SIZE];
+#endif
+} atcac_sw_random_state;
+
+static ATCAC_SW_RANDOM_THREAD_LOCAL atcac_sw_random_state atcac_sw_random_tls;
+
+#ifdef ATCA_USE_PTHREADS
+/* A forked child must not replay its parent's output, so every thread reseeds after a fork */
+static volatile uint32_t atcac_sw_random_forks;
+static pthread_once_t atcac_sw_random_once = PTHREAD_ONCE_INIT;
+
+static void atcac_sw_random_after_fork(void)
+{
+    atcac_sw_random_forks++;
+}
+
+static void atcac_sw_random_register_fork(void)
+{
+    pthread_atfork(NULL, NULL, atcac_sw_random_after_fork);
+}
+#endif
+
+/** \brief read seed material from the OS: getrandom(), or /dev/urandom on kernels without it */
+static int atcac_sw_random_entropy(uint8_t* data, size_t data_size)
+{
+#ifdef __linux__
+    size_t got = 0;
+    ssize_t n;
+    int fd;
+
+#ifdef SYS_getrandom
+    while (got < data_size)
+    {
+        n = syscall(SYS_getrandom, data + got, data_size - got, 0);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        got += (size_t)n;
+    }
+    if (got == data_size)
+        return ATCA_SUCCESS;
+#endif
+
+    fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return ATCA_GEN_FAIL;
+    while (got < data_size)
+    {
+        n = read(fd, data + got, data_size - got);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        got += (size_t)n;
+    }
+    close(fd);
+
+    return got == data_size ? ATCA_SUCCESS : ATCA_GEN_FAIL;
+#else
+    (void)data;
+    (void)data_size;
+    return ATCA_UNIMPLEMENTED;
+#endif
+}
+
+/** \brief instantiate or reseed the calling thread's generator from the OS, mixing in
+ *         additional input and, with ATCAC_SW_RANDOM_DEVICE_RESEED, 32 bytes from the
+ *         device RNG */
+static int atcac_sw_random_seed(atcac_sw_random_state* state, const uint8_t* additional, size_t additional_size)
+{
+    uint8_t seed[48];       // 256-bit entropy input and a 128-bit nonce
+    uint8_t extra[SHA256_DIGEST_SIZE + sizeof(void*) + sizeof(time_t) + sizeof(long)];
+    size_t extra_size = 0;
+    atcac_sw_hmac_drbg_ctx mixed;
+    void* self = state;
+#ifdef __linux__
+    struct timespec now;
+#endif
+    int ret;
+
+    if ((ret = atcac_sw_random_entropy(seed, sizeof(seed))) != ATCA_SUCCESS)
+        return ret;
+
+#ifdef ATCAC_SW_RANDOM_DEVICE_RESEED
+    if (atcab_random(extra) == ATCA_SUCCESS)
+        extra_size = SHA256_DIGEST_SIZE;
+#endif
+    // The state address and the time tell threads and processes apart on top of the entropy
+    memcpy(&extra[extra_size], &self, sizeof(self));
+    extra_size += sizeof(self);
+#ifdef __linux__
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    memcpy(&extra[extra_size], &now.tv_sec, sizeof(now.tv_sec));
+    extra_size += sizeof(now.tv_sec);
+    memcpy(&extra[extra_size], &now.tv_nsec, sizeof(now.tv_nsec));
+    extra_size += sizeof(now.tv_nsec);
+#endif
+
+    if (!state->seeded)
+    {
+        ret = atcac_sw_hmac_drbg_init(&state->drbg, seed, 32, &seed[32], 16, extra, extra_size);
+        if (ret == ATCA_SUCCESS && additional != NULL && additional_size > 0)
+            ret = atcac_sw_hmac_drbg_reseed(&state->drbg, additional, additional_size, NULL, 0);
+    }
+    else
+    {
+        // Reseed with the entropy and the system extras, then the caller's input
+        mixed = state->drbg;
+        ret = atcac_sw_hmac_drbg_reseed(&mixed, seed, sizeof(seed), extra, extra_size);
+        if (ret == ATCA_SUCCESS && additional != NULL && additional_size > 0)
+            ret = atcac_sw_hmac_drbg_reseed(&mixed, additional, additional_size, NULL, 0);
+        if (ret == ATCA_SUCCESS)
+            state->drbg = mixed;
+        memset(&mixed, 0, sizeof(mixed));
+    }
+    memset(seed, 0, sizeof(seed));
+
+#if ATCAC_SW_RANDOM_BUFFER_SIZE > 0
+    // Bytes generated before the reseed must not be handed out after it
+    memset(state->buffer, 0, sizeof(state->buffer));
+    state->buffered = 0;
+#endif
+
+    if (ret == ATCA_SUCCESS)
+    {
+        state->seeded = 1;
+#ifdef ATCA_USE_PTHREADS
+        state->forks = atcac_sw_random_forks;
+#endif
+    }
+    return ret;
+}
 
 /** \brief return software generated random number
+ *
+ * Bytes come from a per-thread HMAC_DRBG (SHA-256) seeded from getrandom(). Each thread
+ * reseeds every ATCAC_SW_RANDOM_RESEED_INTERVAL generate calls and after a fork. Requests
+ * up to half of ATCAC_SW_RANDOM_BUFFER_SIZE are served from a per-thread buffer.
+ *
  * \param[out] data       ptr to space to receive the random number
  * \param[in]  data_size  size of data buffer
- * return ATCA_STATUS
+ * \return ATCA_SUCCESS, ATCA_BAD_PARAM, or an error when the OS has no entropy to give
  */
 
 int atcac_sw_random(uint8_t* data, size_t data_size)
 {
-    return ATCA_UNIMPLEMENTED;
-}
\ No newline at end of file
+    atcac_sw_random_state* state = &atcac_sw_random_tls;
+    size_t n;
+    int ret;
+
+    if (data == NULL && data_size > 0)
+        return ATCA_BAD_PARAM;
+
+#ifdef ATCA_USE_PTHREADS
+    pthread_once(&atcac_sw_random_once, atcac_sw_random_register_fork);
+    if (state->forks != atcac_sw_random_forks)
+        state->seeded = 0;
+#endif
+
+    if (!state->seeded)
+    {
+        if ((ret = atcac_sw_random_seed(state, NULL, 0)) != ATCA_SUCCESS)
+            return ret;
+    }
+
+#if ATCAC_SW_RANDOM_BUFFER_SIZE > 0
+    // Small requests such as challenges come out of the buffer, one generate call
+    // refills it for several of them
+    if (data_size <= ATCAC_SW_RANDOM_BUFFER_SIZE / 2)
+    {
+        uint8_t* ready;
+
+        if (state->buffered < data_size)
+        {
+            if (state->drbg.reseed_counter > ATCAC_SW_RANDOM_RESEED_INTERVAL &&
+                (ret = atcac_sw_random_seed(state, NULL, 0)) != ATCA_SUCCESS)
+                return ret;
+            if ((ret = atcac_sw_hmac_drbg_generate(&state->drbg, state->buffer, sizeof(state->buffer), NULL, 0)) != ATCA_SUCCESS)
+                return ret;
+            state->buffered = sizeof(state->buffer);
+        }
+        ready = &state->buffer[sizeof(state->buffer) - state->buffered];
+        memcpy(data, ready, data_size);
+        memset(ready, 0, data_size);
+        state->buffered -= data_size;
+        return ATCA_SUCCESS;
+    }
+#endif
+
+    do
+    {
+        if (state->drbg.reseed_counter > ATCAC_SW_RANDOM_RESEED_INTERVAL)
+        {
+            if ((ret = atcac_sw_random_seed(state, NULL, 0)) != ATCA_SUCCESS)
+                return ret;
+        }
+
+        n = data_size < ATCAC_SW_HMAC_DRBG_MAX_REQUEST ? data_size : ATCAC_SW_HMAC_DRBG_MAX_REQUEST;
+        if ((ret = atcac_sw_hmac_drbg_generate(&state->drbg, data, n, NULL, 0)) != ATCA_SUCCESS)
+            return ret;
+        data += n;
+        data_size -= n;
+    }
+    while (data_size > 0);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief reseed the calling thread's generator now, for example with 32 bytes from
+ *         atcab_random() to mix device entropy into the software generator
+ * \param[in] additional       extra input mixed in after fresh OS entropy, may be NULL
+ * \param[in] additional_size  size of additional
+ * \return ATCA_SUCCESS, or an error when the OS has no entropy to give
+ */
+int atcac_sw_random_reseed(const uint8_t* additional, size_t additional_size)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_once(&atcac_sw_random_once, atcac_sw_random_register_fork);
+#endif
+    return atcac_sw_random_seed(&atcac_sw_random_tls, additional, additional_size);
+}
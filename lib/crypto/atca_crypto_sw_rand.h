@@ -40,6 +40,7 @@
 #define ATCA_CRYPTO_SW_RAND_H
 
 #include "atca_crypto_sw.h"
+#include "hashes/sha2_routines.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -50,11 +51,46 @@
  * algorithms
  *
    @{ */
+/* Generate calls between reseeds of each thread's generator from the OS entropy source */
+#ifndef ATCAC_SW_RANDOM_RESEED_INTERVAL
+#define ATCAC_SW_RANDOM_RESEED_INTERVAL   65536
+#endif
+
+/* Bytes each thread generates ahead and hands out to small requests, 0 to generate every
+   request separately. Handed out bytes are wiped from the buffer. */
+#ifndef ATCAC_SW_RANDOM_BUFFER_SIZE
+#define ATCAC_SW_RANDOM_BUFFER_SIZE       256
+#endif
+
+/* Largest single HMAC_DRBG request, longer atcac_sw_random() requests are split */
+#define ATCAC_SW_HMAC_DRBG_MAX_REQUEST    65536
+
+/** \brief HMAC_DRBG with SHA-256 (NIST SP 800-90A). The key is held as SHA-256 states
+ *         with the HMAC pads already absorbed. */
+typedef struct
+{
+    sw_sha256_ctx inner;            //!< SHA-256 state after K ^ ipad
+    sw_sha256_ctx outer;            //!< SHA-256 state after K ^ opad
+    uint8_t       v[SHA256_DIGEST_SIZE];
+    uint32_t      reseed_counter;
+} atcac_sw_hmac_drbg_ctx;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+int atcac_sw_hmac_drbg_init(atcac_sw_hmac_drbg_ctx* ctx,
+                            const uint8_t* entropy, size_t entropy_size,
+                            const uint8_t* nonce, size_t nonce_size,
+                            const uint8_t* personalization, size_t personalization_size);
+int atcac_sw_hmac_drbg_reseed(atcac_sw_hmac_drbg_ctx* ctx,
+                              const uint8_t* entropy, size_t entropy_size,
+                              const uint8_t* additional, size_t additional_size);
+int atcac_sw_hmac_drbg_generate(atcac_sw_hmac_drbg_ctx* ctx, uint8_t* data, size_t data_size,
+                                const uint8_t* additional, size_t additional_size);
+
 int atcac_sw_random(uint8_t* data, size_t data_size);
+int atcac_sw_random_reseed(const uint8_t* additional, size_t additional_size);
 
 #ifdef __cplusplus
 }
@@ -107,4 +107,26 @@ int atcac_sw_sha2_256(const uint8_t* data, size_t data_size, uint8_t digest[ATCA
         return ret;
 
     return ATCA_SUCCESS;
-}
\ No newline at end of file
+}
+
+/** \brief computes the SHA256 digests of several independent messages in one call. Where
+ *         the CPU has SIMD units the messages are hashed side by side in vector lanes,
+ *         which is much faster than calling atcac_sw_sha2_256 in a loop for short messages
+ *         such as certificate TBS data and public keys.
+ * \param[in]  data       array of pointers to the messages to hash
+ * \param[in]  data_size  array of message sizes in bytes
+ * \param[in]  count      number of messages
+ * \param[out] digests    receives one digest per message, in the same order
+ * \return ATCA_STATUS
+ */
+
+int atcac_sw_sha2_256_multi(const uint8_t* const data[], const size_t data_size[], size_t count,
+                            uint8_t digests[][ATCA_SHA2_256_DIGEST_SIZE])
+{
+    if (count > 0 && (data == NULL || data_size == NULL || digests == NULL))
+        return ATCA_BAD_PARAM;
+
+    sw_sha256_multi(data, data_size, count, digests);
+
+    return ATCA_SUCCESS;
+}
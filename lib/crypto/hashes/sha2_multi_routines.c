@@ -0,0 +1,460 @@
+/**
+ * \file
+ * \brief Multi-buffer SHA-256: hashes independent messages side by side in SIMD lanes.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "sha2_routines.h"
+
+#if !defined(ATCA_NO_SHA256_ACCEL) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SW_SHA256_MULTI_X86
+#include <immintrin.h>
+#endif
+
+#if !defined(ATCA_NO_SHA256_ACCEL) && defined(__GNUC__) && defined(__aarch64__)
+#define SW_SHA256_MULTI_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(SW_SHA256_MULTI_X86) || defined(SW_SHA256_MULTI_NEON)
+#define SW_SHA256_MULTI_LANES
+#endif
+
+/** \brief Processes one 64-byte block in every lane. state holds word j of
+           lane l at state[j * lanes + l]. */
+typedef void (*sw_sha256_multi_fn)(uint32_t* state, const uint8_t* const* blocks);
+
+#ifdef SW_SHA256_MULTI_LANES
+
+static uint32_t sw_sha256_load_be32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/*
+ * Lane-parallel compression, shared by every instruction set. An
+ * instantiation defines V (the vector type), LANES and the V_* operations,
+ * then expands SW_SHA256_MULTI_BODY as the body of its block function.
+ */
+#define MB_BSIG0(x) V_XOR3(V_ROR(x, 2), V_ROR(x, 13), V_ROR(x, 22))
+#define MB_BSIG1(x) V_XOR3(V_ROR(x, 6), V_ROR(x, 11), V_ROR(x, 25))
+#define MB_SSIG0(x) V_XOR3(V_ROR(x, 7), V_ROR(x, 18), V_SHR(x, 3))
+#define MB_SSIG1(x) V_XOR3(V_ROR(x, 17), V_ROR(x, 19), V_SHR(x, 10))
+
+#define MB_EXPAND(i) \
+    (w[(i) & 15] = V_ADD(V_ADD(w[(i) & 15], MB_SSIG1(w[((i) - 2) & 15])), V_ADD(w[((i) - 7) & 15], MB_SSIG0(w[((i) - 15) & 15]))))
+
+#define MB_ROUND(a, b, c, d, e, f, g, h, i)                                                     \
+    do {                                                                                        \
+        V t1 = V_ADD(V_ADD(h, MB_BSIG1(e)), V_ADD(V_CH(e, f, g), V_ADD(V_SET1(sw_sha256_k[i]), w[(i) & 15]))); \
+        d = V_ADD(d, t1);                                                                       \
+        h = V_ADD(t1, V_ADD(MB_BSIG0(a), V_MAJ(a, b, c)));                                      \
+    } while (0)
+
+#define SW_SHA256_MULTI_BODY                                                  \
+    V a, b, c, d, e, f, g, h;                                                 \
+    V w[16];                                                                  \
+    uint32_t words[LANES];                                                    \
+    int i, l;                                                                 \
+                                                                              \
+    for (i = 0; i < 16; i++)                                                  \
+    {                                                                         \
+        for (l = 0; l < LANES; l++)                                           \
+            words[l] = sw_sha256_load_be32(&blocks[l][i * 4]);                \
+        w[i] = V_LOAD(words);                                                 \
+    }                                                                         \
+    a = V_LOAD(&state[0 * LANES]); b = V_LOAD(&state[1 * LANES]);             \
+    c = V_LOAD(&state[2 * LANES]); d = V_LOAD(&state[3 * LANES]);             \
+    e = V_LOAD(&state[4 * LANES]); f = V_LOAD(&state[5 * LANES]);             \
+    g = V_LOAD(&state[6 * LANES]); h = V_LOAD(&state[7 * LANES]);             \
+                                                                              \
+    for (i = 0; i < SHA256_BLOCK_SIZE; i += 8)                                \
+    {                                                                         \
+        if (i >= 16)                                                          \
+        {                                                                     \
+            MB_EXPAND(i + 0); MB_EXPAND(i + 1); MB_EXPAND(i + 2); MB_EXPAND(i + 3); \
+            MB_EXPAND(i + 4); MB_EXPAND(i + 5); MB_EXPAND(i + 6); MB_EXPAND(i + 7); \
+        }                                                                     \
+        MB_ROUND(a, b, c, d, e, f, g, h, i + 0);                              \
+        MB_ROUND(h, a, b, c, d, e, f, g, i + 1);                              \
+        MB_ROUND(g, h, a, b, c, d, e, f, i + 2);                              \
+        MB_ROUND(f, g, h, a, b, c, d, e, i + 3);                              \
+        MB_ROUND(e, f, g, h, a, b, c, d, i + 4);                              \
+        MB_ROUND(d, e, f, g, h, a, b, c, i + 5);                              \
+        MB_ROUND(c, d, e, f, g, h, a, b, i + 6);                              \
+        MB_ROUND(b, c, d, e, f, g, h, a, i + 7);                              \
+    }                                                                         \
+                                                                              \
+    V_STORE(&state[0 * LANES], V_ADD(a, V_LOAD(&state[0 * LANES])));         \
+    V_STORE(&state[1 * LANES], V_ADD(b, V_LOAD(&state[1 * LANES])));         \
+    V_STORE(&state[2 * LANES], V_ADD(c, V_LOAD(&state[2 * LANES])));         \
+    V_STORE(&state[3 * LANES], V_ADD(d, V_LOAD(&state[3 * LANES])));         \
+    V_STORE(&state[4 * LANES], V_ADD(e, V_LOAD(&state[4 * LANES])));         \
+    V_STORE(&state[5 * LANES], V_ADD(f, V_LOAD(&state[5 * LANES])));         \
+    V_STORE(&state[6 * LANES], V_ADD(g, V_LOAD(&state[6 * LANES])));         \
+    V_STORE(&state[7 * LANES], V_ADD(h, V_LOAD(&state[7 * LANES])))
+
+#endif
+
+#ifdef SW_SHA256_MULTI_X86
+/* AVX2: eight lanes of 32-bit words in a ymm register */
+#define V                __m256i
+#define LANES            8
+#define V_LOAD(p)        _mm256_loadu_si256((const __m256i*)(p))
+#define V_STORE(p, x)    _mm256_storeu_si256((__m256i*)(p), x)
+#define V_SET1(k)        _mm256_set1_epi32((int)(k))
+#define V_ADD(x, y)      _mm256_add_epi32(x, y)
+#define V_SHR(x, n)      _mm256_srli_epi32(x, n)
+#define V_ROR(x, n)      _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define V_XOR3(x, y, z)  _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define V_CH(x, y, z)    _mm256_xor_si256(_mm256_and_si256(x, _mm256_xor_si256(y, z)), z)
+#define V_MAJ(x, y, z)   _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)))
+
+__attribute__((target("avx2")))
+static void sw_sha256_multi_avx2(uint32_t* state, const uint8_t* const* blocks)
+{
+    SW_SHA256_MULTI_BODY;
+}
+
+#undef V
+#undef LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SHR
+#undef V_ROR
+#undef V_XOR3
+#undef V_CH
+#undef V_MAJ
+
+/* AVX-512F: sixteen lanes, native rotates and three-input logic */
+#define V                __m512i
+#define LANES            16
+#define V_LOAD(p)        _mm512_loadu_si512((const void*)(p))
+#define V_STORE(p, x)    _mm512_storeu_si512((void*)(p), x)
+#define V_SET1(k)        _mm512_set1_epi32((int)(k))
+#define V_ADD(x, y)      _mm512_add_epi32(x, y)
+#define V_SHR(x, n)      _mm512_srli_epi32(x, n)
+#define V_ROR(x, n)      _mm512_ror_epi32(x, n)
+#define V_XOR3(x, y, z)  _mm512_ternarylogic_epi32(x, y, z, 0x96)
+#define V_CH(x, y, z)    _mm512_ternarylogic_epi32(x, y, z, 0xCA)
+#define V_MAJ(x, y, z)   _mm512_ternarylogic_epi32(x, y, z, 0xE8)
+
+__attribute__((target("avx512f")))
+static void sw_sha256_multi_avx512(uint32_t* state, const uint8_t* const* blocks)
+{
+    SW_SHA256_MULTI_BODY;
+}
+
+#undef V
+#undef LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SHR
+#undef V_ROR
+#undef V_XOR3
+#undef V_CH
+#undef V_MAJ
+#endif
+
+#ifdef SW_SHA256_MULTI_NEON
+/* NEON: four lanes, bit-select for Ch and Maj */
+#define V                uint32x4_t
+#define LANES            4
+#define V_LOAD(p)        vld1q_u32(p)
+#define V_STORE(p, x)    vst1q_u32(p, x)
+#define V_SET1(k)        vdupq_n_u32(k)
+#define V_ADD(x, y)      vaddq_u32(x, y)
+#define V_SHR(x, n)      vshrq_n_u32(x, n)
+#define V_ROR(x, n)      vsriq_n_u32(vshlq_n_u32(x, 32 - (n)), x, n)
+#define V_XOR3(x, y, z)  veorq_u32(veorq_u32(x, y), z)
+#define V_CH(x, y, z)    vbslq_u32(x, y, z)
+#define V_MAJ(x, y, z)   vbslq_u32(veorq_u32(x, y), z, y)
+
+static void sw_sha256_multi_neon(uint32_t* state, const uint8_t* const* blocks)
+{
+    SW_SHA256_MULTI_BODY;
+}
+
+#undef V
+#undef LANES
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_SHR
+#undef V_ROR
+#undef V_XOR3
+#undef V_CH
+#undef V_MAJ
+#endif
+
+#ifdef SW_SHA256_MULTI_LANES
+
+/** \brief Progress of the message currently assigned to one lane */
+typedef struct
+{
+    const uint8_t* message;                     //!< Message start, whole blocks are read from here
+    size_t         index;                       //!< Position of the message in the caller's arrays
+    size_t         block;                       //!< Next block to process
+    size_t         full_blocks;                 //!< Whole blocks read directly from the message
+    size_t         total_blocks;                //!< Whole blocks plus padded tail blocks
+    uint8_t        tail[SHA256_BLOCK_SIZE * 2]; //!< Trailing bytes with padding and bit length
+} sw_sha256_lane;
+
+static void sw_sha256_lane_start(sw_sha256_lane* lane, uint32_t* state, int lanes, int l,
+                                 size_t index, const uint8_t* message, size_t length)
+{
+    static const uint32_t hash_init[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    size_t rem = length % SHA256_BLOCK_SIZE;
+    size_t tail_size = rem + 9 > SHA256_BLOCK_SIZE ? SHA256_BLOCK_SIZE * 2 : SHA256_BLOCK_SIZE;
+    uint64_t length_bits = (uint64_t)length * 8;
+    int j;
+
+    lane->message = message;
+    lane->index = index;
+    lane->block = 0;
+    lane->full_blocks = length / SHA256_BLOCK_SIZE;
+    lane->total_blocks = lane->full_blocks + tail_size / SHA256_BLOCK_SIZE;
+
+    memset(lane->tail, 0, sizeof(lane->tail));
+    if (rem > 0)
+        memcpy(lane->tail, &message[lane->full_blocks * SHA256_BLOCK_SIZE], rem);
+    lane->tail[rem] = 0x80;
+    for (j = 0; j < 8; j++)
+        lane->tail[tail_size - 1 - j] = (uint8_t)(length_bits >> (j * 8));
+
+    for (j = 0; j < 8; j++)
+        state[j * lanes + l] = hash_init[j];
+}
+
+/**
+ * \brief Runs messages through a lane-parallel block function. Each lane
+ *        takes the next waiting message as soon as its current one is done,
+ *        so messages of mixed lengths keep all lanes busy; idle lanes hash
+ *        a zero block whose result is discarded.
+ */
+static void sw_sha256_multi_lanes(sw_sha256_multi_fn fn, int lanes, const uint8_t* const messages[],
+                                  const size_t lengths[], size_t count, uint8_t digests[][SHA256_DIGEST_SIZE])
+{
+    static const uint8_t idle_block[SHA256_BLOCK_SIZE] = { 0 };
+    sw_sha256_lane lane[SW_SHA256_MULTI_MAX_LANES];
+    uint32_t state[8 * SW_SHA256_MULTI_MAX_LANES];
+    const uint8_t* blocks[SW_SHA256_MULTI_MAX_LANES];
+    uint8_t busy[SW_SHA256_MULTI_MAX_LANES];
+    size_t next = 0;
+    int active = 0;
+    int l, j;
+
+    for (l = 0; l < lanes; l++)
+    {
+        busy[l] = next < count;
+        if (busy[l])
+        {
+            sw_sha256_lane_start(&lane[l], state, lanes, l, next, messages[next], lengths[next]);
+            next++;
+            active++;
+        }
+    }
+
+    while (active > 0)
+    {
+        for (l = 0; l < lanes; l++)
+        {
+            if (!busy[l])
+                blocks[l] = idle_block;
+            else if (lane[l].block < lane[l].full_blocks)
+                blocks[l] = &lane[l].message[lane[l].block * SHA256_BLOCK_SIZE];
+            else
+                blocks[l] = &lane[l].tail[(lane[l].block - lane[l].full_blocks) * SHA256_BLOCK_SIZE];
+        }
+
+        fn(state, blocks);
+
+        for (l = 0; l < lanes; l++)
+        {
+            if (!busy[l] || ++lane[l].block < lane[l].total_blocks)
+                continue;
+
+            for (j = 0; j < 8; j++)
+            {
+                uint32_t word = state[j * lanes + l];
+                digests[lane[l].index][j * 4 + 0] = (uint8_t)(word >> 24);
+                digests[lane[l].index][j * 4 + 1] = (uint8_t)(word >> 16);
+                digests[lane[l].index][j * 4 + 2] = (uint8_t)(word >> 8);
+                digests[lane[l].index][j * 4 + 3] = (uint8_t)word;
+            }
+
+            if (next < count)
+            {
+                sw_sha256_lane_start(&lane[l], state, lanes, l, next, messages[next], lengths[next]);
+                next++;
+            }
+            else
+            {
+                busy[l] = 0;
+                active--;
+            }
+        }
+    }
+}
+#endif
+
+static const char* const sw_sha256_multi_backend_names[SW_SHA256_MULTI_COUNT] = {
+    "auto", "serial", "neon-4", "avx2-8", "avx512-16"
+};
+
+static sw_sha256_multi_backend sw_sha256_multi_active = SW_SHA256_MULTI_AUTO;
+
+/**
+ * \brief Reports whether a multi-buffer backend is compiled in and supported
+ *        by the CPU.
+ *
+ * \param[in] backend  Backend to check. AUTO and SERIAL are always available.
+ *
+ * \return 1 if the backend can be used, 0 otherwise
+ */
+int sw_sha256_multi_backend_available(sw_sha256_multi_backend backend)
+{
+    switch (backend)
+    {
+    case SW_SHA256_MULTI_AUTO:
+    case SW_SHA256_MULTI_SERIAL:
+        return 1;
+#ifdef SW_SHA256_MULTI_NEON
+    case SW_SHA256_MULTI_NEON4:
+        return 1;
+#endif
+#ifdef SW_SHA256_MULTI_X86
+    case SW_SHA256_MULTI_AVX2_8:
+        return __builtin_cpu_supports("avx2");
+    case SW_SHA256_MULTI_AVX512_16:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+ * \brief Selects how sw_sha256_multi spreads messages over the CPU. Intended
+ *        for tests and benchmarks.
+ *
+ * \param[in] backend  Backend to use, or SW_SHA256_MULTI_AUTO to pick the
+ *                     fastest available one.
+ *
+ * \return 0 on success, -1 if the backend is not available on this CPU
+ */
+int sw_sha256_multi_set_backend(sw_sha256_multi_backend backend)
+{
+    if (backend == SW_SHA256_MULTI_AUTO)
+    {
+        if (sw_sha256_multi_backend_available(SW_SHA256_MULTI_AVX512_16))
+            backend = SW_SHA256_MULTI_AVX512_16;
+        else if (sw_sha256_get_backend() != SW_SHA256_BACKEND_SCALAR)
+            backend = SW_SHA256_MULTI_SERIAL;
+        else if (sw_sha256_multi_backend_available(SW_SHA256_MULTI_AVX2_8))
+            backend = SW_SHA256_MULTI_AVX2_8;
+        else if (sw_sha256_multi_backend_available(SW_SHA256_MULTI_NEON4))
+            backend = SW_SHA256_MULTI_NEON4;
+        else
+            backend = SW_SHA256_MULTI_SERIAL;
+    }
+    else if (!sw_sha256_multi_backend_available(backend))
+    {
+        return -1;
+    }
+    sw_sha256_multi_active = backend;
+
+    return 0;
+}
+
+/** \brief Returns the multi-buffer backend in use, resolving the automatic choice */
+sw_sha256_multi_backend sw_sha256_multi_get_backend(void)
+{
+    if (sw_sha256_multi_active == SW_SHA256_MULTI_AUTO)
+        sw_sha256_multi_set_backend(SW_SHA256_MULTI_AUTO);
+    return sw_sha256_multi_active;
+}
+
+/** \brief Short lower case name of a multi-buffer backend, for test and benchmark output */
+const char* sw_sha256_multi_backend_name(sw_sha256_multi_backend backend)
+{
+    if ((unsigned)backend >= SW_SHA256_MULTI_COUNT)
+        return "unknown";
+    return sw_sha256_multi_backend_names[backend];
+}
+
+/**
+ * \brief Computes the SHA-256 digest of each of several independent messages.
+ *
+ * \param[in]  messages  Message pointers, one per digest
+ * \param[in]  lengths   Message lengths in bytes
+ * \param[in]  count     Number of messages
+ * \param[out] digests   Receives one digest per message, in the same order
+ */
+void sw_sha256_multi(const uint8_t* const messages[], const size_t lengths[], size_t count,
+                     uint8_t digests[][SHA256_DIGEST_SIZE])
+{
+    size_t i;
+
+    switch (sw_sha256_multi_get_backend())
+    {
+#ifdef SW_SHA256_MULTI_X86
+    case SW_SHA256_MULTI_AVX2_8:
+        sw_sha256_multi_lanes(sw_sha256_multi_avx2, 8, messages, lengths, count, digests);
+        return;
+    case SW_SHA256_MULTI_AVX512_16:
+        sw_sha256_multi_lanes(sw_sha256_multi_avx512, 16, messages, lengths, count, digests);
+        return;
+#endif
+#ifdef SW_SHA256_MULTI_NEON
+    case SW_SHA256_MULTI_NEON4:
+        sw_sha256_multi_lanes(sw_sha256_multi_neon, 4, messages, lengths, count, digests);
+        return;
+#endif
+    default:
+        for (i = 0; i < count; i++)
+            sw_sha256(messages[i], (unsigned int)lengths[i], digests[i]);
+        return;
+    }
+}
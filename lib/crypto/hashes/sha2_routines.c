@@ -38,108 +38,420 @@
 
 #include <string.h>
 #include "sha2_routines.h"
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+#if !defined(ATCA_NO_SHA256_ACCEL) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SW_SHA256_SHA_NI
+#include <cpuid.h>
+#include <immintrin.h>
+#ifndef bit_SHA
+#define bit_SHA (1 << 29)
+#endif
+#endif
+
+#if !defined(ATCA_NO_SHA256_ACCEL) && defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define SW_SHA256_ARMV8
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define SW_SHA256_ARMV8_TARGET
+#elif defined(__clang__)
+#define SW_SHA256_ARMV8_TARGET __attribute__((target("crypto")))
+#else
+#define SW_SHA256_ARMV8_TARGET __attribute__((target("+crypto")))
+#endif
+#endif
 
 #define rotate_right(value, places) ((value >> places) | (value << (32 - places)))
 
+#define SHA256_BSIG0(x)     (rotate_right(x, 2) ^ rotate_right(x, 13) ^ rotate_right(x, 22))
+#define SHA256_BSIG1(x)     (rotate_right(x, 6) ^ rotate_right(x, 11) ^ rotate_right(x, 25))
+#define SHA256_SSIG0(x)     (rotate_right(x, 7) ^ rotate_right(x, 18) ^ (x >> 3))
+#define SHA256_SSIG1(x)     (rotate_right(x, 17) ^ rotate_right(x, 19) ^ (x >> 10))
+#define SHA256_CH(x, y, z)  ((x & (y ^ z)) ^ z)
+#define SHA256_MAJ(x, y, z) ((x & y) | (z & (x | y)))
+
+/* Message schedule word i, computed in place over a 16 word window */
+#define SHA256_EXPAND(w, i) \
+    (w[(i) & 15] += SHA256_SSIG1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + SHA256_SSIG0(w[((i) - 15) & 15]))
+
+/* One round with the working variables named by position rather than shuffled */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, w, i)                                          \
+    do {                                                                                    \
+        uint32_t t1 = h + SHA256_BSIG1(e) + SHA256_CH(e, f, g) + sw_sha256_k[i] + w[(i) & 15]; \
+        d += t1;                                                                            \
+        h = t1 + SHA256_BSIG0(a) + SHA256_MAJ(a, b, c);                                     \
+    } while (0)
+
+#define SHA256_EXPAND8(w, i)                           \
+    do {                                               \
+        SHA256_EXPAND(w, i + 0); SHA256_EXPAND(w, i + 1); \
+        SHA256_EXPAND(w, i + 2); SHA256_EXPAND(w, i + 3); \
+        SHA256_EXPAND(w, i + 4); SHA256_EXPAND(w, i + 5); \
+        SHA256_EXPAND(w, i + 6); SHA256_EXPAND(w, i + 7); \
+    } while (0)
+
+/* Eight rounds, after which the working variables are back in their original positions */
+#define SHA256_ROUND8(w, i)                                    \
+    do {                                                       \
+        SHA256_ROUND(a, b, c, d, e, f, g, h, w, i + 0);        \
+        SHA256_ROUND(h, a, b, c, d, e, f, g, w, i + 1);        \
+        SHA256_ROUND(g, h, a, b, c, d, e, f, w, i + 2);        \
+        SHA256_ROUND(f, g, h, a, b, c, d, e, w, i + 3);        \
+        SHA256_ROUND(e, f, g, h, a, b, c, d, w, i + 4);        \
+        SHA256_ROUND(d, e, f, g, h, a, b, c, w, i + 5);        \
+        SHA256_ROUND(c, d, e, f, g, h, a, b, w, i + 6);        \
+        SHA256_ROUND(b, c, d, e, f, g, h, a, w, i + 7);        \
+    } while (0)
+
+/** \brief Processes whole 64-byte blocks into an 8 word hash state */
+typedef void (*sw_sha256_block_fn)(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count);
+
+/** \brief SHA-256 round constants, shared with the multi-buffer routines */
+const uint32_t sw_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
 /**
- * \brief Processes whole blocks (64 bytes) of data.
+ * \brief Portable block function. Rounds are unrolled eight at a time so the
+ *        working variables stay in registers and never rotate through memory,
+ *        and the message schedule lives in a 16 word window.
  *
- * \param[in] ctx          SAH256 hash context
- * \param[in] blocks       Raw blocks to be processed
- * \param[in] block_count  Number of 64-byte blocks to process
+ * \param[in,out] hash         Hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
  */
-static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+static void sw_sha256_process_scalar(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
 {
-    int i = 0;
-    uint32_t block = 0;
-
-    union
-    {
-        uint32_t w_word[SHA256_BLOCK_SIZE];
-        uint8_t  w_byte[SHA256_BLOCK_SIZE * sizeof(uint32_t)];
-    } w_union;
-
-    static const uint32_t k[] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
+    uint32_t w[16];
+    uint32_t a, b, c, d, e, f, g, h;
+    int i;
 
-    // Loop through all the blocks to process
-    for (block = 0; block < block_count; block++)
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
     {
-        uint32_t w_index;
-        uint32_t word_value;
-        uint32_t s0, s1;
-        uint32_t t1, t2;
-        uint32_t maj, ch;
-        uint32_t rotate_register[8];
-        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
-
-        // Swap word bytes
-        for (i = 0; i < SHA256_BLOCK_SIZE; i += 4)
+        for (i = 0; i < 16; i++)
         {
-            w_union.w_byte[i + 3] = cur_msg_block[i + 0];
-            w_union.w_byte[i + 2] = cur_msg_block[i + 1];
-            w_union.w_byte[i + 1] = cur_msg_block[i + 2];
-            w_union.w_byte[i + 0] = cur_msg_block[i + 3];
+            w[i] = ((uint32_t)blocks[i * 4 + 0] << 24) | ((uint32_t)blocks[i * 4 + 1] << 16)
+                   | ((uint32_t)blocks[i * 4 + 2] << 8) | (uint32_t)blocks[i * 4 + 3];
         }
 
-        w_index = 16;
-        while (w_index < SHA256_BLOCK_SIZE)
+        a = hash[0]; b = hash[1]; c = hash[2]; d = hash[3];
+        e = hash[4]; f = hash[5]; g = hash[6]; h = hash[7];
+
+        SHA256_ROUND8(w, 0);
+        SHA256_ROUND8(w, 8);
+        for (i = 16; i < SHA256_BLOCK_SIZE; i += 16)
         {
-            // right rotate for 32-bit variable in C: (value >> places) | (value << 32 - places)
-            word_value = w_union.w_word[w_index - 15];
-            s0 = rotate_right(word_value, 7) ^ rotate_right(word_value, 18) ^ (word_value >> 3);
+            SHA256_EXPAND8(w, i);
+            SHA256_ROUND8(w, i);
+            SHA256_EXPAND8(w, i + 8);
+            SHA256_ROUND8(w, i + 8);
+        }
 
-            word_value = w_union.w_word[w_index - 2];
-            s1 = rotate_right(word_value, 17) ^ rotate_right(word_value, 19) ^ (word_value >> 10);
+        hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+        hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+    }
+}
 
-            w_union.w_word[w_index] = w_union.w_word[w_index - 16] + s0 + w_union.w_word[w_index - 7] + s1;
+#ifdef SW_SHA256_SHA_NI
+/* Rounds 4i..4i+3. w[] holds the last sixteen schedule words; the
+   conditions fold away since i is always a constant. */
+#define SHA_NI_ROUNDS4(i)                                                                 \
+    do {                                                                                  \
+        msg = _mm_add_epi32(w[(i) & 3], _mm_loadu_si128((const __m128i*)&sw_sha256_k[(i) * 4])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                              \
+        if ((i) >= 3 && (i) < 15)                                                         \
+        {                                                                                 \
+            tmp = _mm_alignr_epi8(w[(i) & 3], w[((i) - 1) & 3], 4);                       \
+            w[((i) + 1) & 3] = _mm_add_epi32(w[((i) + 1) & 3], tmp);                      \
+            w[((i) + 1) & 3] = _mm_sha256msg2_epu32(w[((i) + 1) & 3], w[(i) & 3]);        \
+        }                                                                                 \
+        msg = _mm_shuffle_epi32(msg, 0x0E);                                               \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);                              \
+        if ((i) >= 1 && (i) < 13)                                                         \
+            w[((i) - 1) & 3] = _mm_sha256msg1_epu32(w[((i) - 1) & 3], w[(i) & 3]);        \
+    } while (0)
 
-            w_index++;
-        }
+/**
+ * \brief Block function using the x86 SHA extensions (SHA-NI). Each
+ *        sha256rnds2 performs two rounds; the state is kept as the ABEF/CDGH
+ *        register pair the instructions expect.
+ *
+ * \param[in,out] hash         Hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
+ */
+__attribute__((target("sha,sse4.1")))
+static void sw_sha256_process_sha_ni(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef_save, cdgh_save, msg, tmp;
+    __m128i w[4];
+    int i;
 
-        // Initialize hash value for this chunk.
-        for (i = 0; i < 8; i++)
-            rotate_register[i] = ctx->hash[i];
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&hash[0]), 0xB1);    // CDAB
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&hash[4]), 0x1B); // EFGH
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                     // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                  // CDGH
 
-        // hash calculation loop
-        for (i = 0; i < SHA256_BLOCK_SIZE; i++)
-        {
-            s0 = rotate_right(rotate_register[0], 2)
-                 ^ rotate_right(rotate_register[0], 13)
-                 ^ rotate_right(rotate_register[0], 22);
-            maj = (rotate_register[0] & rotate_register[1])
-                  ^ (rotate_register[0] & rotate_register[2])
-                  ^ (rotate_register[1] & rotate_register[2]);
-            t2 = s0 + maj;
-            s1 = rotate_right(rotate_register[4], 6)
-                 ^ rotate_right(rotate_register[4], 11)
-                 ^ rotate_right(rotate_register[4], 25);
-            ch = (rotate_register[4] & rotate_register[5])
-                 ^ (~rotate_register[4] & rotate_register[6]);
-            t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_word[i];
-
-            rotate_register[7] = rotate_register[6];
-            rotate_register[6] = rotate_register[5];
-            rotate_register[5] = rotate_register[4];
-            rotate_register[4] = rotate_register[3] + t1;
-            rotate_register[3] = rotate_register[2];
-            rotate_register[2] = rotate_register[1];
-            rotate_register[1] = rotate_register[0];
-            rotate_register[0] = t1 + t2;
-        }
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
+    {
+        abef_save = state0;
+        cdgh_save = state1;
+
+        for (i = 0; i < 4; i++)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&blocks[i * 16]), byte_swap);
 
-        // Add the hash of this block to current result.
-        for (i = 0; i < 8; i++)
-            ctx->hash[i] += rotate_register[i];
+        SHA_NI_ROUNDS4(0);  SHA_NI_ROUNDS4(1);  SHA_NI_ROUNDS4(2);  SHA_NI_ROUNDS4(3);
+        SHA_NI_ROUNDS4(4);  SHA_NI_ROUNDS4(5);  SHA_NI_ROUNDS4(6);  SHA_NI_ROUNDS4(7);
+        SHA_NI_ROUNDS4(8);  SHA_NI_ROUNDS4(9);  SHA_NI_ROUNDS4(10); SHA_NI_ROUNDS4(11);
+        SHA_NI_ROUNDS4(12); SHA_NI_ROUNDS4(13); SHA_NI_ROUNDS4(14); SHA_NI_ROUNDS4(15);
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
     }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // HGFE
+
+    _mm_storeu_si128((__m128i*)&hash[0], state0);
+    _mm_storeu_si128((__m128i*)&hash[4], state1);
+}
+
+static int sw_sha256_has_sha_ni(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1))
+        return 0;
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return (ebx & bit_SHA) != 0;
+}
+#endif
+
+#ifdef SW_SHA256_ARMV8
+/* Rounds 4i..4i+3, scheduling the words for rounds 4i+16.. while they run */
+#define ARMV8_ROUNDS4(i)                                                      \
+    do {                                                                      \
+        msg = vaddq_u32(w[(i) & 3], vld1q_u32(&sw_sha256_k[(i) * 4]));        \
+        if ((i) < 12)                                                         \
+            w[(i) & 3] = vsha256su0q_u32(w[(i) & 3], w[((i) + 1) & 3]);       \
+        tmp = state0;                                                         \
+        state0 = vsha256hq_u32(state0, state1, msg);                          \
+        state1 = vsha256h2q_u32(state1, tmp, msg);                            \
+        if ((i) < 12)                                                         \
+            w[(i) & 3] = vsha256su1q_u32(w[(i) & 3], w[((i) + 2) & 3], w[((i) + 3) & 3]); \
+    } while (0)
+
+/**
+ * \brief Block function using the ARMv8 SHA2 crypto extension. Each
+ *        sha256h/sha256h2 pair performs four rounds.
+ *
+ * \param[in,out] hash         Hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
+ */
+SW_SHA256_ARMV8_TARGET
+static void sw_sha256_process_armv8(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&hash[0]);
+    uint32x4_t state1 = vld1q_u32(&hash[4]);
+    uint32x4_t abcd_save, efgh_save, msg, tmp;
+    uint32x4_t w[4];
+    int i;
+
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
+    {
+        abcd_save = state0;
+        efgh_save = state1;
+
+        for (i = 0; i < 4; i++)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&blocks[i * 16])));
+
+        ARMV8_ROUNDS4(0);  ARMV8_ROUNDS4(1);  ARMV8_ROUNDS4(2);  ARMV8_ROUNDS4(3);
+        ARMV8_ROUNDS4(4);  ARMV8_ROUNDS4(5);  ARMV8_ROUNDS4(6);  ARMV8_ROUNDS4(7);
+        ARMV8_ROUNDS4(8);  ARMV8_ROUNDS4(9);  ARMV8_ROUNDS4(10); ARMV8_ROUNDS4(11);
+        ARMV8_ROUNDS4(12); ARMV8_ROUNDS4(13); ARMV8_ROUNDS4(14); ARMV8_ROUNDS4(15);
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(&hash[0], state0);
+    vst1q_u32(&hash[4], state1);
+}
+
+static int sw_sha256_has_armv8(void)
+{
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+}
+#endif
+
+static const char* const sw_sha256_backend_names[SW_SHA256_BACKEND_COUNT] = {
+    "auto", "scalar", "sha-ni", "armv8"
+};
+
+/* Block function in use, resolved from the CPU once before the first hash */
+static sw_sha256_block_fn sw_sha256_block = NULL;
+static sw_sha256_backend sw_sha256_active = SW_SHA256_BACKEND_AUTO;
+#ifdef ATCA_USE_PTHREADS
+static pthread_once_t sw_sha256_block_once = PTHREAD_ONCE_INIT;
+#else
+static int sw_sha256_block_ready;
+#endif
+
+/**
+ * \brief Reports whether a backend is compiled in and supported by the CPU.
+ *
+ * \param[in] backend  Backend to check. SW_SHA256_BACKEND_AUTO is always available.
+ *
+ * \return 1 if the backend can be used, 0 otherwise
+ */
+int sw_sha256_backend_available(sw_sha256_backend backend)
+{
+    switch (backend)
+    {
+    case SW_SHA256_BACKEND_AUTO:
+    case SW_SHA256_BACKEND_SCALAR:
+        return 1;
+#ifdef SW_SHA256_SHA_NI
+    case SW_SHA256_BACKEND_SHA_NI:
+        return sw_sha256_has_sha_ni();
+#endif
+#ifdef SW_SHA256_ARMV8
+    case SW_SHA256_BACKEND_ARMV8:
+        return sw_sha256_has_armv8();
+#endif
+    default:
+        return 0;
+    }
+}
+
+/** \brief Points the block function at an available backend other than SW_SHA256_BACKEND_AUTO */
+static void sw_sha256_use(sw_sha256_backend backend)
+{
+    switch (backend)
+    {
+#ifdef SW_SHA256_SHA_NI
+    case SW_SHA256_BACKEND_SHA_NI:
+        sw_sha256_block = sw_sha256_process_sha_ni;
+        break;
+#endif
+#ifdef SW_SHA256_ARMV8
+    case SW_SHA256_BACKEND_ARMV8:
+        sw_sha256_block = sw_sha256_process_armv8;
+        break;
+#endif
+    default:
+        sw_sha256_block = sw_sha256_process_scalar;
+        backend = SW_SHA256_BACKEND_SCALAR;
+        break;
+    }
+    sw_sha256_active = backend;
+}
+
+/** \brief Fastest backend the CPU supports */
+static sw_sha256_backend sw_sha256_fastest(void)
+{
+    if (sw_sha256_backend_available(SW_SHA256_BACKEND_SHA_NI))
+        return SW_SHA256_BACKEND_SHA_NI;
+    if (sw_sha256_backend_available(SW_SHA256_BACKEND_ARMV8))
+        return SW_SHA256_BACKEND_ARMV8;
+    return SW_SHA256_BACKEND_SCALAR;
+}
+
+static void sw_sha256_resolve(void)
+{
+    sw_sha256_use(sw_sha256_fastest());
+}
+
+/** \brief Resolves the automatic backend the first time any thread needs it */
+static void sw_sha256_ready(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_once(&sw_sha256_block_once, sw_sha256_resolve);
+#else
+    if (!sw_sha256_block_ready)
+    {
+        sw_sha256_resolve();
+        sw_sha256_block_ready = 1;
+    }
+#endif
+}
+
+/**
+ * \brief Selects the block function used by all SHA-256 contexts. Intended
+ *        for tests and benchmarks; normal callers get the fastest backend
+ *        the CPU supports without calling this. Not safe to call while other
+ *        threads are hashing.
+ *
+ * \param[in] backend  Backend to use, or SW_SHA256_BACKEND_AUTO to pick the
+ *                     fastest available one.
+ *
+ * \return 0 on success, -1 if the backend is not available on this CPU
+ */
+int sw_sha256_set_backend(sw_sha256_backend backend)
+{
+    if (backend == SW_SHA256_BACKEND_AUTO)
+        backend = sw_sha256_fastest();
+    else if (!sw_sha256_backend_available(backend))
+        return -1;
+
+    // resolve first so the automatic choice can't later replace this one
+    sw_sha256_ready();
+    sw_sha256_use(backend);
+
+    return 0;
+}
+
+/**
+ * \brief Returns the backend currently processing blocks, resolving the
+ *        automatic choice if nothing has been hashed yet.
+ */
+sw_sha256_backend sw_sha256_get_backend(void)
+{
+    sw_sha256_ready();
+    return sw_sha256_active;
+}
+
+/** \brief Short lower case name of a backend, for test and benchmark output */
+const char* sw_sha256_backend_name(sw_sha256_backend backend)
+{
+    if ((unsigned)backend >= SW_SHA256_BACKEND_COUNT)
+        return "unknown";
+    return sw_sha256_backend_names[backend];
+}
+
+/**
+ * \brief Processes whole blocks (64 bytes) of data.
+ *
+ * \param[in] ctx          SAH256 hash context
+ * \param[in] blocks       Raw blocks to be processed
+ * \param[in] block_count  Number of 64-byte blocks to process
+ */
+static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+{
+    if (block_count == 0)
+        return;
+    sw_sha256_ready();
+    sw_sha256_block(ctx->hash, blocks, block_count);
 }
 
 void sw_sha256_init(sw_sha256_ctx* ctx)
@@ -39,11 +39,14 @@
 #ifndef SHA2_ROUTINES_H
 #define SHA2_ROUTINES_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define SHA256_DIGEST_SIZE (32)
 #define SHA256_BLOCK_SIZE  (64)
 
+#define SW_SHA256_MULTI_MAX_LANES (16)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -56,6 +59,29 @@ typedef struct
     uint32_t hash[8];                       //!< Hash state
 } sw_sha256_ctx;
 
+/** \brief Block function implementations behind sw_sha256_update/final */
+typedef enum
+{
+    SW_SHA256_BACKEND_AUTO = 0,     //!< Fastest backend the running CPU supports
+    SW_SHA256_BACKEND_SCALAR,       //!< Portable C, always available
+    SW_SHA256_BACKEND_SHA_NI,       //!< x86 SHA extensions
+    SW_SHA256_BACKEND_ARMV8,        //!< ARMv8 SHA2 crypto extension
+    SW_SHA256_BACKEND_COUNT
+} sw_sha256_backend;
+
+/** \brief How sw_sha256_multi spreads independent messages over the CPU */
+typedef enum
+{
+    SW_SHA256_MULTI_AUTO = 0,       //!< Fastest backend the running CPU supports
+    SW_SHA256_MULTI_SERIAL,         //!< One message at a time through the sw_sha256 block backend
+    SW_SHA256_MULTI_NEON4,          //!< Four messages in NEON lanes
+    SW_SHA256_MULTI_AVX2_8,         //!< Eight messages in AVX2 lanes
+    SW_SHA256_MULTI_AVX512_16,      //!< Sixteen messages in AVX-512 lanes
+    SW_SHA256_MULTI_COUNT
+} sw_sha256_multi_backend;
+
+extern const uint32_t sw_sha256_k[64];
+
 void sw_sha256_init(sw_sha256_ctx* ctx);
 
 void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* message, uint32_t len);
@@ -64,6 +90,18 @@ void sw_sha256_final(sw_sha256_ctx * ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
 
 void sw_sha256(const uint8_t * message, unsigned int len, uint8_t digest[SHA256_DIGEST_SIZE]);
 
+int sw_sha256_backend_available(sw_sha256_backend backend);
+int sw_sha256_set_backend(sw_sha256_backend backend);
+sw_sha256_backend sw_sha256_get_backend(void);
+const char* sw_sha256_backend_name(sw_sha256_backend backend);
+
+void sw_sha256_multi(const uint8_t* const messages[], const size_t lengths[], size_t count,
+                     uint8_t digests[][SHA256_DIGEST_SIZE]);
+int sw_sha256_multi_backend_available(sw_sha256_multi_backend backend);
+int sw_sha256_multi_set_backend(sw_sha256_multi_backend backend);
+sw_sha256_multi_backend sw_sha256_multi_get_backend(void);
+const char* sw_sha256_multi_backend_name(sw_sha256_multi_backend backend);
+
 #ifdef __cplusplus
 }
 #endif
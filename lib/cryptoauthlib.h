@@ -46,6 +46,7 @@
 #include "atca_status.h"
 #include "atca_device.h"
 #include "atca_command.h"
+#include "atca_execution.h"
 #include "atca_cfgs.h"
 #include "basic/atca_basic.h"
 #include "basic/atca_helpers.h"
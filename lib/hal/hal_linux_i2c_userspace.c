@@ -39,6 +39,7 @@
 #include "atca_hal.h"
 #include "hal_linux_i2c_userspace.h"
 
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -62,6 +63,120 @@
 // File scope globals
 ATCAI2CMaster_t *i2c_hal_data[MAX_I2C_BUSES]; // map logical, 0-based bus number to index
 int i2c_bus_ref_ct = 0;                       // total in-use count across buses
+static pthread_mutex_t i2c_hal_data_lock = PTHREAD_MUTEX_INITIALIZER;   // guards the two above
+
+/** \brief wait for exclusive use of a bus
+ *
+ * A ticket lock: callers get the bus strictly in the order they arrived, so a device
+ * issuing commands back to back can't starve another one on the same bus. Devices on
+ * different buses never wait on each other.
+ * \param[in] hal  bus object
+ */
+static void hal_i2c_bus_acquire(ATCAI2CMaster_t *hal)
+{
+    unsigned long ticket;
+
+    pthread_mutex_lock(&hal->lock);
+    ticket = hal->next_ticket++;
+    while (ticket != hal->now_serving)
+        pthread_cond_wait(&hal->turn, &hal->lock);
+    pthread_mutex_unlock(&hal->lock);
+}
+
+/** \brief hand a bus acquired with hal_i2c_bus_acquire() to the next caller in line
+ * \param[in] hal  bus object
+ */
+static void hal_i2c_bus_release(ATCAI2CMaster_t *hal)
+{
+    pthread_mutex_lock(&hal->lock);
+    hal->now_serving++;
+    pthread_cond_broadcast(&hal->turn);
+    pthread_mutex_unlock(&hal->lock);
+}
+
+/** \brief open the bus device if the bus object doesn't hold a descriptor yet
+ * \param[in] hal  bus object
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS hal_i2c_open(ATCAI2CMaster_t *hal)
+{
+    if (hal->fd >= 0)
+        return ATCA_SUCCESS;
+
+    hal->stats.opens++;
+    if ( (hal->fd = open(hal->i2c_file, O_RDWR)) < 0)
+        return ATCA_COMM_FAIL;
+    hal->slave_address = -1;
+
+    // adapters that can't report their functionality only get the plain read()/write() path
+    hal->stats.ioctls++;
+    if (ioctl(hal->fd, I2C_FUNCS, &hal->funcs) < 0)
+        hal->funcs = 0;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief check whether an interface moves its data with combined I2C_RDWR transactions
+ *
+ * Selected per interface with ATCAIfaceCfg.atcai2c.combined_xfer, and only honoured
+ * when the adapter supports plain I2C messages (I2C_FUNC_I2C).
+ * \param[in] cfg  interface configuration
+ * \param[in] hal  bus object, its descriptor must already be open
+ * \return non-zero when I2C_RDWR should be used
+ */
+static int hal_i2c_use_rdwr(ATCAIfaceCfg *cfg, ATCAI2CMaster_t *hal)
+{
+    return cfg->atcai2c.combined_xfer && (hal->funcs & I2C_FUNC_I2C);
+}
+
+/** \brief issue a message array as a single I2C_RDWR kernel transaction
+ *
+ * Every message carries its own slave address, so no I2C_SLAVE selection is needed.
+ * \param[in] hal    bus object owning the file descriptor
+ * \param[in] msgs   messages, executed back to back with repeated starts
+ * \param[in] count  number of messages
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS hal_i2c_rdwr(ATCAI2CMaster_t *hal, struct i2c_msg *msgs, int count)
+{
+    struct i2c_rdwr_ioctl_data xfer;
+
+    xfer.msgs = msgs;
+    xfer.nmsgs = count;
+
+    hal->stats.rdwrs++;
+    if (ioctl(hal->fd, I2C_RDWR, &xfer) != count)
+        return ATCA_COMM_FAIL;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief point the bus file descriptor at the given 7-bit slave address
+ *
+ * The address is cached in the bus object so I2C_SLAVE is only re-issued when a
+ * different device (or the wake address) is addressed on the shared descriptor.
+ * \param[in] hal      bus object owning the file descriptor
+ * \param[in] address  7-bit slave address
+ * \return ATCA_STATUS
+ */
+static ATCA_STATUS hal_i2c_set_slave(ATCAI2CMaster_t *hal, int address)
+{
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
+        return ATCA_COMM_FAIL;
+
+    if (hal->slave_address == address)
+        return ATCA_SUCCESS;
+
+    hal->stats.ioctls++;
+    if (ioctl(hal->fd, I2C_SLAVE, address) < 0)
+    {
+        hal->slave_address = -1;    // unknown state, force a re-issue next time
+        return ATCA_COMM_FAIL;
+    }
+    hal->slave_address = address;
+
+    return ATCA_SUCCESS;
+}
 
 /** \brief discover i2c buses available for this hardware
  * this maintains a list of logical to physical bus mappings freeing the application
@@ -100,8 +215,11 @@ ATCA_STATUS hal_i2c_init(void* hal, ATCAIfaceCfg* cfg)
 {
     int bus = cfg->atcai2c.bus; // 0-based logical bus number
     ATCAHAL_t *phal = (ATCAHAL_t*)hal;
+    ATCA_STATUS status = ATCA_COMM_FAIL;
     uint8_t i;
 
+    pthread_mutex_lock(&i2c_hal_data_lock);
+
     if (i2c_bus_ref_ct == 0)    // power up state, no i2c buses will have been used
 
         for (i = 0; i < MAX_I2C_BUSES; i++)
@@ -115,7 +233,16 @@ ATCA_STATUS hal_i2c_init(void* hal, ATCAIfaceCfg* cfg)
         if (i2c_hal_data[bus] == NULL)
         {
             i2c_hal_data[bus] = malloc(sizeof(ATCAI2CMaster_t) );
+            if (i2c_hal_data[bus] == NULL)
+            {
+                i2c_bus_ref_ct--;
+                pthread_mutex_unlock(&i2c_hal_data_lock);
+                return ATCA_COMM_FAIL;
+            }
+            memset(i2c_hal_data[bus], 0, sizeof(ATCAI2CMaster_t));
             i2c_hal_data[bus]->ref_ct = 1;  // buses are shared, this is the first instance
+            pthread_mutex_init(&i2c_hal_data[bus]->lock, NULL);
+            pthread_cond_init(&i2c_hal_data[bus]->turn, NULL);
 
             switch (bus)
             {
@@ -125,6 +252,12 @@ ATCA_STATUS hal_i2c_init(void* hal, ATCAIfaceCfg* cfg)
 
             // store this for use during the release phase
             i2c_hal_data[bus]->bus_index = bus;
+
+            // the descriptor lives as long as the bus object, no slave has been selected on it yet.
+            // A bus that can't be opened yet is retried on first use, like the per-call open used to.
+            i2c_hal_data[bus]->fd = -1;
+            i2c_hal_data[bus]->slave_address = -1;
+            hal_i2c_open(i2c_hal_data[bus]);
         }
         else
         {
@@ -135,9 +268,11 @@ ATCA_STATUS hal_i2c_init(void* hal, ATCAIfaceCfg* cfg)
 
         phal->hal_data = i2c_hal_data[bus];
 
-        return ATCA_SUCCESS;
+        status = ATCA_SUCCESS;
     }
-    return ATCA_COMM_FAIL;
+
+    pthread_mutex_unlock(&i2c_hal_data_lock);
+    return status;
 }
 
 /** \brief HAL implementation of I2C post init
@@ -149,18 +284,11 @@ ATCA_STATUS hal_i2c_post_init(ATCAIface iface)
     return ATCA_SUCCESS;
 }
 
-/** \brief HAL implementation of I2C send over ASF
- * \param[in] iface     instance
- * \param[in] txdata    pointer to space to bytes to send
- * \param[in] txlength  number of bytes to send
- * \return ATCA_STATUS
- */
-
-ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
+/** \brief send with the bus already acquired, see hal_i2c_send() */
+static ATCA_STATUS hal_i2c_send_locked(ATCAIface iface, uint8_t *txdata, int txlength)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bus = cfg->atcai2c.bus;
-    int f_i2c;  // I2C file descriptor
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
 
     // for this implementation of I2C with CryptoAuth chips, txdata is assumed to have ATCAPacket format
 
@@ -170,63 +298,99 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
     txdata[0] = 0x03; // insert the Word Address Value, Command token
     txlength++;       // account for word address value byte.
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(i2c_hal_data[bus]->i2c_file, O_RDWR)) < 0)
+    hal->stats.transfers++;
+
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
 
-    // Set Slave Address
-    if (ioctl(f_i2c, I2C_SLAVE, cfg->atcai2c.slave_address >> 1) < 0)
+    if (hal_i2c_use_rdwr(cfg, hal))
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        struct i2c_msg msg = { cfg->atcai2c.slave_address >> 1, 0, txlength, txdata };
+
+        return hal_i2c_rdwr(hal, &msg, 1);
     }
 
+    // Set Slave Address
+    if (hal_i2c_set_slave(hal, cfg->atcai2c.slave_address >> 1) != ATCA_SUCCESS)
+        return ATCA_COMM_FAIL;
+
     // Send data
-    if (write(f_i2c, txdata, txlength) != txlength)
-    {
-        close(f_i2c);
+    hal->stats.writes++;
+    if (write(hal->fd, txdata, txlength) != txlength)
         return ATCA_COMM_FAIL;
-    }
 
-    close(f_i2c);
     return ATCA_SUCCESS;
 }
 
-/** \brief HAL implementation of I2C receive function for ASF I2C
+/** \brief HAL implementation of I2C send over ASF
  * \param[in] iface     instance
- * \param[in] rxdata    pointer to space to receive the data
- * \param[in] rxlength  ptr to expected number of receive bytes to request
+ * \param[in] txdata    pointer to space to bytes to send
+ * \param[in] txlength  number of bytes to send
  * \return ATCA_STATUS
  */
 
-ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status;
+
+    hal_i2c_bus_acquire(hal);
+    status = hal_i2c_send_locked(iface, txdata, txlength);
+    hal_i2c_bus_release(hal);
+
+    return status;
+}
+
+/** \brief receive with the bus already acquired, see hal_i2c_receive() */
+static ATCA_STATUS hal_i2c_receive_locked(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bus = cfg->atcai2c.bus;
-    int f_i2c;  // I2C file descriptor
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+
+    hal->stats.transfers++;
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(i2c_hal_data[bus]->i2c_file, O_RDWR)) < 0)
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
 
-    // Set Slave Address
-    if (ioctl(f_i2c, I2C_SLAVE, cfg->atcai2c.slave_address >> 1) < 0)
+    if (hal_i2c_use_rdwr(cfg, hal))
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        // count byte, payload and CRC arrive in the one read message
+        struct i2c_msg msg = { cfg->atcai2c.slave_address >> 1, I2C_M_RD, *rxlength, rxdata };
+
+        return hal_i2c_rdwr(hal, &msg, 1);
     }
 
+    // Set Slave Address
+    if (hal_i2c_set_slave(hal, cfg->atcai2c.slave_address >> 1) != ATCA_SUCCESS)
+        return ATCA_COMM_FAIL;
+
     // Receive data
-    if (read(f_i2c, rxdata, *rxlength) != *rxlength)
-    {
-        close(f_i2c);
+    hal->stats.reads++;
+    if (read(hal->fd, rxdata, *rxlength) != *rxlength)
         return ATCA_COMM_FAIL;
-    }
 
-    close(f_i2c);
     return ATCA_SUCCESS;
 }
 
+/** \brief HAL implementation of I2C receive function for ASF I2C
+ * \param[in] iface     instance
+ * \param[in] rxdata    pointer to space to receive the data
+ * \param[in] rxlength  ptr to expected number of receive bytes to request
+ * \return ATCA_STATUS
+ */
+
+ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status;
+
+    hal_i2c_bus_acquire(hal);
+    status = hal_i2c_receive_locked(iface, rxdata, rxlength);
+    hal_i2c_bus_release(hal);
+
+    return status;
+}
+
 /** \brief method to change the bus speec of I2C
  * \param[in] iface  interface on which to change bus speed
  * \param[in] speed  baud rate (typically 100000 or 400000)
@@ -237,33 +401,64 @@ void change_i2c_speed(ATCAIface iface, uint32_t speed)
 
 }
 
-/** \brief wake up CryptoAuth device using I2C bus
- * \param[in] iface  interface to logical device to wakeup
+/** \brief wake sequence built from I2C_RDWR transactions
+ *
+ * The pulse and the status read address different slaves, which each message carries
+ * itself, so the I2C_SLAVE switches of the read()/write() path go away. The device only
+ * answers tWHI after the pulse, a gap the kernel can't insert inside one message array,
+ * so the pulse and the status read are two single-message transactions.
+ * \param[in] cfg  interface configuration
+ * \param[in] hal  bus object
+ * \return ATCA_STATUS
  */
+static ATCA_STATUS hal_i2c_wake_rdwr(ATCAIfaceCfg *cfg, ATCAI2CMaster_t *hal)
+{
+    uint8_t data[4], expected[4] = { 0x04, 0x11, 0x33, 0x43 };
+    uint8_t dummy_byte = 0x00;
+    struct i2c_msg pulse = { 0x00, 0, 1, &dummy_byte };
+    struct i2c_msg status = { cfg->atcai2c.slave_address >> 1, I2C_M_RD, sizeof(data), data };
 
-ATCA_STATUS hal_i2c_wake(ATCAIface iface)
+    // Nobody acknowledges address 0x00, carry on past the NACK where the adapter allows it
+    if (hal->funcs & I2C_FUNC_PROTOCOL_MANGLING)
+        pulse.flags |= I2C_M_IGNORE_NAK;
+    hal_i2c_rdwr(hal, &pulse, 1);
+
+    atca_delay_us(cfg->wake_delay); // wait tWHI + tWLO which is configured based on device type and configuration structure
+
+    if (hal_i2c_rdwr(hal, &status, 1) != ATCA_SUCCESS)
+        return ATCA_RX_NO_RESPONSE;
+
+    if (memcmp(data, expected, 4) == 0)
+        return ATCA_SUCCESS;
+    return ATCA_COMM_FAIL;
+}
+
+/** \brief wake with the bus already acquired, see hal_i2c_wake() */
+static ATCA_STATUS hal_i2c_wake_locked(ATCAIface iface)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bus = cfg->atcai2c.bus;
-    int f_i2c;  // I2C file descriptor
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
     uint8_t data[4], expected[4] = { 0x04, 0x11, 0x33, 0x43 };
     uint8_t dummy_byte = 0x00;
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(i2c_hal_data[bus]->i2c_file, O_RDWR)) < 0)
+    hal->stats.transfers++;
+    hal->stats.wakes++;
+
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
 
+    if (hal_i2c_use_rdwr(cfg, hal))
+        return hal_i2c_wake_rdwr(cfg, hal);
+
     // Send the wake by writing to an address of 0x00
     // Create wake up pulse by sending a slave address 0f 0x00.
     // This slave address is sent to device by using a dummy write command.
-    if (ioctl(f_i2c, I2C_SLAVE, 0x00) < 0)
-    {
-        close(f_i2c);
+    if (hal_i2c_set_slave(hal, 0x00) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
-    }
 
     // Dummy Write
-    if (write(f_i2c, &dummy_byte, 1) < 0)
+    hal->stats.writes++;
+    if (write(hal->fd, &dummy_byte, 1) < 0)
     {
         // This command will always return NACK.
         // So, the return code is being ignored.
@@ -272,20 +467,14 @@ ATCA_STATUS hal_i2c_wake(ATCAIface iface)
     atca_delay_us(cfg->wake_delay); // wait tWHI + tWLO which is configured based on device type and configuration structure
 
     // Set Slave Address
-    if (ioctl(f_i2c, I2C_SLAVE, cfg->atcai2c.slave_address >> 1) < 0)
-    {
-        close(f_i2c);
+    if (hal_i2c_set_slave(hal, cfg->atcai2c.slave_address >> 1) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
-    }
 
     // Receive data
-    if (read(f_i2c, data, 4) != 4)
-    {
-        close(f_i2c);
+    hal->stats.reads++;
+    if (read(hal->fd, data, 4) != 4)
         return ATCA_RX_NO_RESPONSE;
-    }
 
-    close(f_i2c);
     // if necessary, revert baud rate to what came in.
 
     if (memcmp(data, expected, 4) == 0)
@@ -293,69 +482,150 @@ ATCA_STATUS hal_i2c_wake(ATCAIface iface)
     return ATCA_COMM_FAIL;
 }
 
-/** \brief idle CryptoAuth device using I2C bus
- * \param[in] iface  interface to logical device to idle
+/** \brief wake up CryptoAuth device using I2C bus
+ * \param[in] iface  interface to logical device to wakeup
  */
 
-ATCA_STATUS hal_i2c_idle(ATCAIface iface)
+ATCA_STATUS hal_i2c_wake(ATCAIface iface)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status;
+
+    hal_i2c_bus_acquire(hal);
+    status = hal_i2c_wake_locked(iface);
+    hal_i2c_bus_release(hal);
+
+    return status;
+}
+
+/** \brief idle with the bus already acquired, see hal_i2c_idle() */
+static ATCA_STATUS hal_i2c_idle_locked(ATCAIface iface)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bus = cfg->atcai2c.bus;
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
     uint8_t data = 0x02; // idle word address value
-    int f_i2c;           // I2C file descriptor
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(i2c_hal_data[bus]->i2c_file, O_RDWR) ) < 0)
+    hal->stats.transfers++;
+
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
 
-    // Set Slave Address
-    if (ioctl(f_i2c, I2C_SLAVE, cfg->atcai2c.slave_address >> 1) < 0)
+    if (hal_i2c_use_rdwr(cfg, hal))
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        struct i2c_msg msg = { cfg->atcai2c.slave_address >> 1, 0, 1, &data };
+
+        return hal_i2c_rdwr(hal, &msg, 1);
     }
 
+    // Set Slave Address
+    if (hal_i2c_set_slave(hal, cfg->atcai2c.slave_address >> 1) != ATCA_SUCCESS)
+        return ATCA_COMM_FAIL;
+
     // Send data
-    if (write(f_i2c, &data, 1) != 1)
-    {
-        close(f_i2c);
+    hal->stats.writes++;
+    if (write(hal->fd, &data, 1) != 1)
         return ATCA_COMM_FAIL;
-    }
 
-    close(f_i2c);
     return ATCA_SUCCESS;
 }
 
-/** \brief sleep CryptoAuth device using I2C bus
- * \param[in] iface  interface to logical device to sleep
+/** \brief idle CryptoAuth device using I2C bus
+ * \param[in] iface  interface to logical device to idle
  */
 
-ATCA_STATUS hal_i2c_sleep(ATCAIface iface)
+ATCA_STATUS hal_i2c_idle(ATCAIface iface)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status;
+
+    hal_i2c_bus_acquire(hal);
+    status = hal_i2c_idle_locked(iface);
+    hal_i2c_bus_release(hal);
+
+    return status;
+}
+
+/** \brief sleep with the bus already acquired, see hal_i2c_sleep() */
+static ATCA_STATUS hal_i2c_sleep_locked(ATCAIface iface)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
-    int bus = cfg->atcai2c.bus;
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
     uint8_t data = 0x01; // sleep word address value
-    int f_i2c;           // I2C file descriptor
 
-    // Initiate I2C communication
-    if ( (f_i2c = open(i2c_hal_data[bus]->i2c_file, O_RDWR)) < 0)
+    hal->stats.transfers++;
+
+    if (hal_i2c_open(hal) != ATCA_SUCCESS)
         return ATCA_COMM_FAIL;
 
-    // Set Slave Address
-    if (ioctl(f_i2c, I2C_SLAVE, cfg->atcai2c.slave_address >> 1) < 0)
+    if (hal_i2c_use_rdwr(cfg, hal))
     {
-        close(f_i2c);
-        return ATCA_COMM_FAIL;
+        struct i2c_msg msg = { cfg->atcai2c.slave_address >> 1, 0, 1, &data };
+
+        return hal_i2c_rdwr(hal, &msg, 1);
     }
 
+    // Set Slave Address
+    if (hal_i2c_set_slave(hal, cfg->atcai2c.slave_address >> 1) != ATCA_SUCCESS)
+        return ATCA_COMM_FAIL;
+
     // Send data
-    if (write(f_i2c, &data, 1) != 1)
-    {
-        close(f_i2c);
+    hal->stats.writes++;
+    if (write(hal->fd, &data, 1) != 1)
         return ATCA_COMM_FAIL;
-    }
 
-    close(f_i2c);
+    return ATCA_SUCCESS;
+}
+
+/** \brief sleep CryptoAuth device using I2C bus
+ * \param[in] iface  interface to logical device to sleep
+ */
+
+ATCA_STATUS hal_i2c_sleep(ATCAIface iface)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status;
+
+    hal_i2c_bus_acquire(hal);
+    status = hal_i2c_sleep_locked(iface);
+    hal_i2c_bus_release(hal);
+
+    return status;
+}
+
+/** \brief retrieve the bus syscall counters for the bus an interface is attached to
+ * \param[in]  iface  interface whose bus should be queried
+ * \param[out] stats  receives a copy of the counters
+ * \return ATCA_STATUS
+ */
+
+ATCA_STATUS hal_i2c_get_stats(ATCAIface iface, ATCAI2CStats_t *stats)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+
+    if (hal == NULL || stats == NULL)
+        return ATCA_BAD_PARAM;
+
+    hal_i2c_bus_acquire(hal);
+    *stats = hal->stats;
+    hal_i2c_bus_release(hal);
+    return ATCA_SUCCESS;
+}
+
+/** \brief zero the bus syscall counters for the bus an interface is attached to
+ * \param[in] iface  interface whose bus counters should be cleared
+ * \return ATCA_STATUS
+ */
+
+ATCA_STATUS hal_i2c_reset_stats(ATCAIface iface)
+{
+    ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)atgetifacehaldat(iface);
+
+    if (hal == NULL)
+        return ATCA_BAD_PARAM;
+
+    hal_i2c_bus_acquire(hal);
+    memset(&hal->stats, 0, sizeof(hal->stats));
+    hal_i2c_bus_release(hal);
     return ATCA_SUCCESS;
 }
 
@@ -367,15 +637,22 @@ ATCA_STATUS hal_i2c_release(void *hal_data)
 {
     ATCAI2CMaster_t *hal = (ATCAI2CMaster_t*)hal_data;
 
+    pthread_mutex_lock(&i2c_hal_data_lock);
+
     i2c_bus_ref_ct--;   // track total i2c bus interface instances for consistency checking and debugging
 
     // if the use count for this bus has gone to 0 references, disable it.  protect against an unbracketed release
     if (hal && --(hal->ref_ct) <= 0 && i2c_hal_data[hal->bus_index] != NULL)
     {
+        if (hal->fd >= 0)
+            close(hal->fd);
+        pthread_cond_destroy(&hal->turn);
+        pthread_mutex_destroy(&hal->lock);
         free(i2c_hal_data[hal->bus_index]);
         i2c_hal_data[hal->bus_index] = NULL;
     }
 
+    pthread_mutex_unlock(&i2c_hal_data_lock);
     return ATCA_SUCCESS;
 }
 
@@ -39,6 +39,8 @@
 #ifndef HAL_LINUX_I2C_USERSPACE_H_
 #define HAL_LINUX_I2C_USERSPACE_H_
 
+#include <pthread.h>
+
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
  * \brief
@@ -48,6 +50,18 @@
 
 #define MAX_I2C_BUSES   2   // Raspberry Pi has 2 TWI
 
+// Syscall counters kept per bus, used to measure the cost of a command on the wire
+typedef struct atcaI2Cstats
+{
+    uint32_t opens;         // open() calls on the bus device
+    uint32_t ioctls;        // ioctl() calls (slave address selection, adapter functionality query)
+    uint32_t rdwrs;         // ioctl(I2C_RDWR) combined transactions
+    uint32_t reads;         // read() calls
+    uint32_t writes;        // write() calls
+    uint32_t transfers;     // HAL entry points invoked (send, receive, wake, idle, sleep)
+    uint32_t wakes;         // wake sequences issued
+} ATCAI2CStats_t;
+
 // A structure to hold I2C information
 typedef struct atcaI2Cmaster
 {
@@ -55,12 +69,24 @@ typedef struct atcaI2Cmaster
     int  ref_ct;
     // for conveniences during interface release phase
     int bus_index;
+    int fd;             // bus file descriptor, open from hal_i2c_init until the last hal_i2c_release
+    unsigned long funcs; // adapter functionality (I2C_FUNCS) read when fd was opened
+    int slave_address;  // 7-bit address currently selected with I2C_SLAVE on fd, -1 if none
+    ATCAI2CStats_t stats;
+    // the bus is handed to the devices on it in the order they asked for it
+    pthread_mutex_t lock;           // guards the ticket counters
+    pthread_cond_t  turn;           // signalled whenever now_serving moves on
+    unsigned long   next_ticket;    // ticket the next caller draws
+    unsigned long   now_serving;    // ticket of the caller that owns the bus
 } ATCAI2CMaster_t;
 
 void change_i2c_speed(
     ATCAIface iface,
     uint32_t speed);
 
+ATCA_STATUS hal_i2c_get_stats(ATCAIface iface, ATCAI2CStats_t *stats);
+ATCA_STATUS hal_i2c_reset_stats(ATCAIface iface);
+
 /** @} */
 
 #endif /* HAL_LINUX_I2C_H_ */
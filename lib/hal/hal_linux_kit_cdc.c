@@ -43,6 +43,9 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
 #include <termios.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -72,6 +75,92 @@ ATCA_STATUS hal_kit_phy_num_found(int8_t* num_found);
 // File scope globals
 atcacdc_t _gCdc;
 
+/** \brief Milliseconds on the monotonic clock, for receive and transmit deadlines */
+static int64_t cdc_now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/** \brief Move everything the port has ready into its ring buffer without blocking
+ *
+ * With VMIN and VTIME 0 a tty read() returns 0 once the port is drained, O_NONBLOCK or
+ * not, so 0 ends the loop like EAGAIN does. A hangup is taken from poll()'s revents
+ * once nothing is left to read.
+ *  \param[in] kit      the kit whose port is read
+ *  \param[in] revents  events poll() reported for the port
+ *  \return ATCA_SUCCESS, or ATCA_RX_FAIL if the port failed or hung up
+ */
+static ATCA_STATUS cdc_fill(cdc_device_t* kit, short revents)
+{
+    uint16_t count;
+    uint16_t start;
+    uint16_t space;
+    ssize_t bytes_read;
+    size_t total = 0;
+
+    while ((count = (uint16_t)(kit->ring_tail - kit->ring_head)) < CDC_RING_SIZE)
+    {
+        // Read straight into the contiguous free space after ring_tail
+        start = kit->ring_tail & (CDC_RING_SIZE - 1);
+        space = min(CDC_RING_SIZE - count, CDC_RING_SIZE - start);
+        bytes_read = read(kit->read_handle, &kit->ring[start], space);
+        if (bytes_read > 0)
+        {
+            kit->ring_tail += (uint16_t)bytes_read;
+            total += (size_t)bytes_read;
+        }
+        else if (bytes_read < 0 && errno == EINTR)
+            continue;
+        else if (bytes_read == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+        else
+            return ATCA_RX_FAIL;
+    }
+
+    if (total == 0 && (revents & (POLLHUP | POLLERR | POLLNVAL)))
+        return ATCA_RX_FAIL;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Close a kit's port, dropping anything still buffered
+ *  \param[in] kit  the kit whose port is closed
+ */
+static void cdc_close(cdc_device_t* kit)
+{
+    // The read and write handles are the same descriptor
+    if (kit->read_handle != INVALID_HANDLE_VALUE)
+        close(kit->read_handle);
+    kit->read_handle = INVALID_HANDLE_VALUE;
+    kit->write_handle = INVALID_HANDLE_VALUE;
+    kit->ring_head = kit->ring_tail;
+    kit->ring_scanned = 0;
+}
+
+/** \brief Length of the first complete kit message in the ring buffer, '\n' included
+ *
+ * Bytes searched by an earlier call aren't searched again.
+ *
+ *  \param[in] kit  the kit whose ring buffer is searched
+ *  \return the message length, 0 while no complete message has arrived
+ */
+static int cdc_frame_length(cdc_device_t* kit)
+{
+    uint16_t count = (uint16_t)(kit->ring_tail - kit->ring_head);
+
+    while (kit->ring_scanned < count)
+    {
+        if (kit->ring[(uint16_t)(kit->ring_head + kit->ring_scanned) & (CDC_RING_SIZE - 1)] == '\n')
+            return kit->ring_scanned + 1;
+        kit->ring_scanned++;
+    }
+
+    return 0;
+}
+
 
 /** \brief HAL implementation of Kit USB CDC init
  *
@@ -138,7 +227,7 @@ ATCA_STATUS hal_kit_cdc_init(void* hal, ATCAIfaceCfg* cfg)
 
     // Get the read & write handles
     // todo: perform an actual discovery here...
-    if ( (fd = open(dev, O_RDWR | O_NOCTTY)) < 0)
+    if ( (fd = open(dev, O_RDWR | O_NOCTTY | O_NONBLOCK)) < 0)
     {
         printf("Failed to open %s ret:%02X\n", dev, fd);
         return ATCA_COMM_FAIL;
@@ -160,10 +249,13 @@ ATCA_STATUS hal_kit_cdc_init(void* hal, ATCAIfaceCfg* cfg)
     serialTermios.c_iflag = 0;
     serialTermios.c_oflag = 0;
     serialTermios.c_lflag = 0;
-    // serialTermios.c_cc[VMIN] = 1;
-    // serialTermios.c_cc[VTIME] = 0;
+    // Reads return whatever has arrived, receive waits in poll() against its deadline
+    serialTermios.c_cc[VMIN] = 0;
+    serialTermios.c_cc[VTIME] = 0;
 
     tcsetattr(fd, TCSANOW, &serialTermios);
+    // Drop anything left over from an earlier session
+    tcflush(fd, TCIOFLUSH);
 
     _gCdc.kits[0].read_handle = fd;
     _gCdc.kits[0].write_handle = fd;
@@ -205,14 +297,17 @@ ATCA_STATUS hal_kit_cdc_post_init(ATCAIface iface)
  */
 ATCA_STATUS kit_phy_send(ATCAIface iface, const char* txdata, int txlength)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
     int cdcid = cfg->atcauart.port;
     atcacdc_t* pCdc = (atcacdc_t*)atgetifacehaldat(iface);
-    // size_t bytesWritten = 0;  unused
+    int64_t deadline = cdc_now_ms() + CDC_TX_TIMEOUT_MS;
+    struct pollfd pfd;
+    ssize_t bytes_written = 0;
+    int total_bytes = 0;
+    int remaining_ms = 0;
 
 #ifdef KIT_DEBUG
-    printf("--> %s", txdata);
+    printf("--> %.*s", txlength, txdata);
 #endif
     // Verify the input parameters
     if ((txdata == NULL) || (pCdc == NULL))
@@ -222,16 +317,39 @@ ATCA_STATUS kit_phy_send(ATCAIface iface, const char* txdata, int txlength)
     if (pCdc->kits[cdcid].write_handle == INVALID_HANDLE_VALUE)
         return ATCA_COMM_FAIL;
 
-    // Write the bytes to the specified com port
-    write(pCdc->kits[cdcid].write_handle, txdata, txlength);
+    // Write the bytes to the specified com port, waiting for room when the port is full
+    pfd.fd = pCdc->kits[cdcid].write_handle;
+    pfd.events = POLLOUT;
+    while (total_bytes < txlength)
+    {
+        bytes_written = write(pfd.fd, &txdata[total_bytes], txlength - total_bytes);
+        if (bytes_written > 0)
+        {
+            total_bytes += (int)bytes_written;
+            continue;
+        }
+        if (bytes_written < 0 && errno == EINTR)
+            continue;
+        if (bytes_written == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            return ATCA_TX_FAIL;
+
+        remaining_ms = (int)(deadline - cdc_now_ms());
+        if (remaining_ms <= 0 || poll(&pfd, 1, remaining_ms) == 0)
+            return ATCA_TX_TIMEOUT;
+    }
 
-    return status;
+    return ATCA_SUCCESS;
 }
 
-/** \brief HAL implementation of kit protocol send over USB CDC
+/** \brief HAL implementation of kit protocol receive over USB CDC
+ *
+ * Waits in poll() until the port's ring buffer holds a complete kit message or
+ * CDC_RX_TIMEOUT_MS runs out. Bytes after the message stay in the ring buffer
+ * for the next receive.
+ *
  * \param[in]    iface   instance
  * \param[out]   rxdata  pointer to space to receive the data
- * \param[inout] rxsize  ptr to expected number of receive bytes to request
+ * \param[inout] rxsize  As input, the size of rxdata. As output, the number of bytes received.
  * \return ATCA_STATUS
  */
 ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
@@ -240,12 +358,13 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
     int cdcid = cfg->atcauart.port;
     atcacdc_t* pCdc = (atcacdc_t*)atgetifacehaldat(iface);
-    uint8_t buffer[CDC_BUFFER_MAX] = { 0 };
-    bool continue_read = true;
-    int bytes_read = 0;
-    uint16_t total_bytes = 0;
-    char* location = NULL;
-    int bytes_remain = 0;
+    cdc_device_t* kit = NULL;
+    int64_t deadline = cdc_now_ms() + CDC_RX_TIMEOUT_MS;
+    struct pollfd pfd;
+    int frame_length = 0;
+    int remaining_ms = 0;
+    int ret = 0;
+    uint16_t start = 0;
     int bytes_to_cpy = 0;
 
     do
@@ -256,53 +375,155 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
             status = ATCA_BAD_PARAM;
             break;
         }
-        // Verify the write handle
-        if (pCdc->kits[cdcid].read_handle == INVALID_HANDLE_VALUE)
+        kit = &pCdc->kits[cdcid];
+        // Verify the read handle
+        if (kit->read_handle == INVALID_HANDLE_VALUE)
         {
             status = ATCA_COMM_FAIL;
             break;
         }
-        // Read all of the bytes
-        while (continue_read == true)
-        {
-            bytes_read = read(pCdc->kits[cdcid].read_handle, buffer, CDC_BUFFER_MAX);
 
-            // Find the location of the '\n' character in read buffer
-            // todo: generalize this read...  it only applies if there is an ascii protocol with an <eom> of \n and if the <eom> exists
-            location = strchr((char*)&buffer[0], '\n');
-            if (location == NULL)
+        pfd.fd = kit->read_handle;
+        pfd.events = POLLIN;
+        while ((frame_length = cdc_frame_length(kit)) == 0)
+        {
+            if ((uint16_t)(kit->ring_tail - kit->ring_head) == CDC_RING_SIZE)
             {
-                // Copy all of the bytes
-                bytes_to_cpy = bytes_read;
+                // A full ring buffer without a '\n' isn't kit protocol, drop it
+                kit->ring_head = kit->ring_tail;
+                kit->ring_scanned = 0;
+                status = ATCA_RX_FAIL;
+                break;
             }
-            else
+            remaining_ms = (int)(deadline - cdc_now_ms());
+            ret = (remaining_ms > 0) ? poll(&pfd, 1, remaining_ms) : 0;
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
             {
-                // Copy only the bytes remaining in the read buffer to the <eom>
-                bytes_to_cpy = (uint8_t)(location - (char*)buffer) + 1;
-                // The response has been received, stop receiving more data
-                continue_read = false;
+                status = (ret < 0 || kit->ring_tail != kit->ring_head) ? ATCA_RX_FAIL : ATCA_TIMEOUT;
+                break;
             }
-            // Protect rxdata from overwriting, this will have the result of truncating the returned bytes
-            // Remaining space in rxdata
-            bytes_remain = (*rxsize - total_bytes);
-            // Use the minimum between number of bytes read and remaining space
-            bytes_to_cpy = min(bytes_remain, bytes_to_cpy);
-
-            // Copy the received data
-            memcpy(&rxdata[total_bytes], &buffer[0], bytes_to_cpy);
-            total_bytes += bytes_to_cpy;
+            if ((status = cdc_fill(kit, pfd.revents)) != ATCA_SUCCESS)
+                break;
         }
+        if (status != ATCA_SUCCESS)
+            break;
 
+        // Hand out the message, it may wrap around the end of the ring buffer
+        if (frame_length <= *rxsize)
+        {
+            start = kit->ring_head & (CDC_RING_SIZE - 1);
+            bytes_to_cpy = min(frame_length, CDC_RING_SIZE - start);
+            memcpy(rxdata, &kit->ring[start], bytes_to_cpy);
+            memcpy(&rxdata[bytes_to_cpy], kit->ring, frame_length - bytes_to_cpy);
+        }
+        else
+            status = ATCA_RX_FAIL;
+        kit->ring_head += (uint16_t)frame_length;
+        kit->ring_scanned = 0;
     }
     while (0);
 
-    *rxsize = total_bytes;
+    *rxsize = (status == ATCA_SUCCESS) ? frame_length : 0;
 #ifdef KIT_DEBUG
-    printf("<-- %s", rxdata);
+    printf("<-- %.*s", *rxsize, rxdata);
 #endif
     return status;
 }
 
+/** \brief Wait on all open kit ports at once until one of them has a complete kit message
+ *
+ * Lets a single thread service many kit boards: the ports that report ready can
+ * then be received from without blocking.
+ *
+ * A port that hangs up or fails is closed and ATCA_COMM_FAIL returned, the next call
+ * waits on the ports that are left.
+ *
+ * \param[in]  cdc         the CDC HAL data holding the kit ports
+ * \param[in]  timeout_ms  longest time to wait, 0 to only check, negative to wait
+ *                         without a limit
+ * \param[out] ready       bit n is set when port n has a complete message buffered
+ * \return ATCA_SUCCESS when at least one port is ready, ATCA_TIMEOUT when none became
+ *         ready in time, ATCA_COMM_FAIL when a port failed or no port is open
+ */
+ATCA_STATUS hal_kit_cdc_poll(atcacdc_t* cdc, int timeout_ms, uint32_t* ready)
+{
+    struct pollfd pfds[CDC_DEVICES_MAX];
+    int ports[CDC_DEVICES_MAX];
+    int64_t deadline = cdc_now_ms() + timeout_ms;
+    int remaining_ms = 0;
+    int nfds = 0;
+    int ret = 0;
+    int i;
+
+    if ((cdc == NULL) || (ready == NULL))
+        return ATCA_BAD_PARAM;
+
+    while (1)
+    {
+        // Ports that already hold a message are ready, the rest are waited on
+        *ready = 0;
+        nfds = 0;
+        for (i = 0; i < cdc->num_kits_found; i++)
+        {
+            if (cdc->kits[i].read_handle == INVALID_HANDLE_VALUE)
+                continue;
+            if (cdc_frame_length(&cdc->kits[i]) > 0)
+                *ready |= 1u << i;
+            pfds[nfds].fd = cdc->kits[i].read_handle;
+            pfds[nfds].events = POLLIN;
+            ports[nfds++] = i;
+        }
+        if (*ready != 0)
+            return ATCA_SUCCESS;
+        if (nfds == 0)
+            return ATCA_COMM_FAIL;
+
+        remaining_ms = -1;
+        if (timeout_ms >= 0)
+        {
+            remaining_ms = (int)(deadline - cdc_now_ms());
+            if (remaining_ms < 0)
+                remaining_ms = 0;
+        }
+        ret = poll(pfds, nfds, remaining_ms);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret < 0)
+            return ATCA_COMM_FAIL;
+        if (ret == 0)
+            return ATCA_TIMEOUT;
+
+        for (i = 0; i < nfds; i++)
+        {
+            if ((pfds[i].revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) == 0)
+                continue;
+            if (cdc_fill(&cdc->kits[ports[i]], pfds[i].revents) != ATCA_SUCCESS)
+            {
+                // Polling a hung up port again returns at once, forever
+                cdc_close(&cdc->kits[ports[i]]);
+                return ATCA_COMM_FAIL;
+            }
+        }
+    }
+}
+
+/** \brief ASCII frame buffer of the kit behind this interface, KIT_FRAME_SIZE bytes
+ *  \param[in] iface  instance
+ *  \return pointer to the frame buffer, NULL if the interface has no kit
+ */
+char* kit_phy_frame(ATCAIface iface)
+{
+    ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+    atcacdc_t* pCdc = (atcacdc_t*)atgetifacehaldat(iface);
+
+    if ((cfg == NULL) || (pCdc == NULL))
+        return NULL;
+
+    return pCdc->kits[cfg->atcauart.port].frame;
+}
+
 /** \brief Number of USB CDC devices found
  *  \param[out] num_found
  *  \return ATCA_STATUS
@@ -382,17 +603,7 @@ ATCA_STATUS hal_kit_cdc_release(void* hal_data)
     // Close all kit USB devices
     for (i = 0; i < phaldat->num_kits_found; i++)
     {
-        if (phaldat->kits[i].read_handle != INVALID_HANDLE_VALUE)
-        {
-            close(phaldat->kits[i].read_handle);
-            phaldat->kits[i].read_handle = INVALID_HANDLE_VALUE;
-        }
-
-        if (phaldat->kits[i].write_handle != INVALID_HANDLE_VALUE)
-        {
-            close(phaldat->kits[i].write_handle);
-            phaldat->kits[i].write_handle = INVALID_HANDLE_VALUE;
-        }
+        cdc_close(&phaldat->kits[i]);
     }
     return ATCA_SUCCESS;
 }
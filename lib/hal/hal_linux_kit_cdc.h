@@ -39,6 +39,8 @@
 #ifndef HAL_LINUX_KIT_CDC_H_
 #define HAL_LINUX_KIT_CDC_H_
 
+#include "kit_protocol.h"
+
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
  * \brief
@@ -49,6 +51,9 @@
 // Kit USB defines
 #define CDC_DEVICES_MAX     10      //! Maximum number of supported Kit USB devices
 #define CDC_BUFFER_MAX      1024    //! Maximum number of bytes read per port read
+#define CDC_RING_SIZE       1024    //! Bytes buffered per port between frames, a power of two larger than KIT_FRAME_SIZE
+#define CDC_RX_TIMEOUT_MS   3000    //! Longest wait for a complete kit reply, covers the slowest device command
+#define CDC_TX_TIMEOUT_MS   1000    //! Longest wait for the port to accept a kit command
 
 
 // Each device that is found will have a read handle and a write handle
@@ -58,6 +63,11 @@ typedef struct cdc_device
 {
     HANDLE read_handle;         //! The kit USB read file handle
     HANDLE write_handle;        //! The kit USB write file handle
+    char   frame[KIT_FRAME_SIZE]; //! The kit protocol ASCII frame being sent or received
+    uint8_t  ring[CDC_RING_SIZE]; //! Bytes received from the port and not yet handed out
+    uint16_t ring_head;           //! Free-running index of the next byte to hand out of ring
+    uint16_t ring_tail;           //! Free-running index of the next byte to store in ring
+    uint16_t ring_scanned;        //! Bytes after ring_head already known not to hold a '\n'
 } cdc_device_t;
 
 
@@ -68,6 +78,8 @@ typedef struct atcacdc
     int8_t       num_kits_found;
 } atcacdc_t;
 
+ATCA_STATUS hal_kit_cdc_poll(atcacdc_t* cdc, int timeout_ms, uint32_t* ready);
+
 /** @} */
 
 #endif /* HAL_LINUX_KIT_CDC_H_ */
@@ -40,8 +40,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "atca_hal.h"
+#include "kit_phy.h"
 #include "hal_linux_kit_hid.h"
 #include "hal/kit_protocol.h"
 
@@ -95,7 +98,7 @@ ATCA_STATUS hal_kit_hid_init(void* hal, ATCAIfaceCfg* cfg)
     int i = 0;
     char hid_filter[20];
     char device_hid[20];
-    FILE *file_descriptor = NULL;
+    int file_descriptor = INVALID_HANDLE_VALUE;
     int index = 0;
 
     // Check the input variables
@@ -106,8 +109,8 @@ ATCA_STATUS hal_kit_hid_init(void* hal, ATCAIfaceCfg* cfg)
     memset(&_gHid, 0, sizeof(_gHid));
     for (i = 0; i < HID_DEVICES_MAX; i++)
     {
-        _gHid.kits[i].read_handle = NULL;
-        _gHid.kits[i].write_handle = NULL;
+        _gHid.kits[i].read_handle = INVALID_HANDLE_VALUE;
+        _gHid.kits[i].write_handle = INVALID_HANDLE_VALUE;
     }
 
     _gHid.num_kits_found = 0;
@@ -157,13 +160,11 @@ ATCA_STATUS hal_kit_hid_init(void* hal, ATCAIfaceCfg* cfg)
         if (strcasecmp(device_hid, hid_filter) == 0)
         {
             // Open the kit USB device for reading and writing
-            if (_gHid.kits[index].read_handle != NULL)
-                fclose(_gHid.kits[index].read_handle);
-            if (_gHid.kits[index].write_handle != NULL)
-                fclose(_gHid.kits[index].write_handle);
+            if (_gHid.kits[index].read_handle != INVALID_HANDLE_VALUE)
+                close(_gHid.kits[index].read_handle);
 
-            file_descriptor = fopen(udev_device_get_devnode(syspath_device), "rb+");
-            if (file_descriptor != NULL)
+            file_descriptor = open(udev_device_get_devnode(syspath_device), O_RDWR);
+            if (file_descriptor != INVALID_HANDLE_VALUE)
             {
                 _gHid.kits[index].read_handle = file_descriptor;
                 _gHid.kits[index].write_handle = file_descriptor;
@@ -184,7 +185,7 @@ ATCA_STATUS hal_kit_hid_init(void* hal, ATCAIfaceCfg* cfg)
             else
             {
 #ifdef KIT_DEBUG
-                printf("fopen(\"%s\") failed with errno=%d\n",
+                printf("open(\"%s\") failed with errno=%d\n",
                        udev_device_get_devnode(syspath_device),
                        errno);
 #endif          // KIT_DEBUG
@@ -242,71 +243,104 @@ ATCA_STATUS hal_kit_hid_post_init(ATCAIface iface)
  *  \param[in] txlength  number of bytes to send
  *  \return ATCA_STATUS
  */
-ATCA_STATUS kit_phy_send(ATCAIface iface, uint8_t* txdata, int txlength)
+ATCA_STATUS kit_phy_send(ATCAIface iface, const char* txdata, int txlength)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
     atcahid_t* pHid = (atcahid_t*)atgetifacehaldat(iface);
-    size_t bytes_written = 0;
+    ssize_t bytes_written = 0;
+    int total_bytes_written = 0;
 
     if ((txdata == NULL) || (cfg == NULL) || (pHid == NULL))
         return ATCA_BAD_PARAM;
 
-    if (pHid->kits[cfg->atcahid.idx].write_handle == NULL)
+    if (pHid->kits[cfg->atcahid.idx].write_handle == INVALID_HANDLE_VALUE)
         return ATCA_COMM_FAIL;
 
     // Send the data to the kit USB device
-    if (txlength > 0)
+    while (total_bytes_written < txlength)
     {
-        bytes_written = fwrite(txdata, sizeof(uint8_t), txlength,
-                               pHid->kits[cfg->atcahid.idx].write_handle);
-        if (bytes_written != txlength)
-        {
-            clearerr(pHid->kits[cfg->atcahid.idx].write_handle);
+        bytes_written = write(pHid->kits[cfg->atcahid.idx].write_handle, &txdata[total_bytes_written],
+                              txlength - total_bytes_written);
+        if (bytes_written < 0 && errno == EINTR)
+            continue;
+        if (bytes_written <= 0)
             return ATCA_TX_FAIL;
-        }
+        total_bytes_written += (int)bytes_written;
     }
 
     return ATCA_SUCCESS;
 }
 
-/** \brief HAL implementation of kit protocol send over USB HID
+/** \brief HAL implementation of kit protocol receive over USB HID
+ *
+ * Whole reports are read from the hidraw descriptor and only the bytes of each new report are
+ * searched for the end of the message. Whatever follows it in the report, apart from the zero
+ * padding, is kept in the kit's ring buffer and handed out first on the next receive.
+ *
  * \param[in]    iface   instance
  * \param[out]   rxdata  pointer to space to receive the data
- * \param[inout] rxsize  ptr to expected number of receive bytes to request
+ * \param[inout] rxsize  As input, the size of rxdata. As output, the number of bytes received.
  * \return ATCA_STATUS
  */
-ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize)
+ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
 {
     ATCAIfaceCfg *cfg = atgetifacecfg(iface);
     atcahid_t* pHid = (atcahid_t*)atgetifacehaldat(iface);
+    hid_device_t* kit = NULL;
+    uint8_t report[HID_PACKET_MAX];
+    uint8_t* eom = NULL;
     bool continue_read = true;
-    size_t bytes_read = 0;
-    size_t total_bytes_read = 0;
+    ssize_t bytes_read = 0;
+    int bytes_to_cpy = 0;
+    int total_bytes_read = 0;
+    uint8_t c;
 
     if ((rxdata == NULL) || (rxsize == NULL) || (cfg == NULL) || (pHid == NULL))
         return ATCA_BAD_PARAM;
 
-    if (pHid->kits[cfg->atcahid.idx].read_handle == NULL)
+    kit = &pHid->kits[cfg->atcahid.idx];
+    if (kit->read_handle == INVALID_HANDLE_VALUE)
         return ATCA_COMM_FAIL;
 
-    // Receive the data from the kit USB device
-    do
+    // Hand out the bytes left over from the last report first
+    while (continue_read && kit->ring_head != kit->ring_tail)
     {
-        bytes_read = fread(&rxdata[total_bytes_read], sizeof(uint8_t), 1,
-                           pHid->kits[cfg->atcahid.idx].read_handle);
-        if (ferror(pHid->kits[cfg->atcahid.idx].read_handle) != 0)
-        {
-            clearerr(pHid->kits[cfg->atcahid.idx].read_handle);
+        c = kit->ring[kit->ring_head++ & (HID_RING_SIZE - 1)];
+        if (total_bytes_read >= *rxsize)
             return ATCA_RX_FAIL;
-        }
+        rxdata[total_bytes_read++] = (char)c;
+        if (c == '\n')
+            continue_read = false;
+    }
 
-        total_bytes_read += bytes_read;
+    // Receive whole reports from the kit USB device
+    while (continue_read)
+    {
+        bytes_read = read(kit->read_handle, report, sizeof(report));
+        if (bytes_read < 0 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            return ATCA_RX_FAIL;
+
+        // Only the new report needs to be searched for the end of the message
+        eom = memchr(report, '\n', bytes_read);
+        bytes_to_cpy = (eom == NULL) ? (int)bytes_read : (int)(eom - report) + 1;
+        if (total_bytes_read + bytes_to_cpy > *rxsize)
+            return ATCA_RX_FAIL;
+        memcpy(&rxdata[total_bytes_read], report, bytes_to_cpy);
+        total_bytes_read += bytes_to_cpy;
 
-        // Check if the kit protocol message has been received
-        if (strstr((char*)rxdata, "\n") != NULL)
+        if (eom != NULL)
+        {
+            // Keep the rest of the report for the next message
+            for (; bytes_to_cpy < bytes_read; bytes_to_cpy++)
+            {
+                if (report[bytes_to_cpy] != 0)
+                    kit->ring[kit->ring_tail++ & (HID_RING_SIZE - 1)] = report[bytes_to_cpy];
+            }
             continue_read = false;
+        }
     }
-    while (continue_read == true);
 
     // Save the total bytes read
     *rxsize = total_bytes_read;
@@ -314,6 +348,21 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, uint8_t* rxdata, int* rxsize)
     return ATCA_SUCCESS;
 }
 
+/** \brief ASCII frame buffer of the kit behind this interface, KIT_FRAME_SIZE bytes
+ *  \param[in] iface  instance
+ *  \return pointer to the frame buffer, NULL if the interface has no kit
+ */
+char* kit_phy_frame(ATCAIface iface)
+{
+    ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+    atcahid_t* pHid = (atcahid_t*)atgetifacehaldat(iface);
+
+    if ((cfg == NULL) || (pHid == NULL))
+        return NULL;
+
+    return pHid->kits[cfg->atcahid.idx].frame;
+}
+
 /** \brief Number of USB HID devices found
  *  \param[out] num_found
  *  \return ATCA_STATUS
@@ -394,11 +443,11 @@ ATCA_STATUS hal_kit_hid_release(void* hal_data)
     // Close all kit USB devices
     for (i = 0; i < phaldat->num_kits_found; i++)
     {
-        if (_gHid.kits[i].read_handle != NULL)
+        if (_gHid.kits[i].read_handle != INVALID_HANDLE_VALUE)
         {
-            fclose(_gHid.kits[i].read_handle);
-            _gHid.kits[i].read_handle = NULL;
-            _gHid.kits[i].write_handle = NULL;
+            close(_gHid.kits[i].read_handle);
+            _gHid.kits[i].read_handle = INVALID_HANDLE_VALUE;
+            _gHid.kits[i].write_handle = INVALID_HANDLE_VALUE;
         }
     }
 
@@ -39,6 +39,8 @@
 #ifndef HAL_LINUX_KIT_HID_H_
 #define HAL_LINUX_KIT_HID_H_
 
+#include "kit_protocol.h"
+
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
  * \brief
@@ -49,12 +51,19 @@
 // Kit USB defines
 #define HID_DEVICES_MAX     10      //! Maximum number of supported Kit USB devices
 #define HID_PACKET_MAX      512     //! Maximum number of bytes for a HID send/receive packet (typically 64)
+#define HID_RING_SIZE       512     //! Bytes of a report kept past the end of a kit message, a power of two of at least HID_PACKET_MAX
+
+#define INVALID_HANDLE_VALUE ((int)(-1))
 
 // Each device that is found will have a read handle and a write handle
 typedef struct hid_device
 {
-    FILE *read_handle;         //! The kit USB read file handle
-    FILE *write_handle;        //! The kit USB write file handle
+    int      read_handle;           //! The kit USB hidraw read file descriptor
+    int      write_handle;          //! The kit USB hidraw write file descriptor
+    char     frame[KIT_FRAME_SIZE]; //! The kit protocol ASCII frame being sent or received
+    uint8_t  ring[HID_RING_SIZE];   //! Report bytes received after the end of the last kit message
+    uint16_t ring_head;             //! Free-running index of the next byte to hand out of ring
+    uint16_t ring_tail;             //! Free-running index of the next byte to store in ring
 } hid_device_t;
 
 
@@ -0,0 +1,1607 @@
+/**
+ * \file
+ * \brief ATCA Hardware abstraction layer for a software simulated ATECC508A / ATSHA204A.
+ *
+ * The simulator executes each command in memory as soon as it is sent, so the basic
+ * API and its tests run without a device attached and without waiting on the
+ * command execution times.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include "atca_hal.h"
+#include "hal_sim.h"
+#include "crypto/atca_crypto_sw_p256.h"
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#endif
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+// File scope globals
+static ATCASimDevice_t sim_devices[MAX_SIM_DEVICES];
+#ifdef ATCA_USE_PTHREADS
+static pthread_mutex_t sim_devices_lock = PTHREAD_MUTEX_INITIALIZER;   // one command at a time across all simulated devices
+#endif
+
+static void sim_acquire(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_lock(&sim_devices_lock);
+#endif
+}
+
+static void sim_release(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_mutex_unlock(&sim_devices_lock);
+#endif
+}
+
+/* ---- device configuration ---------------------------------------------------------------- */
+
+static bool sim_is_ecc(const ATCASimDevice_t *dev)
+{
+    return atIsECCFamily(dev->devtype);
+}
+
+static size_t sim_config_size(const ATCASimDevice_t *dev)
+{
+    return sim_is_ecc(dev) ? ATCA_ECC_CONFIG_SIZE : ATCA_SHA_CONFIG_SIZE;
+}
+
+static uint16_t sim_slot_config(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    return (uint16_t)dev->config[20 + slot * 2] | ((uint16_t)dev->config[21 + slot * 2] << 8);
+}
+
+static uint16_t sim_key_config(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    if (!sim_is_ecc(dev))
+        return 0;
+    return (uint16_t)dev->config[96 + slot * 2] | ((uint16_t)dev->config[97 + slot * 2] << 8);
+}
+
+static bool sim_config_locked(const ATCASimDevice_t *dev)
+{
+    return dev->config[87] != 0x55;
+}
+
+static bool sim_data_locked(const ATCASimDevice_t *dev)
+{
+    return dev->config[86] != 0x55;
+}
+
+static bool sim_slot_locked(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    uint16_t slot_locked = (uint16_t)dev->config[88] | ((uint16_t)dev->config[89] << 8);
+
+    return sim_is_ecc(dev) && sim_data_locked(dev) && !(slot_locked & (1 << slot));
+}
+
+static size_t sim_slot_size(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    if (!sim_is_ecc(dev))
+        return ATCA_BLOCK_SIZE;
+    if (slot < 8)
+        return 36;
+    return slot == 8 ? SIM_SLOT_SIZE_MAX : 72;
+}
+
+// SlotConfig fields
+#define SIM_READ_KEY(sc)        ((sc) & 0x0F)
+#define SIM_NO_MAC(sc)          (((sc) & 0x0010) != 0)
+#define SIM_ENCRYPT_READ(sc)    (((sc) & 0x0040) != 0)
+#define SIM_IS_SECRET(sc)       (((sc) & 0x0080) != 0)
+#define SIM_WRITE_KEY(sc)       (((sc) >> 8) & 0x0F)
+#define SIM_WRITE_CONFIG(sc)    (((sc) >> 12) & 0x0F)
+
+// KeyConfig fields
+#define SIM_PRIVATE(kc)         (((kc) & 0x0001) != 0)
+#define SIM_PUB_INFO(kc)        (((kc) & 0x0002) != 0)
+#define SIM_KEY_TYPE(kc)        (((kc) >> 2) & 0x07)
+#define SIM_LOCKABLE(kc)        (((kc) & 0x0020) != 0)
+#define SIM_KEY_TYPE_P256       4
+
+static bool sim_is_private(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    return sim_is_ecc(dev) && SIM_PRIVATE(sim_key_config(dev, slot));
+}
+
+static bool sim_is_p256(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    return sim_is_ecc(dev) && SIM_KEY_TYPE(sim_key_config(dev, slot)) == SIM_KEY_TYPE_P256;
+}
+
+/** \brief device serial number SN[0:8] as laid out in the config zone */
+static void sim_get_sn(const ATCASimDevice_t *dev, uint8_t sn[9])
+{
+    memcpy(&sn[0], &dev->config[0], 4);
+    memcpy(&sn[4], &dev->config[8], 5);
+}
+
+/** \brief public key of a slot in the 72 byte padded format, as X then Y */
+static void sim_get_stored_pubkey(const ATCASimDevice_t *dev, uint16_t slot, uint8_t public_key[64])
+{
+    memcpy(&public_key[0], &dev->data[slot][4], 32);
+    memcpy(&public_key[32], &dev->data[slot][40], 32);
+}
+
+/** \brief validity of a public key in a slot with PubInfo set, kept in the upper nibble of its first byte */
+static uint8_t sim_pubkey_validity(const ATCASimDevice_t *dev, uint16_t slot)
+{
+    return dev->data[slot][0] >> 4;
+}
+
+static void sim_set_pubkey_validity(ATCASimDevice_t *dev, uint16_t slot, uint8_t validity)
+{
+    dev->data[slot][0] = (uint8_t)((dev->data[slot][0] & 0x0F) | (validity << 4));
+}
+
+/* ---- random numbers ---------------------------------------------------------------------- */
+
+/** \brief deterministic RNG, SHA-256 over the device seed and a counter. Repeatable runs
+ *         make failures reproducible, nothing here is meant to be secret.
+ */
+static void sim_random(ATCASimDevice_t *dev, uint8_t random[32])
+{
+    uint8_t msg[36];
+
+    memcpy(msg, dev->rng_seed, 32);
+    msg[32] = (uint8_t)(dev->rng_count >> 0);
+    msg[33] = (uint8_t)(dev->rng_count >> 8);
+    msg[34] = (uint8_t)(dev->rng_count >> 16);
+    msg[35] = (uint8_t)(dev->rng_count >> 24);
+    dev->rng_count++;
+    sw_sha256(msg, sizeof(msg), random);
+}
+
+/** \brief random number as the Random command returns it, a fixed pattern until the config zone is locked */
+static void sim_random_out(ATCASimDevice_t *dev, uint8_t random[32])
+{
+    int i;
+
+    if (sim_config_locked(dev))
+    {
+        sim_random(dev, random);
+        return;
+    }
+    for (i = 0; i < 32; i += 4)
+    {
+        random[i + 0] = 0xFF;
+        random[i + 1] = 0xFF;
+        random[i + 2] = 0x00;
+        random[i + 3] = 0x00;
+    }
+}
+
+/* ---- factory state ----------------------------------------------------------------------- */
+
+/** \brief put a device in the state it ships in: zones unlocked and empty */
+static void sim_factory(ATCASimDevice_t *dev, int device_id, ATCADeviceType devtype, const uint8_t revision[4])
+{
+    static const uint8_t rev_ecc508a[4] = { 0x00, 0x00, 0x50, 0x00 };
+    static const uint8_t rev_sha204a[4] = { 0x00, 0x02, 0x00, 0x09 };
+    uint8_t seed_msg[8];
+    bool is_ecc = atIsECCFamily(devtype);
+
+    memset(dev, 0, sizeof(*dev));
+    dev->in_use = true;
+    dev->devtype = devtype;
+
+    if (revision != NULL && (revision[0] | revision[1] | revision[2] | revision[3]) != 0)
+        memcpy(dev->revision, revision, 4);
+    else
+        memcpy(dev->revision, is_ecc ? rev_ecc508a : rev_sha204a, 4);
+
+    // SN[0:1] is always 01 23 and SN[8] is always EE, the rest tells the instances apart
+    dev->config[0] = 0x01;
+    dev->config[1] = 0x23;
+    dev->config[2] = (uint8_t)device_id;
+    dev->config[3] = 0x5A;
+    memcpy(&dev->config[4], dev->revision, 4);
+    dev->config[8] = 0x01;
+    dev->config[9] = 0x02;
+    dev->config[10] = 0x03;
+    dev->config[11] = (uint8_t)device_id;
+    dev->config[12] = 0xEE;
+    if (is_ecc)
+        dev->config[14] = 0x01;     // I2C_Enable
+    else
+        dev->config[13] = 0x55;
+    dev->config[16] = is_ecc ? 0xC0 : 0xC8;
+    dev->config[86] = 0x55;         // LockValue, data and OTP unlocked
+    dev->config[87] = 0x55;         // LockConfig, config unlocked
+    if (is_ecc)
+    {
+        dev->config[88] = 0xFF;     // SlotLocked, no slot locked
+        dev->config[89] = 0xFF;
+    }
+
+    seed_msg[0] = 's';
+    seed_msg[1] = 'i';
+    seed_msg[2] = 'm';
+    seed_msg[3] = (uint8_t)device_id;
+    seed_msg[4] = (uint8_t)devtype;
+    seed_msg[5] = 0;
+    seed_msg[6] = 0;
+    seed_msg[7] = 0;
+    sw_sha256(seed_msg, sizeof(seed_msg), dev->rng_seed);
+}
+
+/* ---- responses --------------------------------------------------------------------------- */
+
+static void sim_response_data(ATCASimDevice_t *dev, const uint8_t *data, size_t data_size)
+{
+    dev->response[0] = (uint8_t)(data_size + ATCA_PACKET_OVERHEAD);
+    memcpy(&dev->response[1], data, data_size);
+    atCRC(data_size + 1, dev->response, &dev->response[data_size + 1]);
+    dev->response_size = dev->response[0];
+}
+
+static void sim_response_status(ATCASimDevice_t *dev, uint8_t status)
+{
+    sim_response_data(dev, &status, 1);
+}
+
+/* ---- commands ---------------------------------------------------------------------------- *
+ * Each command handler gets the command parameters and data, returns the status byte of
+ * the device and, when the command outputs data, leaves its response with sim_response_data().
+ */
+
+/** \brief split a data zone address into slot and byte offset, see atcab_get_addr() */
+static uint8_t sim_data_addr(const ATCASimDevice_t *dev, uint16_t addr, size_t len, uint16_t *slot, size_t *pos)
+{
+    if (addr & 0xF080)
+        return SIM_STATUS_PARSE;
+
+    *slot = (addr >> 3) & 0x0F;
+    *pos = ((addr >> 8) & 0x0F) * ATCA_BLOCK_SIZE;
+    if (len == ATCA_WORD_SIZE)
+        *pos += (addr & 0x07) * ATCA_WORD_SIZE;
+    if (*pos >= sim_slot_size(dev, *slot))
+        return SIM_STATUS_PARSE;
+
+    return SIM_STATUS_SUCCESS;
+}
+
+/** \brief byte offset of a config or OTP zone address */
+static uint8_t sim_zone_addr(size_t zone_size, uint16_t addr, size_t len, size_t *pos)
+{
+    if (addr & 0xFFE0)
+        return SIM_STATUS_PARSE;
+
+    *pos = ((addr >> 3) & 0x03) * ATCA_BLOCK_SIZE;
+    if (len == ATCA_WORD_SIZE)
+        *pos += (addr & 0x07) * ATCA_WORD_SIZE;
+    if (*pos >= zone_size)
+        return SIM_STATUS_PARSE;
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_read(ATCASimDevice_t *dev, uint8_t zone, uint16_t addr, const uint8_t *data, size_t data_size)
+{
+    uint8_t out[ATCA_BLOCK_SIZE];
+    size_t len = (zone & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+    size_t pos = 0;
+    size_t avail;
+    uint16_t slot = 0;
+    uint16_t sc;
+    uint8_t status;
+    int i;
+
+    (void)data;
+    if (data_size != 0 || (zone & ~(ATCA_ZONE_READWRITE_32 | ATCA_ZONE_MASK)))
+        return SIM_STATUS_PARSE;
+
+    memset(out, 0, sizeof(out));
+    switch (zone & ATCA_ZONE_MASK)
+    {
+    case ATCA_ZONE_CONFIG:
+        if ( (status = sim_zone_addr(sim_config_size(dev), addr, len, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        avail = sim_config_size(dev) - pos;
+        memcpy(out, &dev->config[pos], avail < len ? avail : len);
+        break;
+
+    case ATCA_ZONE_OTP:
+        if (!sim_data_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if ( (status = sim_zone_addr(SIM_OTP_SIZE, addr, len, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        memcpy(out, &dev->otp[pos], len);
+        break;
+
+    case ATCA_ZONE_DATA:
+        if (!sim_data_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if ( (status = sim_data_addr(dev, addr, len, &slot, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        if (sim_is_private(dev, slot))
+            return SIM_STATUS_EXECUTION;
+        avail = sim_slot_size(dev, slot) - pos;
+        memcpy(out, &dev->data[slot][pos], avail < len ? avail : len);
+
+        sc = sim_slot_config(dev, slot);
+        if (SIM_IS_SECRET(sc))
+        {
+            // secrets only ever leave the device encrypted with a GenDig over their ReadKey
+            if (!SIM_ENCRYPT_READ(sc) || len != ATCA_BLOCK_SIZE)
+                return SIM_STATUS_EXECUTION;
+            if (!dev->temp_key.valid || !dev->temp_key.gen_dig_data || dev->temp_key.key_id != SIM_READ_KEY(sc))
+                return SIM_STATUS_EXECUTION;
+            for (i = 0; i < ATCA_BLOCK_SIZE; i++)
+                out[i] ^= dev->temp_key.value[i];
+        }
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    sim_response_data(dev, out, len);
+    return SIM_STATUS_SUCCESS;
+}
+
+/** \brief decrypt and authenticate an encrypted Write, see atcab_write_enc() */
+static uint8_t sim_write_decrypt(ATCASimDevice_t *dev, uint8_t zone, uint16_t addr, uint16_t write_key,
+                                 const uint8_t *cipher, const uint8_t *mac, uint8_t *plain)
+{
+    struct atca_write_mac_in_out write_mac;
+    uint8_t sn[9];
+    uint8_t encrypted[ATCA_BLOCK_SIZE];
+    uint8_t expected_mac[32];
+    int i;
+
+    if (mac == NULL || !dev->temp_key.valid || !dev->temp_key.gen_dig_data || dev->temp_key.key_id != write_key)
+        return SIM_STATUS_EXECUTION;
+
+    for (i = 0; i < ATCA_BLOCK_SIZE; i++)
+        plain[i] = cipher[i] ^ dev->temp_key.value[i];
+
+    sim_get_sn(dev, sn);
+    memset(&write_mac, 0, sizeof(write_mac));
+    write_mac.zone = zone;
+    write_mac.key_id = addr;
+    write_mac.sn = sn;
+    write_mac.input_data = plain;
+    write_mac.encrypted_data = encrypted;
+    write_mac.auth_mac = expected_mac;
+    write_mac.temp_key = &dev->temp_key;
+    if (atcah_write_auth_mac(&write_mac) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+
+    dev->temp_key.valid = 0;
+    if (memcmp(expected_mac, mac, sizeof(expected_mac)) != 0)
+        return SIM_STATUS_MISCOMPARE;
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_write(ATCASimDevice_t *dev, uint8_t zone, uint16_t addr, const uint8_t *data, size_t data_size)
+{
+    size_t len = (zone & ATCA_ZONE_READWRITE_32) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+    const uint8_t *mac = NULL;
+    uint8_t plain[ATCA_BLOCK_SIZE];
+    size_t pos = 0;
+    size_t avail;
+    size_t i;
+    uint16_t slot = 0;
+    uint16_t sc;
+    uint16_t kc;
+    uint8_t wc;
+    uint8_t status;
+
+    if (zone & ~(ATCA_ZONE_READWRITE_32 | ATCA_ZONE_ENCRYPTED | ATCA_ZONE_MASK))
+        return SIM_STATUS_PARSE;
+    if (data_size == len + 32)
+        mac = &data[len];
+    else if (data_size != len)
+        return SIM_STATUS_PARSE;
+
+    switch (zone & ATCA_ZONE_MASK)
+    {
+    case ATCA_ZONE_CONFIG:
+        if (sim_config_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if ( (status = sim_zone_addr(sim_config_size(dev), addr, len, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        // the serial number, revision, UserExtra, Selector and lock bytes are not written
+        for (i = 0; i < len && pos + i < sim_config_size(dev); i++)
+            if (pos + i >= 16 && (pos + i < 84 || pos + i >= 88))
+                dev->config[pos + i] = data[i];
+        break;
+
+    case ATCA_ZONE_OTP:
+        if (!sim_config_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if ( (status = sim_zone_addr(SIM_OTP_SIZE, addr, len, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        if (!sim_data_locked(dev))
+        {
+            if (len != ATCA_BLOCK_SIZE)
+                return SIM_STATUS_EXECUTION;
+            memcpy(&dev->otp[pos], data, len);
+        }
+        else
+        {
+            // consumption mode only ever clears bits, read-only mode doesn't write at all
+            if (dev->config[18] != 0x55)
+                return SIM_STATUS_EXECUTION;
+            for (i = 0; i < len; i++)
+                dev->otp[pos + i] &= data[i];
+        }
+        break;
+
+    case ATCA_ZONE_DATA:
+        if (!sim_config_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if ( (status = sim_data_addr(dev, addr, len, &slot, &pos)) != SIM_STATUS_SUCCESS)
+            return status;
+        sc = sim_slot_config(dev, slot);
+        kc = sim_key_config(dev, slot);
+        wc = SIM_WRITE_CONFIG(sc);
+        if (sim_is_private(dev, slot) || sim_slot_locked(dev, slot))
+            return SIM_STATUS_EXECUTION;
+
+        memcpy(plain, data, len);
+        if (!sim_data_locked(dev))
+        {
+            if (len != ATCA_BLOCK_SIZE || (zone & ATCA_ZONE_ENCRYPTED))
+                return SIM_STATUS_EXECUTION;
+        }
+        else if (wc & 0x04)
+        {
+            if (len != ATCA_BLOCK_SIZE)
+                return SIM_STATUS_EXECUTION;
+            if ( (status = sim_write_decrypt(dev, zone, addr, SIM_WRITE_KEY(sc), data, mac, plain)) != SIM_STATUS_SUCCESS)
+                return status;
+        }
+        else if (wc == 0x01 && sim_is_ecc(dev))
+        {
+            // PubInvalid: a validated public key can only be replaced once it has been invalidated
+            if (SIM_PUB_INFO(kc) && sim_pubkey_validity(dev, slot) == 0x5)
+                return SIM_STATUS_EXECUTION;
+        }
+        else if (wc != 0x00)
+            return SIM_STATUS_EXECUTION;
+
+        // a 32 byte write to the last, short block of a slot only writes what fits
+        avail = sim_slot_size(dev, slot) - pos;
+        memcpy(&dev->data[slot][pos], plain, avail < len ? avail : len);
+
+        // writing a validated public key slot invalidates it
+        if (sim_is_ecc(dev) && SIM_PUB_INFO(kc) && sim_data_locked(dev) && pos == 0)
+            sim_set_pubkey_validity(dev, slot, 0xA);
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_lock(ATCASimDevice_t *dev, uint8_t mode, uint16_t summary, const uint8_t *data, size_t data_size)
+{
+    uint8_t crc[2] = { 0, 0 };
+    uint16_t slot;
+    uint16_t slot_locked;
+    uint16_t i;
+    bool check_crc = !(mode & LOCK_ZONE_NO_CRC);
+
+    (void)data;
+    if (data_size != 0)
+        return SIM_STATUS_PARSE;
+
+    switch (mode & 0x03)
+    {
+    case LOCK_ZONE_CONFIG:
+        if (sim_config_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if (check_crc)
+            atCRC(sim_config_size(dev), dev->config, crc);
+        if (check_crc && summary != ((uint16_t)crc[0] | ((uint16_t)crc[1] << 8)))
+            return SIM_STATUS_EXECUTION;
+        dev->config[87] = 0x00;
+        break;
+
+    case LOCK_ZONE_DATA:
+        if (!sim_config_locked(dev) || sim_data_locked(dev))
+            return SIM_STATUS_EXECUTION;
+        if (check_crc)
+        {
+            // the summary covers the slots in order then the OTP zone, one CRC run across all of it
+            uint8_t zones[SIM_SLOT_COUNT * SIM_SLOT_SIZE_MAX + SIM_OTP_SIZE];
+            size_t zones_size = 0;
+
+            for (i = 0; i < SIM_SLOT_COUNT; i++)
+            {
+                memcpy(&zones[zones_size], dev->data[i], sim_slot_size(dev, i));
+                zones_size += sim_slot_size(dev, i);
+            }
+            memcpy(&zones[zones_size], dev->otp, SIM_OTP_SIZE);
+            zones_size += SIM_OTP_SIZE;
+            atCRC(zones_size, zones, crc);
+            if (summary != ((uint16_t)crc[0] | ((uint16_t)crc[1] << 8)))
+                return SIM_STATUS_EXECUTION;
+        }
+        dev->config[86] = 0x00;
+        break;
+
+    case LOCK_ZONE_DATA_SLOT:
+        // atcab_lock_data_slot() sends no summary, a zero summary isn't checked
+        slot = (mode >> 2) & 0x0F;
+        if (!sim_is_ecc(dev))
+            return SIM_STATUS_PARSE;
+        if (!sim_data_locked(dev) || !SIM_LOCKABLE(sim_key_config(dev, slot)) || sim_slot_locked(dev, slot))
+            return SIM_STATUS_EXECUTION;
+        if (check_crc && summary != 0)
+        {
+            atCRC(sim_slot_size(dev, slot), dev->data[slot], crc);
+            if (summary != ((uint16_t)crc[0] | ((uint16_t)crc[1] << 8)))
+                return SIM_STATUS_EXECUTION;
+        }
+        slot_locked = (uint16_t)dev->config[88] | ((uint16_t)dev->config[89] << 8);
+        slot_locked &= ~(1 << slot);
+        dev->config[88] = (uint8_t)(slot_locked >> 0);
+        dev->config[89] = (uint8_t)(slot_locked >> 8);
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_update_extra(ATCASimDevice_t *dev, uint8_t mode, uint16_t value, const uint8_t *data, size_t data_size)
+{
+    uint8_t *extra;
+
+    (void)data;
+    if (data_size != 0 || mode > UPDATE_MODE_SELECTOR)
+        return SIM_STATUS_PARSE;
+
+    // UserExtra and Selector can only be set once
+    extra = &dev->config[mode == UPDATE_MODE_USER_EXTRA ? 84 : 85];
+    if (*extra != 0x00)
+        return SIM_STATUS_EXECUTION;
+    *extra = (uint8_t)value;
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_info(ATCASimDevice_t *dev, uint8_t mode, uint16_t param2, const uint8_t *data, size_t data_size)
+{
+    uint8_t out[4] = { 0, 0, 0, 0 };
+
+    (void)data;
+    if (data_size != 0 || mode > INFO_MODE_MAX)
+        return SIM_STATUS_PARSE;
+
+    switch (mode)
+    {
+    case INFO_MODE_REVISION:
+        memcpy(out, dev->revision, sizeof(out));
+        break;
+
+    case INFO_MODE_KEY_VALID:
+        if (param2 >= SIM_SLOT_COUNT || !sim_is_ecc(dev))
+            return SIM_STATUS_PARSE;
+        if (SIM_PUB_INFO(sim_key_config(dev, param2)))
+            out[0] = sim_pubkey_validity(dev, param2) == 0x5 ? 1 : 0;
+        break;
+
+    case INFO_MODE_STATE:
+        // TempKey flags as in the Sign(Internal) message
+        out[0] = (uint8_t)(dev->temp_key.key_id & 0x0F);
+        out[0] |= (uint8_t)(dev->temp_key.source_flag << 4);
+        out[0] |= (uint8_t)(dev->temp_key.gen_dig_data << 5);
+        out[0] |= (uint8_t)(dev->temp_key.gen_key_data << 6);
+        out[0] |= (uint8_t)(dev->temp_key.no_mac_flag << 7);
+        out[1] = (uint8_t)dev->temp_key.valid;
+        break;
+
+    default:
+        break;
+    }
+
+    sim_response_data(dev, out, sizeof(out));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_random_cmd(ATCASimDevice_t *dev, uint8_t mode, uint16_t param2, const uint8_t *data, size_t data_size)
+{
+    uint8_t out[32];
+
+    (void)mode;
+    (void)param2;
+    (void)data;
+    if (data_size != 0)
+        return SIM_STATUS_PARSE;
+
+    sim_random_out(dev, out);
+    sim_response_data(dev, out, sizeof(out));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_nonce(ATCASimDevice_t *dev, uint8_t mode, uint16_t param2, const uint8_t *data, size_t data_size)
+{
+    atca_nonce_in_out_t nonce;
+    uint8_t rand_out[32];
+
+    (void)param2;
+    memset(&nonce, 0, sizeof(nonce));
+    nonce.mode = mode;
+    nonce.num_in = data;
+    nonce.temp_key = &dev->temp_key;
+
+    switch (mode)
+    {
+    case NONCE_MODE_SEED_UPDATE:
+    case NONCE_MODE_NO_SEED_UPDATE:
+        if (data_size != NONCE_NUMIN_SIZE)
+            return SIM_STATUS_PARSE;
+        sim_random_out(dev, rand_out);
+        nonce.rand_out = rand_out;
+        break;
+
+    case NONCE_MODE_PASSTHROUGH:
+        if (data_size != NONCE_NUMIN_SIZE_PASSTHROUGH)
+            return SIM_STATUS_PARSE;
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    if (atcah_nonce(&nonce) != ATCA_SUCCESS)
+        return SIM_STATUS_PARSE;
+    dev->temp_key.gen_key_data = 0;
+
+    if (mode != NONCE_MODE_PASSTHROUGH)
+        sim_response_data(dev, rand_out, sizeof(rand_out));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_gendig(ATCASimDevice_t *dev, uint8_t zone, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    atca_gen_dig_in_out_t gen_dig;
+    uint8_t sn[9];
+    uint16_t sc = 0;
+
+    if (!dev->temp_key.valid)
+        return SIM_STATUS_EXECUTION;
+
+    sim_get_sn(dev, sn);
+    memset(&gen_dig, 0, sizeof(gen_dig));
+    gen_dig.zone = zone;
+    gen_dig.key_id = key_id;
+    gen_dig.sn = sn;
+    gen_dig.temp_key = &dev->temp_key;
+
+    switch (zone)
+    {
+    case GENDIG_ZONE_CONFIG:
+        if (data_size != 0 || key_id > 3 || key_id * ATCA_BLOCK_SIZE >= sim_config_size(dev))
+            return SIM_STATUS_PARSE;
+        gen_dig.stored_value = &dev->config[key_id * ATCA_BLOCK_SIZE];
+        break;
+
+    case GENDIG_ZONE_OTP:
+        if (data_size != 0 || key_id > 1)
+            return SIM_STATUS_PARSE;
+        gen_dig.stored_value = &dev->otp[key_id * ATCA_BLOCK_SIZE];
+        break;
+
+    case GENDIG_ZONE_DATA:
+        // the host may send OtherData for any key, it's only part of the digest for NoMac keys
+        if (key_id >= SIM_SLOT_COUNT || (data_size != 0 && data_size != 4))
+            return SIM_STATUS_PARSE;
+        if (!sim_data_locked(dev) || sim_is_private(dev, key_id))
+            return SIM_STATUS_EXECUTION;
+        sc = sim_slot_config(dev, key_id);
+        gen_dig.is_key_nomac = sim_is_ecc(dev) && SIM_NO_MAC(sc);
+        if (gen_dig.is_key_nomac && data_size != 4)
+            return SIM_STATUS_PARSE;
+        gen_dig.other_data = data_size ? data : NULL;
+        gen_dig.stored_value = dev->data[key_id];
+        break;
+
+    case GENDIG_ZONE_SHARED_NONCE:
+        if (!sim_is_ecc(dev) || data_size != 32)
+            return SIM_STATUS_PARSE;
+        gen_dig.other_data = data;
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    if (atcah_gen_dig(&gen_dig) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+    dev->temp_key.gen_key_data = 0;
+    dev->temp_key.no_mac_flag = SIM_NO_MAC(sc) ? 1 : 0;
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_mac(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    atca_mac_in_out_t mac;
+    uint8_t sn[9];
+    uint8_t response[32];
+
+    if (key_id >= SIM_SLOT_COUNT || (mode & ~MAC_MODE_MASK))
+        return SIM_STATUS_PARSE;
+    if (data_size != ((mode & MAC_MODE_BLOCK2_TEMPKEY) ? 0 : 32))
+        return SIM_STATUS_PARSE;
+    // the slot only matters when its key goes into the first block
+    if (!(mode & MAC_MODE_BLOCK1_TEMPKEY) && (sim_is_private(dev, key_id) || SIM_NO_MAC(sim_slot_config(dev, key_id))))
+        return SIM_STATUS_EXECUTION;
+
+    sim_get_sn(dev, sn);
+    memset(&mac, 0, sizeof(mac));
+    mac.mode = mode;
+    mac.key_id = key_id;
+    mac.challenge = data_size ? data : NULL;
+    mac.key = dev->data[key_id];
+    mac.otp = dev->otp;
+    mac.sn = sn;
+    mac.response = response;
+    mac.temp_key = (mode & MAC_MODE_USE_TEMPKEY_MASK) ? &dev->temp_key : NULL;
+    if (atcah_mac(&mac) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+
+    sim_response_data(dev, response, sizeof(response));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_checkmac(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    atca_check_mac_in_out_t check_mac;
+    uint8_t sn[9];
+    uint8_t client_resp[32];
+    bool uses_temp_key = (mode & (CHECKMAC_MODE_BLOCK1_TEMPKEY | CHECKMAC_MODE_BLOCK2_TEMPKEY)) != 0;
+
+    if (key_id >= SIM_SLOT_COUNT || (mode & ~CHECKMAC_MODE_MASK) || data_size != CHECKMAC_CLIENT_CHALLENGE_SIZE + CHECKMAC_CLIENT_RESPONSE_SIZE + CHECKMAC_OTHER_DATA_SIZE)
+        return SIM_STATUS_PARSE;
+    if (sim_is_private(dev, key_id))
+        return SIM_STATUS_EXECUTION;
+
+    sim_get_sn(dev, sn);
+    memset(&check_mac, 0, sizeof(check_mac));
+    check_mac.mode = mode;
+    check_mac.key_id = key_id;
+    check_mac.sn = sn;
+    check_mac.client_chal = &data[0];
+    check_mac.client_resp = client_resp;
+    check_mac.other_data = &data[64];
+    check_mac.otp = dev->otp;
+    check_mac.slot_key = dev->data[key_id];
+    check_mac.temp_key = &dev->temp_key;
+    if (atcah_check_mac(&check_mac) != ATCA_SUCCESS)
+    {
+        dev->temp_key.valid = 0;
+        return SIM_STATUS_EXECUTION;
+    }
+    if (uses_temp_key)
+        dev->temp_key.valid = 0;
+
+    if (memcmp(client_resp, &data[32], sizeof(client_resp)) != 0)
+        return SIM_STATUS_MISCOMPARE;
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_hmac(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    struct atca_hmac_in_out hmac;
+    uint8_t sn[9];
+    uint8_t response[32];
+
+    (void)data;
+    if (key_id >= SIM_SLOT_COUNT || data_size != 0 || (mode & ~HMAC_MODE_MASK))
+        return SIM_STATUS_PARSE;
+    if (sim_is_ecc(dev) && (mode & (HMAC_MODE_FLAG_OTP88 | HMAC_MODE_FLAG_OTP64)))
+        return SIM_STATUS_PARSE;   // the ECC devices don't include OTP in HMAC
+    if (sim_is_private(dev, key_id) || SIM_NO_MAC(sim_slot_config(dev, key_id)))
+        return SIM_STATUS_EXECUTION;
+
+    sim_get_sn(dev, sn);
+    memset(&hmac, 0, sizeof(hmac));
+    hmac.mode = mode;
+    hmac.key_id = key_id;
+    hmac.key = dev->data[key_id];
+    hmac.otp = dev->otp;
+    hmac.sn = sn;
+    hmac.response = response;
+    hmac.temp_key = &dev->temp_key;
+    if (atcah_hmac(&hmac) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+
+    sim_response_data(dev, response, sizeof(response));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_derivekey(ATCASimDevice_t *dev, uint8_t mode, uint16_t target, const uint8_t *data, size_t data_size)
+{
+    struct atca_derive_key_in_out derive_key;
+    struct atca_derive_key_mac_in_out derive_key_mac;
+    uint8_t sn[9];
+    uint8_t mac[32];
+    uint8_t target_key[32];
+    uint16_t sc;
+    uint16_t parent;
+    uint8_t wc;
+
+    if (target >= SIM_SLOT_COUNT || (mode & ~DERIVE_KEY_RANDOM_FLAG) || (data_size != 0 && data_size != DERIVE_KEY_MAC_SIZE))
+        return SIM_STATUS_PARSE;
+
+    sc = sim_slot_config(dev, target);
+    wc = SIM_WRITE_CONFIG(sc);
+    // WriteConfig: bit 1 enables DeriveKey, bit 0 creates from WriteKey instead of rolling, bit 3 requires a MAC
+    if (!sim_data_locked(dev) || !(wc & 0x02) || sim_is_private(dev, target) || sim_slot_locked(dev, target))
+        return SIM_STATUS_EXECUTION;
+    parent = (wc & 0x01) ? SIM_WRITE_KEY(sc) : target;
+
+    sim_get_sn(dev, sn);
+    if (wc & 0x08)
+    {
+        if (data_size != DERIVE_KEY_MAC_SIZE)
+            return SIM_STATUS_EXECUTION;
+        memset(&derive_key_mac, 0, sizeof(derive_key_mac));
+        derive_key_mac.mode = mode;
+        derive_key_mac.target_key_id = target;
+        derive_key_mac.sn = sn;
+        derive_key_mac.parent_key = dev->data[parent];
+        derive_key_mac.mac = mac;
+        if (atcah_derive_key_mac(&derive_key_mac) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        if (memcmp(mac, data, sizeof(mac)) != 0)
+            return SIM_STATUS_MISCOMPARE;
+    }
+
+    memset(&derive_key, 0, sizeof(derive_key));
+    derive_key.mode = mode;
+    derive_key.target_key_id = target;
+    derive_key.sn = sn;
+    derive_key.parent_key = dev->data[parent];
+    derive_key.target_key = target_key;
+    derive_key.temp_key = &dev->temp_key;
+    if (atcah_derive_key(&derive_key) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+    memcpy(dev->data[target], target_key, sizeof(target_key));
+
+    return SIM_STATUS_SUCCESS;
+}
+
+/** \brief big-endian SHA-256 intermediate state, as the ATSHA204A returns it after an update */
+static void sim_sha_state(const sw_sha256_ctx *ctx, uint8_t state[32])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        state[i * 4 + 0] = (uint8_t)(ctx->hash[i] >> 24);
+        state[i * 4 + 1] = (uint8_t)(ctx->hash[i] >> 16);
+        state[i * 4 + 2] = (uint8_t)(ctx->hash[i] >> 8);
+        state[i * 4 + 3] = (uint8_t)(ctx->hash[i] >> 0);
+    }
+}
+
+static uint8_t sim_sha(ATCASimDevice_t *dev, uint8_t mode, uint16_t length, const uint8_t *data, size_t data_size)
+{
+    uint8_t block[64];
+    uint8_t digest[32];
+    int i;
+
+    switch (mode)
+    {
+    case SHA_MODE_SHA256_START:
+    case SHA_MODE_HMAC_START:
+        if (data_size != 0)
+            return SIM_STATUS_PARSE;
+        sw_sha256_init(&dev->sha);
+        dev->sha_started = true;
+        dev->sha_hmac = false;
+        if (mode == SHA_MODE_HMAC_START)
+        {
+            if (!sim_is_ecc(dev) || length >= SIM_SLOT_COUNT)
+                return SIM_STATUS_PARSE;
+            if (sim_is_private(dev, length))
+                return SIM_STATUS_EXECUTION;
+            memcpy(dev->sha_hmac_key, dev->data[length], 32);
+            dev->sha_hmac = true;
+            for (i = 0; i < 64; i++)
+                block[i] = (i < 32 ? dev->sha_hmac_key[i] : 0) ^ 0x36;
+            sw_sha256_update(&dev->sha, block, sizeof(block));
+        }
+        break;
+
+    case SHA_MODE_SHA256_UPDATE:
+        if (data_size != 64 || length != 64)
+            return SIM_STATUS_PARSE;
+        if (!dev->sha_started)
+            return SIM_STATUS_EXECUTION;
+        sw_sha256_update(&dev->sha, data, 64);
+        if (!sim_is_ecc(dev))
+        {
+            sim_sha_state(&dev->sha, digest);
+            sim_response_data(dev, digest, sizeof(digest));
+        }
+        break;
+
+    case SHA_MODE_SHA256_PUBLIC:
+        if (!sim_is_ecc(dev) || data_size != 0 || length >= SIM_SLOT_COUNT || length < 8)
+            return SIM_STATUS_PARSE;
+        if (!dev->sha_started)
+            return SIM_STATUS_EXECUTION;
+        sim_get_stored_pubkey(dev, length, block);
+        sw_sha256_update(&dev->sha, block, 64);
+        break;
+
+    case SHA_MODE_SHA256_END:
+    case SHA_MODE_HMAC_END:
+        if (data_size != length || length >= 64)
+            return SIM_STATUS_PARSE;
+        if (!dev->sha_started || dev->sha_hmac != (mode == SHA_MODE_HMAC_END))
+            return SIM_STATUS_EXECUTION;
+        sw_sha256_update(&dev->sha, data, (uint32_t)data_size);
+        sw_sha256_final(&dev->sha, digest);
+        if (dev->sha_hmac)
+        {
+            sw_sha256_init(&dev->sha);
+            for (i = 0; i < 64; i++)
+                block[i] = (i < 32 ? dev->sha_hmac_key[i] : 0) ^ 0x5C;
+            sw_sha256_update(&dev->sha, block, sizeof(block));
+            sw_sha256_update(&dev->sha, digest, sizeof(digest));
+            sw_sha256_final(&dev->sha, digest);
+        }
+        dev->sha_started = false;
+        dev->sha_hmac = false;
+        sim_response_data(dev, digest, sizeof(digest));
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_counter(ATCASimDevice_t *dev, uint8_t mode, uint16_t counter_id, const uint8_t *data, size_t data_size)
+{
+    uint8_t out[4];
+    uint32_t value;
+
+    (void)data;
+    if (!sim_is_ecc(dev) || data_size != 0 || (mode & ~COUNTER_MODE_MASK) || counter_id > 1)
+        return SIM_STATUS_PARSE;
+
+    if (mode == 1)
+    {
+        if (dev->counter[counter_id] >= 2097151)
+            return SIM_STATUS_EXECUTION;
+        dev->counter[counter_id]++;
+    }
+    value = dev->counter[counter_id];
+    out[0] = (uint8_t)(value >> 0);
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+
+    sim_response_data(dev, out, sizeof(out));
+    return SIM_STATUS_SUCCESS;
+}
+
+/* ---- ECC commands ------------------------------------------------------------------------ */
+
+/** \brief new private key for a slot, stored with the 4 pad bytes PrivWrite uses */
+static void sim_new_private_key(ATCASimDevice_t *dev, uint16_t slot, uint8_t public_key[64])
+{
+    do
+    {
+        memset(dev->data[slot], 0, 4);
+        sim_random(dev, &dev->data[slot][4]);
+    }
+    while (atcac_sw_p256_get_pubkey(&dev->data[slot][4], public_key) != ATCA_SUCCESS);
+}
+
+static uint8_t sim_genkey(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    atca_gen_key_in_out_t gen_key;
+    uint8_t sn[9];
+    uint8_t public_key[64];
+
+    if (!sim_is_ecc(dev) || key_id >= SIM_SLOT_COUNT || (mode & ~GENKEY_MODE_MASK))
+        return SIM_STATUS_PARSE;
+    if (data_size != 0 && data_size != 3)
+        return SIM_STATUS_PARSE;
+    if (!sim_config_locked(dev) || !sim_is_p256(dev, key_id))
+        return SIM_STATUS_EXECUTION;
+
+    sim_get_sn(dev, sn);
+    memset(&gen_key, 0, sizeof(gen_key));
+    gen_key.mode = mode;
+    gen_key.key_id = key_id;
+    gen_key.public_key = public_key;
+    gen_key.public_key_size = sizeof(public_key);
+    gen_key.other_data = data_size ? data : NULL;
+    gen_key.sn = sn;
+    gen_key.temp_key = &dev->temp_key;
+
+    if (mode & GENKEY_MODE_PUBKEY_DIGEST)
+    {
+        // digest over the public key stored in the slot
+        if (data_size != 3 || sim_is_private(dev, key_id))
+            return SIM_STATUS_PARSE;
+        if (!dev->temp_key.valid)
+            return SIM_STATUS_EXECUTION;
+        sim_get_stored_pubkey(dev, key_id, public_key);
+        if (atcah_gen_key_msg(&gen_key) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        return SIM_STATUS_SUCCESS;
+    }
+
+    if (!sim_is_private(dev, key_id))
+        return SIM_STATUS_EXECUTION;
+
+    if (mode & GENKEY_MODE_PRIVATE)
+    {
+        if (sim_data_locked(dev) && (!(SIM_WRITE_CONFIG(sim_slot_config(dev, key_id)) & 0x02) || sim_slot_locked(dev, key_id)))
+            return SIM_STATUS_EXECUTION;
+        sim_new_private_key(dev, key_id, public_key);
+    }
+    else if (atcac_sw_p256_get_pubkey(&dev->data[key_id][4], public_key) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;   // no valid key in the slot yet
+
+    if (mode & GENKEY_MODE_DIGEST)
+    {
+        if (!dev->temp_key.valid)
+            return SIM_STATUS_EXECUTION;
+        if (atcah_gen_key_msg(&gen_key) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+    }
+
+    sim_response_data(dev, public_key, sizeof(public_key));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_privwrite(ATCASimDevice_t *dev, uint8_t zone, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    struct atca_write_mac_in_out write_mac;
+    uint8_t sn[9];
+    uint8_t plain[36];
+    uint8_t encrypted[36];
+    uint8_t session_key2[32];
+    uint8_t expected_mac[32];
+    uint16_t sc;
+    int i;
+
+    if (!sim_is_ecc(dev) || key_id >= SIM_SLOT_COUNT || (zone & ~PRIVWRITE_ZONE_MASK) || data_size != 36 + 32)
+        return SIM_STATUS_PARSE;
+    if (!sim_config_locked(dev) || !sim_is_private(dev, key_id) || !sim_is_p256(dev, key_id))
+        return SIM_STATUS_EXECUTION;
+
+    sc = sim_slot_config(dev, key_id);
+    if (!sim_data_locked(dev))
+    {
+        if (zone & PRIVWRITE_MODE_ENCRYPT)
+            return SIM_STATUS_EXECUTION;
+        memcpy(plain, data, sizeof(plain));
+    }
+    else
+    {
+        if (!(zone & PRIVWRITE_MODE_ENCRYPT) || !(SIM_WRITE_CONFIG(sc) & 0x04) || sim_slot_locked(dev, key_id))
+            return SIM_STATUS_EXECUTION;
+        if (!dev->temp_key.valid || !dev->temp_key.gen_dig_data || dev->temp_key.key_id != SIM_WRITE_KEY(sc))
+            return SIM_STATUS_EXECUTION;
+
+        // first 32 bytes are encrypted with TempKey, the last 4 with SHA-256(TempKey)
+        sw_sha256(dev->temp_key.value, 32, session_key2);
+        for (i = 0; i < 32; i++)
+            plain[i] = data[i] ^ dev->temp_key.value[i];
+        for (i = 32; i < 36; i++)
+            plain[i] = data[i] ^ session_key2[i - 32];
+
+        sim_get_sn(dev, sn);
+        memset(&write_mac, 0, sizeof(write_mac));
+        write_mac.zone = zone;
+        write_mac.key_id = key_id;
+        write_mac.sn = sn;
+        write_mac.input_data = plain;
+        write_mac.encrypted_data = encrypted;
+        write_mac.auth_mac = expected_mac;
+        write_mac.temp_key = &dev->temp_key;
+        if (atcah_privwrite_auth_mac(&write_mac) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        dev->temp_key.valid = 0;
+        if (memcmp(expected_mac, &data[36], sizeof(expected_mac)) != 0)
+            return SIM_STATUS_MISCOMPARE;
+    }
+
+    memcpy(dev->data[key_id], plain, sizeof(plain));
+    return SIM_STATUS_SUCCESS;
+}
+
+static uint8_t sim_sign(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    struct atca_sign_internal_in_out sign_internal;
+    uint8_t sn[9];
+    uint8_t digest[32];
+    uint8_t k[32];
+    uint8_t signature[64];
+    uint16_t read_key;
+
+    (void)data;
+    if (!sim_is_ecc(dev) || key_id >= SIM_SLOT_COUNT || data_size != 0 || (mode & ~(SIGN_MODE_MASK | SIGN_MODE_INVALIDATE)))
+        return SIM_STATUS_PARSE;
+    if (!sim_data_locked(dev) || !sim_is_private(dev, key_id) || !sim_is_p256(dev, key_id) || !dev->temp_key.valid)
+        return SIM_STATUS_EXECUTION;
+
+    // ReadKey of a private key: bit 0 allows external messages, bit 1 internal ones
+    read_key = SIM_READ_KEY(sim_slot_config(dev, key_id));
+    if (mode & SIGN_MODE_EXTERNAL)
+    {
+        if (!(read_key & 0x01))
+            return SIM_STATUS_EXECUTION;
+        memcpy(digest, dev->temp_key.value, sizeof(digest));
+    }
+    else
+    {
+        if (!(read_key & 0x02) || !(dev->temp_key.gen_dig_data || dev->temp_key.gen_key_data))
+            return SIM_STATUS_EXECUTION;
+        sim_get_sn(dev, sn);
+        memset(&sign_internal, 0, sizeof(sign_internal));
+        sign_internal.mode = mode;
+        sign_internal.key_id = key_id;
+        sign_internal.for_invalidate = (mode & SIGN_MODE_INVALIDATE) != 0;
+        sign_internal.sn = sn;
+        sign_internal.temp_key = &dev->temp_key;
+        sign_internal.digest = digest;
+        if (atcah_config_to_sign_internal(dev->devtype, &sign_internal, dev->config) != ATCA_SUCCESS
+            || atcah_sign_internal_msg(dev->devtype, &sign_internal) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+    }
+
+    do
+        sim_random(dev, k);
+    while (atcac_sw_p256_sign(&dev->data[key_id][4], digest, k, signature) != ATCA_SUCCESS);
+    dev->temp_key.valid = 0;
+
+    sim_response_data(dev, signature, sizeof(signature));
+    return SIM_STATUS_SUCCESS;
+}
+
+/** \brief digest of the Verify(Validate/Invalidate) message, the Sign(Internal) message rebuilt
+ *         from TempKey, OtherData and the serial number
+ */
+static void sim_validate_digest(const ATCASimDevice_t *dev, const uint8_t other_data[19], uint8_t digest[32])
+{
+    uint8_t msg[55];
+    uint8_t sn[9];
+
+    sim_get_sn(dev, sn);
+    memcpy(&msg[0], dev->temp_key.value, 32);
+    msg[32] = ATCA_SIGN;
+    memcpy(&msg[33], &other_data[0], 10);
+    msg[43] = sn[8];
+    memcpy(&msg[44], &other_data[10], 4);
+    msg[48] = sn[0];
+    msg[49] = sn[1];
+    memcpy(&msg[50], &other_data[14], 5);
+    sw_sha256(msg, sizeof(msg), digest);
+}
+
+static uint8_t sim_verify(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    uint8_t public_key[64];
+    uint8_t digest[32];
+    uint16_t kc;
+    uint16_t validation_key_id;
+    int status;
+
+    if (!sim_is_ecc(dev))
+        return SIM_STATUS_PARSE;
+
+    switch (mode)
+    {
+    case VERIFY_MODE_EXTERNAL:
+        if (key_id != VERIFY_KEY_P256 || data_size != 128)
+            return SIM_STATUS_PARSE;
+        if (!dev->temp_key.valid)
+            return SIM_STATUS_EXECUTION;
+        if (atcac_sw_p256_check_pubkey(&data[64]) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        status = atcac_sw_p256_verify(dev->temp_key.value, data, &data[64]);
+        break;
+
+    case VERIFY_MODE_STORED:
+        if (key_id >= SIM_SLOT_COUNT || data_size != 64)
+            return SIM_STATUS_PARSE;
+        kc = sim_key_config(dev, key_id);
+        if (!sim_data_locked(dev) || SIM_PRIVATE(kc) || SIM_KEY_TYPE(kc) != SIM_KEY_TYPE_P256 || !dev->temp_key.valid)
+            return SIM_STATUS_EXECUTION;
+        if (SIM_PUB_INFO(kc) && sim_pubkey_validity(dev, key_id) != 0x5)
+            return SIM_STATUS_EXECUTION;   // validated public key that hasn't been validated
+        sim_get_stored_pubkey(dev, key_id, public_key);
+        if (atcac_sw_p256_check_pubkey(public_key) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        status = atcac_sw_p256_verify(dev->temp_key.value, data, public_key);
+        break;
+
+    case VERIFY_MODE_VALIDATE:
+    case VERIFY_MODE_INVALIDATE:
+        if (key_id >= SIM_SLOT_COUNT || data_size != 64 + VERIFY_OTHER_DATA_SIZE)
+            return SIM_STATUS_PARSE;
+        kc = sim_key_config(dev, key_id);
+        if (!sim_data_locked(dev) || !SIM_PUB_INFO(kc) || SIM_PRIVATE(kc))
+            return SIM_STATUS_EXECUTION;
+        // TempKey has to hold a GenKey(PubKey digest) of the key being (in)validated
+        if (!dev->temp_key.valid || !dev->temp_key.gen_key_data || dev->temp_key.key_id != key_id)
+            return SIM_STATUS_EXECUTION;
+        validation_key_id = SIM_READ_KEY(sim_slot_config(dev, key_id));
+        sim_get_stored_pubkey(dev, validation_key_id, public_key);
+        if (atcac_sw_p256_check_pubkey(public_key) != ATCA_SUCCESS)
+            return SIM_STATUS_EXECUTION;
+        sim_validate_digest(dev, &data[64], digest);
+        status = atcac_sw_p256_verify(digest, data, public_key);
+        if (status == ATCA_SUCCESS)
+            sim_set_pubkey_validity(dev, key_id, mode == VERIFY_MODE_VALIDATE ? 0x5 : 0xA);
+        break;
+
+    default:
+        return SIM_STATUS_PARSE;
+    }
+
+    if (status == ATCA_CHECKMAC_VERIFY_FAILED || status == ATCA_BAD_PARAM)
+        return SIM_STATUS_MISCOMPARE;
+    return status == ATCA_SUCCESS ? SIM_STATUS_SUCCESS : SIM_STATUS_EXECUTION;
+}
+
+static uint8_t sim_ecdh(ATCASimDevice_t *dev, uint8_t mode, uint16_t key_id, const uint8_t *data, size_t data_size)
+{
+    uint8_t pms[32];
+    uint16_t read_key;
+
+    if (!sim_is_ecc(dev) || mode != ECDH_PREFIX_MODE || key_id >= SIM_SLOT_COUNT || data_size != ECDH_PUBKEYIN_SIZE)
+        return SIM_STATUS_PARSE;
+    if (!sim_data_locked(dev) || !sim_is_private(dev, key_id) || !sim_is_p256(dev, key_id))
+        return SIM_STATUS_EXECUTION;
+
+    // ReadKey of a private key: bit 2 allows ECDH, bit 3 sends the result to slot N+1
+    read_key = SIM_READ_KEY(sim_slot_config(dev, key_id));
+    if (!(read_key & 0x04))
+        return SIM_STATUS_EXECUTION;
+    if (atcac_sw_p256_ecdh(&dev->data[key_id][4], data, pms) != ATCA_SUCCESS)
+        return SIM_STATUS_EXECUTION;
+
+    if (read_key & 0x08)
+    {
+        if (key_id + 1 >= SIM_SLOT_COUNT)
+            return SIM_STATUS_EXECUTION;
+        memcpy(dev->data[key_id + 1], pms, sizeof(pms));
+        return SIM_STATUS_SUCCESS;
+    }
+
+    sim_response_data(dev, pms, sizeof(pms));
+    return SIM_STATUS_SUCCESS;
+}
+
+/* ---- command dispatch -------------------------------------------------------------------- */
+
+typedef uint8_t (*sim_command_fn)(ATCASimDevice_t *dev, uint8_t param1, uint16_t param2, const uint8_t *data, size_t data_size);
+
+static sim_command_fn sim_find_command(uint8_t opcode)
+{
+    switch (opcode)
+    {
+    case ATCA_CHECKMAC:     return &sim_checkmac;
+    case ATCA_COUNTER:      return &sim_counter;
+    case ATCA_DERIVE_KEY:   return &sim_derivekey;
+    case ATCA_ECDH:         return &sim_ecdh;
+    case ATCA_GENDIG:       return &sim_gendig;
+    case ATCA_GENKEY:       return &sim_genkey;
+    case ATCA_HMAC:         return &sim_hmac;
+    case ATCA_INFO:         return &sim_info;
+    case ATCA_LOCK:         return &sim_lock;
+    case ATCA_MAC:          return &sim_mac;
+    case ATCA_NONCE:        return &sim_nonce;
+    case ATCA_PRIVWRITE:    return &sim_privwrite;
+    case ATCA_RANDOM:       return &sim_random_cmd;
+    case ATCA_READ:         return &sim_read;
+    case ATCA_SHA:          return &sim_sha;
+    case ATCA_SIGN:         return &sim_sign;
+    case ATCA_UPDATE_EXTRA: return &sim_update_extra;
+    case ATCA_VERIFY:       return &sim_verify;
+    case ATCA_WRITE:        return &sim_write;
+    default:                return NULL;
+    }
+}
+
+/** \brief check the frame of a command and execute it, leaving the response for hal_sim_receive()
+ * \param[in] dev    simulated device
+ * \param[in] frame  count, opcode, param1, param2, data, CRC
+ * \param[in] size   size of frame
+ */
+static void sim_execute(ATCASimDevice_t *dev, const uint8_t *frame, size_t size)
+{
+    sim_command_fn command;
+    uint8_t crc[2];
+    uint8_t status;
+
+    dev->response_size = 0;
+    if (size < ATCA_CMD_SIZE_MIN || frame[ATCA_COUNT_IDX] != size)
+    {
+        sim_response_status(dev, SIM_STATUS_PARSE);
+        return;
+    }
+
+    atCRC(size - ATCA_CRC_SIZE, frame, crc);
+    if (crc[0] != frame[size - 2] || crc[1] != frame[size - 1])
+    {
+        sim_response_status(dev, SIM_STATUS_CRC);
+        return;
+    }
+
+    if ( (command = sim_find_command(frame[ATCA_OPCODE_IDX])) == NULL)
+        status = SIM_STATUS_PARSE;
+    else
+        status = command(dev, frame[ATCA_PARAM1_IDX],
+                         (uint16_t)frame[ATCA_PARAM2_IDX] | ((uint16_t)frame[ATCA_PARAM2_IDX + 1] << 8),
+                         &frame[ATCA_DATA_IDX], size - ATCA_CMD_SIZE_MIN);
+
+    if (status != SIM_STATUS_SUCCESS || dev->response_size == 0)
+        sim_response_status(dev, status);
+}
+
+/* ---- HAL interface ----------------------------------------------------------------------- */
+
+/** \brief HAL implementation of simulator init, attaches to simulated device atcasim.device_id,
+ *         bringing it up in factory state the first time it's used
+ * \param[in] hal pointer to HAL specific data that is maintained by this HAL
+ * \param[in] cfg pointer to HAL specific configuration data that is used to initialize this HAL
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_sim_init(void *hal, ATCAIfaceCfg *cfg)
+{
+    ATCASimDevice_t *dev;
+    int id = cfg->atcasim.device_id;
+
+    if (id < 0 || id >= MAX_SIM_DEVICES)
+        return ATCA_COMM_FAIL;
+    if (cfg->devtype != ATECC508A && cfg->devtype != ATSHA204A)
+        return ATCA_BAD_PARAM;
+
+    sim_acquire();
+    dev = &sim_devices[id];
+    if (!dev->in_use || dev->devtype != cfg->devtype)
+        sim_factory(dev, id, cfg->devtype, cfg->atcasim.dev_rev);
+    dev->ref_ct++;
+    sim_release();
+
+    ((ATCAHAL_t*)hal)->hal_data = dev;
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of simulator post init
+ * \param[in] iface  instance
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_sim_post_init(ATCAIface iface)
+{
+    (void)iface;
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of simulator send, the command executes before this returns
+ * \param[in] iface     instance
+ * \param[in] txdata    pointer to space to bytes to send
+ * \param[in] txlength  number of bytes to send
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_sim_send(ATCAIface iface, uint8_t *txdata, int txlength)
+{
+    ATCASimDevice_t *dev = (ATCASimDevice_t*)atgetifacehaldat(iface);
+
+    if (dev == NULL || txdata == NULL || txlength <= 0)
+        return ATCA_BAD_PARAM;
+
+    // txdata[0] is the _reserved byte of the ATCAPacket, the frame starts after it
+    sim_acquire();
+    sim_execute(dev, &txdata[1], (size_t)txlength);
+    sim_release();
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief HAL implementation of simulator receive
+ * \param[in]    iface     instance
+ * \param[out]   rxdata    pointer to space to receive the data
+ * \param[inout] rxlength  size of rxdata on input, bytes received on output
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_sim_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength)
+{
+    ATCASimDevice_t *dev = (ATCASimDevice_t*)atgetifacehaldat(iface);
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (dev == NULL || rxdata == NULL || rxlength == NULL)
+        return ATCA_BAD_PARAM;
+
+    sim_acquire();
+    if (dev->response_size == 0)
+    {
+        *rxlength = 0;
+        status = ATCA_RX_NO_RESPONSE;
+    }
+    else
+    {
+        // like the chip, a short read gets the front of the response
+        if (*rxlength > dev->response_size)
+            *rxlength = dev->response_size;
+        memcpy(rxdata, dev->response, *rxlength);
+        dev->response_size = 0;
+    }
+    sim_release();
+
+    return status;
+}
+
+/** \brief wake up the simulated device, it is always ready
+ * \param[in] iface  instance
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_sim_wake(ATCAIface iface)
+{
+    (void)iface;
+    return ATCA_SUCCESS;
+}
+
+/** \brief idle the simulated device, TempKey is retained
+ * \param[in] iface  instance
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_sim_idle(ATCAIface iface)
+{
+    (void)iface;
+    return ATCA_SUCCESS;
+}
+
+/** \brief put the simulated device to sleep, which clears TempKey and the SHA context
+ * \param[in] iface  instance
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_sim_sleep(ATCAIface iface)
+{
+    ATCASimDevice_t *dev = (ATCASimDevice_t*)atgetifacehaldat(iface);
+
+    if (dev == NULL)
+        return ATCA_BAD_PARAM;
+
+    sim_acquire();
+    memset(&dev->temp_key, 0, sizeof(dev->temp_key));
+    dev->sha_started = false;
+    dev->sha_hmac = false;
+    sim_release();
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief detach from a simulated device. Its zones are kept for the next hal_sim_init().
+ * \param[in] hal_data  simulated device, as set by hal_sim_init()
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_sim_release(void *hal_data)
+{
+    ATCASimDevice_t *dev = (ATCASimDevice_t*)hal_data;
+
+    if (dev == NULL)
+        return ATCA_SUCCESS;
+
+    sim_acquire();
+    if (dev->ref_ct > 0)
+        dev->ref_ct--;
+    sim_release();
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief put a simulated device back in factory state: zones unlocked, slots, OTP and counters
+ *         cleared. The device type and revision it was brought up with are kept.
+ * \param[in] device_id  simulated device, as in ATCAIfaceCfg.atcasim.device_id
+ * \return ATCA_STATUS
+ */
+ATCA_STATUS hal_sim_reset(int device_id)
+{
+    ATCASimDevice_t *dev;
+    ATCADeviceType devtype;
+    uint8_t revision[4];
+    int ref_ct;
+
+    if (device_id < 0 || device_id >= MAX_SIM_DEVICES)
+        return ATCA_BAD_PARAM;
+
+    sim_acquire();
+    dev = &sim_devices[device_id];
+    if (dev->in_use)
+    {
+        devtype = dev->devtype;
+        ref_ct = dev->ref_ct;
+        memcpy(revision, dev->revision, sizeof(revision));
+        sim_factory(dev, device_id, devtype, revision);
+        dev->ref_ct = ref_ct;
+    }
+    sim_release();
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief the simulator has no buses to discover
+ * \param[in] i2c_buses  unused
+ * \param[in] max_buses  unused
+ * \return ATCA_UNIMPLEMENTED
+ */
+ATCA_STATUS hal_sim_discover_buses(int i2c_buses[], int max_buses)
+{
+    (void)i2c_buses;
+    (void)max_buses;
+    return ATCA_UNIMPLEMENTED;
+}
+
+/** \brief the simulator has no devices to discover, they are created by hal_sim_init()
+ * \param[in]  busNum  unused
+ * \param[in]  cfg     unused
+ * \param[out] found   set to 0
+ * \return ATCA_UNIMPLEMENTED
+ */
+ATCA_STATUS hal_sim_discover_devices(int busNum, ATCAIfaceCfg *cfg, int *found)
+{
+    (void)busNum;
+    (void)cfg;
+    if (found != NULL)
+        *found = 0;
+    return ATCA_UNIMPLEMENTED;
+}
+
+/** @} */
@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \brief ATCA Hardware abstraction layer for a software simulated ATECC508A / ATSHA204A.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HAL_SIM_H_
+#define HAL_SIM_H_
+
+#include "crypto/hashes/sha2_routines.h"
+#include "host/atca_host.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+#define MAX_SIM_DEVICES     4       // simulated devices, selected by ATCAIfaceCfg.atcasim.device_id
+
+#define SIM_CONFIG_SIZE     128
+#define SIM_OTP_SIZE        64
+#define SIM_SLOT_COUNT      16
+#define SIM_SLOT_SIZE_MAX   416     // slot 8 of the ATECC508A
+
+// Status codes the device puts in a 4 byte status packet
+#define SIM_STATUS_SUCCESS      ((uint8_t)0x00)
+#define SIM_STATUS_MISCOMPARE   ((uint8_t)0x01)
+#define SIM_STATUS_PARSE        ((uint8_t)0x03)
+#define SIM_STATUS_EXECUTION    ((uint8_t)0x0F)
+#define SIM_STATUS_CRC          ((uint8_t)0xFF)
+
+// State of one simulated device. It lives for the whole process so that the zones survive
+// atcab_release()/atcab_init() the same way an EEPROM does, use hal_sim_reset() to start over.
+typedef struct atcaSimDevice
+{
+    bool           in_use;                                      // factory state has been set up
+    ATCADeviceType devtype;
+    int            ref_ct;                                      // interfaces currently open on it
+    uint8_t        revision[4];                                 // returned by Info(Revision)
+    uint8_t        config[SIM_CONFIG_SIZE];
+    uint8_t        otp[SIM_OTP_SIZE];
+    uint8_t        data[SIM_SLOT_COUNT][SIM_SLOT_SIZE_MAX];
+    atca_temp_key_t temp_key;
+    sw_sha256_ctx  sha;                                         // SHA command context
+    bool           sha_started;
+    uint8_t        sha_hmac_key[32];                            // key of a SHA(HMAC) sequence
+    bool           sha_hmac;
+    uint8_t        rng_seed[32];
+    uint32_t       rng_count;
+    uint32_t       counter[2];                                  // monotonic counters
+    uint8_t        response[ATCA_RSP_SIZE_MAX];                 // response waiting for hal_sim_receive
+    uint16_t       response_size;
+} ATCASimDevice_t;
+
+ATCA_STATUS hal_sim_reset(int device_id);
+
+/** @} */
+
+#endif /* HAL_SIM_H_ */
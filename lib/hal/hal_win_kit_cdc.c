@@ -410,6 +410,21 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
     return ATCA_SUCCESS;
 }
 
+/** \brief ASCII frame buffer of the kit behind this interface, KIT_FRAME_SIZE bytes
+ *  \param[in] iface  instance
+ *  \return pointer to the frame buffer, NULL if the interface has no kit
+ */
+char* kit_phy_frame(ATCAIface iface)
+{
+    ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+    atcacdc_t* pCdc = (atcacdc_t*)atgetifacehaldat(iface);
+
+    if ((cfg == NULL) || (pCdc == NULL))
+        return NULL;
+
+    return pCdc->kits[cfg->atcauart.port].frame;
+}
+
 /** \brief Number of USB CDC devices found
  *  \param[out] num_found Number of USB CDC devices found returned here
  *  \return ATCA_STATUS
@@ -40,6 +40,7 @@
 #define HAL_WIN_KIT_CDC_H_
 
 #include <Windows.h>
+#include "kit_protocol.h"
 
 // Kit USB defines
 #define CDC_DEVICES_MAX     10      //! Maximum number of supported Kit USB devices
@@ -51,6 +52,7 @@ typedef struct cdc_device
 {
     HANDLE read_handle;         //! The kit USB read file handle
     HANDLE write_handle;        //! The kit USB write file handle
+    char   frame[KIT_FRAME_SIZE]; //! The kit protocol ASCII frame being sent or received
 } cdc_device_t;
 
 
@@ -340,6 +340,21 @@ ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxsize)
     return ATCA_SUCCESS;
 }
 
+/** \brief ASCII frame buffer of the kit behind this interface, KIT_FRAME_SIZE bytes
+ *  \param[in] iface  instance
+ *  \return pointer to the frame buffer, NULL if the interface has no kit
+ */
+char* kit_phy_frame(ATCAIface iface)
+{
+    ATCAIfaceCfg *cfg = atgetifacecfg(iface);
+    atcahid_t* pHid = (atcahid_t*)atgetifacehaldat(iface);
+
+    if ((cfg == NULL) || (pHid == NULL))
+        return NULL;
+
+    return pHid->kits[cfg->atcahid.idx].frame;
+}
+
 /** \brief Number of USB HID devices found
  *  \param[out] num_found
  *  \return ATCA_STATUS
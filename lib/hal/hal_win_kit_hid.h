@@ -40,6 +40,7 @@
 #define HAL_WIN_KIT_HID_H_
 
 #include <Windows.h>
+#include "kit_protocol.h"
 
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
@@ -57,6 +58,7 @@ typedef struct hid_device
 {
     HANDLE read_handle;         //! The kit USB read file handle
     HANDLE write_handle;        //! The kit USB write file handle
+    char   frame[KIT_FRAME_SIZE]; //! The kit protocol ASCII frame being sent or received
 } hid_device_t;
 
 
@@ -59,6 +59,7 @@ extern "C" {
 ATCA_STATUS kit_phy_num_found(int8_t* num_found);
 ATCA_STATUS kit_phy_send(ATCAIface iface, const char *txdata, int txlength);
 ATCA_STATUS kit_phy_receive(ATCAIface iface, char* rxdata, int* rxlength);
+char* kit_phy_frame(ATCAIface iface);
 
 #ifdef __cplusplus
 }
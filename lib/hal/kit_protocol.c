@@ -37,11 +37,10 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include "kit_phy.h"
 #include "kit_protocol.h"
-#include "basic/atca_helpers.h"
 
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
@@ -50,7 +49,30 @@
  *
    @{ */
 
-
+/** \brief Upper case ASCII hex digits used to encode command bytes */
+static const char kit_hex_digit[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/** \brief Value of each ASCII character as a hex digit, 0xFF for anything that isn't one */
+static const uint8_t kit_hex_value[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
 
 /** \brief HAL implementation of kit protocol init.  This function calls back to the physical protocol to send the bytes
  *  \param[in] iface  instance
@@ -113,6 +135,9 @@ ATCA_STATUS kit_init(ATCAIface iface)
 }
 
 /** \brief HAL implementation of kit protocol send.  This function calls back to the physical protocol to send the bytes
+ *
+ * The command is encoded straight into the kit's preallocated frame buffer.
+ *
  *  \param[in] iface     instance
  *  \param[in] txdata    pointer to bytes to send
  *  \param[in] txlength  number of bytes to send
@@ -121,21 +146,20 @@ ATCA_STATUS kit_init(ATCAIface iface)
 ATCA_STATUS kit_send(ATCAIface iface, const uint8_t* txdata, int txlength)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
-    int nkitbuf = txlength * 2 + KIT_TX_WRAP_SIZE;
-    char* pkitbuf = NULL;
+    char* pkitbuf = kit_phy_frame(iface);
+    int nkitbuf = KIT_FRAME_SIZE;
 
     // Check the pointers
     if ((txdata == NULL))
         return ATCA_BAD_PARAM;
+    if (pkitbuf == NULL)
+        return ATCA_COMM_FAIL;
+
     // Wrap in kit protocol
-    pkitbuf = malloc(nkitbuf);
-    memset(pkitbuf, 0, nkitbuf);
     status = kit_wrap_cmd(&txdata[1], txlength, pkitbuf, &nkitbuf);
     if (status != ATCA_SUCCESS)
-    {
-        free(pkitbuf);
         return ATCA_GEN_FAIL;
-    }
+
     // Send the bytes
     status = kit_phy_send(iface, pkitbuf, nkitbuf);
 
@@ -144,13 +168,13 @@ ATCA_STATUS kit_send(ATCAIface iface, const uint8_t* txdata, int txlength)
     printf("\nKit Write: %s", pkitbuf);
 #endif
 
-    // Free the bytes
-    free(pkitbuf);
-
     return status;
 }
 
 /** \brief HAL implementation to receive bytes and unwrap from kit protocol.  This function calls back to the physical protocol to receive the bytes
+ *
+ * The reply is received into the kit's preallocated frame buffer and decoded from there.
+ *
  * \param[in]    iface   instance
  * \param[in]    rxdata  pointer to space to receive the data
  * \param[inout] rxsize  ptr to expected number of receive bytes to request
@@ -160,41 +184,36 @@ ATCA_STATUS kit_receive(ATCAIface iface, uint8_t* rxdata, uint16_t* rxsize)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
     uint8_t kitstatus = 0;
+    char* pkitbuf = kit_phy_frame(iface);
     int nkitbuf = 0;
     int dataSize = 0;
-    char* pkitbuf = NULL;
 
     // Check the pointers
     if ((rxdata == NULL) || (rxsize == NULL))
         return ATCA_BAD_PARAM;
+    if (pkitbuf == NULL)
+        return ATCA_COMM_FAIL;
 
     // Adjust the read buffer size
     dataSize = *rxsize;
     nkitbuf = dataSize * 2 + KIT_RX_WRAP_SIZE;
-    pkitbuf = malloc(nkitbuf);
-    memset(pkitbuf, 0, nkitbuf);
+    if (nkitbuf > KIT_FRAME_SIZE)
+        nkitbuf = KIT_FRAME_SIZE;
 
     // Receive the bytes
     status = kit_phy_receive(iface, pkitbuf, &nkitbuf);
     if (status != ATCA_SUCCESS)
-    {
-        free(pkitbuf);
         return ATCA_GEN_FAIL;
-    }
 
 #ifdef KIT_DEBUG
     // Print the bytes
-    printf("Kit Read: %s\r", pkitbuf);
+    printf("Kit Read: %.*s\r", nkitbuf, pkitbuf);
 #endif
 
     // Unwrap from kit protocol
-    memset(rxdata, 0, *rxsize);
     status = kit_parse_rsp(pkitbuf, nkitbuf, &kitstatus, rxdata, &dataSize);
     *rxsize = dataSize;
 
-    // Free the bytes
-    free(pkitbuf);
-
     return status;
 }
 
@@ -326,79 +345,96 @@ ATCA_STATUS kit_sleep(ATCAIface iface)
  * \param[in] txdata pointer to the binary data to wrap
  * \param[in] txlen length of the binary data to wrap
  * \param[out] pkitcmd pointer to binary data converted to ascii kit protocol
- * \param[inout] nkitcmd pointer to the size of the binary data converted to ascii kit protocol
+ * \param[inout] nkitcmd As input, the size of the pkitcmd buffer.
+ *                       As output, the length of the ascii kit protocol command, not counting the null terminator.
  * \return ATCA_STATUS
  */
 ATCA_STATUS kit_wrap_cmd(const uint8_t* txdata, int txlen, char* pkitcmd, int* nkitcmd)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    char cmdpre[] = "s:t(";     // sha:talk(
-    char cmdpost[] = ")\n";
-//	char* pkitcmd = NULL;
-    int cmdAsciiLen = txlen * 2;
-    int cmdlen = txlen * 2 + sizeof(cmdpre) + sizeof(cmdpost) + 1;
-    int cpylen = 0;
-    int cpyindex = 0;
+    char* pout = pkitcmd;
+    int i;
 
     // Check the variables
-    if (txdata == NULL || pkitcmd == NULL || nkitcmd == NULL)
+    if (txdata == NULL || pkitcmd == NULL || nkitcmd == NULL || txlen < 0)
         return ATCA_BAD_PARAM;
-    if (*nkitcmd > cmdlen)
-        return ATCA_BAD_PARAM;
-
-    // Wrap in kit protocol
-    memset(pkitcmd, 0, *nkitcmd);
+    if (*nkitcmd < txlen * 2 + KIT_TX_WRAP_SIZE)
+        return ATCA_INVALID_SIZE;
 
-    // Copy the prefix
-    cpylen = (int)strlen(cmdpre);
-    memcpy(&pkitcmd[cpyindex], cmdpre, cpylen);
-    cpyindex += cpylen;
+    // Prefix, sha:talk(
+    *pout++ = 's';
+    *pout++ = ':';
+    *pout++ = 't';
+    *pout++ = '(';
 
-    // Copy the ascii binary bytes
-    status = atcab_bin2hex_(txdata, txlen, &pkitcmd[cpyindex], &cmdAsciiLen, false);
-    if (status != ATCA_SUCCESS)
-        return status;
-    cpyindex += cmdAsciiLen;
+    // Two hex digits per binary byte
+    for (i = 0; i < txlen; i++)
+    {
+        *pout++ = kit_hex_digit[txdata[i] >> 4];
+        *pout++ = kit_hex_digit[txdata[i] & 0x0F];
+    }
 
-    // Copy the postfix
-    cpylen = (int)strlen(cmdpost);
-    memcpy(&pkitcmd[cpyindex], cmdpost, cpylen);
-    cpyindex += cpylen;
+    // Postfix
+    *pout++ = ')';
+    *pout++ = '\n';
+    *pout = '\0';
 
-    *nkitcmd = cpyindex;
+    *nkitcmd = (int)(pout - pkitcmd);
 
-    return status;
+    return ATCA_SUCCESS;
 }
 
 /** \brief Parse the response ascii from the kit
- * \param[out] pkitbuf pointer to ascii kit protocol data to parse
+ *
+ * Decodes a "<status>(<hex data>)" reply in a single pass without copying it.
+ *
+ * \param[in] pkitbuf pointer to ascii kit protocol data to parse
  * \param[in] nkitbuf length of the ascii kit protocol data
- * \param[in] rxdata pointer to the binary data buffer
- * \param[in] datasize size of the pointer to the binary data buffer
+ * \param[out] kitstatus the kit status byte
+ * \param[out] rxdata pointer to the binary data buffer
+ * \param[inout] datasize As input, the size of the rxdata buffer.
+ *                        As output, the number of bytes decoded into rxdata.
  * \return ATCA_STATUS
  */
 ATCA_STATUS kit_parse_rsp(const char* pkitbuf, int nkitbuf, uint8_t* kitstatus, uint8_t* rxdata, int* datasize)
 {
-    ATCA_STATUS status = ATCA_SUCCESS;
-    int statusId = 0;
-    int dataId = 3;
-    int binSize = 1;
-    int asciiDataSize = 0;
-    char* endDataPtr = 0;
+    const uint8_t* pin = (const uint8_t*)pkitbuf;
+    const uint8_t* pend = pin + nkitbuf;
+    uint8_t hi, lo;
+    int count = 0;
+
+    if (pkitbuf == NULL || kitstatus == NULL || rxdata == NULL || datasize == NULL)
+        return ATCA_BAD_PARAM;
 
     // First get the kit status
-    status = atcab_hex2bin(&pkitbuf[statusId], 2, kitstatus, &binSize);
-    if (status != ATCA_SUCCESS)
-        return status;
+    if (nkitbuf < 3)
+        return ATCA_GEN_FAIL;
+    hi = kit_hex_value[pin[0]];
+    lo = kit_hex_value[pin[1]];
+    if ((hi | lo) & 0xF0)
+        return ATCA_GEN_FAIL;
+    *kitstatus = (uint8_t)((hi << 4) | lo);
+    if (pin[2] != '(')
+        return ATCA_GEN_FAIL;
+    pin += 3;
 
-    // Next get the binary data bytes
-    endDataPtr = strchr((char*)pkitbuf, ')');
-    if (endDataPtr < (&pkitbuf[dataId]))
+    // Next get the binary data bytes, up to the closing parenthesis
+    while (pin < pend && *pin != ')')
+    {
+        if (pin + 1 >= pend)
+            return ATCA_GEN_FAIL;
+        hi = kit_hex_value[pin[0]];
+        lo = kit_hex_value[pin[1]];
+        if ((hi | lo) & 0xF0)
+            return ATCA_GEN_FAIL;
+        if (count >= *datasize)
+            return ATCA_INVALID_SIZE;
+        rxdata[count++] = (uint8_t)((hi << 4) | lo);
+        pin += 2;
+    }
+    if (pin >= pend)
         return ATCA_GEN_FAIL;
-    asciiDataSize = (int)(endDataPtr - (&pkitbuf[dataId]));
-    status = atcab_hex2bin(&pkitbuf[dataId], asciiDataSize, rxdata, datasize);
-    if (status != ATCA_SUCCESS)
-        return status;
+
+    *datasize = count;
 
     return ATCA_SUCCESS;
 }
@@ -59,6 +59,9 @@
 #define KIT_MSG_SIZE        (32)
 #define KIT_RX_WRAP_SIZE    (KIT_MSG_SIZE + 6)
 
+// The size of the per-kit ASCII frame buffer, large enough for any command or response packet
+#define KIT_FRAME_SIZE      (ATCA_CMD_SIZE_MAX * 2 + KIT_RX_WRAP_SIZE)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
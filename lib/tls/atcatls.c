@@ -40,6 +40,7 @@
 #include "atcatls_cfg.h"
 #include "basic/atca_basic.h"
 #include "atcacert/atcacert_client.h"
+#include "atcacert/atcacert_cache.h"
 #include "atcacert/atcacert_host_hw.h"
 
 // File scope defines
@@ -870,8 +871,9 @@ ATCA_STATUS atcatls_get_cert(const atcacert_def_t* cert_def, const uint8_t *ca_p
             BREAK(status, "NULL inputs");
         }
 
-        // Build a certificate with signature and public key
-        status = atcacert_read_cert(cert_def, ca_public_key, certout, certsize);
+        // Build a certificate with signature and public key, or take it from the
+        // certificate cache when that is enabled and the stored cert is unchanged
+        status = atcacert_read_cert_cached(cert_def, ca_public_key, certout, certsize);
         if (status != ATCACERT_E_SUCCESS)
             BREAK(status, "Failed to read certificate");
 
@@ -41,6 +41,20 @@
 #include "basic/atca_basic.h"
 #include "test/atca_basic_tests.h"
 #include "host/atca_host.h"
+#include "basic/atca_pool.h"
+#include "basic/atca_sha_stream.h"
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+#include "hal/kit_protocol.h"
+#endif
+#if defined(ATCA_HAL_KIT_CDC) && defined(__linux__) && defined(ATCA_USE_PTHREADS)
+#include <pty.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "hal/hal_linux_kit_cdc.h"
+#include "hal/kit_phy.h"
+#define TEST_KIT_CDC_PTY
+#endif
 
 #if defined(__GNUC__)
 // Unity's RUN_TEST_CASE macro in the test runners declares the function as
@@ -242,6 +256,58 @@ TEST(atca_it_basic, info)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 
+TEST(atca_it_basic, info_ctx)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    uint8_t revision[4];
+    uint8_t revision_ctx[4];
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // the default device and an explicit context on it are the same device
+    status = atcab_info_ctx(atcab_get_device(), revision_ctx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(revision, revision_ctx, sizeof(revision));
+
+    status = atcab_info_ctx(NULL, revision_ctx);
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, status);
+}
+
+TEST(atca_it_basic, pool_random)
+{
+#ifdef ATCA_USE_PTHREADS
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    ATCAIfaceCfg *cfgs[1] = { gCfg };
+    ATCAPool pool;
+    ATCAPoolStats stats;
+    uint8_t randomnum[RANDOM_RSP_SIZE];
+
+    // the pool brings its own device up on the same interface, the global one has to let go
+    atcab_release();
+    pool = newATCAPool(cfgs, 1);
+    TEST_ASSERT_NOT_NULL(pool);
+    TEST_ASSERT_EQUAL(1, atca_pool_size(pool));
+
+    status = atca_pool_random(pool, randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atca_pool_get_stats(pool, 0, &stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, stats.queue_depth);
+    TEST_ASSERT_EQUAL(1, stats.completed);
+    TEST_ASSERT_EQUAL(0, stats.failed);
+
+    deleteATCAPool(&pool);
+    TEST_ASSERT_NULL(pool);
+
+    status = atcab_init(gCfg);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+#else
+    TEST_IGNORE_MESSAGE("needs ATCA_USE_PTHREADS");
+#endif
+}
+
 TEST(atca_it_basic, random)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
@@ -251,6 +317,27 @@ TEST(atca_it_basic, random)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 
+TEST(atca_it_basic, session_rewake)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    uint8_t randomnum[RANDOM_RSP_SIZE];
+
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_random(randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // host time alone, with no commands sent, has to trigger the re-wake
+    atca_delay_ms(ATCA_SESSION_REWAKE_US / 1000 + 100);
+
+    status = atcab_random(randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
 TEST(atca_it_basic, challenge)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
@@ -339,6 +426,89 @@ TEST(atca_it_basic, read_config_zone)
     }
 }
 
+TEST(atca_it_basic, config_shadow)
+{
+#ifndef ATCA_NO_CONFIG_SHADOW
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    ATCAConfigShadowStats before, after;
+    uint8_t serial_number[ATCA_SERIAL_NUM_SIZE];
+    uint8_t data[ATCA_BLOCK_SIZE];
+    uint8_t word[ATCA_WORD_SIZE];
+    bool is_locked = false;
+    uint32_t reads = 0;
+    uint16_t slot;
+
+    status = atcab_config_shadow_invalidate();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_config_shadow_stats(&before);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // one fill answers the lock bytes and the serial number
+    status = atcab_is_locked(LOCK_ZONE_CONFIG, &is_locked);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    reads++;
+    if (atIsECCFamily(gCfg->devtype))
+    {
+        for (slot = 0; slot < 16; slot++)
+        {
+            status = atcab_is_slot_locked(slot, &is_locked);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+            reads++;
+        }
+    }
+    status = atcab_read_serial_number(serial_number);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    reads++;
+
+    status = atcab_config_shadow_stats(&after);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(before.fills + 1, after.fills);
+    TEST_ASSERT_EQUAL(before.reads_saved + reads, after.reads_saved);
+
+    // block 1 holds the counters, it always goes to the bus
+    before = after;
+    status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 1, 0, data, sizeof(data));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_config_shadow_stats(&after);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(before.reads_saved, after.reads_saved);
+
+    // a config write drops the shadow and the next read sees the device again
+    status = atcab_is_locked(LOCK_ZONE_CONFIG, &is_locked);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    if (!is_locked)
+    {
+        status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 5, word, sizeof(word));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        status = atcab_write_zone(ATCA_ZONE_CONFIG, 0, 0, 5, word, sizeof(word));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+    else
+    {
+        status = atcab_config_shadow_invalidate();
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+    status = atcab_config_shadow_stats(&after);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(before.invalidations + 1, after.invalidations);
+
+    status = atcab_read_serial_number(serial_number);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_config_shadow_stats(&after);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(before.fills + 1, after.fills);
+
+    status = atcab_config_shadow_stats(NULL);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+
+    // without a device the read falls through to the bus path and fails there
+    status = atcab_read_zone_ctx(NULL, ATCA_ZONE_CONFIG, 0, 0, 0, data, sizeof(data));
+    TEST_ASSERT_NOT_EQUAL(ATCA_SUCCESS, status);
+#else
+    TEST_IGNORE_MESSAGE("built with ATCA_NO_CONFIG_SHADOW");
+#endif
+}
+
 TEST(atca_it_basic, lock_config_zone)
 {
     ATCA_STATUS status = ATCA_SUCCESS;
@@ -2157,6 +2327,70 @@ TEST(atca_it_basic, sha_long)
 }
 
 
+/** \brief streamed SHA on the device and in software against atcac_sw_sha2_256, for lengths
+ *         around the block boundaries, fed in uneven pieces
+ */
+TEST(atca_it_basic, sha_stream)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    static const size_t sizes[] = { 0, 10, 63, 64, 65, 119, 120, 128, 1000 };
+    uint8_t message[1000];
+    uint8_t digest[ATCA_SHA_DIGEST_SIZE];
+    uint8_t expected[ATCA_SHA_DIGEST_SIZE];
+    ATCAShaStream ctx;
+    ATCAShaStreamStats stats;
+    size_t i, pos, piece;
+
+    for (i = 0; i < sizeof(message); i++)
+        message[i] = (uint8_t)(i * 7 + 3);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256(message, sizes[i], expected));
+
+        status = atca_sha_stream_init(&ctx, atcab_get_device(), true);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        for (pos = 0, piece = 1; pos < sizes[i]; pos += piece, piece = piece * 3 + 1)
+        {
+            if (piece > sizes[i] - pos)
+                piece = sizes[i] - pos;
+            status = atca_sha_stream_update(&ctx, &message[pos], piece);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        }
+        status = atca_sha_stream_finish(&ctx, digest);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL_MEMORY(expected, digest, ATCA_SHA_DIGEST_SIZE);
+
+        status = atca_sha_stream_get_stats(&ctx, &stats);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_FALSE(stats.software);
+        TEST_ASSERT_EQUAL(sizes[i], stats.bytes);
+        TEST_ASSERT_TRUE(stats.commands >= 2 + sizes[i] / ATCA_SHA256_BLOCK_SIZE);
+
+        // the device is released again, a plain command goes through
+        status = atcab_random(digest);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+        status = atca_sha_stream(NULL, false, message, sizes[i], digest, &stats);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL_MEMORY(expected, digest, ATCA_SHA_DIGEST_SIZE);
+        TEST_ASSERT_TRUE(stats.software);
+        TEST_ASSERT_EQUAL(0, stats.commands);
+    }
+
+    status = atca_sha_stream_init(&ctx, NULL, true);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+
+    // abandoned half way, the session is closed
+    status = atca_sha_stream_init(&ctx, atcab_get_device(), true);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atca_sha_stream_update(&ctx, message, 200);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atca_sha_stream_abort(&ctx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, atGetSession(atcab_get_device())->depth);
+}
+
 /** \brief test HW SHA with a short message < SHA block size and not an exact SHA block-size increment
  *
  */
@@ -2178,6 +2412,246 @@ TEST(atca_it_basic, sha_short)
     TEST_ASSERT_EQUAL_MEMORY(rightAnswer, digest, ATCA_SHA_DIGEST_SIZE);
 }
 
+/** \brief Bit-at-a-time CRC-16 the devices document, kept as the reference for atCRC */
+void crc16_reference(size_t length, const uint8_t *data, uint8_t *crc_le)
+{
+    size_t counter;
+    uint16_t crc_register = 0;
+    uint8_t shift_register;
+    uint8_t data_bit, crc_bit;
+
+    for (counter = 0; counter < length; counter++)
+    {
+        for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1)
+        {
+            data_bit = (data[counter] & shift_register) ? 1 : 0;
+            crc_bit = crc_register >> 15;
+            crc_register <<= 1;
+            if (data_bit != crc_bit)
+                crc_register ^= 0x8005;
+        }
+    }
+    crc_le[0] = (uint8_t)(crc_register & 0x00FF);
+    crc_le[1] = (uint8_t)(crc_register >> 8);
+}
+
+TEST(atca_it_basic, crc16_reference)
+{
+    uint8_t data[ATCA_CMD_SIZE_MAX];
+    uint8_t crc[ATCA_CRC_SIZE];
+    uint8_t expected[ATCA_CRC_SIZE];
+    uint32_t seed = 0x12345678;
+    size_t length;
+    size_t i;
+
+    // Known answer: Info command (count, opcode, mode, param2)
+    static const uint8_t info_cmd[] = { 0x07, 0x30, 0x00, 0x00, 0x00 };
+    static const uint8_t info_crc[] = { 0x03, 0x5D };
+    atCRC(sizeof(info_cmd), info_cmd, crc);
+    TEST_ASSERT_EQUAL_MEMORY(info_crc, crc, sizeof(crc));
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    // Every length a packet can have, at every alignment the slice loop can see
+    for (length = 0; length <= sizeof(data); length++)
+    {
+        for (i = 0; i < 8 && i + length <= sizeof(data); i++)
+        {
+            crc16_reference(length, &data[i], expected);
+            atCRC(length, &data[i], crc);
+            TEST_ASSERT_EQUAL_MEMORY(expected, crc, sizeof(crc));
+        }
+    }
+}
+
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+TEST(atca_it_basic, kit_protocol_codec)
+{
+    static const uint8_t read_cmd[] = { 0x07, 0x02, 0x00, 0x00, 0x00, 0x1E, 0x2D };
+    static const char read_frame[] = "s:t(07020000001E2D)\n";
+    static const uint8_t info_rsp[] = { 0x07, 0x00, 0x00, 0x50, 0x00, 0x03, 0x5D };
+    char frame[KIT_FRAME_SIZE];
+    int nframe = sizeof(frame);
+    uint8_t kitstatus = 0xFF;
+    uint8_t data[ATCA_RSP_SIZE_MAX];
+    int ndata = sizeof(data);
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_wrap_cmd(read_cmd, sizeof(read_cmd), frame, &nframe));
+    TEST_ASSERT_EQUAL(sizeof(read_frame) - 1, nframe);
+    TEST_ASSERT_EQUAL_STRING(read_frame, frame);
+
+    nframe = sizeof(read_frame) - 1;
+    TEST_ASSERT_EQUAL(ATCA_INVALID_SIZE, kit_wrap_cmd(read_cmd, sizeof(read_cmd), frame, &nframe));
+
+    // Upper and lower case digits both decode
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_parse_rsp("00(0700005000035d)\n", 19, &kitstatus, data, &ndata));
+    TEST_ASSERT_EQUAL(0, kitstatus);
+    TEST_ASSERT_EQUAL(sizeof(info_rsp), ndata);
+    TEST_ASSERT_EQUAL_MEMORY(info_rsp, data, sizeof(info_rsp));
+
+    ndata = sizeof(data);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_parse_rsp("E0()\n", 5, &kitstatus, data, &ndata));
+    TEST_ASSERT_EQUAL(0xE0, kitstatus);
+    TEST_ASSERT_EQUAL(0, ndata);
+
+    // Malformed replies
+    ndata = sizeof(data);
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, kit_parse_rsp("00(0700G0)\n", 11, &kitstatus, data, &ndata));
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, kit_parse_rsp("00(07000)\n", 10, &kitstatus, data, &ndata));
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, kit_parse_rsp("00(070000", 9, &kitstatus, data, &ndata));
+    TEST_ASSERT_EQUAL(ATCA_GEN_FAIL, kit_parse_rsp("0", 1, &kitstatus, data, &ndata));
+    ndata = 2;
+    TEST_ASSERT_EQUAL(ATCA_INVALID_SIZE, kit_parse_rsp("00(070000)\n", 11, &kitstatus, data, &ndata));
+}
+#endif
+
+#ifdef TEST_KIT_CDC_PTY
+extern char *dev;       // port hal_kit_cdc_init() opens
+
+/** \brief plays the kit board for kit_init(): answers the address and select requests */
+static void* test_kit_cdc_board(void* arg)
+{
+    int master = *(int*)arg;
+    static const char* replies[] = { "00(C0)\n", "00()\n" };
+    struct pollfd pfd = { master, POLLIN, 0 };
+    char c;
+    int answered = 0;
+
+    while (answered < 2 && poll(&pfd, 1, 2000) > 0)
+    {
+        if (read(master, &c, 1) != 1)
+            break;
+        if (c == '\n')
+        {
+            if (write(master, replies[answered], strlen(replies[answered])) < 0)
+                break;
+            answered++;
+        }
+    }
+    return NULL;
+}
+
+/** \brief kit CDC receive against a pty: replies shorter than the ring buffer, two replies
+ *         in one read, polling, and a port that hangs up
+ */
+TEST(atca_it_basic, kit_cdc_pty)
+{
+    ATCAIfaceCfg cfg = cfg_atecc508a_kitcdc_default;
+    ATCAIface iface;
+    atcacdc_t* cdc;
+    pthread_t board;
+    char name[64];
+    char* saved_dev = dev;
+    char rx[KIT_RX_WRAP_SIZE];
+    int rxsize;
+    int master, slave;
+    uint32_t ready = 0;
+
+    TEST_ASSERT_EQUAL(0, openpty(&master, &slave, name, NULL, NULL));
+    close(slave);
+
+    dev = name;
+    pthread_create(&board, NULL, test_kit_cdc_board, &master);
+    iface = newATCAIface(&cfg);
+    pthread_join(board, NULL);
+    dev = saved_dev;
+    TEST_ASSERT_NOT_NULL(iface);
+    cdc = (atcacdc_t*)atgetifacehaldat(iface);
+
+    // a reply far shorter than the ring buffer
+    TEST_ASSERT_EQUAL(9, write(master, "00(0102)\n", 9));
+    rxsize = sizeof(rx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_phy_receive(iface, rx, &rxsize));
+    TEST_ASSERT_EQUAL(9, rxsize);
+    TEST_ASSERT_EQUAL_MEMORY("00(0102)\n", rx, 9);
+
+    // two replies in one read, the second stays buffered
+    TEST_ASSERT_EQUAL(12, write(master, "00(01)\nE0()\n", 12));
+    rxsize = sizeof(rx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_phy_receive(iface, rx, &rxsize));
+    TEST_ASSERT_EQUAL_MEMORY("00(01)\n", rx, rxsize);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, hal_kit_cdc_poll(cdc, 0, &ready));
+    TEST_ASSERT_EQUAL(1, ready);
+    rxsize = sizeof(rx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_phy_receive(iface, rx, &rxsize));
+    TEST_ASSERT_EQUAL_MEMORY("E0()\n", rx, rxsize);
+
+    TEST_ASSERT_EQUAL(ATCA_TIMEOUT, hal_kit_cdc_poll(cdc, 0, &ready));
+    TEST_ASSERT_EQUAL(6, write(master, "00(0)\n", 6));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, hal_kit_cdc_poll(cdc, 1000, &ready));
+    TEST_ASSERT_EQUAL(1, ready);
+    rxsize = sizeof(rx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, kit_phy_receive(iface, rx, &rxsize));
+
+    // the board goes away: the port is closed instead of polled forever
+    close(master);
+    TEST_ASSERT_EQUAL(ATCA_COMM_FAIL, hal_kit_cdc_poll(cdc, -1, &ready));
+    TEST_ASSERT_EQUAL(ATCA_COMM_FAIL, hal_kit_cdc_poll(cdc, -1, &ready));
+    rxsize = sizeof(rx);
+    TEST_ASSERT_EQUAL(ATCA_COMM_FAIL, kit_phy_receive(iface, rx, &rxsize));
+
+    deleteATCAIface(&iface);
+}
+#endif
+
+TEST(atca_it_basic, hex_base64_known_answers)
+{
+    static const uint8_t bytes[] = { 0x00, 0xAB, 0xFF };
+    uint8_t bin[32];
+    int bin_len;
+    char hex[64];
+    int hex_len;
+    char b64[64];
+    size_t b64_len;
+    size_t out_len;
+
+    hex_len = sizeof(hex);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_bin2hex_(bytes, sizeof(bytes), hex, &hex_len, false));
+    TEST_ASSERT_EQUAL(6, hex_len);
+    TEST_ASSERT_EQUAL_STRING("00ABFF", hex);
+
+    // Conversion stops at the last byte that fits
+    hex_len = 5;
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_bin2hex_(bytes, sizeof(bytes), hex, &hex_len, false));
+    TEST_ASSERT_EQUAL(4, hex_len);
+
+    hex_len = sizeof(hex);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_bin2hex(bytes, sizeof(bytes), hex, &hex_len));
+    TEST_ASSERT_EQUAL_STRING("00 AB FF ", hex);
+
+    // White space and case are ignored, an odd last digit stands alone
+    bin_len = sizeof(bin);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_hex2bin("00 ab\r\nFf 7", 13, bin, &bin_len));
+    TEST_ASSERT_EQUAL(4, bin_len);
+    TEST_ASSERT_EQUAL_MEMORY(bytes, bin, sizeof(bytes));
+    TEST_ASSERT_EQUAL(0x07, bin[3]);
+
+    b64_len = sizeof(b64);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_base64encode((const uint8_t*)"Man", 3, b64, &b64_len));
+    TEST_ASSERT_EQUAL_MEMORY("TWFu", b64, 4);
+    b64_len = sizeof(b64);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_base64encode((const uint8_t*)"Ma", 2, b64, &b64_len));
+    TEST_ASSERT_EQUAL_MEMORY("TWE=", b64, 4);
+    b64_len = sizeof(b64);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_base64encode((const uint8_t*)"M", 1, b64, &b64_len));
+    TEST_ASSERT_EQUAL(4, b64_len);
+    TEST_ASSERT_EQUAL_MEMORY("TQ==", b64, 4);
+
+    // Decode in place, skipping the line breaks of a PEM body
+    strcpy(b64, "TWFu\r\nTWE=");
+    out_len = sizeof(b64);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_base64decode(b64, strlen(b64), (uint8_t*)b64, &out_len));
+    TEST_ASSERT_EQUAL(5, out_len);
+    TEST_ASSERT_EQUAL_MEMORY("ManMa", b64, 5);
+
+    out_len = sizeof(bin);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcab_base64decode("TWFuTW", 6, bin, &out_len));
+}
+
 TEST(atca_it_basic, base64encode_decode)
 {
     // Use an arbitrary buffer to encode and decode
@@ -2495,10 +2969,14 @@ TEST_GROUP_RUNNER(atca_it_basic)
     RUN_TEST_CASE(atca_it_basic, init);
     RUN_TEST_CASE(atca_it_basic, doubleinit);
     RUN_TEST_CASE(atca_it_basic, info);
+    RUN_TEST_CASE(atca_it_basic, info_ctx);
+    RUN_TEST_CASE(atca_it_basic, pool_random);
     RUN_TEST_CASE(atca_it_basic, random);
+    RUN_TEST_CASE(atca_it_basic, session_rewake);
     RUN_TEST_CASE(atca_it_basic, sha);
     RUN_TEST_CASE(atca_it_basic, sha_long);
     RUN_TEST_CASE(atca_it_basic, sha_short);
+    RUN_TEST_CASE(atca_it_basic, sha_stream);
     RUN_TEST_CASE(atca_it_basic, sha2_256_nist1);
     RUN_TEST_CASE(atca_it_basic, sha2_256_nist2);
     RUN_TEST_CASE(atca_it_basic, sha2_256_nist_short);
@@ -2508,6 +2986,7 @@ TEST_GROUP_RUNNER(atca_it_basic)
     RUN_TEST_CASE(atca_it_basic, write_bytes_zone_config);
     RUN_TEST_CASE(atca_it_basic, write_config_zone);
     RUN_TEST_CASE(atca_it_basic, read_config_zone);
+    RUN_TEST_CASE(atca_it_basic, config_shadow);
 
     // We no longer automatically lock during the unit test run so tests
     // can be rerun at a specific lock level
@@ -2569,4 +3048,12 @@ void RunBasicOtpZero(void)
 void RunAllHelperTests(void)
 {
     RUN_TEST_CASE(atca_it_basic, base64encode_decode);
+    RUN_TEST_CASE(atca_it_basic, hex_base64_known_answers);
+    RUN_TEST_CASE(atca_it_basic, crc16_reference);
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+    RUN_TEST_CASE(atca_it_basic, kit_protocol_codec);
+#endif
+#ifdef TEST_KIT_CDC_PTY
+    RUN_TEST_CASE(atca_it_basic, kit_cdc_pty);
+#endif
 }
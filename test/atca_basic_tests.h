@@ -39,9 +39,13 @@
 #ifndef ATCA_BASIC_TESTS_H_
 #define ATCA_BASIC_TESTS_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 // Helper tests
 void RunAllHelperTests(void);
 void test_base64encode_decode(void);
+void crc16_reference(size_t length, const uint8_t *data, uint8_t *crc_le);
 
 void RunBasicOtpZero(void);
 void RunAllBasicTests(void);
@@ -0,0 +1,1023 @@
+/**
+ * \file
+ * \brief Host-side benchmarks for CryptoAuthLib.
+ *
+ * Each benchmark prints its own results. Benchmarks that need a device use
+ * gCfg and report themselves as skipped when the device can't be reached.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atca_test.h"
+#include "atca_benchmarks.h"
+#include "atca_basic_tests.h"
+#include "crypto/hashes/sha2_routines.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
+#include "crypto/atca_crypto_sw_p256.h"
+#include "crypto/atca_crypto_sw_rand.h"
+#include "basic/atca_sha_stream.h"
+#include <stdio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <time.h>
+#endif
+#if defined(__linux__) && defined(ATCA_HAL_I2C)
+#include "hal/hal_linux_i2c_userspace.h"
+#endif
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+#include <stdlib.h>
+#include "hal/kit_protocol.h"
+#endif
+#ifdef ATCA_USE_PTHREADS
+#include <pthread.h>
+#include "basic/atca_pool.h"
+#endif
+
+#define BENCH_CMD_ITERATIONS    20
+#define BENCH_POLL_INTERVAL_US  500
+#define BENCH_MAX_THREADS       8
+#define BENCH_SIGN_KEY_ID       0
+#define BENCH_CRC_ITERATIONS    100000
+#define BENCH_KIT_ITERATIONS    100000
+#define BENCH_CODEC_ITERATIONS  20000
+#define BENCH_CODEC_CERT_SIZE   600
+#define BENCH_SHA256_BUFFER_SIZE 65536
+#define BENCH_SHA256_BYTES      (64 * 1024 * 1024)
+#define BENCH_SHA256_MULTI_COUNT 4096
+#define BENCH_SHA256_MULTI_ITERATIONS 50
+#define BENCH_ECDSA_ITERATIONS  500
+#define BENCH_ECDSA_BATCH       256
+#define BENCH_RANDOM_ITERATIONS 100000
+#define BENCH_SHA_STREAM_BYTES  4096
+
+void atca_benchmarks(void)
+{
+    bench_crc();
+    bench_kit_codec();
+    bench_helpers_codec();
+    bench_sha256();
+    bench_sha256_multi();
+    bench_atcacert_date();
+    bench_ecdsa_p256();
+    bench_ecdsa_p256_batch();
+    bench_random();
+    bench_i2c_syscalls();
+    bench_exec_polling();
+    bench_session();
+    bench_sha_stream();
+    bench_threads();
+    bench_pool();
+}
+
+/** \brief monotonic timestamp in nanoseconds, 0 where no clock is available */
+uint64_t bench_now_ns(void)
+{
+#if defined(__linux__)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+/** \brief CRC-16 throughput of atCRC against the bitwise reference, no device needed */
+void bench_crc(void)
+{
+    static const size_t lengths[] = { 7, ATCA_RSP_SIZE_MAX, ATCA_CMD_SIZE_MAX };
+    uint8_t data[ATCA_CMD_SIZE_MAX];
+    uint8_t crc[ATCA_CRC_SIZE];
+    uint64_t start;
+    double ref_ns, crc_ns;
+    size_t i;
+    int n;
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 7 + 1);
+
+    printf("\r\nCRC-16 in ns per packet, bitwise reference vs atCRC (%d iterations)\r\n", BENCH_CRC_ITERATIONS);
+    printf("%-12s %8s %8s %8s\r\n", "bytes", "bitwise", "atCRC", "MB/s");
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        start = bench_now_ns();
+        for (n = 0; n < BENCH_CRC_ITERATIONS; n++)
+        {
+            crc16_reference(lengths[i], data, crc);
+            data[0] ^= crc[0];
+        }
+        ref_ns = (double)(bench_now_ns() - start) / BENCH_CRC_ITERATIONS;
+
+        start = bench_now_ns();
+        for (n = 0; n < BENCH_CRC_ITERATIONS; n++)
+        {
+            atCRC(lengths[i], data, crc);
+            data[0] ^= crc[0];
+        }
+        crc_ns = (double)(bench_now_ns() - start) / BENCH_CRC_ITERATIONS;
+
+        printf("%-12u %8.1f %8.1f %8.1f\r\n", (unsigned)lengths[i], ref_ns, crc_ns,
+               crc_ns > 0 ? (double)lengths[i] * 1000.0 / crc_ns : 0.0);
+    }
+}
+
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+typedef struct
+{
+    const char* name;
+    int         cmd_size;   // command packet, count through CRC
+    int         rsp_size;   // response packet, count through CRC
+} bench_kit_frame_t;
+
+/** \brief the hex encoder the kit HALs used before the codec, one sprintf per byte */
+static ATCA_STATUS bench_legacy_bin2hex(const uint8_t* binary, int binLen, char* asciihex, int* asciihexlen)
+{
+    int i;
+    int hexlen = 0;
+
+    memset(asciihex, 0, *asciihexlen);
+    for (i = 0; i < binLen; i++)
+    {
+        if (hexlen > *asciihexlen)
+            break;
+        sprintf(&asciihex[hexlen], "%02X", *binary++);
+        hexlen += 2;
+    }
+    *asciihexlen = (int)strlen(asciihex);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief the hex decoder the kit HALs used before the codec, packed through a malloc'd
+ *         copy and one sscanf per byte
+ */
+static ATCA_STATUS bench_legacy_hex2bin(const char* asciiHex, int asciiHexLen, uint8_t* binary, int* binLen)
+{
+    int i, j;
+    uint32_t byt;
+    char* packedHex;
+    int packedLen = 0;
+    char hexByte[3];
+
+    packedHex = (char*)malloc(asciiHexLen);
+    memset(packedHex, 0, asciiHexLen);
+    for (i = 0; i < asciiHexLen; i++)
+    {
+        if ((asciiHex[i] >= '0' && asciiHex[i] <= '9') || (asciiHex[i] >= 'A' && asciiHex[i] <= 'F') ||
+            (asciiHex[i] >= 'a' && asciiHex[i] <= 'f'))
+            packedHex[packedLen++] = asciiHex[i];
+    }
+
+    memset(binary, 0, *binLen);
+    memset(hexByte, 0, 3);
+    for (i = 0, j = 0; i < packedLen; i += 2, j++)
+    {
+        if (j > *binLen)
+            break;
+        memcpy(hexByte, &packedHex[i], 2);
+        sscanf(hexByte, "%x", (unsigned int*)&byt);
+        binary[j] = byt;
+    }
+    *binLen = j;
+    free(packedHex);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief one command and reply the way the HALs used to, through malloc'd buffers and
+ *         private copies of the sprintf and sscanf hex codec they called
+ */
+static ATCA_STATUS bench_kit_legacy(const uint8_t* cmd, int cmd_size, const char* reply, int reply_size,
+                                    uint8_t* rsp, int rsp_size)
+{
+    ATCA_STATUS status;
+    int nkitbuf = cmd_size * 2 + KIT_TX_WRAP_SIZE;
+    int hexlen = cmd_size * 2;
+    char* pkitbuf;
+    uint8_t kitstatus;
+    int binsize = 1;
+
+    pkitbuf = malloc(nkitbuf);
+    memset(pkitbuf, 0, nkitbuf);
+    memcpy(pkitbuf, "s:t(", 4);
+    status = bench_legacy_bin2hex(cmd, cmd_size, &pkitbuf[4], &hexlen);
+    memcpy(&pkitbuf[4 + hexlen], ")\n", 2);
+    free(pkitbuf);
+    if (status != ATCA_SUCCESS)
+        return status;
+
+    nkitbuf = rsp_size * 2 + KIT_RX_WRAP_SIZE;
+    pkitbuf = malloc(nkitbuf);
+    memset(pkitbuf, 0, nkitbuf);
+    memcpy(pkitbuf, reply, reply_size);
+    status = bench_legacy_hex2bin(pkitbuf, 2, &kitstatus, &binsize);
+    if (status == ATCA_SUCCESS)
+        status = bench_legacy_hex2bin(&pkitbuf[3], (int)(strchr(pkitbuf, ')') - &pkitbuf[3]), rsp, &rsp_size);
+    free(pkitbuf);
+
+    return status;
+}
+
+/** \brief one command and reply through the kit codec into a preallocated frame */
+static ATCA_STATUS bench_kit_codec_frame(const uint8_t* cmd, int cmd_size, const char* reply, int reply_size,
+                                         uint8_t* rsp, int rsp_size, char* frame)
+{
+    ATCA_STATUS status;
+    int nframe = KIT_FRAME_SIZE;
+    uint8_t kitstatus;
+
+    if ((status = kit_wrap_cmd(cmd, cmd_size, frame, &nframe)) != ATCA_SUCCESS)
+        return status;
+    return kit_parse_rsp(reply, reply_size, &kitstatus, rsp, &rsp_size);
+}
+#endif
+
+/** \brief kit protocol encode and decode time for Sign, Read and SHA frames, no device needed
+ *
+ * The CDC and HID kit HALs share this codec, so the numbers apply to both.
+ */
+void bench_kit_codec(void)
+{
+#if defined(ATCA_HAL_KIT_CDC) || defined(ATCA_HAL_KIT_HID)
+    static const bench_kit_frame_t frames[] = {
+        { "sign",     7,                             ATCA_SIG_SIZE + ATCA_PACKET_OVERHEAD       },
+        { "read32",   7,                             ATCA_BLOCK_SIZE + ATCA_PACKET_OVERHEAD     },
+        { "sha64",    ATCA_SHA256_BLOCK_SIZE + 7,    ATCA_SHA_DIGEST_SIZE + ATCA_PACKET_OVERHEAD },
+    };
+    static char frame[KIT_FRAME_SIZE];
+    char reply[KIT_FRAME_SIZE];
+    uint8_t cmd[ATCA_CMD_SIZE_MAX];
+    uint8_t rsp[ATCA_RSP_SIZE_MAX];
+    int reply_size;
+    uint64_t start;
+    double legacy_ns, codec_ns;
+    size_t i;
+    int j, n;
+
+    printf("\r\nKit protocol ns per command and reply, legacy vs codec (%d iterations)\r\n", BENCH_KIT_ITERATIONS);
+    printf("%-12s %8s %8s\r\n", "frame", "legacy", "codec");
+    for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+    {
+        for (j = 0; j < frames[i].cmd_size; j++)
+            cmd[j] = (uint8_t)(j * 13 + 5);
+        cmd[0] = (uint8_t)frames[i].cmd_size;
+        reply_size = 0;
+        reply[reply_size++] = '0';
+        reply[reply_size++] = '0';
+        reply[reply_size++] = '(';
+        for (j = 0; j < frames[i].rsp_size; j++)
+            reply_size += sprintf(&reply[reply_size], "%02X", (uint8_t)(j * 29 + 3));
+        reply[reply_size++] = ')';
+        reply[reply_size++] = '\n';
+        reply[reply_size] = '\0';
+
+        start = bench_now_ns();
+        for (n = 0; n < BENCH_KIT_ITERATIONS; n++)
+        {
+            if (bench_kit_legacy(cmd, frames[i].cmd_size, reply, reply_size, rsp, sizeof(rsp)) != ATCA_SUCCESS)
+                break;
+        }
+        legacy_ns = (double)(bench_now_ns() - start) / BENCH_KIT_ITERATIONS;
+
+        start = bench_now_ns();
+        for (n = 0; n < BENCH_KIT_ITERATIONS; n++)
+        {
+            if (bench_kit_codec_frame(cmd, frames[i].cmd_size, reply, reply_size, rsp, sizeof(rsp), frame) != ATCA_SUCCESS)
+                break;
+        }
+        codec_ns = (double)(bench_now_ns() - start) / BENCH_KIT_ITERATIONS;
+
+        if (n != BENCH_KIT_ITERATIONS)
+            printf("%-12s failed\r\n", frames[i].name);
+        else
+            printf("%-12s %8.1f %8.1f\r\n", frames[i].name, legacy_ns, codec_ns);
+    }
+#endif
+}
+
+/** \brief hex and base 64 helper throughput on a certificate sized buffer, no device needed */
+void bench_helpers_codec(void)
+{
+    static uint8_t cert[BENCH_CODEC_CERT_SIZE];
+    static char encoded[BENCH_CODEC_CERT_SIZE * 4];
+    static uint8_t decoded[BENCH_CODEC_CERT_SIZE * 2];
+    size_t encoded_len = 0;
+    size_t decoded_len = 0;
+    int hex_len = 0;
+    int bin_len = 0;
+    uint64_t start;
+    double ns[4];
+    int i, n;
+
+    for (i = 0; i < BENCH_CODEC_CERT_SIZE; i++)
+        cert[i] = (uint8_t)(i * 31 + 7);
+
+    printf("\r\nHelper codecs in us per %d byte certificate (%d iterations)\r\n",
+           BENCH_CODEC_CERT_SIZE, BENCH_CODEC_ITERATIONS);
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_CODEC_ITERATIONS; n++)
+    {
+        encoded_len = sizeof(encoded);
+        atcab_base64encode(cert, sizeof(cert), encoded, &encoded_len);
+    }
+    ns[0] = (double)(bench_now_ns() - start) / BENCH_CODEC_ITERATIONS;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_CODEC_ITERATIONS; n++)
+    {
+        decoded_len = sizeof(decoded);
+        atcab_base64decode(encoded, encoded_len, decoded, &decoded_len);
+    }
+    ns[1] = (double)(bench_now_ns() - start) / BENCH_CODEC_ITERATIONS;
+    if (decoded_len != sizeof(cert) || memcmp(decoded, cert, sizeof(cert)) != 0)
+        printf("base64 round trip failed\r\n");
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_CODEC_ITERATIONS; n++)
+    {
+        hex_len = sizeof(encoded);
+        atcab_bin2hex_(cert, sizeof(cert), encoded, &hex_len, false);
+    }
+    ns[2] = (double)(bench_now_ns() - start) / BENCH_CODEC_ITERATIONS;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_CODEC_ITERATIONS; n++)
+    {
+        bin_len = sizeof(decoded);
+        atcab_hex2bin(encoded, hex_len, decoded, &bin_len);
+    }
+    ns[3] = (double)(bench_now_ns() - start) / BENCH_CODEC_ITERATIONS;
+    if (bin_len != sizeof(cert) || memcmp(decoded, cert, sizeof(cert)) != 0)
+        printf("hex round trip failed\r\n");
+
+    printf("%-14s %8.2f\r\n", "base64encode", ns[0] / 1000.0);
+    printf("%-14s %8.2f\r\n", "base64decode", ns[1] / 1000.0);
+    printf("%-14s %8.2f\r\n", "bin2hex", ns[2] / 1000.0);
+    printf("%-14s %8.2f\r\n", "hex2bin", ns[3] / 1000.0);
+}
+
+/** \brief SHA-256 throughput of each block function the CPU supports, no device needed */
+void bench_sha256(void)
+{
+    static const size_t lengths[] = { 64, 1024, BENCH_SHA256_BUFFER_SIZE };
+    static uint8_t data[BENCH_SHA256_BUFFER_SIZE];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sw_sha256_backend backend;
+    size_t i;
+    uint64_t start;
+    double ns;
+    int n, iterations;
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 13 + 5);
+
+    printf("\r\nSHA-256 MB/s per backend (%d bytes hashed per measurement)\r\n", BENCH_SHA256_BYTES);
+    printf("%-12s %10s %10s %10s\r\n", "backend", "64", "1024", "65536");
+    for (backend = SW_SHA256_BACKEND_SCALAR; backend < SW_SHA256_BACKEND_COUNT; backend++)
+    {
+        if (sw_sha256_set_backend(backend) != 0)
+            continue;
+        printf("%-12s", sw_sha256_backend_name(backend));
+        for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        {
+            iterations = (int)(BENCH_SHA256_BYTES / lengths[i]);
+            start = bench_now_ns();
+            for (n = 0; n < iterations; n++)
+            {
+                sw_sha256(data, (unsigned int)lengths[i], digest);
+                data[0] ^= digest[0];
+            }
+            ns = (double)(bench_now_ns() - start);
+            printf(" %10.1f", ns > 0 ? (double)iterations * lengths[i] * 1000.0 / ns : 0.0);
+        }
+        printf("\r\n");
+    }
+    sw_sha256_set_backend(SW_SHA256_BACKEND_AUTO);
+    printf("auto selects %s\r\n", sw_sha256_backend_name(sw_sha256_get_backend()));
+}
+
+/** \brief Independent short messages per second through each multi-buffer backend */
+void bench_sha256_multi(void)
+{
+    // Public key for a key ID, lg_generate_serialnum input, typical certificate TBS
+    static const size_t lengths[] = { 64, 67, 320 };
+    static uint8_t data[BENCH_SHA256_MULTI_COUNT + 320];
+    static const uint8_t* messages[BENCH_SHA256_MULTI_COUNT];
+    static size_t sizes[BENCH_SHA256_MULTI_COUNT];
+    static uint8_t digests[BENCH_SHA256_MULTI_COUNT][SHA256_DIGEST_SIZE];
+    sw_sha256_multi_backend backend;
+    uint64_t start;
+    double ns;
+    size_t i, n;
+    int iter;
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 29 + 3);
+    for (i = 0; i < BENCH_SHA256_MULTI_COUNT; i++)
+        messages[i] = &data[i];
+
+    printf("\r\nMulti-buffer SHA-256, thousand messages per second (%d messages per call)\r\n", BENCH_SHA256_MULTI_COUNT);
+    printf("%-12s %10s %10s %10s\r\n", "backend", "64", "67", "320");
+    for (backend = SW_SHA256_MULTI_SERIAL; backend < SW_SHA256_MULTI_COUNT; backend++)
+    {
+        if (sw_sha256_multi_set_backend(backend) != 0)
+            continue;
+        printf("%-12s", sw_sha256_multi_backend_name(backend));
+        for (n = 0; n < sizeof(lengths) / sizeof(lengths[0]); n++)
+        {
+            for (i = 0; i < BENCH_SHA256_MULTI_COUNT; i++)
+                sizes[i] = lengths[n];
+            start = bench_now_ns();
+            for (iter = 0; iter < BENCH_SHA256_MULTI_ITERATIONS; iter++)
+            {
+                sw_sha256_multi(messages, sizes, BENCH_SHA256_MULTI_COUNT, digests);
+                data[0] ^= digests[0][0];
+            }
+            ns = (double)(bench_now_ns() - start);
+            printf(" %10.1f", ns > 0 ? (double)BENCH_SHA256_MULTI_COUNT * BENCH_SHA256_MULTI_ITERATIONS * 1000000.0 / ns : 0.0);
+        }
+        printf("\r\n");
+    }
+    sw_sha256_multi_set_backend(SW_SHA256_MULTI_AUTO);
+    printf("auto selects %s\r\n", sw_sha256_multi_backend_name(sw_sha256_multi_get_backend()));
+}
+
+void bench_ecdsa_p256(void)
+{
+    uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE];
+    uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    uint8_t digest[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t k[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE];
+    atcac_sw_p256_key* key;
+    uint64_t start;
+    double ns;
+    size_t i;
+    int iter;
+    int failures = 0;
+
+    for (i = 0; i < sizeof(private_key); i++)
+    {
+        private_key[i] = (uint8_t)(i * 37 + 11);
+        digest[i] = (uint8_t)(i * 5 + 1);
+        k[i] = (uint8_t)(i * 71 + 3);
+    }
+    private_key[0] &= 0x7F;
+    k[0] &= 0x7F;
+    atcac_sw_p256_get_pubkey(private_key, public_key);
+
+    printf("\r\nSoftware P-256 ECDSA (%d iterations)\r\n", BENCH_ECDSA_ITERATIONS);
+
+    start = bench_now_ns();
+    for (iter = 0; iter < BENCH_ECDSA_ITERATIONS; iter++)
+    {
+        k[31] = (uint8_t)iter;
+        atcac_sw_p256_sign(private_key, digest, k, signature);
+    }
+    ns = (double)(bench_now_ns() - start);
+    printf("sign   %8.1f us %10.1f /s\r\n", ns / BENCH_ECDSA_ITERATIONS / 1000.0,
+           ns > 0 ? BENCH_ECDSA_ITERATIONS * 1000000000.0 / ns : 0.0);
+
+    start = bench_now_ns();
+    for (iter = 0; iter < BENCH_ECDSA_ITERATIONS; iter++)
+    {
+        if (atcac_sw_p256_verify(digest, signature, public_key) != ATCA_SUCCESS)
+            failures++;
+    }
+    ns = (double)(bench_now_ns() - start);
+    printf("verify %8.1f us %10.1f /s\r\n", ns / BENCH_ECDSA_ITERATIONS / 1000.0,
+           ns > 0 ? BENCH_ECDSA_ITERATIONS * 1000000000.0 / ns : 0.0);
+
+    start = bench_now_ns();
+    key = atcac_sw_p256_key_new(public_key);
+    ns = (double)(bench_now_ns() - start);
+    printf("key    %8.1f us (table build)\r\n", ns / 1000.0);
+
+    start = bench_now_ns();
+    for (iter = 0; iter < BENCH_ECDSA_ITERATIONS; iter++)
+    {
+        if (atcac_sw_p256_verify_key(digest, signature, key) != ATCA_SUCCESS)
+            failures++;
+    }
+    ns = (double)(bench_now_ns() - start);
+    printf("verify %8.1f us %10.1f /s with a prepared key\r\n", ns / BENCH_ECDSA_ITERATIONS / 1000.0,
+           ns > 0 ? BENCH_ECDSA_ITERATIONS * 1000000000.0 / ns : 0.0);
+    atcac_sw_p256_key_free(key);
+
+    if (failures)
+        printf("verify failed %d times\r\n", failures);
+}
+
+void bench_ecdsa_p256_batch(void)
+{
+    static uint8_t digests[BENCH_ECDSA_BATCH][ATCA_ECC_P256_FIELD_SIZE];
+    static uint8_t signatures[BENCH_ECDSA_BATCH][ATCA_ECC_P256_SIGNATURE_SIZE];
+    static uint8_t public_keys[BENCH_ECDSA_BATCH][ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    static atcac_sw_ecdsa_p256_item_t items[BENCH_ECDSA_BATCH];
+    uint8_t results[BENCH_ECDSA_BATCH / 8];
+    uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE];
+    uint8_t k[ATCA_ECC_P256_FIELD_SIZE];
+    size_t keys[] = { BENCH_ECDSA_BATCH, 2 };
+    uint64_t start;
+    double ns;
+    size_t i, n;
+    int failures;
+
+    printf("\r\nSoftware P-256 ECDSA batch of %d, verifies per second\r\n", BENCH_ECDSA_BATCH);
+    printf("%-10s %10s %10s\r\n", "keys", "serial", "batch");
+    for (n = 0; n < sizeof(keys) / sizeof(keys[0]); n++)
+    {
+        // Every signature under its own key (device responses), then two keys (signer certs)
+        for (i = 0; i < BENCH_ECDSA_BATCH; i++)
+        {
+            memset(private_key, 0x5A, sizeof(private_key));
+            private_key[30] = (uint8_t)((i % keys[n]) >> 8);
+            private_key[31] = (uint8_t)(i % keys[n]);
+            memset(digests[i], (int)i, sizeof(digests[i]));
+            memset(k, 0x3C, sizeof(k));
+            k[30] = (uint8_t)(i >> 8);
+            k[31] = (uint8_t)i;
+            atcac_sw_p256_get_pubkey(private_key, public_keys[i]);
+            atcac_sw_p256_sign(private_key, digests[i], k, signatures[i]);
+            items[i].msg = digests[i];
+            items[i].signature = signatures[i];
+            items[i].public_key = public_keys[i];
+        }
+        printf("%-10u", (unsigned)keys[n]);
+
+        atcac_sw_ecdsa_p256_cache_clear();
+        failures = 0;
+        start = bench_now_ns();
+        for (i = 0; i < BENCH_ECDSA_BATCH; i++)
+        {
+            if (atcac_sw_ecdsa_verify_p256(items[i].msg, items[i].signature, items[i].public_key) != ATCA_SUCCESS)
+                failures++;
+        }
+        ns = (double)(bench_now_ns() - start);
+        printf(" %10.1f", ns > 0 ? BENCH_ECDSA_BATCH * 1000000000.0 / ns : 0.0);
+
+        atcac_sw_ecdsa_p256_cache_clear();
+        start = bench_now_ns();
+        if (atcac_sw_ecdsa_verify_p256_batch(items, BENCH_ECDSA_BATCH, results) != ATCA_SUCCESS)
+            failures++;
+        ns = (double)(bench_now_ns() - start);
+        printf(" %10.1f\r\n", ns > 0 ? BENCH_ECDSA_BATCH * 1000000000.0 / ns : 0.0);
+        if (failures)
+            printf("verify failed %d times\r\n", failures);
+    }
+    atcac_sw_ecdsa_p256_cache_clear();
+}
+
+void bench_random(void)
+{
+    uint8_t challenge[32];
+    uint64_t start;
+    double ns;
+    int iter;
+    int failures = 0;
+
+    // First call seeds the thread's generator, keep it out of the timing
+    atcac_sw_random(challenge, sizeof(challenge));
+
+    start = bench_now_ns();
+    for (iter = 0; iter < BENCH_RANDOM_ITERATIONS; iter++)
+    {
+        if (atcac_sw_random(challenge, sizeof(challenge)) != ATCA_SUCCESS)
+            failures++;
+    }
+    ns = (double)(bench_now_ns() - start);
+    printf("\r\nSoftware random, 32-byte challenge: %.1f ns\r\n", ns / BENCH_RANDOM_ITERATIONS);
+    if (failures)
+        printf("random failed %d times\r\n", failures);
+}
+
+typedef ATCA_STATUS (*bench_cmd_fn)(void);
+
+static ATCA_STATUS bench_cmd_info(void)
+{
+    uint8_t revision[4];
+
+    return atcab_info(revision);
+}
+
+static ATCA_STATUS bench_cmd_random(void)
+{
+    uint8_t rand_out[RANDOM_NUM_SIZE];
+
+    return atcab_random(rand_out);
+}
+
+static ATCA_STATUS bench_cmd_read_zone(void)
+{
+    uint8_t block[ATCA_BLOCK_SIZE];
+
+    return atcab_read_zone(ATCA_ZONE_CONFIG, 0, 0, 0, block, ATCA_BLOCK_SIZE);
+}
+
+#if defined(__linux__) && defined(ATCA_HAL_I2C)
+static void bench_i2c_syscalls_cmd(const char* name, bench_cmd_fn cmd)
+{
+    ATCAIface iface = atGetIFace(atcab_get_device());
+    ATCAI2CStats_t stats;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t now;
+    uint32_t legacy;
+    int i;
+
+    hal_i2c_reset_stats(iface);
+    start = bench_now_ns();
+    for (i = 0; i < BENCH_CMD_ITERATIONS; i++)
+    {
+        if (cmd() != ATCA_SUCCESS)
+        {
+            printf("%-12s failed\r\n", name);
+            return;
+        }
+    }
+    elapsed = bench_now_ns() - start;
+    hal_i2c_get_stats(iface, &stats);
+
+    now = stats.opens + stats.ioctls + stats.rdwrs + stats.reads + stats.writes;
+    // Estimate only, the per-call HAL is gone: open + I2C_SLAVE + close on every HAL entry, plus a
+    // second I2C_SLAVE per wake, around one read() or write() per entry and both for a wake
+    legacy = stats.transfers * 4 + stats.wakes * 2;
+    printf("%-12s %6.1f %6.1f %8.2f\r\n", name,
+           (double)legacy / BENCH_CMD_ITERATIONS,
+           (double)now / BENCH_CMD_ITERATIONS,
+           (double)elapsed / BENCH_CMD_ITERATIONS / 1000000.0);
+}
+#endif
+
+/** \brief syscalls issued by the Linux I2C HAL per basic API command
+ *
+ * Reports the syscalls the persistent bus descriptor needs, counted by the HAL, together
+ * with the wall time per command, once with plain read()/write() transfers and once with
+ * combined I2C_RDWR ones. The per-call open()/close() HAL no longer exists, so the "est"
+ * column is an estimate of what it needed, derived from the counted HAL entries and wakes.
+ */
+void bench_i2c_syscalls(void)
+{
+#if defined(__linux__) && defined(ATCA_HAL_I2C)
+    uint8_t combined_xfer;
+    uint8_t mode;
+
+    printf("\r\nI2C syscalls per command (%d iterations)\r\n", BENCH_CMD_ITERATIONS);
+    if (gCfg->iface_type != ATCA_I2C_IFACE)
+    {
+        printf("skipped: no I2C device\r\n");
+        return;
+    }
+
+    combined_xfer = gCfg->atcai2c.combined_xfer;
+    for (mode = 0; mode < 2; mode++)
+    {
+        gCfg->atcai2c.combined_xfer = mode;
+        if (atcab_init(gCfg) != ATCA_SUCCESS)
+        {
+            printf("skipped: no I2C device\r\n");
+            break;
+        }
+        printf("%s\r\n", mode ? "I2C_RDWR" : "read/write");
+        printf("%-12s %6s %6s %8s\r\n", "command", "est", "now", "ms/cmd");
+        bench_i2c_syscalls_cmd("info", bench_cmd_info);
+        bench_i2c_syscalls_cmd("random", bench_cmd_random);
+        bench_i2c_syscalls_cmd("read_zone", bench_cmd_read_zone);
+        atcab_release();
+    }
+    gCfg->atcai2c.combined_xfer = combined_xfer;
+    printf("est: estimated for the former per-call open()/close() HAL, 4 syscalls per HAL entry and 2 more per wake\r\n");
+#endif
+}
+
+/** \brief average latency of a command, 0 when it fails */
+static double bench_cmd_ms(bench_cmd_fn cmd)
+{
+    uint64_t start;
+    int i;
+
+    start = bench_now_ns();
+    for (i = 0; i < BENCH_CMD_ITERATIONS; i++)
+    {
+        if (cmd() != ATCA_SUCCESS)
+            return 0;
+    }
+    return (double)(bench_now_ns() - start) / BENCH_CMD_ITERATIONS / 1000000.0;
+}
+
+/** \brief command latency with fixed worst-case delays against response polling */
+void bench_exec_polling(void)
+{
+    static const struct
+    {
+        const char*  name;
+        bench_cmd_fn cmd;
+    } cmds[] = {
+        { "info",      bench_cmd_info      },
+        { "random",    bench_cmd_random    },
+        { "read_zone", bench_cmd_read_zone },
+    };
+    uint16_t poll_interval = gCfg->poll_interval;
+    double fixed_ms, poll_ms;
+    size_t i;
+
+    printf("\r\nCommand latency in ms, fixed delay vs polling every %dus (%d iterations)\r\n",
+           BENCH_POLL_INTERVAL_US, BENCH_CMD_ITERATIONS);
+    printf("%-12s %8s %8s\r\n", "command", "fixed", "polled");
+    for (i = 0; i < sizeof(cmds) / sizeof(cmds[0]); i++)
+    {
+        gCfg->poll_interval = 0;
+        if (atcab_init(gCfg) != ATCA_SUCCESS)
+        {
+            printf("skipped: no device\r\n");
+            break;
+        }
+        fixed_ms = bench_cmd_ms(cmds[i].cmd);
+        atcab_release();
+
+        gCfg->poll_interval = BENCH_POLL_INTERVAL_US;
+        if (atcab_init(gCfg) != ATCA_SUCCESS)
+            break;
+        poll_ms = bench_cmd_ms(cmds[i].cmd);
+        atcab_release();
+
+        if (fixed_ms == 0 || poll_ms == 0)
+            printf("%-12s failed\r\n", cmds[i].name);
+        else
+            printf("%-12s %8.2f %8.2f\r\n", cmds[i].name, fixed_ms, poll_ms);
+    }
+    gCfg->poll_interval = poll_interval;
+}
+
+/** \brief a batch of config zone reads with a wake per command against one session */
+void bench_session(void)
+{
+    double single_ms, session_ms;
+
+    printf("\r\nread_zone latency in ms, wake per command vs session (%d iterations)\r\n", BENCH_CMD_ITERATIONS);
+    if (atcab_init(gCfg) != ATCA_SUCCESS)
+    {
+        printf("skipped: no device\r\n");
+        return;
+    }
+
+    single_ms = bench_cmd_ms(bench_cmd_read_zone);
+    atcab_session_begin();
+    session_ms = bench_cmd_ms(bench_cmd_read_zone);
+    atcab_session_end();
+    atcab_release();
+
+    if (single_ms == 0 || session_ms == 0)
+        printf("%-12s failed\r\n", "read_zone");
+    else
+        printf("%-12s %8.2f %8.2f\r\n", "read_zone", single_ms, session_ms);
+}
+
+/** \brief hash BENCH_SHA_STREAM_BYTES one SHA command at a time, each with its own wake */
+static ATCA_STATUS bench_sha_per_block(const uint8_t* data, size_t size, uint8_t* digest)
+{
+    ATCA_STATUS status;
+    size_t pos;
+
+    if ( (status = atcab_sha_start()) != ATCA_SUCCESS)
+        return status;
+    for (pos = 0; pos + ATCA_SHA256_BLOCK_SIZE <= size; pos += ATCA_SHA256_BLOCK_SIZE)
+    {
+        if ( (status = atcab_sha_update(&data[pos])) != ATCA_SUCCESS)
+            return status;
+    }
+    return atcab_sha_end(digest, (uint16_t)(size - pos), &data[pos]);
+}
+
+/** \brief hashing a message on the device block by block against the pipelined stream
+ *         and the software fallback, with the throughput the stream reports
+ */
+void bench_sha_stream(void)
+{
+    static uint8_t data[BENCH_SHA_STREAM_BYTES];
+    uint8_t digest[ATCA_SHA_DIGEST_SIZE];
+    ATCAShaStreamStats stats;
+    uint64_t start;
+    double ms;
+    size_t i;
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(i * 11 + 1);
+
+    printf("\r\nSHA-256 of %d bytes, ms and bytes/s of device time accounted\r\n", BENCH_SHA_STREAM_BYTES);
+    printf("%-12s %10s %10s\r\n", "mode", "ms", "bytes/s");
+
+    start = bench_now_ns();
+    if (atca_sha_stream(NULL, false, data, sizeof(data), digest, &stats) == ATCA_SUCCESS)
+        printf("%-12s %10.3f %10s\r\n", "software", (double)(bench_now_ns() - start) / 1000000.0, "-");
+
+    if (atcab_init(gCfg) != ATCA_SUCCESS)
+    {
+        printf("skipped: no device\r\n");
+        return;
+    }
+
+    start = bench_now_ns();
+    if (bench_sha_per_block(data, sizeof(data), digest) == ATCA_SUCCESS)
+        printf("%-12s %10.3f %10s\r\n", "per block", (double)(bench_now_ns() - start) / 1000000.0, "-");
+    else
+        printf("%-12s failed\r\n", "per block");
+
+    start = bench_now_ns();
+    if (atca_sha_stream(atcab_get_device(), true, data, sizeof(data), digest, &stats) == ATCA_SUCCESS)
+    {
+        ms = (double)(bench_now_ns() - start) / 1000000.0;
+        printf("%-12s %10.3f %10u\r\n", "stream", ms, (unsigned)stats.bytes_per_sec);
+    }
+    else
+        printf("%-12s failed\r\n", "stream");
+
+    atcab_release();
+}
+
+#ifdef ATCA_USE_PTHREADS
+typedef struct
+{
+    ATCADevice device;
+    int        signs;   // signatures to produce
+    int        failed;  // signatures that came back with an error
+} bench_thread_t;
+
+static void* bench_sign_thread(void* arg)
+{
+    bench_thread_t *t = (bench_thread_t*)arg;
+    uint8_t msg[ATCA_SHA_DIGEST_SIZE];
+    uint8_t signature[ATCA_SIG_SIZE];
+    int i;
+
+    memset(msg, 0x5A, sizeof(msg));
+    for (i = 0; i < t->signs; i++)
+    {
+        if (atcab_sign_ctx(t->device, BENCH_SIGN_KEY_ID, msg, signature) != ATCA_SUCCESS)
+            t->failed++;
+    }
+    return NULL;
+}
+#endif
+
+/** \brief aggregate signatures per second with 1 up to BENCH_MAX_THREADS threads signing
+ *
+ * The threads share the default device, so the per-device lock keeps their commands
+ * from interleaving on the bus; a failure count other than 0 means it didn't.
+ */
+void bench_threads(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    pthread_t threads[BENCH_MAX_THREADS];
+    bench_thread_t state[BENCH_MAX_THREADS];
+    uint64_t start, elapsed;
+    int count, i, failed;
+
+    printf("\r\nSignatures per second by thread count (%d signatures per thread)\r\n", BENCH_CMD_ITERATIONS);
+    if (atcab_init(gCfg) != ATCA_SUCCESS)
+    {
+        printf("skipped: no device\r\n");
+        return;
+    }
+
+    printf("%-8s %10s %8s\r\n", "threads", "signs/s", "failed");
+    for (count = 1; count <= BENCH_MAX_THREADS; count *= 2)
+    {
+        start = bench_now_ns();
+        for (i = 0; i < count; i++)
+        {
+            state[i].device = atcab_get_device();
+            state[i].signs = BENCH_CMD_ITERATIONS;
+            state[i].failed = 0;
+            pthread_create(&threads[i], NULL, bench_sign_thread, &state[i]);
+        }
+        failed = 0;
+        for (i = 0; i < count; i++)
+        {
+            pthread_join(threads[i], NULL);
+            failed += state[i].failed;
+        }
+        elapsed = bench_now_ns() - start;
+
+        printf("%-8d %10.2f %8d\r\n", count,
+               (double)(count * BENCH_CMD_ITERATIONS - failed) * 1000000000.0 / (double)elapsed, failed);
+    }
+    atcab_release();
+#endif
+}
+
+#ifdef ATCA_USE_PTHREADS
+typedef struct
+{
+    ATCAPool pool;
+    int      signs;
+    int      failed;
+} bench_pool_thread_t;
+
+static void* bench_pool_thread(void* arg)
+{
+    bench_pool_thread_t *t = (bench_pool_thread_t*)arg;
+    uint8_t msg[ATCA_SHA_DIGEST_SIZE];
+    uint8_t signature[ATCA_SIG_SIZE];
+    int i;
+
+    memset(msg, 0xA5, sizeof(msg));
+    for (i = 0; i < t->signs; i++)
+    {
+        if (atca_pool_sign(t->pool, BENCH_SIGN_KEY_ID, msg, signature) != ATCA_SUCCESS)
+            t->failed++;
+    }
+    return NULL;
+}
+#endif
+
+/** \brief signatures per second through a device pool, and the per-device pool counters
+ *
+ * The pool holds the configured device; with more parts on the board, add their
+ * configurations to cfgs to see the throughput scale.
+ */
+void bench_pool(void)
+{
+#ifdef ATCA_USE_PTHREADS
+    ATCAIfaceCfg *cfgs[1] = { gCfg };
+    pthread_t threads[BENCH_MAX_THREADS];
+    bench_pool_thread_t state[BENCH_MAX_THREADS];
+    ATCAPoolStats stats;
+    ATCAPool pool;
+    uint64_t start, elapsed;
+    int count, i, failed;
+
+    printf("\r\nDevice pool signatures per second by caller threads (%d signatures per thread)\r\n", BENCH_CMD_ITERATIONS);
+    if ( (pool = newATCAPool(cfgs, sizeof(cfgs) / sizeof(cfgs[0]))) == NULL)
+    {
+        printf("skipped: no device\r\n");
+        return;
+    }
+
+    printf("%-8s %10s %8s\r\n", "threads", "signs/s", "failed");
+    for (count = 1; count <= BENCH_MAX_THREADS; count *= 2)
+    {
+        start = bench_now_ns();
+        for (i = 0; i < count; i++)
+        {
+            state[i].pool = pool;
+            state[i].signs = BENCH_CMD_ITERATIONS;
+            state[i].failed = 0;
+            pthread_create(&threads[i], NULL, bench_pool_thread, &state[i]);
+        }
+        failed = 0;
+        for (i = 0; i < count; i++)
+        {
+            pthread_join(threads[i], NULL);
+            failed += state[i].failed;
+        }
+        elapsed = bench_now_ns() - start;
+
+        printf("%-8d %10.2f %8d\r\n", count,
+               (double)(count * BENCH_CMD_ITERATIONS - failed) * 1000000000.0 / (double)elapsed, failed);
+    }
+
+    printf("%-8s %10s %8s %10s %10s %8s\r\n", "device", "completed", "failed", "avg ms", "max ms", "exec %");
+    for (i = 0; i < atca_pool_size(pool); i++)
+    {
+        atca_pool_get_stats(pool, i, &stats);
+        printf("%-8d %10u %8u %10.2f %10.2f %8.1f\r\n", i, (unsigned)stats.completed, (unsigned)stats.failed,
+               stats.completed ? (double)stats.total_us / stats.completed / 1000.0 : 0.0,
+               (double)stats.max_us / 1000.0,
+               stats.total_us ? 100.0 * (double)stats.busy_us / (double)stats.total_us : 0.0);
+    }
+    deleteATCAPool(&pool);
+#endif
+}
@@ -39,12 +39,26 @@
 #include "atca_crypto_sw_tests.h"
 #include "crypto/atca_crypto_sw_sha1.h"
 #include "crypto/atca_crypto_sw_sha2.h"
-#ifdef WIN32
+#include "crypto/atca_crypto_sw_ecdsa.h"
+#include "crypto/atca_crypto_sw_p256.h"
+#include "crypto/atca_crypto_sw_rand.h"
+#include "crypto/hashes/sha2_routines.h"
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#if defined(WIN32) || defined(__linux__)
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #endif
 
+#ifdef WIN32
+#define SHA_BYTE_TEST_VECTORS "../cryptoauthlib-win-host/cryptoauthlib/test/sha-byte-test-vectors/"
+#else
+#define SHA_BYTE_TEST_VECTORS "sha-byte-test-vectors/"
+#endif
+
 static const uint8_t nist_hash_msg1[] = "abc";
 static const uint8_t nist_hash_msg2[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
 static const uint8_t nist_hash_msg3[] = "a";
@@ -67,6 +81,18 @@ void atca_crypto_sw_tests(void)
     RUN_TEST(test_atcac_sw_sha2_256_nist_short);
     RUN_TEST(test_atcac_sw_sha2_256_nist_long);
     RUN_TEST(test_atcac_sw_sha2_256_nist_monte);
+    RUN_TEST(test_atcac_sw_sha2_256_backends);
+    RUN_TEST(test_atcac_sw_sha2_256_multi);
+
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_vectors);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_sign);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_key);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_cache);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_batch);
+
+    RUN_TEST(test_atcac_sw_hmac_drbg_cavp);
+    RUN_TEST(test_atcac_sw_hmac_drbg_inputs);
+    RUN_TEST(test_atcac_sw_random);
 
     UnityEnd();
 }
@@ -128,7 +154,7 @@ void test_atcac_sw_sha1_nist3(void)
     TEST_ASSERT_EQUAL_MEMORY(digest_ref, digest, sizeof(digest_ref));
 }
 
-#ifdef WIN32
+#if defined(WIN32) || defined(__linux__)
 static void hex_to_uint8(const char hex_str[2], uint8_t* num)
 {
     *num = 0;
@@ -369,8 +395,8 @@ void test_atcac_sw_sha2_256_nist3(void)
 
 static void test_atcac_sw_sha2_256_nist_simple(const char* filename)
 {
-#ifndef WIN32
-    TEST_IGNORE_MESSAGE("Test only available under windows.");
+#if !defined(WIN32) && !defined(__linux__)
+    TEST_IGNORE_MESSAGE("Test only available under windows and linux.");
 #else
     FILE* rsp_file = NULL;
     int ret = ATCA_SUCCESS;
@@ -407,24 +433,25 @@ static void test_atcac_sw_sha2_256_nist_simple(const char* filename)
         count++;
     }
     while (ret == ATCA_SUCCESS);
+    fclose(rsp_file);
     TEST_ASSERT_MESSAGE(count > 0, "No long tests found in file.");
 #endif
 }
 
 void test_atcac_sw_sha2_256_nist_short(void)
 {
-    test_atcac_sw_sha2_256_nist_simple("../cryptoauthlib-win-host/cryptoauthlib/test/sha-byte-test-vectors/SHA256ShortMsg.rsp");
+    test_atcac_sw_sha2_256_nist_simple(SHA_BYTE_TEST_VECTORS "SHA256ShortMsg.rsp");
 }
 
 void test_atcac_sw_sha2_256_nist_long(void)
 {
-    test_atcac_sw_sha2_256_nist_simple("../cryptoauthlib-win-host/cryptoauthlib/test/sha-byte-test-vectors/SHA256LongMsg.rsp");
+    test_atcac_sw_sha2_256_nist_simple(SHA_BYTE_TEST_VECTORS "SHA256LongMsg.rsp");
 }
 
-void test_atcac_sw_sha2_256_nist_monte(void)
+static void test_atcac_sw_sha2_256_nist_monte_file(const char* filename)
 {
-#ifndef WIN32
-    TEST_IGNORE_MESSAGE("Test only available under windows.");
+#if !defined(WIN32) && !defined(__linux__)
+    TEST_IGNORE_MESSAGE("Test only available under windows and linux.");
 #else
     FILE* rsp_file = NULL;
     int ret = ATCA_SUCCESS;
@@ -434,7 +461,7 @@ void test_atcac_sw_sha2_256_nist_monte(void)
     uint8_t m[sizeof(seed) * 3];
     uint8_t md_ref[sizeof(seed)];
 
-    rsp_file = fopen("../cryptoauthlib-win-host/cryptoauthlib/test/sha-byte-test-vectors/SHA256Monte.rsp", "r");
+    rsp_file = fopen(filename, "r");
     TEST_ASSERT_NOT_EQUAL_MESSAGE(NULL, rsp_file, "Failed to  open sha-byte-test-vectors/SHA256Monte.rsp");
 
     // Find the seed value
@@ -458,5 +485,917 @@ void test_atcac_sw_sha2_256_nist_monte(void)
         TEST_ASSERT_EQUAL_MEMORY(md_ref, &md[2], sizeof(md_ref));
         memcpy(seed, &md[2], sizeof(seed));
     }
+    fclose(rsp_file);
+#endif
+}
+
+void test_atcac_sw_sha2_256_nist_monte(void)
+{
+    test_atcac_sw_sha2_256_nist_monte_file(SHA_BYTE_TEST_VECTORS "SHA256Monte.rsp");
+}
+
+void test_atcac_sw_sha2_256_backends(void)
+{
+    sw_sha256_backend backend;
+    int tested = 0;
+
+    for (backend = SW_SHA256_BACKEND_SCALAR; backend < SW_SHA256_BACKEND_COUNT; backend++)
+    {
+        if (sw_sha256_set_backend(backend) != 0)
+            continue;
+        TEST_ASSERT_EQUAL(backend, sw_sha256_get_backend());
+        printf("[%s] ", sw_sha256_backend_name(backend));
+
+        test_atcac_sw_sha2_256_nist1();
+        test_atcac_sw_sha2_256_nist2();
+        test_atcac_sw_sha2_256_nist_simple(SHA_BYTE_TEST_VECTORS "SHA256ShortMsg.rsp");
+        test_atcac_sw_sha2_256_nist_simple(SHA_BYTE_TEST_VECTORS "SHA256LongMsg.rsp");
+        test_atcac_sw_sha2_256_nist_monte_file(SHA_BYTE_TEST_VECTORS "SHA256Monte.rsp");
+        tested++;
+    }
+    TEST_ASSERT_EQUAL(0, sw_sha256_set_backend(SW_SHA256_BACKEND_AUTO));
+    TEST_ASSERT_MESSAGE(tested > 0, "No SHA-256 backend available.");
+}
+
+#if defined(WIN32) || defined(__linux__)
+#define SHA2_256_MULTI_RSP_MAX  80
+
+/** \brief Hashes every message of a NIST rsp file (up to 64 bytes each) in one multi-buffer call */
+static void test_atcac_sw_sha2_256_multi_rsp(const char* filename)
+{
+    static uint8_t msg[SHA2_256_MULTI_RSP_MAX][64];
+    static uint8_t md_ref[SHA2_256_MULTI_RSP_MAX][ATCA_SHA2_256_DIGEST_SIZE];
+    static uint8_t md[SHA2_256_MULTI_RSP_MAX][ATCA_SHA2_256_DIGEST_SIZE];
+    const uint8_t* data[SHA2_256_MULTI_RSP_MAX];
+    size_t data_size[SHA2_256_MULTI_RSP_MAX];
+    FILE* rsp_file = NULL;
+    int len_bits = 0;
+    size_t count = 0;
+    size_t i;
+
+    rsp_file = fopen(filename, "r");
+    TEST_ASSERT_NOT_NULL_MESSAGE(rsp_file, "Failed to  open file");
+
+    while (count < SHA2_256_MULTI_RSP_MAX && read_rsp_int_value(rsp_file, "Len = ", &len_bits) == ATCA_SUCCESS)
+    {
+        TEST_ASSERT_TRUE(len_bits / 8 <= (int)sizeof(msg[0]));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, read_rsp_hex_value(rsp_file, "Msg = ", msg[count], len_bits == 0 ? 1 : len_bits / 8));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, read_rsp_hex_value(rsp_file, "MD = ", md_ref[count], sizeof(md_ref[count])));
+        data[count] = msg[count];
+        data_size[count] = len_bits / 8;
+        count++;
+    }
+    fclose(rsp_file);
+    TEST_ASSERT_MESSAGE(count > 0, "No tests found in file.");
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256_multi(data, data_size, count, md));
+    for (i = 0; i < count; i++)
+        TEST_ASSERT_EQUAL_MEMORY(md_ref[i], md[i], ATCA_SHA2_256_DIGEST_SIZE);
+}
+#endif
+
+void test_atcac_sw_sha2_256_multi(void)
+{
+    // Lengths on both sides of the one and two block padding boundaries, in an
+    // order that makes lanes finish and refill at different times
+    static const size_t lengths[] = {
+        0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 3, 67, 64, 300, 1000,
+        17, 55, 200, 64, 56, 9, 511, 512, 513, 2, 33, 67, 67, 67, 64, 64, 250
+    };
+    static uint8_t message[1100];
+    const uint8_t* data[sizeof(lengths) / sizeof(lengths[0])];
+    uint8_t digests[sizeof(lengths) / sizeof(lengths[0])][ATCA_SHA2_256_DIGEST_SIZE];
+    uint8_t digest_ref[ATCA_SHA2_256_DIGEST_SIZE];
+    sw_sha256_multi_backend backend;
+    size_t i;
+    int ret;
+
+    for (i = 0; i < sizeof(message); i++)
+        message[i] = (uint8_t)(i * 31 + 7);
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        data[i] = &message[i];
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_sha2_256_multi(NULL, NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_sha2_256_multi(NULL, lengths, 1, digests));
+
+    for (backend = SW_SHA256_MULTI_SERIAL; backend < SW_SHA256_MULTI_COUNT; backend++)
+    {
+        if (sw_sha256_multi_set_backend(backend) != 0)
+            continue;
+        printf("[%s] ", sw_sha256_multi_backend_name(backend));
+
+        memset(digests, 0, sizeof(digests));
+        ret = atcac_sw_sha2_256_multi(data, lengths, sizeof(lengths) / sizeof(lengths[0]), digests);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+        for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        {
+            ret = atcac_sw_sha2_256(data[i], lengths[i], digest_ref);
+            TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+            TEST_ASSERT_EQUAL_MEMORY(digest_ref, digests[i], sizeof(digest_ref));
+        }
+
+        // Fewer messages than lanes
+        memset(digests, 0, sizeof(digests));
+        ret = atcac_sw_sha2_256_multi(&data[14], &lengths[14], 3, digests);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+        for (i = 0; i < 3; i++)
+        {
+            atcac_sw_sha2_256(data[14 + i], lengths[14 + i], digest_ref);
+            TEST_ASSERT_EQUAL_MEMORY(digest_ref, digests[i], sizeof(digest_ref));
+        }
+
+#if defined(WIN32) || defined(__linux__)
+        test_atcac_sw_sha2_256_multi_rsp(SHA_BYTE_TEST_VECTORS "SHA256ShortMsg.rsp");
 #endif
-}
\ No newline at end of file
+    }
+    TEST_ASSERT_EQUAL(0, sw_sha256_multi_set_backend(SW_SHA256_MULTI_AUTO));
+}
+
+typedef struct
+{
+    const char* name;
+    int         expected;
+    uint8_t     digest[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t     signature[ATCA_ECC_P256_SIGNATURE_SIZE];
+    uint8_t     public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+} ecdsa_p256_vector;
+
+// Edge cases in the style of the Wycheproof ecdsa_secp256r1_sha256 suite: out of
+// range and malleated scalars, x(R) between n and p, a Shamir sum at infinity,
+// point doubling inside the sum and public keys that aren't on the curve
+static const ecdsa_p256_vector ecdsa_p256_vectors[] = {
+    {
+        "valid", ATCA_SUCCESS,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xB5, 0x38, 0xEF, 0xE7, 0xFA, 0xB1, 0xFA, 0x7D, 0x10, 0x14, 0x7F, 0x0E, 0x3D, 0xAC, 0x00, 0x08,
+            0xE8, 0x89, 0xBE, 0x86, 0x28, 0x37, 0x04, 0x07, 0x14, 0x31, 0x68, 0xF7, 0xA4, 0x37, 0x31, 0x7D
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "valid high s", ATCA_SUCCESS,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0x4A, 0xC7, 0x10, 0x17, 0x05, 0x4E, 0x05, 0x83, 0xEF, 0xEB, 0x80, 0xF1, 0xC2, 0x53, 0xFF, 0xF6,
+            0xD4, 0x5D, 0x3C, 0x27, 0x7E, 0xE0, 0x9A, 0x7D, 0xDF, 0x88, 0x61, 0xCB, 0x58, 0x2B, 0xF3, 0xD4
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "modified digest", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBE
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xB5, 0x38, 0xEF, 0xE7, 0xFA, 0xB1, 0xFA, 0x7D, 0x10, 0x14, 0x7F, 0x0E, 0x3D, 0xAC, 0x00, 0x08,
+            0xE8, 0x89, 0xBE, 0x86, 0x28, 0x37, 0x04, 0x07, 0x14, 0x31, 0x68, 0xF7, 0xA4, 0x37, 0x31, 0x7D
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "r zero", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xB5, 0x38, 0xEF, 0xE7, 0xFA, 0xB1, 0xFA, 0x7D, 0x10, 0x14, 0x7F, 0x0E, 0x3D, 0xAC, 0x00, 0x08,
+            0xE8, 0x89, 0xBE, 0x86, 0x28, 0x37, 0x04, 0x07, 0x14, 0x31, 0x68, 0xF7, 0xA4, 0x37, 0x31, 0x7D
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "s zero", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "r equals n", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51,
+            0xB5, 0x38, 0xEF, 0xE7, 0xFA, 0xB1, 0xFA, 0x7D, 0x10, 0x14, 0x7F, 0x0E, 0x3D, 0xAC, 0x00, 0x08,
+            0xE8, 0x89, 0xBE, 0x86, 0x28, 0x37, 0x04, 0x07, 0x14, 0x31, 0x68, 0xF7, 0xA4, 0x37, 0x31, 0x7D
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "s equals n", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "small s", ATCA_SUCCESS,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34
+        },
+        {
+            0x03, 0x30, 0xD4, 0xB3, 0x8B, 0x38, 0x52, 0x04, 0x71, 0xCB, 0x38, 0xD7, 0x6B, 0x64, 0x49, 0x1C,
+            0x58, 0x2C, 0x3E, 0xAE, 0x35, 0xDD, 0xFA, 0xB7, 0x91, 0xE8, 0xC5, 0x6F, 0x3C, 0x28, 0xDF, 0x9F,
+            0x9A, 0x5E, 0x25, 0x85, 0x29, 0x4D, 0xBC, 0xB7, 0x11, 0x7D, 0xC5, 0xB2, 0x00, 0x14, 0xB7, 0xDC,
+            0x3A, 0x57, 0x3C, 0x52, 0x38, 0xC1, 0x4F, 0x9C, 0x8F, 0xC9, 0x79, 0x32, 0x92, 0x15, 0x4A, 0x29
+        }
+    },
+    {
+        "s plus n", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x37, 0x85
+        },
+        {
+            0x03, 0x30, 0xD4, 0xB3, 0x8B, 0x38, 0x52, 0x04, 0x71, 0xCB, 0x38, 0xD7, 0x6B, 0x64, 0x49, 0x1C,
+            0x58, 0x2C, 0x3E, 0xAE, 0x35, 0xDD, 0xFA, 0xB7, 0x91, 0xE8, 0xC5, 0x6F, 0x3C, 0x28, 0xDF, 0x9F,
+            0x9A, 0x5E, 0x25, 0x85, 0x29, 0x4D, 0xBC, 0xB7, 0x11, 0x7D, 0xC5, 0xB2, 0x00, 0x14, 0xB7, 0xDC,
+            0x3A, 0x57, 0x3C, 0x52, 0x38, 0xC1, 0x4F, 0x9C, 0x8F, 0xC9, 0x79, 0x32, 0x92, 0x15, 0x4A, 0x29
+        }
+    },
+    {
+        "r and s one", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "r and s swapped", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0xB5, 0x38, 0xEF, 0xE7, 0xFA, 0xB1, 0xFA, 0x7D, 0x10, 0x14, 0x7F, 0x0E, 0x3D, 0xAC, 0x00, 0x08,
+            0xE8, 0x89, 0xBE, 0x86, 0x28, 0x37, 0x04, 0x07, 0x14, 0x31, 0x68, 0xF7, 0xA4, 0x37, 0x31, 0x7D,
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "s max", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "digest all ones", ATCA_SUCCESS,
+        {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+        },
+        {
+            0x47, 0x1C, 0x3E, 0x75, 0x8C, 0x49, 0x04, 0x28, 0x5B, 0xBA, 0x7E, 0x53, 0x11, 0x8E, 0xD0, 0xF5,
+            0x24, 0xAD, 0xEB, 0x07, 0x57, 0xD2, 0x5B, 0xD2, 0xF8, 0xE7, 0xB0, 0xD7, 0x6D, 0xFA, 0x71, 0x4C,
+            0x78, 0xB9, 0x0B, 0x31, 0x3E, 0x13, 0xFB, 0x59, 0x74, 0xED, 0xA9, 0x88, 0xD1, 0x47, 0x39, 0xBE,
+            0x29, 0x7C, 0x2A, 0xA7, 0x5C, 0x3D, 0xC2, 0x85, 0x11, 0x23, 0x6D, 0x9F, 0x25, 0x9B, 0x20, 0x15
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "digest zero", ATCA_SUCCESS,
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        },
+        {
+            0x47, 0x1C, 0x3E, 0x75, 0x8C, 0x49, 0x04, 0x28, 0x5B, 0xBA, 0x7E, 0x53, 0x11, 0x8E, 0xD0, 0xF5,
+            0x24, 0xAD, 0xEB, 0x07, 0x57, 0xD2, 0x5B, 0xD2, 0xF8, 0xE7, 0xB0, 0xD7, 0x6D, 0xFA, 0x71, 0x4C,
+            0x5F, 0xF9, 0x02, 0x0D, 0x35, 0x43, 0x19, 0x84, 0x0E, 0x22, 0x4E, 0xBE, 0x56, 0xF3, 0xE2, 0xD1,
+            0x4C, 0x5D, 0x1B, 0x05, 0x3A, 0xB2, 0xF7, 0xD2, 0x35, 0x34, 0x1B, 0x06, 0x08, 0x18, 0x11, 0x63
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "x(R) reduced mod n", ATCA_SUCCESS,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+        },
+        {
+            0x9E, 0xC5, 0xDE, 0x5D, 0xC9, 0x63, 0x85, 0x73, 0x30, 0x09, 0x8A, 0x21, 0x51, 0x0C, 0xC3, 0x69,
+            0xD0, 0x8E, 0x82, 0x04, 0x0E, 0x11, 0x67, 0xD7, 0x58, 0x76, 0x64, 0xD8, 0xE1, 0xC1, 0x0F, 0xCC,
+            0xEC, 0xFC, 0xFC, 0x9A, 0x78, 0x12, 0xCD, 0x59, 0x25, 0xB9, 0xD2, 0x04, 0xDC, 0x1E, 0x4B, 0x3B,
+            0xC0, 0xFA, 0x01, 0xDE, 0x20, 0xA9, 0x4C, 0x08, 0xEB, 0xDB, 0x1C, 0xD1, 0x74, 0x7F, 0x74, 0x66
+        }
+    },
+    {
+        "x(R) not reduced", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x54,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+        },
+        {
+            0x9E, 0xC5, 0xDE, 0x5D, 0xC9, 0x63, 0x85, 0x73, 0x30, 0x09, 0x8A, 0x21, 0x51, 0x0C, 0xC3, 0x69,
+            0xD0, 0x8E, 0x82, 0x04, 0x0E, 0x11, 0x67, 0xD7, 0x58, 0x76, 0x64, 0xD8, 0xE1, 0xC1, 0x0F, 0xCC,
+            0xEC, 0xFC, 0xFC, 0x9A, 0x78, 0x12, 0xCD, 0x59, 0x25, 0xB9, 0xD2, 0x04, 0xDC, 0x1E, 0x4B, 0x3B,
+            0xC0, 0xFA, 0x01, 0xDE, 0x20, 0xA9, 0x4C, 0x08, 0xEB, 0xDB, 0x1C, 0xD1, 0x74, 0x7F, 0x74, 0x66
+        }
+    },
+    {
+        "result at infinity", ATCA_CHECKMAC_VERIFY_FAILED,
+        {
+            0xB2, 0x98, 0x12, 0x19, 0xEB, 0x97, 0x99, 0x5C, 0xEC, 0xF8, 0x10, 0x0E, 0xE7, 0x8A, 0x77, 0xC8,
+            0xCD, 0x10, 0x07, 0x14, 0x06, 0x2C, 0xF5, 0xC7, 0xCC, 0x7F, 0xF2, 0xFF, 0x18, 0x98, 0x31, 0x31
+        },
+        {
+            0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
+            0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "public key is generator", ATCA_SUCCESS,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xA0, 0xDE, 0x4E, 0xE4, 0xD8, 0xDB, 0xCD, 0x29, 0xAA, 0x38, 0x09, 0xD0, 0x01, 0x7E, 0x9C, 0xA0,
+            0x6B, 0x50, 0xEE, 0xC1, 0x6A, 0x5C, 0xDE, 0x3F, 0x7E, 0x9E, 0x6E, 0x45, 0xDC, 0x9F, 0x02, 0x57
+        },
+        {
+            0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+            0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+            0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+            0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+        }
+    },
+    {
+        "doubling in Shamir sum", ATCA_SUCCESS,
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F
+        },
+        {
+            0x2B, 0x42, 0xF5, 0x76, 0xD0, 0x7F, 0x41, 0x65, 0xFF, 0x65, 0xD1, 0xF3, 0xB1, 0x50, 0x0F, 0x81,
+            0xE4, 0x4C, 0x31, 0x6F, 0x1F, 0x0B, 0x3E, 0xF5, 0x73, 0x25, 0xB6, 0x9A, 0xCA, 0x46, 0x10, 0x4F,
+            0xA8, 0x1A, 0xB7, 0x1D, 0x3A, 0x22, 0x66, 0x98, 0x7E, 0xD3, 0xC7, 0x44, 0x8D, 0x5D, 0x73, 0xD7,
+            0xFE, 0x24, 0x92, 0xD3, 0x33, 0xF0, 0xEF, 0xF4, 0xD4, 0x9C, 0x6B, 0x5B, 0xFD, 0x0E, 0x64, 0xC1
+        },
+        {
+            0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+            0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+            0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+            0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+        }
+    },
+    {
+        "public key off curve", ATCA_BAD_PARAM,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+        },
+        {
+            0xB7, 0xE0, 0x8A, 0xFD, 0xFE, 0x94, 0xBA, 0xD3, 0xF1, 0xDC, 0x8C, 0x73, 0x47, 0x98, 0xBA, 0x1C,
+            0x62, 0xB3, 0xA0, 0xAD, 0x1E, 0x9E, 0xA2, 0xA3, 0x82, 0x01, 0xCD, 0x08, 0x89, 0xBC, 0x7A, 0x19,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x0A
+        }
+    },
+    {
+        "public key x above p", ATCA_BAD_PARAM,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+        },
+        {
+            0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0x36, 0x03, 0xF7, 0x47, 0x95, 0x9D, 0xBF, 0x7A, 0x4B, 0xB2, 0x26, 0xE4, 0x19, 0x28, 0x72, 0x90,
+            0x63, 0xAD, 0xC7, 0xAE, 0x43, 0x52, 0x9E, 0x61, 0xB5, 0x63, 0xBB, 0xC6, 0x06, 0xCC, 0x5E, 0x09
+        }
+    },
+    {
+        "public key zero", ATCA_BAD_PARAM,
+        {
+            0xAF, 0x2B, 0xDB, 0xE1, 0xAA, 0x9B, 0x6E, 0xC1, 0xE2, 0xAD, 0xE1, 0xD6, 0x94, 0xF4, 0x1F, 0xC7,
+            0x1A, 0x83, 0x1D, 0x02, 0x68, 0xE9, 0x89, 0x15, 0x62, 0x11, 0x3D, 0x8A, 0x62, 0xAD, 0xD1, 0xBF
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        }
+    }
+};
+
+void test_atcac_sw_ecdsa_verify_p256_vectors(void)
+{
+    size_t i;
+    int ret;
+
+    for (i = 0; i < sizeof(ecdsa_p256_vectors) / sizeof(ecdsa_p256_vectors[0]); i++)
+    {
+        const ecdsa_p256_vector* v = &ecdsa_p256_vectors[i];
+
+        ret = atcac_sw_ecdsa_verify_p256(v->digest, v->signature, v->public_key);
+        TEST_ASSERT_EQUAL_MESSAGE(v->expected, ret, v->name);
+    }
+
+    ret = atcac_sw_ecdsa_verify_p256(NULL, ecdsa_p256_vectors[0].signature, ecdsa_p256_vectors[0].public_key);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    ret = atcac_sw_ecdsa_verify_p256(ecdsa_p256_vectors[0].digest, NULL, ecdsa_p256_vectors[0].public_key);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    ret = atcac_sw_ecdsa_verify_p256(ecdsa_p256_vectors[0].digest, ecdsa_p256_vectors[0].signature, NULL);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+}
+
+void test_atcac_sw_ecdsa_verify_p256_sign(void)
+{
+    uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE];
+    uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    uint8_t digest[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t k[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE];
+    size_t round;
+    size_t i;
+    int ret;
+
+    // Round trip a series of keys through the signer, then make sure single bit
+    // changes to the digest, signature and key are all rejected
+    for (round = 0; round < 8; round++)
+    {
+        for (i = 0; i < sizeof(private_key); i++)
+        {
+            private_key[i] = (uint8_t)(round * 53 + i * 7 + 1);
+            digest[i] = (uint8_t)(round * 11 + i * 29);
+            k[i] = (uint8_t)(round * 97 + i * 13 + 5);
+        }
+        private_key[0] &= 0x7F;
+        k[0] &= 0x7F;
+
+        ret = atcac_sw_p256_get_pubkey(private_key, public_key);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+        ret = atcac_sw_p256_sign(private_key, digest, k, signature);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+        ret = atcac_sw_ecdsa_verify_p256(digest, signature, public_key);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+        digest[round] ^= 0x01;
+        ret = atcac_sw_ecdsa_verify_p256(digest, signature, public_key);
+        TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, ret);
+        digest[round] ^= 0x01;
+
+        signature[31 - round] ^= 0x80;
+        ret = atcac_sw_ecdsa_verify_p256(digest, signature, public_key);
+        TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, ret);
+        signature[31 - round] ^= 0x80;
+
+        signature[63 - round] ^= 0x02;
+        ret = atcac_sw_ecdsa_verify_p256(digest, signature, public_key);
+        TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, ret);
+        signature[63 - round] ^= 0x02;
+
+        public_key[63] ^= 0x01;
+        ret = atcac_sw_ecdsa_verify_p256(digest, signature, public_key);
+        TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    }
+}
+
+void test_atcac_sw_ecdsa_verify_p256_key(void)
+{
+    atcac_sw_p256_key* key;
+    size_t i;
+    int ret;
+
+    // The same edge cases through a prepared key, which takes the fixed-base table path
+    for (i = 0; i < sizeof(ecdsa_p256_vectors) / sizeof(ecdsa_p256_vectors[0]); i++)
+    {
+        const ecdsa_p256_vector* v = &ecdsa_p256_vectors[i];
+
+        key = atcac_sw_p256_key_new(v->public_key);
+        if (v->expected == ATCA_BAD_PARAM)
+        {
+            TEST_ASSERT_NULL_MESSAGE(key, v->name);
+            continue;
+        }
+        TEST_ASSERT_NOT_NULL_MESSAGE(key, v->name);
+        ret = atcac_sw_p256_verify_key(v->digest, v->signature, key);
+        TEST_ASSERT_EQUAL_MESSAGE(v->expected, ret, v->name);
+        atcac_sw_p256_key_free(key);
+    }
+
+    TEST_ASSERT_NULL(atcac_sw_p256_key_new(NULL));
+    key = atcac_sw_p256_key_new(ecdsa_p256_vectors[0].public_key);
+    TEST_ASSERT_NOT_NULL(key);
+    ret = atcac_sw_p256_verify_key(NULL, ecdsa_p256_vectors[0].signature, key);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    ret = atcac_sw_p256_verify_key(ecdsa_p256_vectors[0].digest, NULL, key);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    ret = atcac_sw_p256_verify_key(ecdsa_p256_vectors[0].digest, ecdsa_p256_vectors[0].signature, NULL);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+    atcac_sw_p256_key_free(key);
+}
+
+void test_atcac_sw_ecdsa_verify_p256_cache(void)
+{
+    uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE];
+    uint8_t public_keys[ATCAC_SW_ECDSA_P256_CACHE_SIZE + 1][ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    atcac_sw_ecdsa_p256_cache_stats_t stats;
+    size_t round;
+    size_t i;
+    int ret;
+
+    atcac_sw_ecdsa_p256_cache_clear();
+
+    // Repeating the vectors promotes their keys, later rounds run on cached tables
+    for (round = 0; round < ATCAC_SW_ECDSA_P256_CACHE_PROMOTE + 1; round++)
+    {
+        for (i = 0; i < sizeof(ecdsa_p256_vectors) / sizeof(ecdsa_p256_vectors[0]); i++)
+        {
+            const ecdsa_p256_vector* v = &ecdsa_p256_vectors[i];
+
+            ret = atcac_sw_ecdsa_verify_p256(v->digest, v->signature, v->public_key);
+            TEST_ASSERT_EQUAL_MESSAGE(v->expected, ret, v->name);
+        }
+    }
+    atcac_sw_ecdsa_p256_cache_stats(&stats);
+#ifndef ATCA_NO_P256_TABLES
+    TEST_ASSERT(stats.builds > 0);
+    TEST_ASSERT(stats.hits > 0);
+#endif
+
+    // Explicitly added keys get tables at once and the least recently used one goes
+    // when the cache overflows
+    atcac_sw_ecdsa_p256_cache_clear();
+    memset(private_key, 0x5A, sizeof(private_key));
+    for (i = 0; i < ATCAC_SW_ECDSA_P256_CACHE_SIZE + 1; i++)
+    {
+        private_key[31] = (uint8_t)i;
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_p256_get_pubkey(private_key, public_keys[i]));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_p256_cache_add(public_keys[i]));
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_p256_cache_add(public_keys[ATCAC_SW_ECDSA_P256_CACHE_SIZE]));
+    atcac_sw_ecdsa_p256_cache_stats(&stats);
+#ifndef ATCA_NO_P256_TABLES
+    TEST_ASSERT_EQUAL(ATCAC_SW_ECDSA_P256_CACHE_SIZE + 1, stats.builds);
+    TEST_ASSERT_EQUAL(1, stats.evictions);
+#endif
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_p256_cache_add(NULL));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_p256_cache_add(ecdsa_p256_vectors[sizeof(ecdsa_p256_vectors) / sizeof(ecdsa_p256_vectors[0]) - 1].public_key));
+    atcac_sw_ecdsa_p256_cache_clear();
+}
+
+void test_atcac_sw_ecdsa_verify_p256_batch(void)
+{
+    static uint8_t digests[40][ATCA_ECC_P256_FIELD_SIZE];
+    static uint8_t signatures[40][ATCA_ECC_P256_SIGNATURE_SIZE];
+    static uint8_t public_keys[4][ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    atcac_sw_ecdsa_p256_item_t items[40];
+    uint8_t private_key[ATCA_ECC_P256_PRIVATE_KEY_SIZE];
+    uint8_t k[ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t results[5];
+    uint8_t expected[5];
+    size_t count = sizeof(ecdsa_p256_vectors) / sizeof(ecdsa_p256_vectors[0]);
+    size_t i;
+    int ret;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_batch(NULL, 0, NULL));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256_batch(NULL, 1, results));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256_batch(items, 1, NULL));
+
+    // The edge case vectors as one batch
+    TEST_ASSERT(count <= sizeof(items) / sizeof(items[0]));
+    memset(expected, 0, sizeof(expected));
+    for (i = 0; i < count; i++)
+    {
+        items[i].msg = ecdsa_p256_vectors[i].digest;
+        items[i].signature = ecdsa_p256_vectors[i].signature;
+        items[i].public_key = ecdsa_p256_vectors[i].public_key;
+        if (ecdsa_p256_vectors[i].expected == ATCA_SUCCESS)
+            expected[i / 8] |= (uint8_t)(1 << (i % 8));
+    }
+    memset(results, 0xAA, sizeof(results));
+    ret = atcac_sw_ecdsa_verify_p256_batch(items, count, results);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, ret);
+    TEST_ASSERT_EQUAL_MEMORY(expected, results, (count + 7) / 8);
+
+    // A fleet sharing a few keys with every third signature corrupted and one missing
+    memset(private_key, 0x3C, sizeof(private_key));
+    for (i = 0; i < 4; i++)
+    {
+        private_key[31] = (uint8_t)i;
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_p256_get_pubkey(private_key, public_keys[i]));
+    }
+    memset(expected, 0, sizeof(expected));
+    for (i = 0; i < 40; i++)
+    {
+        private_key[31] = (uint8_t)(i % 4);
+        memset(digests[i], (int)i, sizeof(digests[i]));
+        memset(k, (int)(i + 1), sizeof(k));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_p256_sign(private_key, digests[i], k, signatures[i]));
+        items[i].msg = digests[i];
+        items[i].signature = signatures[i];
+        items[i].public_key = public_keys[i % 4];
+        if (i % 3 == 0)
+            signatures[i][40] ^= 0x10;
+        else
+            expected[i / 8] |= (uint8_t)(1 << (i % 8));
+    }
+    items[20].public_key = NULL;
+    expected[20 / 8] &= (uint8_t)~(1 << (20 % 8));
+
+    ret = atcac_sw_ecdsa_verify_p256_batch(items, 40, results);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, ret);
+    TEST_ASSERT_EQUAL_MEMORY(expected, results, sizeof(expected));
+
+    // All valid, odd count
+    ret = atcac_sw_ecdsa_verify_p256_batch(&items[1], 2, results);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_HEX8(0x03, results[0]);
+}
+
+void test_atcac_sw_hmac_drbg_cavp(void)
+{
+    // CAVP HMAC_DRBG.rsp, SHA-256, no prediction resistance, no reseed, COUNT = 0
+    static const uint8_t entropy[] = {
+        0xca, 0x85, 0x19, 0x11, 0x34, 0x93, 0x84, 0xbf, 0xfe, 0x89, 0xde, 0x1c, 0xbd, 0xc4, 0x6e, 0x68,
+        0x31, 0xe4, 0x4d, 0x34, 0xa4, 0xfb, 0x93, 0x5e, 0xe2, 0x85, 0xdd, 0x14, 0xb7, 0x1a, 0x74, 0x88
+    };
+    static const uint8_t nonce[] = {
+        0x65, 0x9b, 0xa9, 0x6c, 0x60, 0x1d, 0xc6, 0x9f, 0xc9, 0x02, 0x94, 0x08, 0x05, 0xec, 0x0c, 0xa8
+    };
+    static const uint8_t returned_bits[] = {
+        0xe5, 0x28, 0xe9, 0xab, 0xf2, 0xde, 0xce, 0x54, 0xd4, 0x7c, 0x7e, 0x75, 0xe5, 0xfe, 0x30, 0x21,
+        0x49, 0xf8, 0x17, 0xea, 0x9f, 0xb4, 0xbe, 0xe6, 0xf4, 0x19, 0x96, 0x97, 0xd0, 0x4d, 0x5b, 0x89,
+        0xd5, 0x4f, 0xbb, 0x97, 0x8a, 0x15, 0xb5, 0xc4, 0x43, 0xc9, 0xec, 0x21, 0x03, 0x6d, 0x24, 0x60,
+        0xb6, 0xf7, 0x3e, 0xba, 0xd0, 0xdc, 0x2a, 0xba, 0x6e, 0x62, 0x4a, 0xbf, 0x07, 0x74, 0x5b, 0xc1,
+        0x07, 0x69, 0x4b, 0xb7, 0x54, 0x7b, 0xb0, 0x99, 0x5f, 0x70, 0xde, 0x25, 0xd6, 0xb2, 0x9e, 0x2d,
+        0x30, 0x11, 0xbb, 0x19, 0xd2, 0x76, 0x76, 0xc0, 0x71, 0x62, 0xc8, 0xb5, 0xcc, 0xde, 0x06, 0x68,
+        0x96, 0x1d, 0xf8, 0x68, 0x03, 0x48, 0x2c, 0xb3, 0x7e, 0xd6, 0xd5, 0xc0, 0xbb, 0x8d, 0x50, 0xcf,
+        0x1f, 0x50, 0xd4, 0x76, 0xaa, 0x04, 0x58, 0xbd, 0xab, 0xa8, 0x06, 0xf4, 0x8b, 0xe9, 0xdc, 0xb8
+    };
+    atcac_sw_hmac_drbg_ctx ctx;
+    uint8_t data[sizeof(returned_bits)];
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_init(&ctx, entropy, sizeof(entropy), nonce, sizeof(nonce), NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_generate(&ctx, data, sizeof(data), NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_generate(&ctx, data, sizeof(data), NULL, 0));
+    TEST_ASSERT_EQUAL_MEMORY(returned_bits, data, sizeof(returned_bits));
+}
+
+void test_atcac_sw_hmac_drbg_inputs(void)
+{
+    // Personalization, additional input, a reseed and a partial block, checked against
+    // an independent implementation of SP 800-90A
+    static const uint8_t personalization[] = "lib-atca personalization";
+    static const uint8_t additional[] = "additional one";
+    static const uint8_t reseed_extra[] = "reseed extra";
+    static const uint8_t expected1[] = {
+        0xff, 0xd0, 0x61, 0xf0, 0x93, 0x2c, 0x7e, 0x14, 0x91, 0x7c, 0x30, 0x72, 0xfb, 0x09, 0xa7, 0x01,
+        0x7d, 0x12, 0x3f, 0x75, 0x2e, 0xbf, 0x36, 0xee, 0x4a, 0xbc, 0xba, 0xfe, 0xee, 0xae, 0x40, 0x69,
+        0x3b, 0x9b, 0xef, 0x32, 0x72, 0x5c, 0xe3, 0x52
+    };
+    static const uint8_t expected2[] = {
+        0x2e, 0x3d, 0xb6, 0x53, 0x85, 0x6e, 0xda, 0x37, 0x56, 0x79, 0xc8, 0x19, 0xe6, 0x94, 0x4b, 0x88,
+        0xa7, 0x3e, 0xec, 0x32, 0x7a, 0x98, 0x42, 0x27, 0x0f, 0xcb, 0xef, 0x6f, 0x30, 0xfe, 0xae, 0x7a,
+        0xb8, 0x4d, 0x2a, 0xfd, 0x4a, 0xce, 0x91, 0xc4, 0xc3, 0x6e, 0x9d, 0x02, 0x81, 0xd8, 0x0f, 0x5e,
+        0xfd, 0xbf, 0x38, 0x85, 0x8e, 0x34, 0xea, 0x53, 0x96, 0x31, 0x95, 0x1b, 0x06, 0x0d, 0xd0, 0x45
+    };
+    atcac_sw_hmac_drbg_ctx ctx;
+    uint8_t seed[48];
+    uint8_t data[64];
+    size_t i;
+
+    for (i = 0; i < sizeof(seed); i++)
+        seed[i] = (uint8_t)i;
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_init(&ctx, seed, 32, &seed[32], 16, personalization, sizeof(personalization) - 1));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_generate(&ctx, data, sizeof(expected1), additional, sizeof(additional) - 1));
+    TEST_ASSERT_EQUAL_MEMORY(expected1, data, sizeof(expected1));
+
+    for (i = 0; i < 32; i++)
+        seed[i] = (uint8_t)(100 + i);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_reseed(&ctx, seed, 32, reseed_extra, sizeof(reseed_extra) - 1));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_hmac_drbg_generate(&ctx, data, sizeof(expected2), NULL, 0));
+    TEST_ASSERT_EQUAL_MEMORY(expected2, data, sizeof(expected2));
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_hmac_drbg_init(NULL, seed, 32, NULL, 0, NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_hmac_drbg_init(&ctx, NULL, 32, NULL, 0, NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_hmac_drbg_generate(&ctx, NULL, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_hmac_drbg_generate(&ctx, data, ATCAC_SW_HMAC_DRBG_MAX_REQUEST + 1, NULL, 0));
+}
+
+void test_atcac_sw_random(void)
+{
+#ifdef __linux__
+    static uint8_t large[ATCAC_SW_HMAC_DRBG_MAX_REQUEST + 100];
+    static const uint8_t zero[32] = { 0 };
+    uint8_t random1[32];
+    uint8_t random2[32];
+    uint8_t device[32];
+    int fds[2];
+    pid_t pid;
+    int status;
+    size_t i;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(random1, sizeof(random1)));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(random2, sizeof(random2)));
+    TEST_ASSERT(memcmp(random1, zero, sizeof(zero)) != 0);
+    TEST_ASSERT(memcmp(random1, random2, sizeof(random1)) != 0);
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(NULL, 0));
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_random(NULL, 1));
+
+    // Requests past the DRBG limit are split, the tail must be filled too
+    memset(large, 0, sizeof(large));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(large, sizeof(large)));
+    TEST_ASSERT(memcmp(&large[sizeof(large) - sizeof(zero)], zero, sizeof(zero)) != 0);
+
+    // Device entropy is just mixed in, a constant must not make the output repeat
+    memset(device, 0xA5, sizeof(device));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random_reseed(device, sizeof(device)));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(random1, sizeof(random1)));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random_reseed(device, sizeof(device)));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(random2, sizeof(random2)));
+    TEST_ASSERT(memcmp(random1, random2, sizeof(random1)) != 0);
+
+    // A forked child and its parent must not produce the same bytes
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    fflush(stdout);
+    pid = fork();
+    TEST_ASSERT(pid >= 0);
+    if (pid == 0)
+    {
+        atcac_sw_random(random2, sizeof(random2));
+        i = (size_t)write(fds[1], random2, sizeof(random2));
+        _exit(i == sizeof(random2) ? 0 : 1);
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_random(random1, sizeof(random1)));
+    TEST_ASSERT_EQUAL(sizeof(random2), read(fds[0], random2, sizeof(random2)));
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+#ifdef ATCA_USE_PTHREADS
+    TEST_ASSERT(memcmp(random1, random2, sizeof(random1)) != 0);
+#endif
+#else
+    TEST_IGNORE_MESSAGE("No OS entropy source on this platform");
+#endif
+}
@@ -55,6 +55,16 @@ void test_atcac_sw_sha2_256_nist3(void);
 void test_atcac_sw_sha2_256_nist_short(void);
 void test_atcac_sw_sha2_256_nist_long(void);
 void test_atcac_sw_sha2_256_nist_monte(void);
+void test_atcac_sw_sha2_256_backends(void);
+void test_atcac_sw_sha2_256_multi(void);
+void test_atcac_sw_ecdsa_verify_p256_vectors(void);
+void test_atcac_sw_ecdsa_verify_p256_sign(void);
+void test_atcac_sw_ecdsa_verify_p256_key(void);
+void test_atcac_sw_ecdsa_verify_p256_cache(void);
+void test_atcac_sw_ecdsa_verify_p256_batch(void);
+void test_atcac_sw_hmac_drbg_cavp(void);
+void test_atcac_sw_hmac_drbg_inputs(void);
+void test_atcac_sw_random(void);
 
 
 #endif
\ No newline at end of file
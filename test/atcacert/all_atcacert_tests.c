@@ -69,6 +69,7 @@ void RunAllCertDataTests(void)
     RUN_TEST_GROUP(atcacert_date_get_max_date);
     RUN_TEST_GROUP(atcacert_date_dec_compcert);
     RUN_TEST_GROUP(atcacert_date_dec);
+    RUN_TEST_GROUP(atcacert_date_batch);
 
     RUN_TEST_GROUP(atcacert_get_key_id);
     RUN_TEST_GROUP(atcacert_set_cert_element);
@@ -100,6 +101,10 @@ void RunAllCertDataTests(void)
     RUN_TEST_GROUP(atcacert_cert_build);
     RUN_TEST_GROUP(atcacert_is_device_loc_overlap);
     RUN_TEST_GROUP(atcacert_get_device_data);
+    RUN_TEST_GROUP(atcacert_read_plan_build);
+    RUN_TEST_GROUP(atcacert_cache);
+
+    RUN_TEST_GROUP(atcacert_host_sw);
 }
 
 void RunAllCertIOTests(void)
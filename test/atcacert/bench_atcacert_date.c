@@ -0,0 +1,129 @@
+/**
+ * \file
+ * \brief Benchmark of the atcacert_date POSIX conversions, one at a time and batched.
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atcacert/atcacert_date.h"
+#include "test/atca_benchmarks.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_DATE_COUNT        4096
+#define BENCH_DATE_ITERATIONS   100
+
+/** \brief the year by year, month by month walk the conversion used to be, as the baseline */
+static uint32_t bench_date_walk(const atcacert_tm_utc_t* ts)
+{
+    static const uint32_t month_days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    uint32_t days = 0;
+    int year = ts->tm_year + 1900;
+    int y, m;
+
+    for (y = 1970; y < year; y++)
+        days += ((y % 4 == 0 && y % 100 != 0) || y % 400 == 0) ? 366 : 365;
+    for (m = 0; m < ts->tm_mon; m++)
+        days += month_days[m] + (m == 1 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0));
+
+    return (days + ts->tm_mday - 1) * 86400 + ts->tm_hour * 3600 + ts->tm_min * 60 + ts->tm_sec;
+}
+
+/**
+ * \brief ns per date for POSIX uint32 encode and decode: the old walk, the closed form one
+ *        date at a time, and atcacert_date_enc_batch()/atcacert_date_dec_batch()
+ */
+void bench_atcacert_date(void)
+{
+    static atcacert_tm_utc_t ts[BENCH_DATE_COUNT];
+    static uint8_t enc[BENCH_DATE_COUNT * DATEFMT_POSIX_UINT32_BE_SIZE];
+    uint32_t posix_time;
+    uint32_t sink = 0;
+    uint64_t start;
+    double ns[5];
+    size_t i;
+    int n;
+
+    // issue dates spread over 2000 to 2105, where the walk has the most years to cover
+    for (i = 0; i < BENCH_DATE_COUNT; i++)
+    {
+        posix_time = 946684800 + (uint32_t)(i * 817397u % 3300000000u);
+        enc[i * 4 + 0] = (uint8_t)(posix_time >> 24);
+        enc[i * 4 + 1] = (uint8_t)(posix_time >> 16);
+        enc[i * 4 + 2] = (uint8_t)(posix_time >> 8);
+        enc[i * 4 + 3] = (uint8_t)(posix_time >> 0);
+    }
+    atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_BE, enc, BENCH_DATE_COUNT, ts);
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_DATE_ITERATIONS; n++)
+    {
+        for (i = 0; i < BENCH_DATE_COUNT; i++)
+            sink += bench_date_walk(&ts[i]);
+    }
+    ns[0] = (double)(bench_now_ns() - start) / BENCH_DATE_ITERATIONS / BENCH_DATE_COUNT;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_DATE_ITERATIONS; n++)
+    {
+        for (i = 0; i < BENCH_DATE_COUNT; i++)
+            atcacert_date_enc_posix_uint32_be(&ts[i], &enc[i * 4]);
+    }
+    ns[1] = (double)(bench_now_ns() - start) / BENCH_DATE_ITERATIONS / BENCH_DATE_COUNT;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_DATE_ITERATIONS; n++)
+        atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, ts, BENCH_DATE_COUNT, enc);
+    ns[2] = (double)(bench_now_ns() - start) / BENCH_DATE_ITERATIONS / BENCH_DATE_COUNT;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_DATE_ITERATIONS; n++)
+    {
+        for (i = 0; i < BENCH_DATE_COUNT; i++)
+            atcacert_date_dec_posix_uint32_be(&enc[i * 4], &ts[i]);
+    }
+    ns[3] = (double)(bench_now_ns() - start) / BENCH_DATE_ITERATIONS / BENCH_DATE_COUNT;
+
+    start = bench_now_ns();
+    for (n = 0; n < BENCH_DATE_ITERATIONS; n++)
+        atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_BE, enc, BENCH_DATE_COUNT, ts);
+    ns[4] = (double)(bench_now_ns() - start) / BENCH_DATE_ITERATIONS / BENCH_DATE_COUNT;
+
+    printf("\r\natcacert_date POSIX uint32 ns per date (%d dates x %d)\r\n", BENCH_DATE_COUNT, BENCH_DATE_ITERATIONS);
+    printf("%-12s %10s %10s %10s\r\n", "", "walk", "single", "batch");
+    printf("%-12s %10.1f %10.1f %10.1f\r\n", "encode", ns[0], ns[1], ns[2]);
+    printf("%-12s %10s %10.1f %10.1f\r\n", "decode", "-", ns[3], ns[4]);
+    if (sink == 0)
+        printf("\r\n");
+}
@@ -0,0 +1,373 @@
+/**
+ * \file
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "atcacert/atcacert_cache.h"
+#include "atcacert/atcacert_client.h"
+#include "test/unity.h"
+#include "test/unity_fixture.h"
+#include "test_cert_def_0_device.h"
+#include "test_cert_def_1_signer.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_CACHE_FILE "test_atcacert_cache.bin"
+
+static const uint8_t g_comp_cert[72] = { 0x01, 0x02, 0x03, 0x04 };
+
+/* Fingerprint standing in for a compressed cert that differs in one byte */
+static void cache_fingerprint(uint8_t variant, uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE])
+{
+    uint8_t comp_cert[sizeof(g_comp_cert)];
+    int ret;
+
+    memcpy(comp_cert, g_comp_cert, sizeof(comp_cert));
+    comp_cert[sizeof(comp_cert) - 1] = variant;
+    ret = atcacert_cache_fingerprint(NULL, 0, comp_cert, sizeof(comp_cert), NULL, fingerprint);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+}
+
+TEST_GROUP(atcacert_cache);
+
+TEST_SETUP(atcacert_cache)
+{
+    atcacert_cache_clear();
+}
+
+TEST_TEAR_DOWN(atcacert_cache)
+{
+    atcacert_cache_clear();
+    remove(TEST_CACHE_FILE);
+}
+
+TEST(atcacert_cache, store_lookup)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t cert[512];
+    size_t cert_size = sizeof(cert);
+    char pem[1024];
+    size_t pem_size = sizeof(pem);
+    char pem_ref[1024];
+    size_t pem_ref_size = sizeof(pem_ref);
+    atcacert_cache_stats_t stats;
+
+    cache_fingerprint(0, fingerprint);
+    ret = atcacert_cache_lookup(1, fingerprint, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+
+    ret = atcacert_cache_store(1, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_cache_lookup(1, fingerprint, cert, &cert_size, pem, &pem_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(g_test_cert_def_0_device.cert_template_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(g_test_cert_def_0_device.cert_template, cert, cert_size);
+
+    ret = atcacert_encode_pem_cert(g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size, pem_ref, &pem_ref_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(pem_ref_size, pem_size);
+    TEST_ASSERT_EQUAL_STRING(pem_ref, pem);
+
+    // Another id with the same fingerprint is a different certificate
+    ret = atcacert_cache_lookup(2, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+
+    atcacert_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hits);
+    TEST_ASSERT_EQUAL(2, stats.misses);
+    TEST_ASSERT_EQUAL(1, stats.stores);
+}
+
+TEST(atcacert_cache, stale)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t fingerprint_new[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t cert[512];
+    size_t cert_size = sizeof(cert);
+
+    cache_fingerprint(0, fingerprint);
+    cache_fingerprint(1, fingerprint_new);
+    TEST_ASSERT(memcmp(fingerprint, fingerprint_new, sizeof(fingerprint)) != 0);
+
+    ret = atcacert_cache_store(1, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_store(2, fingerprint, g_test_cert_def_1_signer.cert_template, g_test_cert_def_1_signer.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    // A rewritten compressed cert misses and its rebuild replaces only its own entry
+    ret = atcacert_cache_lookup(1, fingerprint_new, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+    ret = atcacert_cache_store(1, fingerprint_new, g_test_cert_def_1_signer.cert_template, g_test_cert_def_1_signer.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_cache_lookup(1, fingerprint, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+    cert_size = sizeof(cert);
+    ret = atcacert_cache_lookup(1, fingerprint_new, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(g_test_cert_def_1_signer.cert_template, cert, cert_size);
+    ret = atcacert_cache_lookup(2, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+}
+
+TEST(atcacert_cache, lru)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint32_t id;
+
+    cache_fingerprint(0, fingerprint);
+    for (id = 0; id < ATCACERT_CACHE_ENTRIES; id++)
+    {
+        ret = atcacert_cache_store(id, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    }
+
+    // Using the oldest entry makes the second oldest the one to go
+    ret = atcacert_cache_lookup(0, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_store(ATCACERT_CACHE_ENTRIES, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_cache_lookup(1, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+    for (id = 0; id <= ATCACERT_CACHE_ENTRIES; id++)
+    {
+        if (id == 1)
+            continue;
+        ret = atcacert_cache_lookup(id, fingerprint, NULL, NULL, NULL, NULL);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    }
+}
+
+TEST(atcacert_cache, small_buf)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t cert[64];
+    size_t cert_size = sizeof(cert);
+    char pem[64];
+    size_t pem_size = sizeof(pem);
+    static uint8_t too_big[ATCACERT_CACHE_MAX_CERT_SIZE + 1];
+
+    cache_fingerprint(0, fingerprint);
+    ret = atcacert_cache_store(1, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_cache_lookup(1, fingerprint, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, ret);
+    TEST_ASSERT_EQUAL(g_test_cert_def_0_device.cert_template_size, cert_size);
+
+    ret = atcacert_cache_lookup(1, fingerprint, NULL, NULL, pem, &pem_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, ret);
+    TEST_ASSERT(pem_size > sizeof(pem));
+
+    ret = atcacert_cache_store(2, fingerprint, too_big, sizeof(too_big));
+    TEST_ASSERT_EQUAL(ATCACERT_E_BUFFER_TOO_SMALL, ret);
+}
+
+TEST(atcacert_cache, fingerprint)
+{
+    int ret = 0;
+    uint8_t base[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t other[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t ca_public_key[64];
+
+    memset(ca_public_key, 0, sizeof(ca_public_key));
+    ret = atcacert_cache_fingerprint(g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size,
+                                     g_comp_cert, sizeof(g_comp_cert), NULL, base);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    // Repeatable
+    ret = atcacert_cache_fingerprint(g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size,
+                                     g_comp_cert, sizeof(g_comp_cert), NULL, other);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(base, other, sizeof(base));
+
+    // Every input counts, even an all zero CA key
+    ret = atcacert_cache_fingerprint(g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size,
+                                     g_comp_cert, sizeof(g_comp_cert), ca_public_key, other);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT(memcmp(base, other, sizeof(base)) != 0);
+
+    ret = atcacert_cache_fingerprint(g_test_cert_def_1_signer.cert_template, g_test_cert_def_1_signer.cert_template_size,
+                                     g_comp_cert, sizeof(g_comp_cert), NULL, other);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT(memcmp(base, other, sizeof(base)) != 0);
+
+    ret = atcacert_cache_fingerprint(g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size,
+                                     g_comp_cert, sizeof(g_comp_cert) - 1, NULL, other);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT(memcmp(base, other, sizeof(base)) != 0);
+}
+
+TEST(atcacert_cache, save_load)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t cert[512];
+    size_t cert_size = sizeof(cert);
+    char pem[1024];
+    size_t pem_size = sizeof(pem);
+    char pem_ref[1024];
+    size_t pem_ref_size = sizeof(pem_ref);
+    atcacert_cache_stats_t stats;
+
+    cache_fingerprint(0, fingerprint);
+    ret = atcacert_cache_store(0x02100000, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_store(0x020C0000, fingerprint, g_test_cert_def_1_signer.cert_template, g_test_cert_def_1_signer.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_lookup(0x02100000, fingerprint, NULL, NULL, pem_ref, &pem_ref_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_cache_save(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    atcacert_cache_clear();
+    ret = atcacert_cache_lookup(0x02100000, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+
+    ret = atcacert_cache_load(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    atcacert_cache_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.hits + stats.misses + stats.stores);
+
+    ret = atcacert_cache_lookup(0x02100000, fingerprint, cert, &cert_size, pem, &pem_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(g_test_cert_def_0_device.cert_template_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(g_test_cert_def_0_device.cert_template, cert, cert_size);
+    TEST_ASSERT_EQUAL_STRING(pem_ref, pem);
+    cert_size = sizeof(cert);
+    ret = atcacert_cache_lookup(0x020C0000, fingerprint, cert, &cert_size, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(g_test_cert_def_1_signer.cert_template_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(g_test_cert_def_1_signer.cert_template, cert, cert_size);
+
+    // An empty cache saves and loads too
+    atcacert_cache_clear();
+    ret = atcacert_cache_save(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_load(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+}
+
+TEST(atcacert_cache, load_damaged)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t file[1024];
+    size_t file_size;
+    FILE* fp;
+
+    cache_fingerprint(0, fingerprint);
+    ret = atcacert_cache_store(1, fingerprint, g_test_cert_def_0_device.cert_template, g_test_cert_def_0_device.cert_template_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_cache_save(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    fp = fopen(TEST_CACHE_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    file_size = fread(file, 1, sizeof(file), fp);
+    fclose(fp);
+    TEST_ASSERT(file_size > 100 && file_size < sizeof(file));
+
+    // Corrupt a byte of the certificate
+    file[100] ^= 0x01;
+    fp = fopen(TEST_CACHE_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    TEST_ASSERT_EQUAL(file_size, fwrite(file, 1, file_size, fp));
+    fclose(fp);
+
+    ret = atcacert_cache_load(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_DECODING_ERROR, ret);
+    ret = atcacert_cache_lookup(1, fingerprint, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_NOT_CACHED, ret);
+
+    // Truncated
+    file[100] ^= 0x01;
+    fp = fopen(TEST_CACHE_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(fp);
+    TEST_ASSERT_EQUAL(20, fwrite(file, 1, 20, fp));
+    fclose(fp);
+    ret = atcacert_cache_load(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_DECODING_ERROR, ret);
+
+    remove(TEST_CACHE_FILE);
+    ret = atcacert_cache_load(TEST_CACHE_FILE);
+    TEST_ASSERT_EQUAL(ATCACERT_E_ERROR, ret);
+}
+
+TEST(atcacert_cache, bad_params)
+{
+    int ret = 0;
+    uint8_t fingerprint[ATCACERT_CACHE_FINGERPRINT_SIZE];
+    uint8_t cert[64];
+    char pem[64];
+
+    ret = atcacert_cache_fingerprint(NULL, 10, g_comp_cert, sizeof(g_comp_cert), NULL, fingerprint);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_fingerprint(NULL, 0, NULL, sizeof(g_comp_cert), NULL, fingerprint);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_fingerprint(NULL, 0, g_comp_cert, sizeof(g_comp_cert), NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    cache_fingerprint(0, fingerprint);
+    ret = atcacert_cache_lookup(1, NULL, NULL, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_lookup(1, fingerprint, cert, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_lookup(1, fingerprint, NULL, NULL, pem, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_cache_store(1, NULL, cert, sizeof(cert));
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_store(1, fingerprint, NULL, sizeof(cert));
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_store(1, fingerprint, cert, 0);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_cache_save(NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_cache_load(NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_read_cert_cached(NULL, NULL, cert, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+    ret = atcacert_read_cert_pem_cached(&g_test_cert_def_0_device, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+}
@@ -38,6 +38,7 @@
 
 
 #include "atcacert/atcacert_client.h"
+#include "atcacert/atcacert_cache.h"
 #include "test/unity.h"
 #include "test/unity_fixture.h"
 #include <string.h>
@@ -303,6 +304,69 @@ TEST(atcacert_client, atcacert_client__atcacert_read_cert_device)
     TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
 }
 
+TEST(atcacert_client, atcacert_client__atcacert_read_cert_plan)
+{
+    int ret = 0;
+    uint8_t cert[512];
+    size_t cert_size;
+    atcacert_read_plan_t plan;
+    int i;
+
+    ret = atcacert_read_plan_build(&g_test_cert_def_0_device, &plan);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    // The same plan serves repeated reads
+    for (i = 0; i < 2; i++)
+    {
+        cert_size = sizeof(cert);
+        ret = atcacert_read_cert_plan(&plan, g_signer_public_key, cert, &cert_size);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL(g_device_cert_ref_size, cert_size);
+        TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    }
+}
+
+TEST(atcacert_client, atcacert_client__atcacert_read_cert_cached)
+{
+    int ret = 0;
+    uint8_t cert[512];
+    size_t cert_size;
+    char pem[1024];
+    size_t pem_size = sizeof(pem);
+    char pem_ref[1024];
+    size_t pem_ref_size = sizeof(pem_ref);
+    atcacert_cache_stats_t stats;
+    int i;
+
+    atcacert_cache_enable(true);
+
+    // Rebuilt once, then served from the cache
+    for (i = 0; i < 2; i++)
+    {
+        cert_size = sizeof(cert);
+        ret = atcacert_read_cert_cached(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL(g_device_cert_ref_size, cert_size);
+        TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    }
+    ret = atcacert_read_cert_pem_cached(&g_test_cert_def_0_device, g_signer_public_key, pem, &pem_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    ret = atcacert_encode_pem_cert(g_device_cert_ref, g_device_cert_ref_size, pem_ref, &pem_ref_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_STRING(pem_ref, pem);
+
+    // A different CA key is a different certificate
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert_cached(&g_test_cert_def_0_device, g_signer_ca_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    atcacert_cache_stats(&stats);
+    atcacert_cache_enable(false);
+    TEST_ASSERT_EQUAL(2, stats.hits);
+    TEST_ASSERT_EQUAL(2, stats.misses);
+    TEST_ASSERT_EQUAL(2, stats.stores);
+}
+
 TEST(atcacert_client, atcacert_client__atcacert_read_cert_small_buf)
 {
     int ret = 0;
@@ -430,4 +494,101 @@ TEST(atcacert_client, atcacert_client__atcacert_get_response_bad_params)
 
     ret = atcacert_get_response(16, NULL, NULL);
     TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
-}
\ No newline at end of file
+}
+
+TEST_GROUP(atcacert_read_plan_build);
+
+TEST_SETUP(atcacert_read_plan_build)
+{
+}
+
+TEST_TEAR_DOWN(atcacert_read_plan_build)
+{
+}
+
+TEST(atcacert_read_plan_build, device)
+{
+    int ret = 0;
+    atcacert_read_plan_t plan;
+    static const atcacert_read_op_t ops_ref[] = {
+        { 0, 0, 0, 32 },    // compressed cert, slot 10
+        { 0, 1, 0, 32 },
+        { 0, 2, 0, 32 },
+        { 1, 0, 0, 64 },    // public key, GenKey slot 0
+        { 2, 0, 0, 32 },    // device SN, config bytes 0-12
+    };
+
+    ret = atcacert_read_plan_build(&g_test_cert_def_0_device, &plan);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_PTR(&g_test_cert_def_0_device, plan.cert_def);
+    TEST_ASSERT_EQUAL(3, plan.device_locs_count);
+    TEST_ASSERT_EQUAL(sizeof(ops_ref) / sizeof(ops_ref[0]), plan.ops_count);
+    TEST_ASSERT_EQUAL_MEMORY(ops_ref, plan.ops, sizeof(ops_ref));
+    TEST_ASSERT_EQUAL(5, plan.commands);
+    TEST_ASSERT_EQUAL(4 * (11 + 32) + (11 + 64), plan.bus_bytes);
+}
+
+TEST(atcacert_read_plan_build, words)
+{
+    int ret = 0;
+    atcacert_read_plan_t plan;
+    atcacert_def_t cert_def;
+    const atcacert_cert_element_t cert_elements[] = {
+        {
+            .id         = "config word",
+            .device_loc = { .zone = DEVZONE_CONFIG, .slot = 0, .is_genkey = 0, .offset = 20, .count = 4 },
+            .cert_loc   = { .offset = 0, .count = 0 }
+        },
+        {
+            .id         = "slot word",
+            .device_loc = { .zone = DEVZONE_DATA, .slot = 10, .is_genkey = 0, .offset = 101, .count = 2 },
+            .cert_loc   = { .offset = 0, .count = 0 }
+        }
+    };
+    static const atcacert_read_op_t ops_ref[] = {
+        { 0, 0, 0, 32 },    // compressed cert, slot 10
+        { 0, 1, 0, 32 },
+        { 0, 2, 0, 32 },
+        { 0, 3, 1, 4  },    // slot word, slot 10 bytes 100-103
+        { 1, 0, 0, 64 },    // public key, GenKey slot 0
+        { 2, 0, 5, 4  },    // config word, config bytes 20-23
+    };
+
+    memcpy(&cert_def, &g_test_cert_def_0_device, sizeof(cert_def));
+    cert_def.sn_source = SNSRC_STORED;
+    cert_def.cert_elements = cert_elements;
+    cert_def.cert_elements_count = sizeof(cert_elements) / sizeof(cert_elements[0]);
+
+    ret = atcacert_read_plan_build(&cert_def, &plan);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(sizeof(ops_ref) / sizeof(ops_ref[0]), plan.ops_count);
+    TEST_ASSERT_EQUAL_MEMORY(ops_ref, plan.ops, sizeof(ops_ref));
+    TEST_ASSERT_EQUAL(6, plan.commands);
+    TEST_ASSERT_EQUAL(3 * (11 + 32) + 2 * (11 + 4) + (11 + 64), plan.bus_bytes);
+}
+
+TEST(atcacert_read_plan_build, bad_params)
+{
+    int ret = 0;
+    atcacert_read_plan_t plan;
+    uint8_t cert[128];
+    size_t cert_size = sizeof(cert);
+
+    ret = atcacert_read_plan_build(NULL, &plan);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_read_plan_build(&g_test_cert_def_0_device, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_read_cert_plan(NULL, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_read_plan_build(&g_test_cert_def_0_device, &plan);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    ret = atcacert_read_cert_plan(&plan, g_signer_public_key, NULL, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_read_cert_plan(&plan, g_signer_public_key, cert, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+}
@@ -50,9 +50,18 @@ TEST_GROUP_RUNNER(atcacert_client)
 
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_signer);
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_device);
+    RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_plan);
+    RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_cached);
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_small_buf);
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_read_cert_bad_params);
 
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_get_response);
     RUN_TEST_CASE(atcacert_client, atcacert_client__atcacert_get_response_bad_params);
 }
+
+TEST_GROUP_RUNNER(atcacert_read_plan_build)
+{
+    RUN_TEST_CASE(atcacert_read_plan_build, device);
+    RUN_TEST_CASE(atcacert_read_plan_build, words);
+    RUN_TEST_CASE(atcacert_read_plan_build, bad_params);
+}
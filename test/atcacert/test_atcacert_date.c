@@ -2042,4 +2042,167 @@ TEST(atcacert_date_dec, bad_params)
     ts_str_size = sizeof(ts_str);
     ret = atcacert_date_dec(DATEFMT_RFC5280_GEN, NULL, ts_str_size, NULL);
     TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
-}
\ No newline at end of file
+}
+
+
+TEST_GROUP(atcacert_date_batch);
+
+TEST_SETUP(atcacert_date_batch)
+{
+}
+
+TEST_TEAR_DOWN(atcacert_date_batch)
+{
+}
+
+/**
+ * \brief Every day of POSIX uint32 time decodes to the calendar day after the previous
+ *        one and encodes back to the same value.
+ */
+TEST(atcacert_date_batch, posix_every_day)
+{
+    static const int month_days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    static uint8_t enc[256 * DATEFMT_POSIX_UINT32_BE_SIZE];
+    static uint8_t enc_back[256 * DATEFMT_POSIX_UINT32_BE_SIZE];
+    static atcacert_tm_utc_t ts[256];
+    atcacert_tm_utc_t ref;
+    uint32_t day = 0;
+    uint32_t secs;
+    size_t i, count;
+    int ret, year, mdays;
+
+    set_tm(&ref, 1970, 1, 1, 0, 0, 0);
+    while (day <= 0xFFFFFFFE / 86400)
+    {
+        count = 0;
+        for (i = 0; i < 256 && day <= 0xFFFFFFFE / 86400; i++, day++, count++)
+        {
+            // walk the time of day too, short of the end of POSIX uint32 time
+            secs = day * 86400;
+            if ((uint64_t)secs + (day * 3607) % 86400 <= 0xFFFFFFFE)
+                secs += (day * 3607) % 86400;
+            enc[i * 4 + 0] = (uint8_t)(secs >> 24);
+            enc[i * 4 + 1] = (uint8_t)(secs >> 16);
+            enc[i * 4 + 2] = (uint8_t)(secs >> 8);
+            enc[i * 4 + 3] = (uint8_t)(secs >> 0);
+        }
+        ret = atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_BE, enc, count, ts);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+        for (i = 0; i < count; i++)
+        {
+            TEST_ASSERT_EQUAL(ref.tm_year, ts[i].tm_year);
+            TEST_ASSERT_EQUAL(ref.tm_mon, ts[i].tm_mon);
+            TEST_ASSERT_EQUAL(ref.tm_mday, ts[i].tm_mday);
+
+            year = ref.tm_year + 1900;
+            mdays = month_days[ref.tm_mon] + (ref.tm_mon == 1 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+            if (++ref.tm_mday > mdays)
+            {
+                ref.tm_mday = 1;
+                if (++ref.tm_mon > 11)
+                {
+                    ref.tm_mon = 0;
+                    ref.tm_year++;
+                }
+            }
+        }
+
+        ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, ts, count, enc_back);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_MEMORY(enc, enc_back, count * DATEFMT_POSIX_UINT32_BE_SIZE);
+    }
+}
+
+TEST(atcacert_date_batch, posix_uint32_le)
+{
+    int ret = 0;
+    atcacert_tm_utc_t ts[3];
+    atcacert_tm_utc_t ts_dec[3];
+    uint8_t ts_str[3 * DATEFMT_POSIX_UINT32_LE_SIZE];
+    const uint8_t ts_str_ref[] = {
+        0xF7, 0x4C, 0x7F, 0x52,     // 2013-11-10 09:08:07
+        0x00, 0x00, 0x00, 0x00,     // 1970-01-01 00:00:00
+        0xFE, 0xFF, 0xFF, 0xFF      // 2106-02-07 06:28:14
+    };
+
+    set_tm(&ts[0], 2013, 11, 10, 9, 8, 7);
+    set_tm(&ts[1], 1970, 1, 1, 0, 0, 0);
+    set_tm(&ts[2], 2106, 2, 7, 6, 28, 14);
+
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_LE, ts, 3, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(ts_str_ref, ts_str, sizeof(ts_str_ref));
+
+    ret = atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_LE, ts_str, 3, ts_dec);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(ts, ts_dec, sizeof(ts));
+}
+
+TEST(atcacert_date_batch, rfc5280_gen)
+{
+    int ret = 0;
+    atcacert_tm_utc_t ts[2];
+    atcacert_tm_utc_t ts_dec[2];
+    uint8_t ts_str[2 * DATEFMT_RFC5280_GEN_SIZE];
+
+    set_tm(&ts[0], 2013, 11, 10, 9, 8, 7);
+    set_tm(&ts[1], 9999, 12, 31, 23, 59, 59);
+
+    ret = atcacert_date_enc_batch(DATEFMT_RFC5280_GEN, ts, 2, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY("20131110090807Z99991231235959Z", ts_str, sizeof(ts_str));
+
+    ret = atcacert_date_dec_batch(DATEFMT_RFC5280_GEN, ts_str, 2, ts_dec);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(ts, ts_dec, sizeof(ts));
+}
+
+TEST(atcacert_date_batch, invalid)
+{
+    int ret = 0;
+    atcacert_tm_utc_t ts[3];
+    uint8_t ts_str[3 * DATEFMT_POSIX_UINT32_BE_SIZE];
+
+    set_tm(&ts[0], 2013, 11, 10, 9, 8, 7);
+    set_tm(&ts[1], 2106, 2, 7, 6, 28, 15);   // one second past the max
+    set_tm(&ts[2], 2013, 11, 10, 9, 8, 7);
+
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, ts, 3, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_INVALID_DATE, ret);
+
+    set_tm(&ts[1], 1969, 12, 31, 23, 59, 59);
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_LE, ts, 3, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_INVALID_DATE, ret);
+}
+
+TEST(atcacert_date_batch, bad_params)
+{
+    int ret = 0;
+    atcacert_tm_utc_t ts;
+    uint8_t ts_str[DATEFMT_POSIX_UINT32_BE_SIZE];
+
+    set_tm(&ts, 2013, 11, 10, 9, 8, 7);
+
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, NULL, 1, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, &ts, 1, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_date_enc_batch((atcacert_date_format_t)20, &ts, 1, ts_str);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_BE, NULL, 1, &ts);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_date_dec_batch(DATEFMT_POSIX_UINT32_BE, ts_str, 1, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_date_dec_batch((atcacert_date_format_t)20, ts_str, 1, &ts);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    // nothing to do is not an error
+    ret = atcacert_date_enc_batch(DATEFMT_POSIX_UINT32_BE, NULL, 0, NULL);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+}
@@ -215,4 +215,13 @@ TEST_GROUP_RUNNER(atcacert_date_dec)
     RUN_TEST_CASE(atcacert_date_dec, small_buf);
     RUN_TEST_CASE(atcacert_date_dec, bad_format);
     RUN_TEST_CASE(atcacert_date_dec, bad_params);
-}
\ No newline at end of file
+}
+
+TEST_GROUP_RUNNER(atcacert_date_batch)
+{
+    RUN_TEST_CASE(atcacert_date_batch, posix_every_day);
+    RUN_TEST_CASE(atcacert_date_batch, posix_uint32_le);
+    RUN_TEST_CASE(atcacert_date_batch, rfc5280_gen);
+    RUN_TEST_CASE(atcacert_date_batch, invalid);
+    RUN_TEST_CASE(atcacert_date_batch, bad_params);
+}
@@ -0,0 +1,64 @@
+/**
+ * \file
+ *
+ * \copyright Copyright (c) 2017 Microchip Technology Inc. and its subsidiaries (Microchip). All rights reserved.
+ *
+ * \page License
+ *
+ * You are permitted to use this software and its derivatives with Microchip
+ * products. Redistribution and use in source and binary forms, with or without
+ * modification, is permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Microchip may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with a
+ *    Microchip integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY MICROCHIP "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL MICROCHIP BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test/unity.h"
+#include "test/unity_fixture.h"
+
+#ifdef __GNUC__
+// Unity macros trigger this warning
+#pragma GCC diagnostic ignored "-Wnested-externs"
+#endif
+
+TEST_GROUP_RUNNER(atcacert_host_sw)
+{
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_cert_sw);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_cert_sw_verify_failed);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_cert_sw_short_cert);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_cert_sw_bad_sig);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_cert_sw_bad_params);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_certs_sw_batch);
+
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_gen_challenge_sw);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_gen_challenge_sw_bad_params);
+
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw_bad_challenge);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw_bad_response);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw_bad_public_key);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw_malformed_public_key);
+    RUN_TEST_CASE(atcacert_host_sw, atcacert_host_sw__atcacert_verify_response_sw_bad_params);
+}
@@ -57,7 +57,11 @@
 #include "atca_unit_tests.h"
 #include "atca_basic_tests.h"
 #include "atca_crypto_sw_tests.h"
+#include "atca_benchmarks.h"
 #include "cmd-processor.h"
+#ifdef ATCA_HAL_SIM
+#include "hal/hal_sim.h"
+#endif
 
 #define TEST_CD
 #define TEST_CIO
@@ -201,6 +205,28 @@ static void atca_basic_tests(ATCADeviceType deviceType)
     UnityMain(sizeof(argv) / sizeof(char*), argv, RunAllBasicTests);
 }
 
+#ifdef ATCA_HAL_SIM
+/** \brief run the basic tests on a simulated device, starting from factory state and
+ *         once more after locking each of the config and data zones, so the tests that
+ *         need a particular lock state all get their turn
+ */
+static void atca_sim_basic_tests(ATCADeviceType deviceType)
+{
+    const char* argv[] = { "manual", "-v" };
+
+    *gCfg = (deviceType == ATSHA204A) ? cfg_atsha204a_sim_default : cfg_atecc508a_sim_default;
+    hal_sim_reset(gCfg->atcasim.device_id);
+
+    UnityMain(sizeof(argv) / sizeof(char*), argv, RunAllBasicTests);
+    if (lock_config_zone() != ATCA_SUCCESS)
+        return;
+    UnityMain(sizeof(argv) / sizeof(char*), argv, RunAllBasicTests);
+    if (lock_data_zone() != ATCA_SUCCESS)
+        return;
+    UnityMain(sizeof(argv) / sizeof(char*), argv, RunAllBasicTests);
+}
+#endif
+
 static void atca_basic_otpzero_test(void)
 {
     const char* argv[] = { "manual", "-v" };
@@ -227,6 +253,10 @@ int help(void)
     printf("b108 - run basic tests on ECC108A\r\n");
     printf("u204 - run unit tests for SHA204A\r\n");
     printf("b204 - run basic tests for SHA204A\r\n");
+#ifdef ATCA_HAL_SIM
+    printf("s508 - run basic tests on a simulated ECC508A at each lock state\r\n");
+    printf("s204 - run basic tests on a simulated SHA204A at each lock state\r\n");
+#endif
     printf("util - run helper function tests\r\n");
     printf("readcfg - read the config zone\r\n");
     printf("data N - read the data zone for slot N\r\n");
@@ -246,6 +276,7 @@ int help(void)
     printf("crypto - run unit tests for software crypto functions\r\n");
 #endif
     printf("rand - generate some random numbers\r\n");
+    printf("bench - run host-side benchmarks\r\n");
     printf("discover - buses and devices\r\n");
 
 
@@ -522,6 +553,16 @@ int parseCmd(const char *command)
     {
         atca_basic_tests(ATSHA204A);
     }
+#ifdef ATCA_HAL_SIM
+    else if ( (cmds = strstr(command, "s508")) )
+    {
+        atca_sim_basic_tests(ATECC508A);
+    }
+    else if ( (cmds = strstr(command, "s204")) )
+    {
+        atca_sim_basic_tests(ATSHA204A);
+    }
+#endif
     else if ( (cmds = strstr(command, "util")) )
     {
         atca_helper_tests();
@@ -538,6 +579,10 @@ int parseCmd(const char *command)
         certio_unit_tests();
     }
 #endif
+    else if ( (cmds = strstr(command, "bench")) )
+    {
+        atca_benchmarks();
+    }
     else if ( (cmds = strstr(command, "otpzero")) )
     {
         atca_basic_otpzero_test();